@@ -0,0 +1 @@
+/root/repo/src/wifi/model/rate-control/aarf-wifi-manager.h
\ No newline at end of file
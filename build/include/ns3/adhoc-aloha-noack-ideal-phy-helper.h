@@ -0,0 +1 @@
+/root/repo/src/spectrum/helper/adhoc-aloha-noack-ideal-phy-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/adhoc-wifi-mac.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/netanim/model/animation-interface.h
\ No newline at end of file
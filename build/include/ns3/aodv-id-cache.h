@@ -0,0 +1 @@
+/root/repo/src/aodv/model/aodv-id-cache.h
\ No newline at end of file
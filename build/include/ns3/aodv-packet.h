@@ -0,0 +1 @@
+/root/repo/src/aodv/model/aodv-packet.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/aodv/model/aodv-rtable.h
\ No newline at end of file
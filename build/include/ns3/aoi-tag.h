@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/aoi-tag.h
\ No newline at end of file
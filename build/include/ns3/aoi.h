@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/aoi.h
\ No newline at end of file
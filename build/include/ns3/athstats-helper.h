@@ -0,0 +1 @@
+/root/repo/src/wifi/helper/athstats-helper.h
\ No newline at end of file
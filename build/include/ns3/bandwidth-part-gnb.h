@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/bandwidth-part-gnb.h
\ No newline at end of file
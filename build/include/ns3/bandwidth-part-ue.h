@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/bandwidth-part-ue.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/energy/model/basic-energy-harvester.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/beam-manager.h
\ No newline at end of file
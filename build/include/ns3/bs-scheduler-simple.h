@@ -0,0 +1 @@
+/root/repo/src/wimax/model/bs-scheduler-simple.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wave/model/bsm-application.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/buildings/model/building-list.h
\ No newline at end of file
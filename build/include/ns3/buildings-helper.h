@@ -0,0 +1 @@
+/root/repo/src/buildings/helper/buildings-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/buildings/model/buildings-propagation-loss-model.h
\ No newline at end of file
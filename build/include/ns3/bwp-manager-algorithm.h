@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/bwp-manager-algorithm.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/bwp-manager-ue.h
\ No newline at end of file
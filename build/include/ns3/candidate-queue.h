@@ -0,0 +1 @@
+/root/repo/src/internet/model/candidate-queue.h
\ No newline at end of file
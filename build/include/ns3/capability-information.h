@@ -0,0 +1 @@
+/root/repo/src/wifi/model/capability-information.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/cc-bwp-helper.h
\ No newline at end of file
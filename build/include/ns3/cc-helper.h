@@ -0,0 +1 @@
+/root/repo/src/lte/helper/cc-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/propagation/model/channel-condition-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/network/model/channel-list.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/spectrum/model/complex-matrix-array.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/csma/model/csma-channel.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/ctrl-headers.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wave/model/default-channel-scheduler.h
\ No newline at end of file
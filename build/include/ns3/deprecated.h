@@ -0,0 +1 @@
+/root/repo/src/core/model/deprecated.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/dsdv/model/dsdv-routing-protocol.h
\ No newline at end of file
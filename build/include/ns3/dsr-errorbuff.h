@@ -0,0 +1 @@
+/root/repo/src/dsr/model/dsr-errorbuff.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/dsr/model/dsr-routing.h
\ No newline at end of file
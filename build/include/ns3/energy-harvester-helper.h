@@ -0,0 +1 @@
+/root/repo/src/energy/helper/energy-harvester-helper.h
\ No newline at end of file
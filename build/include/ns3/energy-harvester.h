@@ -0,0 +1 @@
+/root/repo/src/energy/model/energy-harvester.h
\ No newline at end of file
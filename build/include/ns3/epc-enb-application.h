@@ -0,0 +1 @@
+/root/repo/src/lte/model/epc-enb-application.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/epc-enb-s1-sap.h
\ No newline at end of file
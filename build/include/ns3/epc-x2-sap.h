@@ -0,0 +1 @@
+/root/repo/src/lte/model/epc-x2-sap.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/network/utils/error-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/error-rate-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/core/model/fatal-impl.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/fd-net-device/model/fd-net-device.h
\ No newline at end of file
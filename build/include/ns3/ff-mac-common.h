@@ -0,0 +1 @@
+/root/repo/src/lte/model/ff-mac-common.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/ff-mac-scheduler.h
\ No newline at end of file
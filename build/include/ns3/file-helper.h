@@ -0,0 +1 @@
+/root/repo/src/stats/helper/file-helper.h
\ No newline at end of file
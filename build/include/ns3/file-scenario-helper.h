@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/file-scenario-helper.h
\ No newline at end of file
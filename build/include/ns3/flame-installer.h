@@ -0,0 +1 @@
+/root/repo/src/mesh/helper/flame/flame-installer.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/mesh/model/flame/flame-protocol.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/mesh/model/flame/flame-rtable.h
\ No newline at end of file
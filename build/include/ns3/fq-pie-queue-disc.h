@@ -0,0 +1 @@
+/root/repo/src/traffic-control/model/fq-pie-queue-disc.h
\ No newline at end of file
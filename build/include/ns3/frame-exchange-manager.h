@@ -0,0 +1 @@
+/root/repo/src/wifi/model/frame-exchange-manager.h
\ No newline at end of file
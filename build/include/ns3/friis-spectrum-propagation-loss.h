@@ -0,0 +1 @@
+/root/repo/src/spectrum/model/friis-spectrum-propagation-loss.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/internet/model/global-route-manager.h
\ No newline at end of file
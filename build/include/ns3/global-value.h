@@ -0,0 +1 @@
+/root/repo/src/core/model/global-value.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/he/he-operation.h
\ No newline at end of file
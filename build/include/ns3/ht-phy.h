@@ -0,0 +1 @@
+/root/repo/src/wifi/model/ht/ht-phy.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/mesh/model/dot11s/hwmp-protocol.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/internet/model/icmpv6-l4-protocol.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/ideal-beamforming-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/mesh/model/dot11s/ie-dot11s-rann.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/core/model/int64x64-128.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/network/utils/ipv4-address.h
\ No newline at end of file
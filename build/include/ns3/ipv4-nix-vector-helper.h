@@ -0,0 +1 @@
+/root/repo/src/nix-vector-routing/helper/ipv4-nix-vector-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/internet/model/ipv4-raw-socket-impl.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/internet/model/ipv6-end-point-demux.h
\ No newline at end of file
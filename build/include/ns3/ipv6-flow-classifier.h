@@ -0,0 +1 @@
+/root/repo/src/flow-monitor/model/ipv6-flow-classifier.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/internet/model/ipv6-queue-disc-item.h
\ No newline at end of file
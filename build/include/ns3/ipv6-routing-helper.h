@@ -0,0 +1 @@
+/root/repo/src/internet/helper/ipv6-routing-helper.h
\ No newline at end of file
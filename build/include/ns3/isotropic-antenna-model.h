@@ -0,0 +1 @@
+/root/repo/src/antenna/model/isotropic-antenna-model.h
\ No newline at end of file
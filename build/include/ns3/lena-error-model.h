@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/lena-error-model.h
\ No newline at end of file
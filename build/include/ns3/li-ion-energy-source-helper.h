@@ -0,0 +1 @@
+/root/repo/src/energy/helper/li-ion-energy-source-helper.h
\ No newline at end of file
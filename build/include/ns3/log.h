@@ -0,0 +1 @@
+/root/repo/src/core/model/log.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lr-wpan/model/lr-wpan-interference-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lr-wpan/model/lr-wpan-mac-header.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-anr.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-as-sap.h
\ No newline at end of file
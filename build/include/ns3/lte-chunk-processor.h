@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-chunk-processor.h
\ No newline at end of file
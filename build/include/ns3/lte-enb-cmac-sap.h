@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-enb-cmac-sap.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-enb-component-carrier-manager.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-enb-rrc.h
\ No newline at end of file
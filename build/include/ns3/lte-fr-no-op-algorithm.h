@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-fr-no-op-algorithm.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/helper/lte-global-pathloss-database.h
\ No newline at end of file
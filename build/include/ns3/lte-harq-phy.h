@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-harq-phy.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/helper/lte-hex-grid-enb-topology-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-mi-error-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-phy.h
\ No newline at end of file
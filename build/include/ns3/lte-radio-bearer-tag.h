@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-radio-bearer-tag.h
\ No newline at end of file
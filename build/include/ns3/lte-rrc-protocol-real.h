@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-rrc-protocol-real.h
\ No newline at end of file
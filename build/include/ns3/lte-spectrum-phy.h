@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-spectrum-phy.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/lte-vendor-specific-parameters.h
\ No newline at end of file
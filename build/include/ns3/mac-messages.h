@@ -0,0 +1 @@
+/root/repo/src/wimax/model/mac-messages.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/network/utils/mac8-address.h
\ No newline at end of file
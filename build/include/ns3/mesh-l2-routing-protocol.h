@@ -0,0 +1 @@
+/root/repo/src/mesh/model/mesh-l2-routing-protocol.h
\ No newline at end of file
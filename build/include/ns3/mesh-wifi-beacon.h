@@ -0,0 +1 @@
+/root/repo/src/mesh/model/mesh-wifi-beacon.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/mesh/model/mesh-wifi-interface-mac.h
\ No newline at end of file
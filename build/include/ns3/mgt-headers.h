@@ -0,0 +1 @@
+/root/repo/src/wifi/model/mgt-headers.h
\ No newline at end of file
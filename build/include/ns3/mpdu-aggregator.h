@@ -0,0 +1 @@
+/root/repo/src/wifi/model/mpdu-aggregator.h
\ No newline at end of file
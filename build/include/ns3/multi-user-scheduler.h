@@ -0,0 +1 @@
+/root/repo/src/wifi/model/he/multi-user-scheduler.h
\ No newline at end of file
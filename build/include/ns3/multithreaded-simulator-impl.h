@@ -0,0 +1 @@
+/root/repo/src/core/model/multithreaded-simulator-impl.h
\ No newline at end of file
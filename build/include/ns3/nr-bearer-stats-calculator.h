@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/nr-bearer-stats-calculator.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-ch-access-manager.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-dci-containers.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/nr-delay-histogram.h
\ No newline at end of file
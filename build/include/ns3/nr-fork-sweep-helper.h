@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/nr-fork-sweep-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-gnb-net-device.h
\ No newline at end of file
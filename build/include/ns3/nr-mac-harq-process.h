@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-mac-harq-process.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-mac-header-fs.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-mac-scheduler-cqi-management.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-mac-scheduler-ns3.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-mac-scheduler-ofdma-pf.h
\ No newline at end of file
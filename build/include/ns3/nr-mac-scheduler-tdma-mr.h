@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-mac-scheduler-tdma-mr.h
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifdef NS3_MODULE_COMPILATION 
+    error "Do not include ns3 module aggregator headers from other modules these are meant only for end user scripts." 
+#endif 
+#ifndef NS3_MODULE_NR
+    // Module headers: 
+    #include <ns3/nr-helper.h>
+    #include <ns3/nr-phy-rx-trace.h>
+    #include <ns3/nr-mac-rx-trace.h>
+    #include <ns3/nr-point-to-point-epc-helper.h>
+    #include <ns3/nr-bearer-stats-calculator.h>
+    #include <ns3/nr-bearer-stats-connector.h>
+    #include <ns3/nr-bearer-stats-simple.h>
+    #include <ns3/nr-delay-histogram.h>
+    #include <ns3/beamforming-helper-base.h>
+    #include <ns3/ideal-beamforming-helper.h>
+    #include <ns3/realistic-beamforming-helper.h>
+    #include <ns3/node-distribution-scenario-interface.h>
+    #include <ns3/grid-scenario-helper.h>
+    #include <ns3/hexagonal-grid-scenario-helper.h>
+    #include <ns3/file-scenario-helper.h>
+    #include <ns3/trajectory-file-helper.h>
+    #include <ns3/cc-bwp-helper.h>
+    #include <ns3/nr-radio-environment-map-helper.h>
+    #include <ns3/nr-spectrum-value-helper.h>
+    #include <ns3/scenario-parameters.h>
+    #include <ns3/three-gpp-ftp-m1-helper.h>
+    #include <ns3/nr-stats-calculator.h>
+    #include <ns3/nr-mac-scheduling-stats.h>
+    #include <ns3/aoi.h>
+    #include <ns3/aoi-tag.h>
+    #include <ns3/nr-net-device.h>
+    #include <ns3/nr-gnb-net-device.h>
+    #include <ns3/nr-ue-net-device.h>
+    #include <ns3/nr-phy.h>
+    #include <ns3/nr-gnb-phy.h>
+    #include <ns3/nr-ue-phy.h>
+    #include <ns3/nr-spectrum-phy.h>
+    #include <ns3/nr-interference.h>
+    #include <ns3/nr-mac-pdu-info.h>
+    #include <ns3/nr-mac-header-vs.h>
+    #include <ns3/nr-mac-header-vs-ul.h>
+    #include <ns3/nr-mac-header-vs-dl.h>
+    #include <ns3/nr-mac-header-fs.h>
+    #include <ns3/nr-mac-header-fs-ul.h>
+    #include <ns3/nr-mac-header-fs-dl.h>
+    #include <ns3/nr-mac-short-bsr-ce.h>
+    #include <ns3/nr-phy-mac-common.h>
+    #include <ns3/nr-dci-containers.h>
+    #include <ns3/nr-pool-allocator.h>
+    #include <ns3/nr-mac-scheduler.h>
+    #include <ns3/nr-mac-scheduler-tdma-rr.h>
+    #include <ns3/nr-mac-scheduler-tdma-pf.h>
+    #include <ns3/nr-mac-scheduler-ofdma-rr.h>
+    #include <ns3/nr-mac-scheduler-ofdma-pf.h>
+    #include <ns3/nr-control-messages.h>
+    #include <ns3/nr-spectrum-signal-parameters.h>
+    #include <ns3/nr-radio-bearer-tag.h>
+    #include <ns3/nr-amc.h>
+    #include <ns3/nr-mac-sched-sap.h>
+    #include <ns3/nr-mac-csched-sap.h>
+    #include <ns3/nr-phy-sap.h>
+    #include <ns3/nr-lte-mi-error-model.h>
+    #include <ns3/nr-gnb-mac.h>
+    #include <ns3/nr-ue-mac.h>
+    #include <ns3/nr-rrc-protocol-ideal.h>
+    #include <ns3/nr-harq-phy.h>
+    #include <ns3/bandwidth-part-gnb.h>
+    #include <ns3/bandwidth-part-ue.h>
+    #include <ns3/bwp-manager-gnb.h>
+    #include <ns3/bwp-manager-ue.h>
+    #include <ns3/bwp-manager-algorithm.h>
+    #include <ns3/nr-mac-harq-process.h>
+    #include <ns3/nr-mac-harq-vector.h>
+    #include <ns3/nr-mac-scheduler-harq-rr.h>
+    #include <ns3/nr-mac-scheduler-cqi-management.h>
+    #include <ns3/nr-mac-scheduler-lcg.h>
+    #include <ns3/nr-mac-scheduler-ns3.h>
+    #include <ns3/nr-mac-scheduler-tdma.h>
+    #include <ns3/nr-mac-scheduler-ofdma.h>
+    #include <ns3/nr-mac-scheduler-ofdma-mr.h>
+    #include <ns3/nr-mac-scheduler-tdma-mr.h>
+    #include <ns3/nr-mac-scheduler-ue-info.h>
+    #include <ns3/nr-mac-scheduler-ue-info-mr.h>
+    #include <ns3/nr-mac-scheduler-ue-info-rr.h>
+    #include <ns3/nr-mac-scheduler-ue-info-pf.h>
+    #include <ns3/nr-eesm-error-model.h>
+    #include <ns3/nr-eesm-t1.h>
+    #include <ns3/nr-eesm-t2.h>
+    #include <ns3/nr-eesm-ir.h>
+    #include <ns3/nr-eesm-cc.h>
+    #include <ns3/nr-eesm-ir-t1.h>
+    #include <ns3/nr-eesm-ir-t2.h>
+    #include <ns3/nr-eesm-cc-t1.h>
+    #include <ns3/nr-eesm-cc-t2.h>
+    #include <ns3/nr-error-model.h>
+    #include <ns3/nr-ch-access-manager.h>
+    #include <ns3/beam-id.h>
+    #include <ns3/beamforming-vector.h>
+    #include <ns3/beam-manager.h>
+    #include <ns3/ideal-beamforming-algorithm.h>
+    #include <ns3/realistic-beamforming-algorithm.h>
+    #include <ns3/sfnsf.h>
+    #include <ns3/lena-error-model.h>
+    #include <ns3/nr-mac-scheduler-srs.h>
+    #include <ns3/nr-mac-scheduler-srs-default.h>
+    #include <ns3/nr-ue-power-control.h>
+    #include <ns3/realistic-bf-manager.h>
+    #include <ns3/beam-conf-id.h>
+    #include <ns3/file-transfer-helper.h>
+    #include <ns3/file-transfer-application.h>
+    #include <ns3/three-gpp-channel-model-param.h>
+    #include <ns3/distance-based-three-gpp-spectrum-propagation-loss-model.h>
+    #include <ns3/nr-fork-sweep-helper.h>
+#endif 
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-phy-sap.h
\ No newline at end of file
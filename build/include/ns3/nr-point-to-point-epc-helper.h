@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/nr-point-to-point-epc-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-pool-allocator.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/nr-radio-environment-map-helper.h
\ No newline at end of file
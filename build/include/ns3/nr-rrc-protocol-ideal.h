@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-rrc-protocol-ideal.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-spectrum-signal-parameters.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-ue-net-device.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/nr-ue-phy.h
\ No newline at end of file
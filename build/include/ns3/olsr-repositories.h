@@ -0,0 +1 @@
+/root/repo/src/olsr/model/olsr-repositories.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/olsr/model/olsr-state.h
\ No newline at end of file
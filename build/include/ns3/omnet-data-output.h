@@ -0,0 +1 @@
+/root/repo/src/stats/model/omnet-data-output.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/applications/helper/on-off-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/topology-read/model/orbis-topology-reader.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/applications/model/packet-loss-counter.h
\ No newline at end of file
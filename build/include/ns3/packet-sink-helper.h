@@ -0,0 +1 @@
+/root/repo/src/applications/helper/packet-sink-helper.h
\ No newline at end of file
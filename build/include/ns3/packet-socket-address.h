@@ -0,0 +1 @@
+/root/repo/src/network/utils/packet-socket-address.h
\ No newline at end of file
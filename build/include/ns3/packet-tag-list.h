@@ -0,0 +1 @@
+/root/repo/src/network/model/packet-tag-list.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/network/model/packet.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/core/model/pair.h
\ No newline at end of file
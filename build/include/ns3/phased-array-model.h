@@ -0,0 +1 @@
+/root/repo/src/antenna/model/phased-array-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/phy-entity.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/helper/phy-stats-calculator.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/propagation/model/probabilistic-v2v-channel-condition-model.h
\ No newline at end of file
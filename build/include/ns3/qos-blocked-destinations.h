@@ -0,0 +1 @@
+/root/repo/src/wifi/model/qos-blocked-destinations.h
\ No newline at end of file
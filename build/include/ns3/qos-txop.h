@@ -0,0 +1 @@
+/root/repo/src/wifi/model/qos-txop.h
\ No newline at end of file
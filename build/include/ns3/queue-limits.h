@@ -0,0 +1 @@
+/root/repo/src/network/utils/queue-limits.h
\ No newline at end of file
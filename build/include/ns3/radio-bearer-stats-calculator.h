@@ -0,0 +1 @@
+/root/repo/src/lte/helper/radio-bearer-stats-calculator.h
\ No newline at end of file
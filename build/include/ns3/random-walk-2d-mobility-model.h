@@ -0,0 +1 @@
+/root/repo/src/mobility/model/random-walk-2d-mobility-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/mobility/model/random-waypoint-mobility-model.h
\ No newline at end of file
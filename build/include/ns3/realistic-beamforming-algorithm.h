@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/realistic-beamforming-algorithm.h
\ No newline at end of file
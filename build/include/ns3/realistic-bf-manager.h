@@ -0,0 +1 @@
+/root/repo/contrib/nr/model/realistic-bf-manager.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/mobility/model/rectangle.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/internet/model/ripng.h
\ No newline at end of file
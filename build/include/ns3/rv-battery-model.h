@@ -0,0 +1 @@
+/root/repo/src/energy/model/rv-battery-model.h
\ No newline at end of file
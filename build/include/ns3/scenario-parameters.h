@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/scenario-parameters.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wimax/model/send-params.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/applications/model/seq-ts-size-header.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/network/utils/simple-channel.h
\ No newline at end of file
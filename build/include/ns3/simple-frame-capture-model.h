@@ -0,0 +1 @@
+/root/repo/src/wifi/model/simple-frame-capture-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wimax/model/snr-to-block-error-rate-manager.h
\ No newline at end of file
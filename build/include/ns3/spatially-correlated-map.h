@@ -0,0 +1 @@
+/root/repo/src/propagation/model/spatially-correlated-map.h
\ No newline at end of file
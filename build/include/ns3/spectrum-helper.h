@@ -0,0 +1 @@
+/root/repo/src/spectrum/helper/spectrum-helper.h
\ No newline at end of file
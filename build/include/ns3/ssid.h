@@ -0,0 +1 @@
+/root/repo/src/wifi/model/ssid.h
\ No newline at end of file
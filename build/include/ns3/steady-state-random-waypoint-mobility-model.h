@@ -0,0 +1 @@
+/root/repo/src/mobility/model/steady-state-random-waypoint-mobility-model.h
\ No newline at end of file
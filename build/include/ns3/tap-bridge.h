@@ -0,0 +1 @@
+/root/repo/src/tap-bridge/model/tap-bridge.h
\ No newline at end of file
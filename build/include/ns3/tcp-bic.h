@@ -0,0 +1 @@
+/root/repo/src/internet/model/tcp-bic.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/internet/model/tcp-option-sack.h
\ No newline at end of file
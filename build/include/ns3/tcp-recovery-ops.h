@@ -0,0 +1 @@
+/root/repo/src/internet/model/tcp-recovery-ops.h
\ No newline at end of file
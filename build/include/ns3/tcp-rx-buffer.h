@@ -0,0 +1 @@
+/root/repo/src/internet/model/tcp-rx-buffer.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/lte/model/tdbet-ff-mac-scheduler.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/core/model/test.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/rate-control/thompson-sampling-wifi-manager.h
\ No newline at end of file
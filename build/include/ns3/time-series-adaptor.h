@@ -0,0 +1 @@
+/root/repo/src/stats/model/time-series-adaptor.h
\ No newline at end of file
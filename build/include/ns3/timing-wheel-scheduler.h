@@ -0,0 +1 @@
+/root/repo/src/core/model/timing-wheel-scheduler.h
\ No newline at end of file
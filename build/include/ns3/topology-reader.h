@@ -0,0 +1 @@
+/root/repo/src/topology-read/model/topology-reader.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/network/model/trailer.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/contrib/nr/helper/trajectory-file-helper.h
\ No newline at end of file
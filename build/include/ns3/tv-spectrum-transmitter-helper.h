@@ -0,0 +1 @@
+/root/repo/src/spectrum/helper/tv-spectrum-transmitter-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/spectrum/model/tv-spectrum-transmitter.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/uan/model/uan-header-rc.h
\ No newline at end of file
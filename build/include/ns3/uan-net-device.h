@@ -0,0 +1 @@
+/root/repo/src/uan/model/uan-net-device.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/uan/model/uan-noise-model-default.h
\ No newline at end of file
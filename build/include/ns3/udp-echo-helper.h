@@ -0,0 +1 @@
+/root/repo/src/applications/helper/udp-echo-helper.h
\ No newline at end of file
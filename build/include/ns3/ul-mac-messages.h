@@ -0,0 +1 @@
+/root/repo/src/wimax/model/ul-mac-messages.h
\ No newline at end of file
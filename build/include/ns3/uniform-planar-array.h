@@ -0,0 +1 @@
+/root/repo/src/antenna/model/uniform-planar-array.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/core/model/unused.h
\ No newline at end of file
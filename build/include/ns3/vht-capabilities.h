@@ -0,0 +1 @@
+/root/repo/src/wifi/model/vht/vht-capabilities.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/vht/vht-frame-exchange-manager.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/virtual-net-device/model/virtual-net-device.h
\ No newline at end of file
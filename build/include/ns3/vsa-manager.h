@@ -0,0 +1 @@
+/root/repo/src/wave/model/vsa-manager.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wave/helper/wave-bsm-stats.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wave/model/wave-frame-exchange-manager.h
\ No newline at end of file
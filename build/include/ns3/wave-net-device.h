@@ -0,0 +1 @@
+/root/repo/src/wave/model/wave-net-device.h
\ No newline at end of file
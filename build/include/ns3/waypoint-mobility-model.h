@@ -0,0 +1 @@
+/root/repo/src/mobility/model/waypoint-mobility-model.h
\ No newline at end of file
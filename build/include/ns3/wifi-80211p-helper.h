@@ -0,0 +1 @@
+/root/repo/src/wave/helper/wifi-80211p-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/helper/wifi-mac-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/wifi-phy-listener.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/wifi-phy-operating-channel.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/wifi-remote-station-info.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/wifi-spectrum-phy-interface.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wifi/model/wifi-tx-current-model.h
\ No newline at end of file
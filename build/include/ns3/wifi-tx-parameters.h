@@ -0,0 +1 @@
+/root/repo/src/wifi/model/wifi-tx-parameters.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/wimax/model/wimax-connection.h
\ No newline at end of file
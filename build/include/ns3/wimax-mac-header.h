@@ -0,0 +1 @@
+/root/repo/src/wimax/model/wimax-mac-header.h
\ No newline at end of file
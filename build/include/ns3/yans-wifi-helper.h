@@ -0,0 +1 @@
+/root/repo/src/wifi/helper/yans-wifi-helper.h
\ No newline at end of file
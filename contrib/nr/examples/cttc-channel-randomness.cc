@@ -248,11 +248,11 @@ main (int argc, char *argv[])
 
   Ptr<const ThreeGppChannelModel::ChannelMatrix> channelMatrix1 = channelModel->GetChannel (txMob, rxMob, txAntenna, rxAntenna);
 
-/*  for (uint32_t i = 0; i < channelMatrix1->m_channel.size (); i++)
+/*  for (uint32_t i = 0; i < channelMatrix1->m_channel.GetNumRows (); i++)
   {
-      for (uint32_t j = 0; j < channelMatrix1->m_channel.at (0).size (); j++)
+      for (uint32_t j = 0; j < channelMatrix1->m_channel.GetNumCols (); j++)
       {
-          std::cout << channelMatrix1->m_channel[i][j][0] << std::endl;
+          std::cout << channelMatrix1->m_channel (i, j, 0) << std::endl;
       }
   }*/
 
@@ -278,11 +278,11 @@ main (int argc, char *argv[])
 
   Ptr<const ThreeGppChannelModel::ChannelMatrix> channelMatrix2 = channelModel->GetChannel (txMob, rxMob, txAntenna, rxAntenna);
 
-/*  for (uint32_t i = 0; i < channelMatrix2->m_channel.size (); i++)
+/*  for (uint32_t i = 0; i < channelMatrix2->m_channel.GetNumRows (); i++)
   {
-      for (uint32_t j = 0; j < channelMatrix2->m_channel.at (0).size (); j++)
+      for (uint32_t j = 0; j < channelMatrix2->m_channel.GetNumCols (); j++)
       {
-          std::cout << channelMatrix2->m_channel[i][j][0] << std::endl;
+          std::cout << channelMatrix2->m_channel (i, j, 0) << std::endl;
       }
   }*/
 
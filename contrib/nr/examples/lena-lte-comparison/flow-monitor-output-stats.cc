@@ -60,7 +60,6 @@ FlowMonitorOutputStats::Save (const Ptr<FlowMonitor> &monitor,
                               FlowMonitorHelper &flowmonHelper,
                               const std::string &filename)
 {
-  bool ret;
   monitor->CheckForLostPackets ();
   Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier> (flowmonHelper.GetClassifier ());
   FlowMonitor::FlowStatsContainer flowStats = monitor->GetFlowStats ();
@@ -78,6 +77,7 @@ FlowMonitorOutputStats::Save (const Ptr<FlowMonitor> &monitor,
 
   outFile.setf (std::ios_base::fixed);
 
+  SQLiteOutput::RowBatch batch (m_tableName, 11);
   for (auto i = flowStats.cbegin (); i != flowStats.cend (); ++i)
     {
       Ipv4FlowClassifier::FiveTuple t = classifier->FindFlow (i->first);
@@ -92,10 +92,6 @@ FlowMonitorOutputStats::Save (const Ptr<FlowMonitor> &monitor,
           protoStream.str ("UDP");
         }
 
-      sqlite3_stmt *stmt;
-
-      m_db->SpinPrepare (&stmt, "INSERT INTO " + m_tableName + " VALUES (?,?,?,?,?,?,?,?,?,?,?);");
-
       // Measure the duration of the flow from sender's perspective
       double rxDuration = i->second.timeLastTxPacket.GetSeconds () - i->second.timeFirstTxPacket.GetSeconds ();
       double txOffered = i->second.txBytes * 8.0 / rxDuration / 1000.0 / 1000.0;
@@ -106,17 +102,6 @@ FlowMonitorOutputStats::Save (const Ptr<FlowMonitor> &monitor,
       outFile << "  TxOffered:  " << txOffered << " Mbps\n";
       outFile << "  Rx Bytes:   " << i->second.rxBytes << "\n";
 
-      ret = m_db->Bind (stmt, 1, i->first);
-      NS_ABORT_UNLESS (ret);
-      ret = m_db->Bind (stmt, 2, i->second.txPackets);
-      NS_ABORT_UNLESS (ret);
-      ret = m_db->Bind (stmt, 3, static_cast<uint32_t> (i->second.txBytes));
-      NS_ABORT_UNLESS (ret);
-      ret = m_db->Bind (stmt, 4, txOffered);
-      NS_ABORT_UNLESS (ret);
-      ret = m_db->Bind (stmt, 5, static_cast<uint32_t> (i->second.rxBytes));
-      NS_ABORT_UNLESS (ret);
-
       if (i->second.rxPackets > 0)
         {
           double th = i->second.rxBytes * 8.0 / rxDuration / 1000 / 1000;
@@ -126,43 +111,25 @@ FlowMonitorOutputStats::Save (const Ptr<FlowMonitor> &monitor,
           averageFlowThroughput += th;
           averageFlowDelay += delay;
 
-          ret = m_db->Bind (stmt, 6, th);
-          NS_ABORT_UNLESS (ret);
-          ret = m_db->Bind (stmt, 7, delay);
-          NS_ABORT_UNLESS (ret);
-          ret = m_db->Bind (stmt, 8, jitter);
-          NS_ABORT_UNLESS (ret);
-
           outFile << "  Throughput: " << th << " Mbps\n";
           outFile << "  Mean delay:  " <<  delay << " ms\n";
           outFile << "  Mean jitter:  " << jitter  << " ms\n";
+
+          // only the flows that received something are stored in the database
+          batch.AddRow (i->first, i->second.txPackets, static_cast<uint32_t> (i->second.txBytes),
+                        txOffered, static_cast<uint32_t> (i->second.rxBytes), th, delay, jitter,
+                        i->second.rxPackets, RngSeedManager::GetSeed (),
+                        static_cast<uint32_t> (RngSeedManager::GetRun ()));
         }
       else
         {
           outFile << "  Throughput:  0 Mbps\n";
           outFile << "  Mean delay:  0 ms (NOT VALID)\n";
           outFile << "  Mean jitter: 0 ms (NOT VALID)\n";
-          ret = m_db->Bind (stmt, 6, 0.0);
-          NS_ABORT_UNLESS (ret);
-          ret = m_db->Bind (stmt, 7, 0.0);
-          NS_ABORT_UNLESS (ret);
-          ret = m_db->Bind (stmt, 8, 0.0);
-          NS_ABORT_UNLESS (ret);
         }
       outFile << "  Rx Packets: " << i->second.rxPackets << "\n";
-      ret = m_db->Bind (stmt, 9, i->second.rxPackets);
-      NS_ABORT_UNLESS (ret);
-      ret = m_db->Bind (stmt, 10, RngSeedManager::GetSeed ());
-      NS_ABORT_UNLESS (ret);
-      ret = m_db->Bind (stmt, 11, static_cast<uint32_t> (RngSeedManager::GetRun ()));
-      NS_ABORT_UNLESS (ret);
-
-      if (i->second.rxPackets > 0)
-        {
-          ret = m_db->SpinExec (stmt);
-          NS_ABORT_UNLESS (ret);
-        }
     }
+  m_db->Write (std::move (batch));
 
   outFile << "\n\n  Mean flow throughput: " << averageFlowThroughput / flowStats.size () << "\n";
   outFile << "  Mean flow delay: " << averageFlowDelay / flowStats.size () << "\n";
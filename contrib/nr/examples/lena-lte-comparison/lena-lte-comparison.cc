@@ -253,6 +253,10 @@ LenaLteComparison (const Parameters &params)
 
   std::cout << "  statistics\n";
   SQLiteOutput db (params.outputDir + "/" + params.simTag + ".db", "lena-lte-comparison");
+  // the batches of the statistics are written by a background thread, while
+  // the simulation continues
+  db.SetWalMode ();
+  db.EnableAsyncWrite ();
   SinrOutputStats sinrStats;
   PowerOutputStats ueTxPowerStats;
   PowerOutputStats gnbRxPowerStats;
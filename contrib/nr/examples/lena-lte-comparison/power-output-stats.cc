@@ -120,45 +120,16 @@ PowerOutputStats::DeleteWhere (SQLiteOutput *p, uint32_t seed,
 
 void PowerOutputStats::WriteCache ()
 {
-  bool ret = m_db->SpinExec ("BEGIN TRANSACTION;");
+  SQLiteOutput::RowBatch batch (m_tableName, 13);
   for (const auto & v : m_powerCache)
     {
-      sqlite3_stmt *stmt;
-      ret = m_db->SpinPrepare (&stmt, "INSERT INTO " + m_tableName + " VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?);");
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 1, v.frame);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 2, v.subFrame);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 3, v.slot);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 4, v.rnti);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 5, static_cast<uint32_t> (v.imsi));
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 6, v.bwpId);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 7, v.cellId);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 8, v.txPowerRb);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 9, v.txPowerTotal);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 10, v.rbNumActive);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 11, v.rbNumTotal);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 12, RngSeedManager::GetSeed ());
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 13, static_cast<uint32_t> (RngSeedManager::GetRun ()));
-      NS_ASSERT (ret);
-
-      ret = m_db->SpinExec (stmt);
-      NS_ASSERT (ret);
+      batch.AddRow (v.frame, v.subFrame, v.slot, v.rnti, static_cast<uint32_t> (v.imsi),
+                    v.bwpId, v.cellId, v.txPowerRb, v.txPowerTotal, v.rbNumActive,
+                    v.rbNumTotal, RngSeedManager::GetSeed (),
+                    static_cast<uint32_t> (RngSeedManager::GetRun ()));
     }
   m_powerCache.clear ();
-  ret = m_db->SpinExec ("END TRANSACTION;");
-  NS_ASSERT (ret);
+  m_db->Write (std::move (batch));
 }
 
 } // namespace ns3
@@ -95,40 +95,18 @@ RbOutputStats::DeleteWhere (SQLiteOutput *p, uint32_t seed,
 
 void RbOutputStats::WriteCache ()
 {
-  bool ret = m_db->SpinExec ("BEGIN TRANSACTION;");
+  SQLiteOutput::RowBatch batch (m_tableName, 9);
   for (const auto & v : m_slotCache)
     {
       for (const auto & rb : v.rbUsed)
         {
-          sqlite3_stmt *stmt;
-          ret = m_db->SpinPrepare (&stmt, "INSERT INTO " + m_tableName + " VALUES (?,?,?,?,?,?,?,?,?);");
-          NS_ASSERT (ret);
-          ret = m_db->Bind (stmt, 1, v.sfnSf.GetFrame ());
-          NS_ASSERT (ret);
-          ret = m_db->Bind (stmt, 2, v.sfnSf.GetSubframe ());
-          NS_ASSERT (ret);
-          ret = m_db->Bind (stmt, 3, v.sfnSf.GetSlot ());
-          NS_ASSERT (ret);
-          ret = m_db->Bind (stmt, 4, v.sym);
-          NS_ASSERT (ret);
-          ret = m_db->Bind (stmt, 5, rb);
-          NS_ASSERT (ret);
-          ret = m_db->Bind (stmt, 6, v.bwpId);
-          NS_ASSERT (ret);
-          ret = m_db->Bind (stmt, 7, v.cellId);
-          NS_ASSERT (ret);
-          ret = m_db->Bind (stmt, 8, RngSeedManager::GetSeed ());
-          NS_ASSERT (ret);
-          ret = m_db->Bind (stmt, 9, static_cast<uint32_t> (RngSeedManager::GetRun ()));
-          NS_ASSERT (ret);
-
-          ret = m_db->SpinExec (stmt);
-          NS_ASSERT (ret);
+          batch.AddRow (v.sfnSf.GetFrame (), v.sfnSf.GetSubframe (), v.sfnSf.GetSlot (),
+                        v.sym, rb, v.bwpId, v.cellId, RngSeedManager::GetSeed (),
+                        static_cast<uint32_t> (RngSeedManager::GetRun ()));
         }
     }
   m_slotCache.clear ();
-  ret = m_db->SpinExec ("END TRANSACTION;");
-  NS_ASSERT (ret);
+  m_db->Write (std::move (batch));
 }
 
 } // namespace ns3
@@ -83,31 +83,14 @@ SinrOutputStats::DeleteWhere (SQLiteOutput *p, uint32_t seed,
 
 void SinrOutputStats::WriteCache ()
 {
-  bool ret = m_db->SpinExec ("BEGIN TRANSACTION;");
+  SQLiteOutput::RowBatch batch (m_tableName, 6);
   for (const auto & v : m_sinrCache)
     {
-      sqlite3_stmt *stmt;
-      ret = m_db->SpinPrepare (&stmt, "INSERT INTO " + m_tableName + " VALUES (?,?,?,?,?,?);");
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 1, v.cellId);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 2, v.bwpId);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 3, v.rnti);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 4, v.avgSinr);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 5, RngSeedManager::GetSeed ());
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 6, static_cast<uint32_t> (RngSeedManager::GetRun ()));
-      NS_ASSERT (ret);
-
-      ret = m_db->SpinExec (stmt);
-      NS_ASSERT (ret);
+      batch.AddRow (v.cellId, v.bwpId, v.rnti, v.avgSinr, RngSeedManager::GetSeed (),
+                    static_cast<uint32_t> (RngSeedManager::GetRun ()));
     }
   m_sinrCache.clear ();
-  ret = m_db->SpinExec ("END TRANSACTION;");
-  NS_ASSERT (ret);
+  m_db->Write (std::move (batch));
 }
 
 } // namespace ns3
@@ -102,43 +102,16 @@ SlotOutputStats::DeleteWhere (SQLiteOutput *p, uint32_t seed,
 
 void SlotOutputStats::WriteCache ()
 {
-  bool ret = m_db->SpinExec ("BEGIN TRANSACTION;");
+  SQLiteOutput::RowBatch batch (m_tableName, 12);
   for (const auto & v : m_slotCache)
     {
-      sqlite3_stmt *stmt;
-      ret = m_db->SpinPrepare (&stmt, "INSERT INTO " + m_tableName + " VALUES (?,?,?,?,?,?,?,?,?,?,?,?);");
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 1, v.sfnSf.GetFrame ());
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 2, v.sfnSf.GetSubframe ());
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 3, v.sfnSf.GetSlot ());
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 4, v.bwpId);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 5, v.cellId);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 6, v.scheduledUe);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 7, v.usedReg);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 8, v.usedSym);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 9, v.availableRb);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 10, v.availableSym);
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 11, RngSeedManager::GetSeed ());
-      NS_ASSERT (ret);
-      ret = m_db->Bind (stmt, 12, static_cast<uint32_t> (RngSeedManager::GetRun ()));
-      NS_ASSERT (ret);
-
-      ret = m_db->SpinExec (stmt);
-      NS_ASSERT (ret);
+      batch.AddRow (v.sfnSf.GetFrame (), v.sfnSf.GetSubframe (), v.sfnSf.GetSlot (),
+                    v.bwpId, v.cellId, v.scheduledUe, v.usedReg, v.usedSym,
+                    v.availableRb, v.availableSym, RngSeedManager::GetSeed (),
+                    static_cast<uint32_t> (RngSeedManager::GetRun ()));
     }
   m_slotCache.clear ();
-  ret = m_db->SpinExec ("END TRANSACTION;");
-  NS_ASSERT (ret);
+  m_db->Write (std::move (batch));
 }
 
 } // namespace ns3
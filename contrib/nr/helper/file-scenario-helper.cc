@@ -153,11 +153,30 @@ FileScenarioHelper::Add (const std::string filePath,
     {
       m_bsPositioner = CreateObject<ListPositionAllocator> ();
     }
-  m_bsPositioner->Add (filePath, m_bsHeight, delimiter);
+  if (TrajectoryFile::IsTrajectoryFile (filePath))
+    {
+      TrajectoryFile sites (filePath);
+      for (std::size_t siteId = 0; siteId < sites.GetNumNodes (); ++siteId)
+        {
+          m_bsPositioner->Add (sites.GetWaypoint (siteId, 0).position);
+        }
+    }
+  else
+    {
+      m_bsPositioner->Add (filePath, m_bsHeight, delimiter);
+    }
   auto numSites = m_bsPositioner->GetSize ();
   SetSitesNumber (numSites);
 }
 
+void
+FileScenarioHelper::SetUtTrajectories (const std::string filePath,
+                                       uint32_t lookAhead /* = 16 */)
+{
+  m_utTrajectories = Create<TrajectoryFile> (filePath);
+  m_utLookAhead = lookAhead;
+}
+
 void
 FileScenarioHelper::CheckScenario (const char * where) const
 {
@@ -191,6 +210,9 @@ FileScenarioHelper::CreateScenario ()
                  "Must SetBsHeight() before CreateScenario()");
   NS_ASSERT_MSG (m_utHeight >= 0.0,
                  "Must SetUtHeight() before CreateScenario()");
+  NS_ABORT_MSG_IF (m_utTrajectories && m_utTrajectories->GetNumNodes () < m_numUt,
+                   "The UT trajectory file has " << m_utTrajectories->GetNumNodes () <<
+                   " nodes, " << m_numUt << " UTs are needed");
 
   auto sectors = GetNumSectorsPerSite ();
   std::cout << "      creating BS" << std::endl;
@@ -265,6 +287,27 @@ FileScenarioHelper::CreateScenario ()
   std::cout << effIsd << std::endl;
   
 
+  // Position the UEs along their trajectories, if given
+  if (m_utTrajectories)
+    {
+      std::cout << "      UE trajectories" << std::endl;
+      TrajectoryFileHelper trajectories (m_utTrajectories);
+      trajectories.SetLookAhead (m_utLookAhead);
+      trajectories.Install (m_ut);
+
+      Ptr<ListPositionAllocator> utPositioner = CreateObject<ListPositionAllocator> ();
+      for (uint32_t utId = 0; utId < m_numUt; ++utId)
+        {
+          utPositioner->Add (m_utTrajectories->GetWaypoint (utId, 0).position);
+        }
+
+      std::cout << "      plot deployment" << std::endl;
+      PlotDeployment (m_bsPositioner, utPositioner, sectors, maxRadius, std::min (effIsd, m_isd));
+
+      m_scenarioCreated = true;
+      return;
+    }
+
   // Position the UEs uniformly in the sector annulus
   std::cout << "      UE positions" << std::endl;
   // equivalent for a hexagonal laydown:
@@ -22,6 +22,7 @@
 #define FILE_SCENARIO_HELPER_H
 
 #include "node-distribution-scenario-interface.h"
+#include "trajectory-file-helper.h"
 #include <ns3/ptr.h>
 #include <ns3/vector.h>
 
@@ -59,6 +60,17 @@ public:
    * The file is read using CsvReader, which explains how comments
    * and whitespace are handled.
    *
+   * The file can also be a binary TrajectoryFile (e.g., converted once from
+   * the CSV file with TrajectoryFile::ConvertCsv), which is mapped instead
+   * of being parsed; the site positions are the first waypoints of its
+   * nodes.
+   *
+   * The height of a site is the Z of the file, if it has one. A CSV file
+   * with only X and Y gets the BS height (SetBsHeight() or
+   * SetScenarioParameters(), which must come before this call). A
+   * TrajectoryFile always stores Z, so the BS height is not applied:
+   * pass it as the default Z to TrajectoryFile::ConvertCsv instead.
+   *
    * Multiple calls to Add() will append the positions from each
    * successive file to the list of sites.
    *
@@ -67,6 +79,21 @@ public:
    */
   void Add (const std::string filePath,
             char delimiter = ',');
+
+  /**
+   * \brief Read the UT positions from a trajectory file, instead of
+   * dropping the UTs randomly around the sites.
+   * UT i follows the trajectory of node i of the file, with the waypoints
+   * added on demand by TrajectoryFileHelper. The UT heights are the Z of
+   * the file, SetUtHeight() is not applied.
+   * CreateScenario() aborts if the file has fewer nodes than the UTs.
+   *
+   * \param [in] filePath The path to the TrajectoryFile.
+   * \param [in] lookAhead The number of waypoints added at a time;
+   * see TrajectoryFileHelper::SetLookAhead.
+   */
+  void SetUtTrajectories (const std::string filePath,
+                          uint32_t lookAhead = 16);
   
   /**
    * \brief Get the site position corresponding to a given cell.
@@ -97,6 +124,11 @@ private:
    */
   Ptr<ListPositionAllocator> m_bsPositioner;
 
+  /** The UT trajectories, if the UTs are not dropped randomly. */
+  Ptr<const TrajectoryFile> m_utTrajectories;
+  /** The number of UT waypoints added at a time. */
+  uint32_t m_utLookAhead {16};
+
 };
 
 } // namespace ns3
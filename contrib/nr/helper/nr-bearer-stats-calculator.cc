@@ -98,6 +98,18 @@ NrBearerStatsCalculator::GetTypeId (void)
                    StringValue ("NrUlPdcpStatsE2E.txt"),
                    MakeStringAccessor (&NrBearerStatsCalculator::m_ulPdcpOutputFilename),
                    MakeStringChecker ())
+    .AddAttribute ("RlcSnapshotFilename",
+                   "Name of the file where the RLC binary snapshots will be saved "
+                   "at every epoch. Empty to disable the snapshots.",
+                   StringValue (""),
+                   MakeStringAccessor (&NrBearerStatsCalculator::m_rlcSnapshotFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("PdcpSnapshotFilename",
+                   "Name of the file where the PDCP binary snapshots will be saved "
+                   "at every epoch. Empty to disable the snapshots.",
+                   StringValue (""),
+                   MakeStringAccessor (&NrBearerStatsCalculator::m_pdcpSnapshotFilename),
+                   MakeStringChecker ())
   ;
   return tid;
 }
@@ -138,18 +150,42 @@ NrBearerStatsCalculator::GetEpoch () const
   return m_epochDuration;
 }
 
+NrBearerStatsCalculator::BearerStats &
+NrBearerStatsCalculator::GetBearer (uint64_t imsi, uint8_t lcid)
+{
+  uint64_t key = (imsi << 8) | lcid;
+  auto it = m_bearerIndex.find (key);
+  if (it != m_bearerIndex.end ())
+    {
+      return m_bearers[it->second];
+    }
+
+  NS_LOG_DEBUG (this << " Creating stats for IMSI " << imsi << " and LCID " << (uint32_t) lcid);
+  m_bearerIndex.emplace (key, static_cast<uint32_t> (m_bearers.size ()));
+  m_bearers.emplace_back ();
+  m_bearers.back ().id = ImsiLcidPair_t (imsi, lcid);
+  return m_bearers.back ();
+}
+
+const NrBearerStatsCalculator::BearerStats *
+NrBearerStatsCalculator::FindBearer (uint64_t imsi, uint8_t lcid) const
+{
+  auto it = m_bearerIndex.find ((imsi << 8) | lcid);
+  return it != m_bearerIndex.end () ? &m_bearers[it->second] : nullptr;
+}
+
 void
 NrBearerStatsCalculator::UlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
   NS_LOG_FUNCTION (this);
 
-  ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_ulCellId[p] = cellId;
-      m_flowId[p] = LteFlowId_t (rnti, lcid);
-      m_ulTxPackets[p]++;
-      m_ulTxData[p] += packetSize;
+      BearerStats &bearer = GetBearer (imsi, lcid);
+      bearer.ul.cellId = cellId;
+      bearer.flowId = LteFlowId_t (rnti, lcid);
+      bearer.ul.txPackets++;
+      bearer.ul.txData += packetSize;
     }
   m_pendingOutput = true;
 }
@@ -159,13 +195,13 @@ NrBearerStatsCalculator::DlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti,
 {
   NS_LOG_FUNCTION (this);
 
-  ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_dlCellId[p] = cellId;
-      m_flowId[p] = LteFlowId_t (rnti, lcid);
-      m_dlTxPackets[p]++;
-      m_dlTxData[p] += packetSize;
+      BearerStats &bearer = GetBearer (imsi, lcid);
+      bearer.dl.cellId = cellId;
+      bearer.flowId = LteFlowId_t (rnti, lcid);
+      bearer.dl.txPackets++;
+      bearer.dl.txData += packetSize;
     }
   m_pendingOutput = true;
 }
@@ -176,22 +212,14 @@ NrBearerStatsCalculator::UlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti,
 {
   NS_LOG_FUNCTION (this);
 
-  ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_ulCellId[p] = cellId;
-      m_ulRxPackets[p]++;
-      m_ulRxData[p] += packetSize;
-
-      Uint64StatsMap::iterator it = m_ulDelay.find (p);
-      if (it == m_ulDelay.end ())
-        {
-          NS_LOG_DEBUG (this << " Creating UL stats calculators for IMSI " << p.m_imsi << " and LCID " << (uint32_t) p.m_lcId);
-          m_ulDelay[p] = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
-          m_ulPduSize[p] = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
-        }
-      m_ulDelay[p]->Update (delay);
-      m_ulPduSize[p]->Update (packetSize);
+      DirectionStats &ul = GetBearer (imsi, lcid).ul;
+      ul.cellId = cellId;
+      ul.rxPackets++;
+      ul.rxData += packetSize;
+      ul.delay.Update (delay);
+      ul.pduSize.Update (packetSize);
     }
   m_pendingOutput = true;
 }
@@ -201,22 +229,14 @@ NrBearerStatsCalculator::DlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti,
 {
   NS_LOG_FUNCTION (this);
 
-  ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_dlCellId[p] = cellId;
-      m_dlRxPackets[p]++;
-      m_dlRxData[p] += packetSize;
-
-      Uint64StatsMap::iterator it = m_dlDelay.find (p);
-      if (it == m_dlDelay.end ())
-        {
-          NS_LOG_DEBUG (this << " Creating DL stats calculators for IMSI " << p.m_imsi << " and LCID " << (uint32_t) p.m_lcId);
-          m_dlDelay[p] = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
-          m_dlPduSize[p] = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
-        }
-      m_dlDelay[p]->Update (delay);
-      m_dlPduSize[p]->Update (packetSize);
+      DirectionStats &dl = GetBearer (imsi, lcid).dl;
+      dl.cellId = cellId;
+      dl.rxPackets++;
+      dl.rxData += packetSize;
+      dl.delay.Update (delay);
+      dl.pduSize.Update (packetSize);
     }
   m_pendingOutput = true;
 }
@@ -229,6 +249,7 @@ NrBearerStatsCalculator::ShowResults (void)
 
   std::ofstream ulOutFile;
   std::ofstream dlOutFile;
+  bool firstWrite = m_firstWrite;
 
   if (m_firstWrite == true)
     {
@@ -274,6 +295,7 @@ NrBearerStatsCalculator::ShowResults (void)
 
   WriteUlResults (ulOutFile);
   WriteDlResults (dlOutFile);
+  WriteSnapshot (firstWrite);
   m_pendingOutput = false;
 
 }
@@ -283,16 +305,16 @@ NrBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
 {
   NS_LOG_FUNCTION (this);
 
-  // Get the unique IMSI / LCID list
-
+  // Get the IMSI / LCID list, sorted as the output has always been
   std::vector < ImsiLcidPair_t > pairVector;
-  for (Uint32Map::iterator it = m_ulTxPackets.begin (); it != m_ulTxPackets.end (); ++it)
+  for (const auto &bearer : m_bearers)
     {
-      if (find (pairVector.begin (), pairVector.end (), (*it).first) == pairVector.end ())
+      if (bearer.ul.txPackets > 0)
         {
-          pairVector.push_back ((*it).first);
+          pairVector.push_back (bearer.id);
         }
     }
+  std::sort (pairVector.begin (), pairVector.end ());
 
   Time endTime = m_startTime + m_epochDuration;
   for (std::vector<ImsiLcidPair_t>::iterator it = pairVector.begin (); it != pairVector.end (); ++it)
@@ -302,8 +324,9 @@ NrBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
       outFile << endTime.GetSeconds () << "\t";
       outFile << GetUlCellId (p.m_imsi, p.m_lcId) << "\t";
       outFile << p.m_imsi << "\t";
-      outFile << m_flowId[p].m_rnti << "\t";
-      outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
+      const LteFlowId_t &flowId = FindBearer (p.m_imsi, p.m_lcId)->flowId;
+      outFile << flowId.m_rnti << "\t";
+      outFile << (uint32_t) flowId.m_lcId << "\t";
       outFile << GetUlTxPackets (p.m_imsi, p.m_lcId) << "\t";
       outFile << GetUlTxData (p.m_imsi, p.m_lcId) << "\t";
       outFile << GetUlRxPackets (p.m_imsi, p.m_lcId) << "\t";
@@ -329,15 +352,16 @@ NrBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
 {
   NS_LOG_FUNCTION (this);
 
-  // Get the unique IMSI list
+  // Get the IMSI / LCID list, sorted as the output has always been
   std::vector < ImsiLcidPair_t > pairVector;
-  for (Uint32Map::iterator it = m_dlTxPackets.begin (); it != m_dlTxPackets.end (); ++it)
+  for (const auto &bearer : m_bearers)
     {
-      if (find (pairVector.begin (), pairVector.end (), (*it).first) == pairVector.end ())
+      if (bearer.dl.txPackets > 0)
         {
-          pairVector.push_back ((*it).first);
+          pairVector.push_back (bearer.id);
         }
     }
+  std::sort (pairVector.begin (), pairVector.end ());
 
   Time endTime = m_startTime + m_epochDuration;
   for (std::vector<ImsiLcidPair_t>::iterator pair = pairVector.begin (); pair != pairVector.end (); ++pair)
@@ -347,8 +371,9 @@ NrBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
       outFile << endTime.GetSeconds () << "\t";
       outFile << GetDlCellId (p.m_imsi, p.m_lcId) << "\t";
       outFile << p.m_imsi << "\t";
-      outFile << m_flowId[p].m_rnti << "\t";
-      outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
+      const LteFlowId_t &flowId = FindBearer (p.m_imsi, p.m_lcId)->flowId;
+      outFile << flowId.m_rnti << "\t";
+      outFile << (uint32_t) flowId.m_lcId << "\t";
       outFile << GetDlTxPackets (p.m_imsi, p.m_lcId) << "\t";
       outFile << GetDlTxData (p.m_imsi, p.m_lcId) << "\t";
       outFile << GetDlRxPackets (p.m_imsi, p.m_lcId) << "\t";
@@ -369,24 +394,77 @@ NrBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
   outFile.close ();
 }
 
+void
+NrBearerStatsCalculator::WriteSnapshot (bool first)
+{
+  NS_LOG_FUNCTION (this << first);
+
+  std::string filename = GetSnapshotFilename ();
+  if (filename.empty ())
+    {
+      return;
+    }
+
+  std::ofstream outFile (filename.c_str (), std::ios_base::binary |
+                         (first ? std::ios_base::trunc : std::ios_base::app));
+  if (!outFile.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename.c_str ());
+      return;
+    }
+  if (first)
+    {
+      uint32_t version = 1;
+      outFile.write ("NRBS", 4);
+      outFile.write (reinterpret_cast<const char *> (&version), sizeof (version));
+    }
+
+  int64_t start = m_startTime.GetNanoSeconds ();
+  int64_t end = (m_startTime + m_epochDuration).GetNanoSeconds ();
+  for (const auto &bearer : m_bearers)
+    {
+      for (uint8_t direction = 0; direction < 2; ++direction)
+        {
+          const DirectionStats &stats = direction == 0 ? bearer.dl : bearer.ul;
+          if (stats.txPackets == 0 && stats.rxPackets == 0)
+            {
+              continue;
+            }
+          outFile.write (reinterpret_cast<const char *> (&direction), sizeof (direction));
+          outFile.write (reinterpret_cast<const char *> (&start), sizeof (start));
+          outFile.write (reinterpret_cast<const char *> (&end), sizeof (end));
+          outFile.write (reinterpret_cast<const char *> (&stats.cellId), sizeof (stats.cellId));
+          outFile.write (reinterpret_cast<const char *> (&bearer.id.m_imsi), sizeof (bearer.id.m_imsi));
+          outFile.write (reinterpret_cast<const char *> (&bearer.flowId.m_rnti), sizeof (bearer.flowId.m_rnti));
+          outFile.write (reinterpret_cast<const char *> (&bearer.id.m_lcId), sizeof (bearer.id.m_lcId));
+          outFile.write (reinterpret_cast<const char *> (&stats.txPackets), sizeof (stats.txPackets));
+          outFile.write (reinterpret_cast<const char *> (&stats.txData), sizeof (stats.txData));
+          outFile.write (reinterpret_cast<const char *> (&stats.rxPackets), sizeof (stats.rxPackets));
+          outFile.write (reinterpret_cast<const char *> (&stats.rxData), sizeof (stats.rxData));
+          stats.pduSize.Serialize (outFile);
+          stats.delay.Serialize (outFile);
+        }
+    }
+}
+
 void
 NrBearerStatsCalculator::ResetResults (void)
 {
   NS_LOG_FUNCTION (this);
 
-  m_ulTxPackets.erase (m_ulTxPackets.begin (), m_ulTxPackets.end ());
-  m_ulRxPackets.erase (m_ulRxPackets.begin (), m_ulRxPackets.end ());
-  m_ulRxData.erase (m_ulRxData.begin (), m_ulRxData.end ());
-  m_ulTxData.erase (m_ulTxData.begin (), m_ulTxData.end ());
-  m_ulDelay.erase (m_ulDelay.begin (), m_ulDelay.end ());
-  m_ulPduSize.erase (m_ulPduSize.begin (), m_ulPduSize.end ());
-
-  m_dlTxPackets.erase (m_dlTxPackets.begin (), m_dlTxPackets.end ());
-  m_dlRxPackets.erase (m_dlRxPackets.begin (), m_dlRxPackets.end ());
-  m_dlRxData.erase (m_dlRxData.begin (), m_dlRxData.end ());
-  m_dlTxData.erase (m_dlTxData.begin (), m_dlTxData.end ());
-  m_dlDelay.erase (m_dlDelay.begin (), m_dlDelay.end ());
-  m_dlPduSize.erase (m_dlPduSize.begin (), m_dlPduSize.end ());
+  // The CellIds and the FlowIds are kept across the epochs
+  for (auto &bearer : m_bearers)
+    {
+      for (DirectionStats *stats : {&bearer.ul, &bearer.dl})
+        {
+          stats->txPackets = 0;
+          stats->rxPackets = 0;
+          stats->txData = 0;
+          stats->rxData = 0;
+          stats->delay.Reset ();
+          stats->pduSize.Reset ();
+        }
+    }
 }
 
 void
@@ -412,203 +490,187 @@ uint32_t
 NrBearerStatsCalculator::GetUlTxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulTxPackets[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->ul.txPackets : 0;
 }
 
 uint32_t
 NrBearerStatsCalculator::GetUlRxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulRxPackets[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->ul.rxPackets : 0;
 }
 
 uint64_t
 NrBearerStatsCalculator::GetUlTxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulTxData[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->ul.txData : 0;
 }
 
 uint64_t
 NrBearerStatsCalculator::GetUlRxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulRxData[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->ul.rxData : 0;
+}
+
+uint32_t
+NrBearerStatsCalculator::GetUlCellId (uint64_t imsi, uint8_t lcid)
+{
+  NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->ul.cellId : 0;
 }
 
 double
 NrBearerStatsCalculator::GetUlDelay (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  Uint64StatsMap::iterator it = m_ulDelay.find (p);
-  if (it == m_ulDelay.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->ul.delay.GetStats ().GetCount () == 0)
     {
       NS_LOG_ERROR ("UL delay for " << imsi << " - " << (uint16_t) lcid << " not found");
       return 0;
-
     }
-  return m_ulDelay[p]->getMean ();
+  return bearer->ul.delay.GetStats ().GetMean ();
 }
 
 std::vector<double>
 NrBearerStatsCalculator::GetUlDelayStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  std::vector<double> stats;
-  Uint64StatsMap::iterator it = m_ulDelay.find (p);
-  if (it == m_ulDelay.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->ul.delay.GetStats ().GetCount () == 0)
     {
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      return stats;
-
+      return std::vector<double> (4, 0.0);
     }
-  stats.push_back (m_ulDelay[p]->getMean ());
-  stats.push_back (m_ulDelay[p]->getStddev ());
-  stats.push_back (m_ulDelay[p]->getMin ());
-  stats.push_back (m_ulDelay[p]->getMax ());
-  return stats;
+  const NrRunningStats &delay = bearer->ul.delay.GetStats ();
+  return {delay.GetMean (), delay.GetStddev (),
+          static_cast<double> (delay.GetMin ()), static_cast<double> (delay.GetMax ())};
 }
 
 std::vector<double>
 NrBearerStatsCalculator::GetUlPduSizeStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  std::vector<double> stats;
-  Uint32StatsMap::iterator it = m_ulPduSize.find (p);
-  if (it == m_ulPduSize.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->ul.pduSize.GetCount () == 0)
     {
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      return stats;
+      return std::vector<double> (4, 0.0);
+    }
+  const NrRunningStats &pduSize = bearer->ul.pduSize;
+  return {pduSize.GetMean (), pduSize.GetStddev (),
+          static_cast<double> (pduSize.GetMin ()), static_cast<double> (pduSize.GetMax ())};
+}
 
+double
+NrBearerStatsCalculator::GetUlDelayQuantile (uint64_t imsi, uint8_t lcid, double q)
+{
+  NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid << q);
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr)
+    {
+      return 0;
     }
-  stats.push_back (m_ulPduSize[p]->getMean ());
-  stats.push_back (m_ulPduSize[p]->getStddev ());
-  stats.push_back (m_ulPduSize[p]->getMin ());
-  stats.push_back (m_ulPduSize[p]->getMax ());
-  return stats;
+  return bearer->ul.delay.GetQuantile (q) * 1e-9;
 }
 
 uint32_t
 NrBearerStatsCalculator::GetDlTxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlTxPackets[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->dl.txPackets : 0;
 }
 
 uint32_t
 NrBearerStatsCalculator::GetDlRxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlRxPackets[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->dl.rxPackets : 0;
 }
 
 uint64_t
 NrBearerStatsCalculator::GetDlTxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlTxData[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->dl.txData : 0;
 }
 
 uint64_t
 NrBearerStatsCalculator::GetDlRxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlRxData[p];
-}
-
-uint32_t
-NrBearerStatsCalculator::GetUlCellId (uint64_t imsi, uint8_t lcid)
-{
-  NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulCellId[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->dl.rxData : 0;
 }
 
 uint32_t
 NrBearerStatsCalculator::GetDlCellId (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlCellId[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->dl.cellId : 0;
 }
 
 double
 NrBearerStatsCalculator::GetDlDelay (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  Uint64StatsMap::iterator it = m_dlDelay.find (p);
-  if (it == m_dlDelay.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->dl.delay.GetStats ().GetCount () == 0)
     {
-      NS_LOG_ERROR ("DL delay for " << imsi << " not found");
+      NS_LOG_ERROR ("DL delay for " << imsi << " - " << (uint16_t) lcid << " not found");
       return 0;
     }
-  return m_dlDelay[p]->getMean ();
+  return bearer->dl.delay.GetStats ().GetMean ();
 }
 
 std::vector<double>
 NrBearerStatsCalculator::GetDlDelayStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  std::vector<double> stats;
-  Uint64StatsMap::iterator it = m_dlDelay.find (p);
-  if (it == m_dlDelay.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->dl.delay.GetStats ().GetCount () == 0)
     {
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      return stats;
-
+      return std::vector<double> (4, 0.0);
     }
-  stats.push_back (m_dlDelay[p]->getMean ());
-  stats.push_back (m_dlDelay[p]->getStddev ());
-  stats.push_back (m_dlDelay[p]->getMin ());
-  stats.push_back (m_dlDelay[p]->getMax ());
-  return stats;
+  const NrRunningStats &delay = bearer->dl.delay.GetStats ();
+  return {delay.GetMean (), delay.GetStddev (),
+          static_cast<double> (delay.GetMin ()), static_cast<double> (delay.GetMax ())};
 }
 
 std::vector<double>
 NrBearerStatsCalculator::GetDlPduSizeStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  std::vector<double> stats;
-  Uint32StatsMap::iterator it = m_dlPduSize.find (p);
-  if (it == m_dlPduSize.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->dl.pduSize.GetCount () == 0)
     {
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      return stats;
-
+      return std::vector<double> (4, 0.0);
     }
-  stats.push_back (m_dlPduSize[p]->getMean ());
-  stats.push_back (m_dlPduSize[p]->getStddev ());
-  stats.push_back (m_dlPduSize[p]->getMin ());
-  stats.push_back (m_dlPduSize[p]->getMax ());
-  return stats;
+  const NrRunningStats &pduSize = bearer->dl.pduSize;
+  return {pduSize.GetMean (), pduSize.GetStddev (),
+          static_cast<double> (pduSize.GetMin ()), static_cast<double> (pduSize.GetMax ())};
 }
 
+double
+NrBearerStatsCalculator::GetDlDelayQuantile (uint64_t imsi, uint8_t lcid, double q)
+{
+  NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid << q);
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr)
+    {
+      return 0;
+    }
+  return bearer->dl.delay.GetQuantile (q) * 1e-9;
+}
 
 std::string
 NrBearerStatsCalculator::GetUlOutputFilename (void)
@@ -636,4 +698,17 @@ NrBearerStatsCalculator::GetDlOutputFilename (void)
     }
 }
 
+std::string
+NrBearerStatsCalculator::GetSnapshotFilename (void)
+{
+  if (m_protocolType == "RLC")
+    {
+      return m_rlcSnapshotFilename;
+    }
+  else
+    {
+      return m_pdcpSnapshotFilename;
+    }
+}
+
 } // namespace ns3
@@ -37,7 +37,10 @@
 #include <string>
 #include <map>
 #include <fstream>
+#include <unordered_map>
+#include <vector>
 #include "nr-bearer-stats-simple.h"
+#include "nr-delay-histogram.h"
 
 namespace ns3 {
 /// Container: (IMSI, LCID) pair, uint32_t
@@ -71,6 +74,25 @@ typedef std::map<ImsiLcidPair_t, LteFlowId_t> FlowIdMap;
  *   - Average, min, max and standard deviation of PDU delay (delay is
  *     calculated from the generation of the PDU to its reception)
  *   - Average, min, max and standard deviation of PDU size
+ *
+ * The statistics are kept in a vector with an entry per bearer, found by
+ * (IMSI, LCID) through an index, and reused at every epoch: the memory
+ * does not grow with the duration of the simulation. The delays are also
+ * stored in a NrDelayHistogram per bearer and direction, from which the
+ * high quantiles (e.g., GetDlDelayQuantile (imsi, lcid, 0.99999)) are
+ * available without storing every PDU.
+ *
+ * If the attribute RlcSnapshotFilename (or PdcpSnapshotFilename, for the
+ * PDCP statistics) is not empty, at the end of every epoch the statistics
+ * of the bearers with traffic are also appended to that file in binary
+ * form (in the byte order of the host). The file starts with the magic
+ * "NRBS" and the version (uint32, 1), followed by a record per bearer and
+ * direction with: the direction (uint8, 0 for DL and 1 for UL), the start
+ * and the end of the epoch (int64, ns), the CellId (uint32), the IMSI
+ * (uint64), the RNTI (uint16), the LCID (uint8), the number of transmitted
+ * PDUs (uint32) and bytes (uint64), the number of received PDUs (uint32)
+ * and bytes (uint64), the PDU size statistics (NrRunningStats::Serialize)
+ * and the delay histogram, in ns (NrDelayHistogram::Serialize).
  */
 
 class NrBearerStatsCalculator : public NrBearerStatsBase
@@ -210,6 +232,14 @@ public:
    * @return PDU size statistics average, min, max and standard deviation in seconds
    */
   std::vector<double> GetUlPduSizeStats (uint64_t imsi, uint8_t lcid);
+  /**
+   * Gets a quantile of the uplink RLC to RLC delay
+   * @param imsi IMSI of the UE
+   * @param lcid LCID
+   * @param q quantile, in [0, 1]
+   * @return RLC to RLC delay quantile in seconds, with a relative error below 3%
+   */
+  double GetUlDelayQuantile (uint64_t imsi, uint8_t lcid, double q);
   /**
    * Gets the number of transmitted downlink data bytes.
    * @param imsi IMSI of the UE
@@ -266,6 +296,14 @@ public:
    * @return PDU size statistics average, min, max and standard deviation in seconds
    */
   std::vector<double> GetDlPduSizeStats (uint64_t imsi, uint8_t lcid);
+  /**
+   * Gets a quantile of the downlink RLC to RLC delay
+   * @param imsi IMSI of the UE
+   * @param lcid LCID
+   * @param q quantile, in [0, 1]
+   * @return RLC to RLC delay quantile in seconds, with a relative error below 3%
+   */
+  double GetDlDelayQuantile (uint64_t imsi, uint8_t lcid, double q);
   /**
    * \return UL output file name
    */
@@ -274,8 +312,54 @@ public:
    * return DL output file name
    */
   std::string GetDlOutputFilename (void);
+  /**
+   * \return binary snapshot file name, empty if the snapshots are disabled
+   */
+  std::string GetSnapshotFilename (void);
 
 private:
+  /**
+   * Statistics of a bearer in a direction
+   */
+  struct DirectionStats
+  {
+    uint32_t cellId {0};       //!< CellId (kept across the epochs)
+    uint32_t txPackets {0};    //!< Number of TX Packets
+    uint32_t rxPackets {0};    //!< Number of RX Packets
+    uint64_t txData {0};       //!< Amount of TX Data
+    uint64_t rxData {0};       //!< Amount of RX Data
+    NrDelayHistogram delay;    //!< Delay, in ns
+    NrRunningStats pduSize;    //!< PDU Size
+  };
+  /**
+   * Statistics of a bearer
+   */
+  struct BearerStats
+  {
+    ImsiLcidPair_t id;         //!< (IMSI, LCID) pair
+    LteFlowId_t flowId;        //!< FlowId, ie. (RNTI, LCID)
+    DirectionStats ul;         //!< UL statistics
+    DirectionStats dl;         //!< DL statistics
+  };
+  /**
+   * Gets the statistics of a bearer, creating them if needed
+   * @param imsi IMSI of the UE
+   * @param lcid LCID
+   * @return the statistics of the bearer
+   */
+  BearerStats & GetBearer (uint64_t imsi, uint8_t lcid);
+  /**
+   * Finds the statistics of a bearer
+   * @param imsi IMSI of the UE
+   * @param lcid LCID
+   * @return the statistics of the bearer, or nullptr if the bearer is unknown
+   */
+  const BearerStats * FindBearer (uint64_t imsi, uint8_t lcid) const;
+  /**
+   * Writes the statistics of the epoch to the binary snapshot file
+   * @param first true if the file has to be created
+   */
+  void WriteSnapshot (bool first);
   /**
    * Called after each epoch to write collected
    * statistics to output files. During first call
@@ -312,21 +396,8 @@ private:
   void EndEpoch (void);
 
   EventId m_endEpochEvent; //!< Event id for next end epoch event
-  FlowIdMap m_flowId; //!< List of FlowIds, ie. (RNTI, LCID) by (IMSI, LCID) pair
-  Uint32Map m_dlCellId; //!< List of DL CellIds by (IMSI, LCID) pair
-  Uint32Map m_dlTxPackets; //!< Number of DL TX Packets by (IMSI, LCID) pair
-  Uint32Map m_dlRxPackets; //!< Number of DL RX Packets by (IMSI, LCID) pair
-  Uint64Map m_dlTxData; //!< Amount of DL TX Data by (IMSI, LCID) pair
-  Uint64Map m_dlRxData; //!< Amount of DL RX Data by (IMSI, LCID) pair
-  Uint64StatsMap m_dlDelay; //!< DL delay by (IMSI, LCID) pair
-  Uint32StatsMap m_dlPduSize; //!< DL PDU Size by (IMSI, LCID) pair
-  Uint32Map m_ulCellId; //!< List of UL CellIds by (IMSI, LCID) pair
-  Uint32Map m_ulTxPackets; //!< Number of UL TX Packets by (IMSI, LCID) pair
-  Uint32Map m_ulRxPackets; //!< Number of UL RX Packets by (IMSI, LCID) pair
-  Uint64Map m_ulTxData; //!< Amount of UL TX Data by (IMSI, LCID) pair
-  Uint64Map m_ulRxData; //!< Amount of UL RX Data by (IMSI, LCID) pair
-  Uint64StatsMap m_ulDelay; //!< UL delay by (IMSI, LCID) pair
-  Uint32StatsMap m_ulPduSize; //!< UL PDU Size by (IMSI, LCID) pair
+  std::vector<BearerStats> m_bearers; //!< Statistics of the bearers
+  std::unordered_map<uint64_t, uint32_t> m_bearerIndex; //!< Index in m_bearers by (IMSI, LCID)
   /**
    * Start time of the on going epoch
    */
@@ -363,6 +434,14 @@ private:
    * Name of the file where the uplink PDCP statistics will be saved
    */
   std::string m_ulPdcpOutputFilename;
+  /**
+   * Name of the file where the RLC binary snapshots will be saved
+   */
+  std::string m_rlcSnapshotFilename;
+  /**
+   * Name of the file where the PDCP binary snapshots will be saved
+   */
+  std::string m_pdcpSnapshotFilename;
   std::ofstream m_dlOutFile;
   std::ofstream m_ulOutFile;
 };
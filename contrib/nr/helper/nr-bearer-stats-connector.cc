@@ -159,22 +159,24 @@ NrBearerStatsConnector::EnsureConnected ()
   NS_LOG_FUNCTION (this);
   if (!m_connected)
     {
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/NewUeContext",
-                       MakeBoundCallback (&NrBearerStatsConnector::NotifyNewUeContextEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/RandomAccessSuccessful",
-                       MakeBoundCallback (&NrBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/ConnectionReconfiguration",
-                       MakeBoundCallback (&NrBearerStatsConnector::NotifyConnectionReconfigurationEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/ConnectionReconfiguration",
-                       MakeBoundCallback (&NrBearerStatsConnector::NotifyConnectionReconfigurationUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverStart",
-                       MakeBoundCallback (&NrBearerStatsConnector::NotifyHandoverStartEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverStart",
-                       MakeBoundCallback (&NrBearerStatsConnector::NotifyHandoverStartUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverEndOk",
-                       MakeBoundCallback (&NrBearerStatsConnector::NotifyHandoverEndOkEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverEndOk",
-                       MakeBoundCallback (&NrBearerStatsConnector::NotifyHandoverEndOkUe, this));
+      Config::ConnectionList connections;
+      connections.push_back (std::make_pair ("/NodeList/*/DeviceList/*/LteEnbRrc/NewUeContext",
+                                             MakeBoundCallback (&NrBearerStatsConnector::NotifyNewUeContextEnb, this)));
+      connections.push_back (std::make_pair ("/NodeList/*/DeviceList/*/LteUeRrc/RandomAccessSuccessful",
+                                             MakeBoundCallback (&NrBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this)));
+      connections.push_back (std::make_pair ("/NodeList/*/DeviceList/*/LteEnbRrc/ConnectionReconfiguration",
+                                             MakeBoundCallback (&NrBearerStatsConnector::NotifyConnectionReconfigurationEnb, this)));
+      connections.push_back (std::make_pair ("/NodeList/*/DeviceList/*/LteUeRrc/ConnectionReconfiguration",
+                                             MakeBoundCallback (&NrBearerStatsConnector::NotifyConnectionReconfigurationUe, this)));
+      connections.push_back (std::make_pair ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverStart",
+                                             MakeBoundCallback (&NrBearerStatsConnector::NotifyHandoverStartEnb, this)));
+      connections.push_back (std::make_pair ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverStart",
+                                             MakeBoundCallback (&NrBearerStatsConnector::NotifyHandoverStartUe, this)));
+      connections.push_back (std::make_pair ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverEndOk",
+                                             MakeBoundCallback (&NrBearerStatsConnector::NotifyHandoverEndOkEnb, this)));
+      connections.push_back (std::make_pair ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverEndOk",
+                                             MakeBoundCallback (&NrBearerStatsConnector::NotifyHandoverEndOkUe, this)));
+      Config::ConnectMany (connections);
       m_connected = true;
     }
 }
@@ -258,6 +260,7 @@ NrBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi, u
   std::string ueManagerPath = it->second;
   NS_LOG_LOGIC (this << " ueManagerPath: " << ueManagerPath);
   m_ueManagerPathByCellIdRnti.erase (it);
+  Config::ConnectionList connections;
 
   if (m_rlcStats)
     {
@@ -277,20 +280,20 @@ NrBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi, u
                           MakeBoundCallback (&UlRxPduCallback, arg));
 
       // connect SRB0 both at UE and eNB
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      connections.push_back (std::make_pair (ueRrcPath + "/Srb0/LteRlc/TxPDU",
+                                             MakeBoundCallback (&UlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (ueRrcPath + "/Srb0/LteRlc/RxPDU",
+                                             MakeBoundCallback (&DlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (ueManagerPath + "/Srb0/LteRlc/TxPDU",
+                                             MakeBoundCallback (&DlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (ueManagerPath + "/Srb0/LteRlc/RxPDU",
+                                             MakeBoundCallback (&UlRxPduCallback, arg)));
 
       // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      connections.push_back (std::make_pair (ueManagerPath + "/Srb1/LteRlc/TxPDU",
+                                             MakeBoundCallback (&DlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (ueManagerPath + "/Srb1/LteRlc/RxPDU",
+                                             MakeBoundCallback (&UlRxPduCallback, arg)));
     }
   if (m_pdcpStats)
     {
@@ -300,27 +303,29 @@ NrBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi, u
       arg->stats = m_pdcpStats;
 
       // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
+      connections.push_back (std::make_pair (ueManagerPath + "/Srb1/LtePdcp/RxPDU",
+                                             MakeBoundCallback (&UlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (ueManagerPath + "/Srb1/LtePdcp/TxPDU",
+                                             MakeBoundCallback (&DlTxPduCallback, arg)));
     }
+  Config::ConnectMany (connections);
 }
 
 void
 NrBearerStatsConnector::ConnectSrb1TracesUe (std::string ueRrcPath, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+  Config::ConnectionList connections;
   if (m_rlcStats)
     {
       Ptr<NrBoundCallbackArgument> arg = Create<NrBoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
+      connections.push_back (std::make_pair (ueRrcPath + "/Srb1/LteRlc/TxPDU",
+                                             MakeBoundCallback (&UlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (ueRrcPath + "/Srb1/LteRlc/RxPDU",
+                                             MakeBoundCallback (&DlRxPduCallback, arg)));
     }
   if (m_pdcpStats)
     {
@@ -328,11 +333,12 @@ NrBearerStatsConnector::ConnectSrb1TracesUe (std::string ueRrcPath, uint64_t ims
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_pdcpStats;
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
+      connections.push_back (std::make_pair (ueRrcPath + "/Srb1/LtePdcp/RxPDU",
+                                             MakeBoundCallback (&DlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (ueRrcPath + "/Srb1/LtePdcp/TxPDU",
+                                             MakeBoundCallback (&UlTxPduCallback, arg)));
     }
+  Config::ConnectMany (connections);
 }
 
 void
@@ -363,20 +369,21 @@ NrBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi, uin
   NS_LOG_FUNCTION (this << context);
   NS_LOG_LOGIC (this << "expected context should match /NodeList/*/DeviceList/*/LteUeRrc/");
   std::string basePath = context.substr (0, context.rfind ("/"));
+  Config::ConnectionList connections;
   if (m_rlcStats)
     {
       Ptr<NrBoundCallbackArgument> arg = Create<NrBoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
+      connections.push_back (std::make_pair (basePath + "/DataRadioBearerMap/*/LteRlc/TxPDU",
+                                             MakeBoundCallback (&UlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath + "/DataRadioBearerMap/*/LteRlc/RxPDU",
+                                             MakeBoundCallback (&DlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath + "/Srb1/LteRlc/TxPDU",
+                                             MakeBoundCallback (&UlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath + "/Srb1/LteRlc/RxPDU",
+                                             MakeBoundCallback (&DlRxPduCallback, arg)));
 
     }
   if (m_pdcpStats)
@@ -385,15 +392,16 @@ NrBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi, uin
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
+      connections.push_back (std::make_pair (basePath + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
+                                             MakeBoundCallback (&DlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
+                                             MakeBoundCallback (&UlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath + "/Srb1/LtePdcp/RxPDU",
+                                             MakeBoundCallback (&DlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath + "/Srb1/LtePdcp/TxPDU",
+                                             MakeBoundCallback (&UlTxPduCallback, arg)));
     }
+  Config::ConnectMany (connections);
 }
 
 void
@@ -403,24 +411,25 @@ NrBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi, ui
   NS_LOG_LOGIC (this << "expected context  should match /NodeList/*/DeviceList/*/LteEnbRrc/");
   std::ostringstream basePath;
   basePath <<  context.substr (0, context.rfind ("/")) << "/UeMap/" << (uint32_t) rnti;
+  Config::ConnectionList connections;
   if (m_rlcStats)
     {
       Ptr<NrBoundCallbackArgument> arg = Create<NrBoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
+      connections.push_back (std::make_pair (basePath.str () + "/DataRadioBearerMap/*/LteRlc/RxPDU",
+                                             MakeBoundCallback (&UlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath.str () + "/DataRadioBearerMap/*/LteRlc/TxPDU",
+                                             MakeBoundCallback (&DlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath.str () + "/Srb0/LteRlc/RxPDU",
+                                             MakeBoundCallback (&UlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath.str () + "/Srb0/LteRlc/TxPDU",
+                                             MakeBoundCallback (&DlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath.str () + "/Srb1/LteRlc/RxPDU",
+                                             MakeBoundCallback (&UlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath.str () + "/Srb1/LteRlc/TxPDU",
+                                             MakeBoundCallback (&DlTxPduCallback, arg)));
     }
   if (m_pdcpStats)
     {
@@ -428,15 +437,16 @@ NrBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi, ui
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      connections.push_back (std::make_pair (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
+                                             MakeBoundCallback (&DlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
+                                             MakeBoundCallback (&UlRxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath.str () + "/Srb1/LtePdcp/TxPDU",
+                                             MakeBoundCallback (&DlTxPduCallback, arg)));
+      connections.push_back (std::make_pair (basePath.str () + "/Srb1/LtePdcp/RxPDU",
+                                             MakeBoundCallback (&UlRxPduCallback, arg)));
     }
+  Config::ConnectMany (connections);
 }
 
 void
@@ -0,0 +1,205 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "nr-delay-histogram.h"
+#include <ns3/assert.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+namespace {
+
+template <typename T>
+void
+WriteValue (std::ostream &os, T value)
+{
+  os.write (reinterpret_cast<const char *> (&value), sizeof (T));
+}
+
+template <typename T>
+bool
+ReadValue (std::istream &is, T *value)
+{
+  is.read (reinterpret_cast<char *> (value), sizeof (T));
+  return static_cast<bool> (is);
+}
+
+} // unnamed namespace
+
+void
+NrRunningStats::Update (uint64_t v)
+{
+  ++m_count;
+  if (m_count == 1)
+    {
+      m_min = v;
+      m_max = v;
+      m_mean = v;
+      m_s = 0.0;
+      return;
+    }
+
+  m_min = std::min (m_min, v);
+  m_max = std::max (m_max, v);
+
+  // Knuth, TAOCP vol. 2, as in MinMaxAvgTotalCalculator
+  double meanPrev = m_mean;
+  m_mean = meanPrev + (v - meanPrev) / m_count;
+  m_s = m_s + (v - meanPrev) * (v - m_mean);
+}
+
+void
+NrRunningStats::Reset ()
+{
+  *this = NrRunningStats ();
+}
+
+double
+NrRunningStats::GetStddev () const
+{
+  return m_count > 1 ? std::sqrt (m_s / (m_count - 1)) : 0.0;
+}
+
+void
+NrRunningStats::Serialize (std::ostream &os) const
+{
+  WriteValue (os, m_count);
+  WriteValue (os, m_min);
+  WriteValue (os, m_max);
+  WriteValue (os, m_mean);
+  WriteValue (os, m_s);
+}
+
+bool
+NrRunningStats::Deserialize (std::istream &is)
+{
+  return ReadValue (is, &m_count) && ReadValue (is, &m_min) && ReadValue (is, &m_max)
+         && ReadValue (is, &m_mean) && ReadValue (is, &m_s);
+}
+
+uint32_t
+NrDelayHistogram::GetBucket (uint64_t v)
+{
+  if (v < (1ULL << SUB_BITS))
+    {
+      return static_cast<uint32_t> (v);
+    }
+  uint32_t msb = 63 - __builtin_clzll (v);
+  uint32_t shift = msb - SUB_BITS;
+  return ((shift + 1) << SUB_BITS) + static_cast<uint32_t> ((v >> shift) - (1ULL << SUB_BITS));
+}
+
+uint64_t
+NrDelayHistogram::GetBucketStart (uint32_t bucket)
+{
+  NS_ASSERT (bucket < N_BUCKETS);
+  if (bucket < (1U << SUB_BITS))
+    {
+      return bucket;
+    }
+  uint32_t shift = (bucket >> SUB_BITS) - 1;
+  uint64_t mantissa = (bucket & ((1U << SUB_BITS) - 1)) + (1ULL << SUB_BITS);
+  return mantissa << shift;
+}
+
+void
+NrDelayHistogram::Update (uint64_t v)
+{
+  if (m_buckets.empty ())
+    {
+      m_buckets.resize (N_BUCKETS, 0);
+    }
+  ++m_buckets[GetBucket (v)];
+  m_stats.Update (v);
+}
+
+void
+NrDelayHistogram::Reset ()
+{
+  if (m_stats.GetCount () > 0)
+    {
+      std::fill (m_buckets.begin (), m_buckets.end (), 0);
+    }
+  m_stats.Reset ();
+}
+
+uint64_t
+NrDelayHistogram::GetQuantile (double q) const
+{
+  uint64_t count = m_stats.GetCount ();
+  if (count == 0)
+    {
+      return 0;
+    }
+  q = std::min (std::max (q, 0.0), 1.0);
+  uint64_t rank = std::max<uint64_t> (static_cast<uint64_t> (std::ceil (q * count)), 1);
+
+  uint64_t cumulative = 0;
+  for (uint32_t bucket = 0; bucket < m_buckets.size (); ++bucket)
+    {
+      cumulative += m_buckets[bucket];
+      if (cumulative >= rank)
+        {
+          uint64_t start = GetBucketStart (bucket);
+          uint64_t width = bucket < (1U << SUB_BITS) ? 1 : 1ULL << ((bucket >> SUB_BITS) - 1);
+          uint64_t center = start + width / 2;
+          return std::min (std::max (center, m_stats.GetMin ()), m_stats.GetMax ());
+        }
+    }
+  return m_stats.GetMax ();
+}
+
+void
+NrDelayHistogram::Serialize (std::ostream &os) const
+{
+  m_stats.Serialize (os);
+  uint32_t nonEmpty = static_cast<uint32_t> (m_buckets.size ()
+                                             - std::count (m_buckets.begin (), m_buckets.end (), 0));
+  WriteValue (os, nonEmpty);
+  for (uint32_t bucket = 0; bucket < m_buckets.size (); ++bucket)
+    {
+      if (m_buckets[bucket] > 0)
+        {
+          WriteValue (os, bucket);
+          WriteValue (os, m_buckets[bucket]);
+        }
+    }
+}
+
+bool
+NrDelayHistogram::Deserialize (std::istream &is)
+{
+  uint32_t nonEmpty;
+  if (!m_stats.Deserialize (is) || !ReadValue (is, &nonEmpty))
+    {
+      return false;
+    }
+  m_buckets.assign (N_BUCKETS, 0);
+  for (uint32_t i = 0; i < nonEmpty; ++i)
+    {
+      uint32_t bucket;
+      uint64_t count;
+      if (!ReadValue (is, &bucket) || !ReadValue (is, &count) || bucket >= N_BUCKETS)
+        {
+          return false;
+        }
+      m_buckets[bucket] = count;
+    }
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,191 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef NR_DELAY_HISTOGRAM_H_
+#define NR_DELAY_HISTOGRAM_H_
+
+#include <stdint.h>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup utils
+ *
+ * \brief Running count, minimum, maximum, mean and standard deviation of
+ * a series of values, without storing the values.
+ *
+ * The mean and the variance are updated as in MinMaxAvgTotalCalculator,
+ * so the two give the same results; this class is a plain value, and it
+ * can be reset and reused without allocations.
+ */
+class NrRunningStats
+{
+public:
+  /**
+   * \brief Add a value
+   * \param v the value
+   */
+  void Update (uint64_t v);
+  /**
+   * \brief Forget all the values
+   */
+  void Reset ();
+
+  /**
+   * \return the number of values
+   */
+  uint64_t GetCount () const
+  {
+    return m_count;
+  }
+  /**
+   * \return the minimum value, or 0 without values
+   */
+  uint64_t GetMin () const
+  {
+    return m_min;
+  }
+  /**
+   * \return the maximum value, or 0 without values
+   */
+  uint64_t GetMax () const
+  {
+    return m_max;
+  }
+  /**
+   * \return the mean of the values
+   */
+  double GetMean () const
+  {
+    return m_mean;
+  }
+  /**
+   * \return the (sample) standard deviation of the values
+   */
+  double GetStddev () const;
+
+  /**
+   * \brief Write the statistics in binary form
+   *
+   * The format (in the byte order of the host) is the number of values,
+   * the minimum and the maximum (uint64), the mean and the sum of the
+   * squared differences from the mean (double).
+   *
+   * \param os the output stream
+   */
+  void Serialize (std::ostream &os) const;
+  /**
+   * \brief Read the statistics written by Serialize
+   * \param is the input stream
+   * \return true if the statistics were read successfully
+   */
+  bool Deserialize (std::istream &is);
+
+private:
+  uint64_t m_count {0};   //!< Number of values
+  uint64_t m_min {0};     //!< Minimum value
+  uint64_t m_max {0};     //!< Maximum value
+  double m_mean {0.0};    //!< Mean of the values
+  double m_s {0.0};       //!< Sum of the squared differences from the mean
+};
+
+/**
+ * \ingroup utils
+ *
+ * \brief Histogram of delays with logarithmic buckets and a fixed memory.
+ *
+ * The values below 2^SUB_BITS have a bucket each; every following power
+ * of 2 is split in 2^SUB_BITS buckets of the same width. The relative
+ * error of a quantile is then below 2^-SUB_BITS (about 3%) for any value,
+ * from nanoseconds to hours, with a fixed number of buckets: the
+ * high quantiles (p99.999) of very long simulations can be computed
+ * without storing every sample.
+ *
+ * The buckets are allocated at the first value, and Reset keeps them.
+ */
+class NrDelayHistogram
+{
+public:
+  static const uint32_t SUB_BITS = 5;  //!< log2 of the buckets in a power of 2
+  static const uint32_t N_BUCKETS = (64 - SUB_BITS + 1) << SUB_BITS; //!< Number of buckets
+
+  /**
+   * \brief Add a value
+   * \param v the value (e.g., a delay in ns)
+   */
+  void Update (uint64_t v);
+  /**
+   * \brief Forget all the values, keeping the memory of the buckets
+   */
+  void Reset ();
+
+  /**
+   * \return the running statistics of the values
+   */
+  const NrRunningStats & GetStats () const
+  {
+    return m_stats;
+  }
+  /**
+   * \brief Get a quantile of the values
+   * \param q the quantile, in [0, 1] (e.g., 0.99999)
+   * \return the center of the bucket of the quantile, limited to the minimum
+   * and the maximum value, or 0 without values
+   */
+  uint64_t GetQuantile (double q) const;
+
+  /**
+   * \brief Get the bucket of a value
+   * \param v the value
+   * \return the index of the bucket
+   */
+  static uint32_t GetBucket (uint64_t v);
+  /**
+   * \brief Get the smallest value of a bucket
+   * \param bucket the index of the bucket
+   * \return the smallest value that goes in the bucket
+   */
+  static uint64_t GetBucketStart (uint32_t bucket);
+
+  /**
+   * \brief Write the histogram in binary form
+   *
+   * The format (in the byte order of the host) is the one of
+   * NrRunningStats::Serialize, followed by the number of non-empty buckets
+   * (uint32) and, for each of them, its index (uint32) and its count
+   * (uint64).
+   *
+   * \param os the output stream
+   */
+  void Serialize (std::ostream &os) const;
+  /**
+   * \brief Read a histogram written by Serialize
+   * \param is the input stream
+   * \return true if the histogram was read successfully
+   */
+  bool Deserialize (std::istream &is);
+
+private:
+  NrRunningStats m_stats;          //!< Running statistics of the values
+  std::vector<uint64_t> m_buckets; //!< Count of the values in each bucket
+};
+
+} // namespace ns3
+
+#endif /* NR_DELAY_HISTOGRAM_H_ */
@@ -0,0 +1,222 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "nr-fork-sweep-helper.h"
+
+#include <ns3/abort.h>
+#include <ns3/config.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/system-path.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrForkSweepHelper");
+
+NrForkSweepHelper::NrForkSweepHelper ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+NrForkSweepHelper::SetCheckpointTime (const Time &checkpoint)
+{
+  NS_LOG_FUNCTION (this << checkpoint);
+  m_checkpoint = checkpoint;
+}
+
+void
+NrForkSweepHelper::SetStopTime (const Time &stop)
+{
+  NS_LOG_FUNCTION (this << stop);
+  m_stop = stop;
+}
+
+void
+NrForkSweepHelper::SetOutputDirectory (const std::string &dir)
+{
+  NS_LOG_FUNCTION (this << dir);
+  m_outputDir = dir;
+}
+
+void
+NrForkSweepHelper::SetMaxParallel (uint32_t maxParallel)
+{
+  NS_LOG_FUNCTION (this << maxParallel);
+  m_maxParallel = maxParallel;
+}
+
+void
+NrForkSweepHelper::AddVariant (const std::string &name,
+                               const std::vector<AttributeSetting> &attributes)
+{
+  NS_LOG_FUNCTION (this << name);
+  NS_ABORT_MSG_IF (name.empty (), "A variant needs a name for its output directory");
+  for (const auto & v : m_variants)
+    {
+      NS_ABORT_MSG_IF (v.m_name == name, "Variant " << name << " added twice");
+    }
+  m_variants.push_back ({name, attributes});
+}
+
+uint32_t
+NrForkSweepHelper::GetNVariants () const
+{
+  return static_cast<uint32_t> (m_variants.size ());
+}
+
+uint32_t
+NrForkSweepHelper::GetNFailedVariants () const
+{
+  return m_failed;
+}
+
+std::string
+NrForkSweepHelper::GetVariantOutputDirectory (uint32_t variant) const
+{
+  const std::string & name = m_variants.at (variant).m_name;
+  return m_outputDir.empty () ? name : SystemPath::Append (m_outputDir, name);
+}
+
+void
+NrForkSweepHelper::SetupChild (uint32_t variant) const
+{
+  NS_LOG_FUNCTION (this << variant);
+  const Variant & v = m_variants.at (variant);
+
+  std::string dir = GetVariantOutputDirectory (variant);
+  NS_ABORT_MSG_IF (chdir (dir.c_str ()) != 0, "Cannot enter the directory " << dir);
+
+  // The output of the variant goes in its directory
+  int out = open ("stdout.txt", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  int err = open ("stderr.txt", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  NS_ABORT_MSG_IF (out < 0 || err < 0, "Cannot create the output files in " << dir);
+  dup2 (out, STDOUT_FILENO);
+  dup2 (err, STDERR_FILENO);
+  close (out);
+  close (err);
+
+  for (const auto & attribute : v.m_attributes)
+    {
+      NS_LOG_INFO ("Variant " << v.m_name << ": " << attribute.first << " = " << attribute.second);
+      Config::Set (attribute.first, StringValue (attribute.second));
+    }
+
+  Simulator::Stop (m_stop - Simulator::Now ());
+}
+
+int32_t
+NrForkSweepHelper::ForkVariants ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_variants.empty (), "No variants to run");
+  NS_ABORT_MSG_IF (m_stop <= m_checkpoint, "The stop time must be after the checkpoint");
+  NS_ABORT_MSG_IF (Simulator::Now () > m_checkpoint, "The checkpoint is in the past");
+
+  for (uint32_t i = 0; i < m_variants.size (); ++i)
+    {
+      SystemPath::MakeDirectories (GetVariantOutputDirectory (i));
+    }
+
+  if (Simulator::Now () < m_checkpoint)
+    {
+      Simulator::Stop (m_checkpoint - Simulator::Now ());
+      Simulator::Run ();
+    }
+  NS_LOG_INFO ("Checkpoint reached at " << Simulator::Now ().As (Time::MS) <<
+               ", forking " << m_variants.size () << " variants");
+
+  uint32_t maxParallel = m_maxParallel;
+  if (maxParallel == 0)
+    {
+      maxParallel = std::max (std::thread::hardware_concurrency (), 1U);
+    }
+
+  // Otherwise, the buffered output would be written again by every child
+  std::cout.flush ();
+  std::cerr.flush ();
+  std::fflush (nullptr);
+
+  m_failed = 0;
+  // Block until any child ends. The status of a child not forked here
+  // (the program may have other children) is not counted
+  std::vector<pid_t> running;
+  auto waitOne = [this, &running] ()
+    {
+      while (true)
+        {
+          int status = 0;
+          pid_t pid = waitpid (-1, &status, 0);
+          if (pid < 0 && errno == EINTR)
+            {
+              continue;
+            }
+          NS_ABORT_MSG_IF (pid < 0, "waitpid() failed with " << running.size () << " variants running");
+          auto it = std::find (running.begin (), running.end (), pid);
+          if (it == running.end ())
+            {
+              NS_LOG_INFO ("Process " << pid << " is not a variant, ignored");
+              continue;
+            }
+          if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+            {
+              NS_LOG_WARN ("Child " << pid << " failed with status " << status);
+              ++m_failed;
+            }
+          running.erase (it);
+          return;
+        }
+    };
+
+  for (uint32_t i = 0; i < m_variants.size (); ++i)
+    {
+      if (running.size () == maxParallel)
+        {
+          waitOne ();
+        }
+
+      pid_t pid = fork ();
+      NS_ABORT_MSG_IF (pid < 0, "fork() failed for variant " << m_variants.at (i).m_name);
+      if (pid == 0)
+        {
+          SetupChild (i);
+          return static_cast<int32_t> (i);
+        }
+      NS_LOG_INFO ("Variant " << m_variants.at (i).m_name << " running in process " << pid);
+      running.push_back (pid);
+    }
+
+  while (!running.empty ())
+    {
+      waitOne ();
+    }
+  return PARENT;
+}
+
+} // namespace ns3
@@ -0,0 +1,183 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef NR_FORK_SWEEP_HELPER_H
+#define NR_FORK_SWEEP_HELPER_H
+
+#include <ns3/nstime.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup helper
+ * \brief Run the variants of a parameter sweep from a shared checkpoint
+ *
+ * Many sweeps change only attributes that can be modified after the
+ * set-up (e.g., the scheduler attributes), but pay for every point the
+ * creation of the topology, the attach of the UEs and the initial
+ * configuration phase. This helper runs the scenario once up to a
+ * checkpoint time, then fork()s one child process per variant. The child
+ * applies the attributes of its variant with Config::Set, moves to its own
+ * output directory, and continues the simulation up to the stop time;
+ * the parent waits for the children, running at most SetMaxParallel() of them
+ * at the same time.
+ *
+ * The helper should be used in the following way:
+ *
+ * \code
+ * // ... create the scenario, install the devices and the applications ...
+ * NrForkSweepHelper sweep;
+ * sweep.SetCheckpointTime (MilliSeconds (100));
+ * sweep.SetStopTime (Seconds (1));
+ * sweep.SetOutputDirectory ("RESULTS");
+ * std::string path = "/NodeList/ * /DeviceList/ * /$ns3::NrGnbNetDevice/BandwidthPartMap/ * "
+ *                    "/FfMacScheduler/$ns3::NrMacSchedulerOfdma/schOFDMA";
+ * sweep.AddVariant ("ofdma", {{path, "1"}});
+ * sweep.AddVariant ("sym-ofdma", {{path, "2"}});
+ *
+ * int32_t variant = sweep.ForkVariants ();
+ * if (variant == NrForkSweepHelper::PARENT)
+ *   {
+ *     Simulator::Destroy ();
+ *     return sweep.GetNFailedVariants () == 0 ? 0 : 1;
+ *   }
+ * Simulator::Run (); // the child continues up to the stop time
+ * // ... print or save the results of the variant ...
+ * Simulator::Destroy ();
+ * \endcode
+ *
+ * (the spaces around the wildcards of the path are only needed in this
+ * comment).
+ *
+ * The standard output and error of a child are redirected to files in its
+ * output directory, and the files opened with a relative path after the
+ * checkpoint are created there. The files that were already open at the
+ * checkpoint (e.g., the traces enabled before Simulator::Run) are shared
+ * by all the children, so they should be opened after ForkVariants().
+ *
+ * The fork duplicates only the calling thread: the simulator
+ * implementation must not have threads running at the checkpoint (the
+ * realtime implementation, for instance, cannot be used).
+ */
+class NrForkSweepHelper
+{
+public:
+  /**
+   * \brief An attribute to set in a variant: the Config path and its value,
+   * in the string format accepted by StringValue
+   */
+  typedef std::pair<std::string, std::string> AttributeSetting;
+
+  /** Value returned by ForkVariants() in the parent process */
+  static const int32_t PARENT = -1;
+
+  /**
+   * \brief NrForkSweepHelper constructor
+   */
+  NrForkSweepHelper ();
+
+  /**
+   * \brief Set the time at which the children are forked
+   * \param checkpoint the checkpoint time
+   */
+  void SetCheckpointTime (const Time &checkpoint);
+
+  /**
+   * \brief Set the time at which the children stop the simulation
+   * \param stop the stop time, after the checkpoint
+   */
+  void SetStopTime (const Time &stop);
+
+  /**
+   * \brief Set the directory that contains the output directories of the
+   * variants (one for each variant, with its name)
+   * \param dir the directory, created if it does not exist
+   */
+  void SetOutputDirectory (const std::string &dir);
+
+  /**
+   * \brief Set the maximum number of children that run at the same time
+   * \param maxParallel number of children; 0 means the number of cores
+   */
+  void SetMaxParallel (uint32_t maxParallel);
+
+  /**
+   * \brief Add a variant of the sweep
+   * \param name the name of the variant, used as its output directory
+   * \param attributes the attributes to set after the checkpoint
+   */
+  void AddVariant (const std::string &name, const std::vector<AttributeSetting> &attributes);
+
+  /**
+   * \return the number of variants
+   */
+  uint32_t GetNVariants () const;
+
+  /**
+   * \brief Run the simulation up to the checkpoint, and fork the variants
+   *
+   * In the parent, the function returns when all the children have ended.
+   * The parent waits for any child of the process: another child that ends
+   * meanwhile is reaped, and not counted as a variant.
+   * In a child, it returns after the attributes of the variant have been
+   * set and the simulation stop has been scheduled at the stop time; the
+   * caller has then to call Simulator::Run() to continue the simulation.
+   *
+   * \return the index of the variant in a child, PARENT in the parent
+   */
+  int32_t ForkVariants ();
+
+  /**
+   * \return the number of children that did not exit with status 0,
+   * after ForkVariants() returned in the parent
+   */
+  uint32_t GetNFailedVariants () const;
+
+  /**
+   * \param variant the index of the variant
+   * \return the output directory of the variant
+   */
+  std::string GetVariantOutputDirectory (uint32_t variant) const;
+
+private:
+  /**
+   * \brief Set up the child process of a variant
+   * \param variant the index of the variant
+   */
+  void SetupChild (uint32_t variant) const;
+
+  /** A variant of the sweep */
+  struct Variant
+  {
+    std::string m_name;                          //!< Name of the variant
+    std::vector<AttributeSetting> m_attributes;  //!< Attributes of the variant
+  };
+
+  Time m_checkpoint;              //!< Time at which the children are forked
+  Time m_stop;                    //!< Time at which the children stop
+  std::string m_outputDir;        //!< Directory of the output directories
+  uint32_t m_maxParallel {0};     //!< Maximum number of running children
+  std::vector<Variant> m_variants; //!< The variants
+  uint32_t m_failed {0};          //!< Children that failed
+};
+
+} // namespace ns3
+
+#endif // NR_FORK_SWEEP_HELPER_H
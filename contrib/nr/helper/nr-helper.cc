@@ -54,8 +54,18 @@
 #include <ns3/three-gpp-v2v-propagation-loss-model.h>
 #include <ns3/three-gpp-v2v-channel-condition-model.h>
 #include <ns3/uniform-planar-array.h>
+#include <ns3/node-list.h>
+#include <ns3/simulator.h>
+#include <ns3/core-config.h>
+#if HAVE_PTHREAD_H
+#include <ns3/multithreaded-simulator-impl.h>
+#endif /* HAVE_PTHREAD_H */
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
 
 namespace ns3 {
 
@@ -119,6 +129,15 @@ NrHelper::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&NrHelper::m_harqEnabled),
                    MakeBooleanChecker ())
+    .AddAttribute ("ShareChannelParams",
+                   "If true, the BWPs of a band with the same scenario share the "
+                   "channel condition model and the 3GPP channel parameters of each "
+                   "pair of nodes, that are then generated once for all the "
+                   "carriers. Each BWP still generates its channel matrices, "
+                   "with its own frequency and antennas.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NrHelper::m_shareChannelParams),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
@@ -287,6 +306,11 @@ NrHelper::InitializeOperationBand (OperationBandInfo *band, uint8_t flags)
     {BandwidthPartInfo::V2V_Urban, std::bind (&InitV2VUrban, std::placeholders::_1, std::placeholders::_2)},
   };
 
+  // With ShareChannelParams, the channel condition model and the channel
+  // model of the first BWP of each scenario, that the following BWPs share
+  std::unordered_map<BandwidthPartInfo::Scenario, Ptr<ChannelConditionModel>, std::hash<int>> sharedConditionModels;
+  std::unordered_map<BandwidthPartInfo::Scenario, Ptr<ThreeGppChannelModel>, std::hash<int>> sharedChannelModels;
+
   // Iterate over all CCs, and instantiate the channel and propagation model
   for (const auto & cc : band->m_cc)
     {
@@ -296,7 +320,16 @@ NrHelper::InitializeOperationBand (OperationBandInfo *band, uint8_t flags)
           // static function defined above and stored inside the lookup table
           initLookupTable.at (bwp->m_scenario) (&m_pathlossModelFactory, &m_channelConditionModelFactory);
 
-          auto channelConditionModel  = m_channelConditionModelFactory.Create<ChannelConditionModel>();
+          Ptr<ChannelConditionModel> channelConditionModel;
+          if (m_shareChannelParams && sharedConditionModels.count (bwp->m_scenario) > 0)
+            {
+              channelConditionModel = sharedConditionModels.at (bwp->m_scenario);
+            }
+          else
+            {
+              channelConditionModel = m_channelConditionModelFactory.Create<ChannelConditionModel>();
+              sharedConditionModels[bwp->m_scenario] = channelConditionModel;
+            }
 
           if (bwp->m_propagation == nullptr && flags & INIT_PROPAGATION)
             {
@@ -312,6 +345,19 @@ NrHelper::InitializeOperationBand (OperationBandInfo *band, uint8_t flags)
               DynamicCast<ThreeGppSpectrumPropagationLossModel> (bwp->m_3gppChannel)->SetChannelModelAttribute ("Frequency", DoubleValue (bwp->m_centralFrequency));
               DynamicCast<ThreeGppSpectrumPropagationLossModel> (bwp->m_3gppChannel)->SetChannelModelAttribute ("Scenario", StringValue (bwp->GetScenario ()));
               DynamicCast<ThreeGppSpectrumPropagationLossModel> (bwp->m_3gppChannel)->SetChannelModelAttribute ("ChannelConditionModel", PointerValue (channelConditionModel));
+
+              auto channelModel = DynamicCast<ThreeGppChannelModel> (DynamicCast<ThreeGppSpectrumPropagationLossModel> (bwp->m_3gppChannel)->GetChannelModel ());
+              if (m_shareChannelParams && channelModel != nullptr)
+                {
+                  if (sharedChannelModels.count (bwp->m_scenario) > 0)
+                    {
+                      channelModel->ShareChannelParams (sharedChannelModels.at (bwp->m_scenario));
+                    }
+                  else
+                    {
+                      sharedChannelModels[bwp->m_scenario] = channelModel;
+                    }
+                }
             }
 
           if (bwp->m_channel == nullptr && flags & INIT_CHANNEL)
@@ -958,6 +1004,10 @@ NrHelper::InstallSingleGnbDevice (const Ptr<Node> &n,
 
   dev->SetAttribute ("LteEnbComponentCarrierManager", PointerValue (ccmEnbManager));
   dev->SetCcMap (ccMap);
+  for (const auto &it : ccMap)
+    {
+      NrGnbNetDevice::RegisterBwpId (it.second->GetCellId (), dev);
+    }
   dev->SetAttribute ("LteEnbRrc", PointerValue (rrc));
   dev->Initialize ();
 
@@ -987,10 +1037,96 @@ void
 NrHelper::AttachToClosestEnb (NetDeviceContainer ueDevices, NetDeviceContainer enbDevices)
 {
   NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (enbDevices.GetN () > 0, "empty enb device container");
+
+  // Index the gNBs in a uniform grid over the (x, y) plane, with about one
+  // gNB per cell, so that each UE looks only at the cells around it instead
+  // of at all the gNBs.
+  std::vector<Vector> enbPos;
+  enbPos.reserve (enbDevices.GetN ());
+  for (NetDeviceContainer::Iterator i = enbDevices.Begin (); i != enbDevices.End (); ++i)
+    {
+      enbPos.push_back ((*i)->GetNode ()->GetObject<MobilityModel> ()->GetPosition ());
+    }
+
+  double minX = enbPos.front ().x;
+  double maxX = minX;
+  double minY = enbPos.front ().y;
+  double maxY = minY;
+  for (const auto & pos : enbPos)
+    {
+      minX = std::min (minX, pos.x);
+      maxX = std::max (maxX, pos.x);
+      minY = std::min (minY, pos.y);
+      maxY = std::max (maxY, pos.y);
+    }
+
+  const double n = static_cast<double> (enbPos.size ());
+  const double width = maxX - minX;
+  const double height = maxY - minY;
+  double cellSize = std::max (std::sqrt (width * height / n), std::max (width, height) / n);
+  if (cellSize <= 0.0)
+    {
+      cellSize = 1.0;
+    }
+  const int64_t nX = static_cast<int64_t> (width / cellSize) + 1;
+  const int64_t nY = static_cast<int64_t> (height / cellSize) + 1;
+
+  auto cellOf = [cellSize] (double v, double min, int64_t size)
+    {
+      int64_t c = static_cast<int64_t> (std::floor ((v - min) / cellSize));
+      return std::min (std::max (c, static_cast<int64_t> (0)), size - 1);
+    };
+
+  std::vector<std::vector<uint32_t> > grid (nX * nY);
+  for (uint32_t i = 0; i < enbPos.size (); ++i)
+    {
+      grid[cellOf (enbPos[i].y, minY, nY) * nX + cellOf (enbPos[i].x, minX, nX)].push_back (i);
+    }
 
   for (NetDeviceContainer::Iterator i = ueDevices.Begin (); i != ueDevices.End (); i++)
     {
-      AttachToClosestEnb (*i, enbDevices);
+      Vector uepos = (*i)->GetNode ()->GetObject<MobilityModel> ()->GetPosition ();
+      const int64_t cx = cellOf (uepos.x, minX, nX);
+      const int64_t cy = cellOf (uepos.y, minY, nY);
+
+      double minDistance = std::numeric_limits<double>::infinity ();
+      uint32_t closest = 0;
+      const int64_t maxRing = std::max (nX, nY);
+      for (int64_t ring = 0; ring <= maxRing; ++ring)
+        {
+          // The gNBs in the rings after this one are at least (ring - 1) cells
+          // away, also for UEs outside the grid. Equal distances go to the
+          // first gNB of the container, as with a linear search.
+          if (ring > 1 && minDistance < (ring - 1) * cellSize)
+            {
+              break;
+            }
+          for (int64_t y = std::max (cy - ring, static_cast<int64_t> (0));
+               y <= std::min (cy + ring, nY - 1); ++y)
+            {
+              const bool border = (y == cy - ring || y == cy + ring);
+              const int64_t step = border ? 1 : 2 * ring;
+              for (int64_t x = cx - ring; x <= cx + ring; x += std::max (step, static_cast<int64_t> (1)))
+                {
+                  if (x < 0 || x >= nX)
+                    {
+                      continue;
+                    }
+                  for (uint32_t idx : grid[y * nX + x])
+                    {
+                      double distance = CalculateDistance (uepos, enbPos[idx]);
+                      if (distance < minDistance || (distance == minDistance && idx < closest))
+                        {
+                          minDistance = distance;
+                          closest = idx;
+                        }
+                    }
+                }
+            }
+        }
+
+      AttachToEnb (*i, enbDevices.Get (closest));
     }
 }
 
@@ -1062,6 +1198,127 @@ NrHelper::AttachToEnb (const Ptr<NetDevice> &ueDevice,
     }
 }
 
+Time
+NrHelper::AssignSimulatorPartitions (const NetDeviceContainer &gnbDevices,
+                                     const NetDeviceContainer &ueDevices) const
+{
+  NS_LOG_FUNCTION (this);
+
+#if HAVE_PTHREAD_H
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_ABORT_MSG_IF (impl == nullptr, "The simulator implementation is not ns3::MultithreadedSimulatorImpl");
+  NS_ABORT_MSG_IF (gnbDevices.GetN () == 0, "No gNB devices to partition");
+
+  // Group the nodes that share a spectrum channel (union-find on the node ids)
+  std::vector<uint32_t> group (NodeList::GetNNodes ());
+  std::iota (group.begin (), group.end (), 0);
+  auto findGroup = [&group] (uint32_t node)
+    {
+      while (group.at (node) != node)
+        {
+          group.at (node) = group.at (group.at (node));
+          node = group.at (node);
+        }
+      return node;
+    };
+
+  std::map<Ptr<SpectrumChannel>, uint32_t> nodeOfChannel;
+  auto addChannel = [&] (uint32_t node, const Ptr<SpectrumChannel> &channel)
+    {
+      auto it = nodeOfChannel.find (channel);
+      if (it == nodeOfChannel.end ())
+        {
+          nodeOfChannel.emplace (channel, node);
+        }
+      else
+        {
+          group.at (findGroup (node)) = findGroup (it->second);
+        }
+    };
+
+  Time lookahead = Time::Max ();
+  for (auto it = gnbDevices.Begin (); it != gnbDevices.End (); ++it)
+    {
+      Ptr<NrGnbNetDevice> gnb = (*it)->GetObject<NrGnbNetDevice> ();
+      NS_ABORT_IF (gnb == nullptr);
+      for (uint32_t i = 0; i < gnb->GetCcMapSize (); ++i)
+        {
+          addChannel (gnb->GetNode ()->GetId (), gnb->GetPhy (i)->GetSpectrumPhy ()->GetSpectrumChannel ());
+          lookahead = std::min (lookahead, gnb->GetPhy (i)->GetSlotPeriod ());
+        }
+    }
+  for (auto it = ueDevices.Begin (); it != ueDevices.End (); ++it)
+    {
+      Ptr<NrUeNetDevice> ue = (*it)->GetObject<NrUeNetDevice> ();
+      NS_ABORT_IF (ue == nullptr);
+      for (uint32_t i = 0; i < ue->GetCcMapSize (); ++i)
+        {
+          addChannel (ue->GetNode ()->GetId (), ue->GetPhy (i)->GetSpectrumPhy ()->GetSpectrumChannel ());
+        }
+    }
+
+  // One partition for each group, in the order of the devices; the other
+  // nodes stay in the partition 0
+  std::map<uint32_t, uint32_t> partitionOfGroup;
+  auto assign = [&] (const NetDeviceContainer &devices)
+    {
+      for (auto it = devices.Begin (); it != devices.End (); ++it)
+        {
+          uint32_t node = (*it)->GetNode ()->GetId ();
+          uint32_t root = findGroup (node);
+          if (partitionOfGroup.find (root) == partitionOfGroup.end ())
+            {
+              uint32_t partition = static_cast<uint32_t> (partitionOfGroup.size ()) + 1;
+              partitionOfGroup.emplace (root, partition);
+            }
+          impl->SetPartition (node, partitionOfGroup.at (root));
+        }
+    };
+  assign (gnbDevices);
+  assign (ueDevices);
+
+  // The events between partitions travel on the wired channels
+  for (auto n = NodeList::Begin (); n != NodeList::End (); ++n)
+    {
+      for (uint32_t d = 0; d < (*n)->GetNDevices (); ++d)
+        {
+          Ptr<Channel> channel = (*n)->GetDevice (d)->GetChannel ();
+          if (channel == nullptr || DynamicCast<SpectrumChannel> (channel) != nullptr)
+            {
+              continue;
+            }
+          bool crossPartitions = false;
+          for (std::size_t j = 0; j < channel->GetNDevices (); ++j)
+            {
+              uint32_t other = channel->GetDevice (j)->GetNode ()->GetId ();
+              crossPartitions |= impl->GetPartition (other) != impl->GetPartition ((*n)->GetId ());
+            }
+          if (!crossPartitions)
+            {
+              continue;
+            }
+          TimeValue delay;
+          NS_ABORT_MSG_IF (!channel->GetAttributeFailSafe ("Delay", delay),
+                           "Channel " << channel->GetInstanceTypeId ().GetName () <<
+                           " connects different partitions, but it has no Delay attribute");
+          lookahead = std::min (lookahead, delay.Get ());
+        }
+    }
+
+  // A zero lookahead would run all the partitions in a single thread
+  NS_ABORT_MSG_IF (lookahead.IsZero (),
+                   "A channel with zero delay connects different partitions: set a "
+                   "positive delay on the links between the gNBs and the EPC "
+                   "(e.g., PointToPointEpcHelper::S1uLinkDelay)");
+  NS_LOG_INFO ("Assigned " << partitionOfGroup.size () << " cell partitions, lookahead " <<
+               lookahead.As (Time::US));
+  impl->SetAttribute ("Lookahead", TimeValue (lookahead));
+  return lookahead;
+#else /* HAVE_PTHREAD_H */
+  NS_FATAL_ERROR ("ns3::MultithreadedSimulatorImpl is not available without threads");
+  return Time (0);
+#endif /* HAVE_PTHREAD_H */
+}
 
 
 uint8_t
@@ -1500,6 +1757,8 @@ NrHelper::ActivateDataRadioBearer (Ptr<NetDevice> ueDevice, EpsBearer bearer)
 void
 NrHelper::EnableTraces (void)
 {
+  Config::ConnectionList connections;
+  m_traceConnections = &connections;
   EnableDlDataPhyTraces ();
   EnableDlCtrlPhyTraces ();
   EnableUlPhyTraces ();
@@ -1517,6 +1776,21 @@ NrHelper::EnableTraces (void)
   EnableDlMacSchedTraces ();
   EnableUlMacSchedTraces ();
   EnablePathlossTraces ();
+  m_traceConnections = nullptr;
+  Config::ConnectMany (connections);
+}
+
+void
+NrHelper::ConnectTrace (const std::string &path, const CallbackBase &cb)
+{
+  if (m_traceConnections != nullptr)
+    {
+      m_traceConnections->push_back (std::make_pair (path, cb));
+    }
+  else
+    {
+      Config::Connect (path, cb);
+    }
 }
 
 Ptr<NrPhyRxTrace>
@@ -1529,11 +1803,11 @@ void
 NrHelper::EnableDlDataPhyTraces (void)
 {
   //NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/DlDataSinr",
-                   MakeBoundCallback (&NrPhyRxTrace::DlDataSinrCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/DlDataSinr",
+                MakeBoundCallback (&NrPhyRxTrace::DlDataSinrCallback, m_phyStats));
 
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/NrSpectrumPhyList/*/RxPacketTraceUe",
-                   MakeBoundCallback (&NrPhyRxTrace::RxPacketTraceUeCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/NrSpectrumPhyList/*/RxPacketTraceUe",
+                MakeBoundCallback (&NrPhyRxTrace::RxPacketTraceUeCallback, m_phyStats));
 }
 
 
@@ -1541,65 +1815,65 @@ void
 NrHelper::EnableDlCtrlPhyTraces (void)
 {
   //NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/DlCtrlSinr",
-                   MakeBoundCallback (&NrPhyRxTrace::DlCtrlSinrCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/DlCtrlSinr",
+                MakeBoundCallback (&NrPhyRxTrace::DlCtrlSinrCallback, m_phyStats));
 }
 
 void
 NrHelper::EnableGnbPhyCtrlMsgsTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbPhy/GnbPhyRxedCtrlMsgsTrace",
-                   MakeBoundCallback (&NrPhyRxTrace::RxedGnbPhyCtrlMsgsCallback, m_phyStats));
-  Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbPhy/GnbPhyTxedCtrlMsgsTrace",
-                   MakeBoundCallback (&NrPhyRxTrace::TxedGnbPhyCtrlMsgsCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbPhy/GnbPhyRxedCtrlMsgsTrace",
+                MakeBoundCallback (&NrPhyRxTrace::RxedGnbPhyCtrlMsgsCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbPhy/GnbPhyTxedCtrlMsgsTrace",
+                MakeBoundCallback (&NrPhyRxTrace::TxedGnbPhyCtrlMsgsCallback, m_phyStats));
 }
 
 void
 NrHelper::EnableGnbMacCtrlMsgsTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/GnbMacRxedCtrlMsgsTrace",
-                   MakeBoundCallback (&NrMacRxTrace::RxedGnbMacCtrlMsgsCallback, m_macStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/GnbMacRxedCtrlMsgsTrace",
+                MakeBoundCallback (&NrMacRxTrace::RxedGnbMacCtrlMsgsCallback, m_macStats));
 
-  Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/GnbMacTxedCtrlMsgsTrace",
-                   MakeBoundCallback (&NrMacRxTrace::TxedGnbMacCtrlMsgsCallback, m_macStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/GnbMacTxedCtrlMsgsTrace",
+                MakeBoundCallback (&NrMacRxTrace::TxedGnbMacCtrlMsgsCallback, m_macStats));
 }
 
 void
 NrHelper::EnableUePhyCtrlMsgsTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/UePhyRxedCtrlMsgsTrace",
-                   MakeBoundCallback (&NrPhyRxTrace::RxedUePhyCtrlMsgsCallback, m_phyStats));
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/UePhyTxedCtrlMsgsTrace",
-                   MakeBoundCallback (&NrPhyRxTrace::TxedUePhyCtrlMsgsCallback, m_phyStats));
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/UePhyRxedDlDciTrace",
-                   MakeBoundCallback (&NrPhyRxTrace::RxedUePhyDlDciCallback, m_phyStats));
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/UePhyTxedHarqFeedbackTrace",
-                   MakeBoundCallback (&NrPhyRxTrace::TxedUePhyHarqFeedbackCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/UePhyRxedCtrlMsgsTrace",
+                MakeBoundCallback (&NrPhyRxTrace::RxedUePhyCtrlMsgsCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/UePhyTxedCtrlMsgsTrace",
+                MakeBoundCallback (&NrPhyRxTrace::TxedUePhyCtrlMsgsCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/UePhyRxedDlDciTrace",
+                MakeBoundCallback (&NrPhyRxTrace::RxedUePhyDlDciCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/UePhyTxedHarqFeedbackTrace",
+                MakeBoundCallback (&NrPhyRxTrace::TxedUePhyHarqFeedbackCallback, m_phyStats));
 }
 
 void
 NrHelper::EnableUeMacCtrlMsgsTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUeMac/UeMacRxedCtrlMsgsTrace",
-                   MakeBoundCallback (&NrMacRxTrace::RxedUeMacCtrlMsgsCallback, m_macStats));
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUeMac/UeMacTxedCtrlMsgsTrace",
-                   MakeBoundCallback (&NrMacRxTrace::TxedUeMacCtrlMsgsCallback, m_macStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUeMac/UeMacRxedCtrlMsgsTrace",
+                MakeBoundCallback (&NrMacRxTrace::RxedUeMacCtrlMsgsCallback, m_macStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUeMac/UeMacTxedCtrlMsgsTrace",
+                MakeBoundCallback (&NrMacRxTrace::TxedUeMacCtrlMsgsCallback, m_macStats));
 }
 
 void
 NrHelper::EnableUlPhyTraces (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbPhy/NrSpectrumPhyList/*/RxPacketTraceEnb",
-                   MakeBoundCallback (&NrPhyRxTrace::RxPacketTraceEnbCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbPhy/NrSpectrumPhyList/*/RxPacketTraceEnb",
+                MakeBoundCallback (&NrPhyRxTrace::RxPacketTraceEnbCallback, m_phyStats));
 }
 
 void
 NrHelper::EnableGnbPacketCountTrace ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbPhy/NrSpectrumPhyList/*/ReportEnbTxRxPacketCount",
-                   MakeBoundCallback (&NrPhyRxTrace::ReportPacketCountEnbCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbPhy/NrSpectrumPhyList/*/ReportEnbTxRxPacketCount",
+                MakeBoundCallback (&NrPhyRxTrace::ReportPacketCountEnbCallback, m_phyStats));
 
 }
 
@@ -1607,8 +1881,8 @@ void
 NrHelper::EnableUePacketCountTrace ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/NrSpectrumPhyList/*/ReportUeTxRxPacketCount",
-                   MakeBoundCallback (&NrPhyRxTrace::ReportPacketCountUeCallback, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/NrSpectrumPhyList/*/ReportUeTxRxPacketCount",
+                MakeBoundCallback (&NrPhyRxTrace::ReportPacketCountUeCallback, m_phyStats));
 
 }
 
@@ -1616,8 +1890,8 @@ void
 NrHelper::EnableTransportBlockTrace ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/ReportDownlinkTbSize",
-                   MakeBoundCallback (&NrPhyRxTrace::ReportDownLinkTBSize, m_phyStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUePhy/ReportDownlinkTbSize",
+                MakeBoundCallback (&NrPhyRxTrace::ReportDownLinkTBSize, m_phyStats));
 }
 
 
@@ -1668,24 +1942,24 @@ void
 NrHelper::EnableDlMacSchedTraces ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/DlScheduling",
-                   MakeBoundCallback (&NrMacSchedulingStats::DlSchedulingCallback, m_macSchedStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/DlScheduling",
+                MakeBoundCallback (&NrMacSchedulingStats::DlSchedulingCallback, m_macSchedStats));
 }
 
 void
 NrHelper::EnableUlMacSchedTraces ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/UlScheduling",
-                   MakeBoundCallback (&NrMacSchedulingStats::UlSchedulingCallback, m_macSchedStats));
+  ConnectTrace ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/UlScheduling",
+                MakeBoundCallback (&NrMacSchedulingStats::UlSchedulingCallback, m_macSchedStats));
 }
 
 void
 NrHelper::EnablePathlossTraces ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/ChannelList/*/$ns3::SpectrumChannel/PathLoss",
-                   MakeBoundCallback (&NrPhyRxTrace::PathlossTraceCallback, m_phyStats));
+  ConnectTrace ("/ChannelList/*/$ns3::SpectrumChannel/PathLoss",
+                MakeBoundCallback (&NrPhyRxTrace::PathlossTraceCallback, m_phyStats));
 
 }
 
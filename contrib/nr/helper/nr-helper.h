@@ -25,6 +25,7 @@
 #include <ns3/node-container.h>
 #include <ns3/eps-bearer.h>
 #include <ns3/object-factory.h>
+#include <ns3/config.h>
 #include <ns3/nr-bearer-stats-connector.h>
 #include <ns3/nr-control-messages.h>
 #include <ns3/three-gpp-propagation-loss-model.h>
@@ -307,6 +308,10 @@ public:
 
   /**
    * \brief Attach the UE specified to the closest GNB
+   *
+   * The gNBs are indexed in a grid, so that the cost is about the same of
+   * attaching each UE to a known gNB also with thousands of UEs and gNBs.
+   *
    * \param ueDevices UE devices to attach
    * \param enbDevices GNB devices from which the algorithm has to select the closest
    */
@@ -318,6 +323,45 @@ public:
    */
   void AttachToEnb (const Ptr<NetDevice> &ueDevice, const Ptr<NetDevice> &gnbDevice);
 
+  /**
+   * \brief Partition the nodes for the ns3::MultithreadedSimulatorImpl
+   *
+   * The simulator implementation must be ns3::MultithreadedSimulatorImpl,
+   * and the method must be called after the installation of the devices
+   * (and of the EPC links) and before Simulator::Run.
+   *
+   * The gNBs and the UEs that share a spectrum channel are put in the same
+   * partition, as the channel, the propagation models and the PHYs are
+   * touched by all of them; cells on different carriers get different
+   * partitions. The other nodes (EPC, remote hosts) stay in the partition 0.
+   *
+   * The lookahead of the simulator is set to the minimum delay of the
+   * channels that connect nodes of different partitions (e.g., the S1-U and
+   * X2 links), capped by the shortest slot period. The method aborts if one
+   * of these delays is zero, as it is with the default
+   * PointToPointEpcHelper::S1uLinkDelay: set a positive delay, otherwise
+   * the partitions would never run in parallel.
+   *
+   * The signaling between the gNBs and the EPC calls the EPC applications
+   * directly: use the MultithreadedSimulatorImpl::ParallelStartTime attribute
+   * to run the attach and the bearer setup before the parallel phase. The
+   * traces enabled with EnableTraces() are shared by all the cells, and
+   * cannot be used in the parallel phase, as well as the periodic update of
+   * the IdealBeamformingHelper: set its BeamformingPeriodicity beyond the
+   * end of the simulation.
+   *
+   * The state that the cells share (the RA preamble IDs of the UEs, the
+   * handover messages of NrGnbRrcProtocolIdeal, the spectrum models) is
+   * atomic or protected by a mutex; the rest of the MAC and PHY state is
+   * kept per device.
+   *
+   * \param gnbDevices the gNB devices
+   * \param ueDevices the UE devices
+   * \return the lookahead
+   */
+  Time AssignSimulatorPartitions (const NetDeviceContainer &gnbDevices,
+                                  const NetDeviceContainer &ueDevices) const;
+
   /**
    * \brief Enables the following traces:
    * Transmitted/Received Control Messages
@@ -325,6 +369,12 @@ public:
    * RLC traces
    * PDCP traces
    *
+   * The trace sinks are connected all together with Config::ConnectMany,
+   * which resolves the gNB and UE devices only once for all the traces.
+   *
+   * When the module is configured with NS3_NR_STATISTICS=OFF, the slot,
+   * RB, scheduling and packet reception statistics are compiled out, and
+   * their trace sources never fire.
    */
   void EnableTraces ();
 
@@ -409,6 +459,10 @@ public:
    * If the models are already set (i.e., the pointers are not null) the helper
    * will not touch anything.
    *
+   * If the attribute ShareChannelParams is true, the BWPs of the band with the
+   * same scenario share the channel condition model and the parameters of the
+   * 3GPP channel model (see ThreeGppChannelModel::ShareChannelParams).
+   *
    * \param band the band representation
    * \param flags the flags for the initialization. Default to initialize everything
    */
@@ -843,6 +897,13 @@ public:
    int64_t AssignStreams (NetDeviceContainer c, int64_t stream);
 
 private:
+  /**
+   * \brief Connect a trace sink with context, or add it to the
+   * connections of EnableTraces() when it is in progress
+   * \param path the path of the trace sources
+   * \param cb the trace sink
+   */
+  void ConnectTrace (const std::string &path, const CallbackBase &cb);
 
    /**
     * Assign a fixed random variable stream number to the channel and propagation
@@ -927,6 +988,7 @@ private:
 
   bool m_harqEnabled {false};
   bool m_snrTest {false};
+  bool m_shareChannelParams {false}; //!< Share the channel parameters among the BWPs of a band
 
   Ptr<NrPhyRxTrace> m_phyStats; //!< Pointer to the PhyRx stats
   Ptr<NrMacRxTrace> m_macStats; //!< Pointer to the MacRx stats
@@ -940,6 +1002,8 @@ private:
   //Configured Grant
   bool m_configuredGrant{false};
 
+  Config::ConnectionList *m_traceConnections {nullptr}; //!< Connections of EnableTraces() in progress
+
 };
 
 }
@@ -19,6 +19,7 @@
 
 #include "nr-spectrum-value-helper.h"
 #include <map>
+#include <mutex>
 #include <cmath>
 #include <ns3/log.h>
 #include <ns3/fatal-error.h>
@@ -68,6 +69,7 @@ operator < (const NrSpectrumModelId& a, const NrSpectrumModelId& b)
 }
 
 static std::map<NrSpectrumModelId, Ptr<SpectrumModel> > g_nrSpectrumModelMap; ///< nr spectrum model map
+static std::mutex g_nrSpectrumModelMapMutex; ///< the PHYs of different threads may look up and fill the map
 
 Ptr<const SpectrumModel>
 NrSpectrumValueHelper::GetSpectrumModel (uint32_t numRbs, double centerFrequency, double subcarrierSpacing)
@@ -83,6 +85,7 @@ NrSpectrumValueHelper::GetSpectrumModel (uint32_t numRbs, double centerFrequency
 
   NrSpectrumModelId modelId = NrSpectrumModelId (centerFrequency, numRbs, subcarrierSpacing);
 
+  std::lock_guard<std::mutex> lock (g_nrSpectrumModelMapMutex);
   if (g_nrSpectrumModelMap.find (modelId) != g_nrSpectrumModelMap.end ())
     {
       return g_nrSpectrumModelMap.find (modelId)->second;
@@ -0,0 +1,261 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "trajectory-file-helper.h"
+
+#include <ns3/abort.h>
+#include <ns3/csv-reader.h>
+#include <ns3/log.h>
+#include <ns3/node.h>
+#include <ns3/simulator.h>
+#include <ns3/waypoint-mobility-model.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TrajectoryFileHelper");
+
+const char TrajectoryFile::MAGIC[8] = {'N', 'S', '3', 'T', 'R', 'A', 'J', '1'};
+
+TrajectoryFile::TrajectoryFile (const std::string &filePath)
+{
+  NS_LOG_FUNCTION (this << filePath);
+
+  int fd = open (filePath.c_str (), O_RDONLY);
+  NS_ABORT_MSG_IF (fd < 0, "Cannot open the trajectory file " << filePath);
+  struct stat st;
+  NS_ABORT_MSG_IF (fstat (fd, &st) != 0, "Cannot read the size of " << filePath);
+  m_mappingSize = static_cast<std::size_t> (st.st_size);
+  NS_ABORT_MSG_IF (m_mappingSize < sizeof (Header), filePath << " is not a trajectory file");
+
+  m_mapping = mmap (nullptr, m_mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  NS_ABORT_MSG_IF (m_mapping == MAP_FAILED, "Cannot map the trajectory file " << filePath);
+
+  const Header *header = static_cast<const Header *> (m_mapping);
+  NS_ABORT_MSG_IF (std::memcmp (header->m_magic, MAGIC, sizeof (MAGIC)) != 0,
+                   filePath << " is not a trajectory file");
+  m_numNodes = header->m_numNodes;
+  std::size_t numWaypoints = header->m_numWaypoints;
+  NS_ABORT_MSG_IF (m_mappingSize != sizeof (Header) + (m_numNodes + 1) * sizeof (uint64_t)
+                   + numWaypoints * sizeof (Record),
+                   "Wrong size of the trajectory file " << filePath);
+
+  m_offsets = reinterpret_cast<const uint64_t *> (header + 1);
+  m_records = reinterpret_cast<const Record *> (m_offsets + m_numNodes + 1);
+  NS_ABORT_MSG_IF (m_offsets[0] != 0 || m_offsets[m_numNodes] != numWaypoints,
+                   "Wrong index of the waypoints in " << filePath);
+  for (std::size_t node = 0; node < m_numNodes; node++)
+    {
+      NS_ABORT_MSG_IF (m_offsets[node] >= m_offsets[node + 1],
+                       "Node " << node << " has no waypoints in " << filePath);
+    }
+
+  NS_LOG_INFO ("Mapped " << m_numNodes << " trajectories, " << numWaypoints << " waypoints");
+}
+
+TrajectoryFile::~TrajectoryFile ()
+{
+  NS_LOG_FUNCTION (this);
+  munmap (m_mapping, m_mappingSize);
+}
+
+bool
+TrajectoryFile::IsTrajectoryFile (const std::string &filePath)
+{
+  NS_LOG_FUNCTION (filePath);
+  std::ifstream file (filePath, std::ios::binary);
+  char magic[sizeof (MAGIC)];
+  return file.read (magic, sizeof (magic)) && std::memcmp (magic, MAGIC, sizeof (MAGIC)) == 0;
+}
+
+std::size_t
+TrajectoryFile::ConvertCsv (const std::string &csvPath,
+                            const std::string &filePath,
+                            double defaultZ /* = 0 */,
+                            char delimiter /* = ',' */)
+{
+  NS_LOG_FUNCTION (csvPath << filePath << defaultZ << std::string ("'") + delimiter + "'");
+
+  // the node and the waypoint of each row
+  std::vector<std::pair<uint64_t, Record> > rows;
+  bool positions = false;
+
+  CsvReader csv (csvPath, delimiter);
+  while (csv.FetchNextRow ())
+    {
+      if (csv.IsBlankRow () || csv.ColumnCount () < 2)
+        {
+          // comment line
+          continue;
+        }
+
+      bool rowPositions = (csv.ColumnCount () <= 3);
+      NS_ABORT_MSG_IF (!rows.empty () && rowPositions != positions,
+                       "Row " << csv.RowNumber () << " of " << csvPath
+                              << " mixes positions and waypoints");
+      positions = rowPositions;
+
+      uint64_t node = rows.size ();
+      Record record {0, 0, 0, defaultZ};
+      std::size_t column = 0;
+      bool ok = true;
+      if (!positions)
+        {
+          ok = csv.GetValue (column++, node) && csv.GetValue (column++, record.m_time);
+        }
+      ok = ok && csv.GetValue (column++, record.m_x) && csv.GetValue (column++, record.m_y);
+      if (column < csv.ColumnCount ())
+        {
+          ok = ok && csv.GetValue (column, record.m_z);
+        }
+      NS_ABORT_MSG_IF (!ok, "Failed reading row " << csv.RowNumber () << " of " << csvPath);
+      rows.emplace_back (node, record);
+    }
+  NS_LOG_INFO ("read " << csv.RowNumber () << " rows");
+
+  std::stable_sort (rows.begin (), rows.end (),
+                    [] (const std::pair<uint64_t, Record> &a, const std::pair<uint64_t, Record> &b)
+                    {
+                      return a.first < b.first;
+                    });
+
+  Header header;
+  std::memcpy (header.m_magic, MAGIC, sizeof (MAGIC));
+  header.m_numNodes = rows.empty () ? 0 : rows.back ().first + 1;
+  header.m_numWaypoints = rows.size ();
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve (header.m_numNodes + 1);
+  std::vector<Record> records;
+  records.reserve (rows.size ());
+  for (std::size_t i = 0; i < rows.size (); i++)
+    {
+      if (i > 0 && rows[i].first == rows[i - 1].first)
+        {
+          NS_ABORT_MSG_IF (rows[i].second.m_time <= rows[i - 1].second.m_time,
+                           "The waypoints of node " << rows[i].first << " in " << csvPath
+                                                    << " are not in increasing order of time");
+        }
+      else
+        {
+          NS_ABORT_MSG_IF (rows[i].first != offsets.size (),
+                           "Node " << offsets.size () << " has no waypoints in " << csvPath);
+          offsets.push_back (i);
+        }
+      records.push_back (rows[i].second);
+    }
+  offsets.push_back (rows.size ());
+
+  std::ofstream file (filePath, std::ios::binary | std::ios::trunc);
+  NS_ABORT_MSG_IF (!file.is_open (), "Cannot create the trajectory file " << filePath);
+  file.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  file.write (reinterpret_cast<const char *> (offsets.data ()), offsets.size () * sizeof (uint64_t));
+  file.write (reinterpret_cast<const char *> (records.data ()), records.size () * sizeof (Record));
+  NS_ABORT_MSG_IF (!file, "Cannot write the trajectory file " << filePath);
+
+  return header.m_numNodes;
+}
+
+std::size_t
+TrajectoryFile::GetNumWaypoints (std::size_t node) const
+{
+  NS_ASSERT (node < m_numNodes);
+  return m_offsets[node + 1] - m_offsets[node];
+}
+
+Waypoint
+TrajectoryFile::GetWaypoint (std::size_t node, std::size_t index) const
+{
+  NS_ASSERT (index < GetNumWaypoints (node));
+  const Record &record = m_records[m_offsets[node] + index];
+  return Waypoint (Seconds (record.m_time), Vector (record.m_x, record.m_y, record.m_z));
+}
+
+TrajectoryFileHelper::TrajectoryFileHelper (const std::string &filePath)
+  : m_file (Create<TrajectoryFile> (filePath))
+{
+}
+
+TrajectoryFileHelper::TrajectoryFileHelper (Ptr<const TrajectoryFile> file)
+  : m_file (file)
+{
+}
+
+Ptr<const TrajectoryFile>
+TrajectoryFileHelper::GetFile () const
+{
+  return m_file;
+}
+
+void
+TrajectoryFileHelper::SetLookAhead (uint32_t lookAhead)
+{
+  NS_ABORT_MSG_IF (lookAhead < 2, "The look-ahead must be at least 2 waypoints");
+  m_lookAhead = lookAhead;
+}
+
+void
+TrajectoryFileHelper::Install (const NodeContainer &nodes, std::size_t firstNode /* = 0 */) const
+{
+  NS_LOG_FUNCTION (this << nodes.GetN () << firstNode);
+  NS_ABORT_MSG_IF (firstNode + nodes.GetN () > m_file->GetNumNodes (),
+                   "The trajectory file has " << m_file->GetNumNodes () << " nodes, "
+                                              << firstNode + nodes.GetN () << " are needed");
+
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<Node> node = nodes.Get (i);
+      NS_ABORT_MSG_IF (m_file->GetWaypoint (firstNode + i, 0).time < Simulator::Now (),
+                       "The trajectory of node " << node->GetId () << " starts in the past");
+      Ptr<WaypointMobilityModel> model = CreateObject<WaypointMobilityModel> ();
+      node->AggregateObject (model);
+      AddWaypoints (m_file, model, firstNode + i, 0, m_lookAhead);
+    }
+}
+
+void
+TrajectoryFileHelper::AddWaypoints (Ptr<const TrajectoryFile> file, Ptr<WaypointMobilityModel> model,
+                                    std::size_t node, std::size_t next, uint32_t lookAhead)
+{
+  NS_LOG_FUNCTION (node << next);
+  std::size_t numWaypoints = file->GetNumWaypoints (node);
+  std::size_t end = std::min<std::size_t> (next + lookAhead, numWaypoints);
+  for (std::size_t i = next; i < end; i++)
+    {
+      model->AddWaypoint (file->GetWaypoint (node, i));
+    }
+
+  // Add the next waypoints when the model reaches the last but one
+  // waypoint: it is then still moving towards a waypoint already added
+  if (end < numWaypoints)
+    {
+      Time when = file->GetWaypoint (node, end - 2).time;
+      Simulator::Schedule (when - Simulator::Now (), &TrajectoryFileHelper::AddWaypoints,
+                           file, model, node, end, lookAhead);
+    }
+}
+
+} // namespace ns3
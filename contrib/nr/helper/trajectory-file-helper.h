@@ -0,0 +1,234 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef TRAJECTORY_FILE_HELPER_H
+#define TRAJECTORY_FILE_HELPER_H
+
+#include <ns3/node-container.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/waypoint.h>
+
+#include <cstdint>
+#include <string>
+
+namespace ns3 {
+
+class WaypointMobilityModel;
+
+/**
+ * \ingroup helper
+ * \brief Read-only view of a binary file of node trajectories
+ *
+ * The file stores, for each node, the list of its waypoints (time and
+ * position), in a compact binary format that is memory-mapped: opening a
+ * file does not parse or copy the waypoints, which are read from the
+ * mapping (and then from the disk, by the operating system) only when
+ * they are requested. Nodes that do not move have a single waypoint.
+ *
+ * The file is made of (all the values in the byte order of the machine
+ * that wrote it):
+ * - the header: the 8 characters "NS3TRAJ1", the number of nodes N and the
+ *   total number of waypoints W, as 64-bit unsigned integers;
+ * - N + 1 64-bit unsigned integers: the index of the first waypoint of each
+ *   node, followed by W;
+ * - W waypoints, each made of the time in seconds and the x, y and z
+ *   coordinates in meters, as doubles.
+ *
+ * The waypoints of each node are in strictly increasing order of time. A
+ * file is created from a CSV file with ConvertCsv().
+ */
+class TrajectoryFile : public SimpleRefCount<TrajectoryFile>
+{
+public:
+  /**
+   * \brief Map a trajectory file. The simulation is aborted if the file
+   * cannot be opened or if it is not a valid trajectory file.
+   * \param filePath the path of the file
+   */
+  TrajectoryFile (const std::string &filePath);
+
+  /**
+   * \brief Unmap the file
+   */
+  ~TrajectoryFile ();
+
+  TrajectoryFile (const TrajectoryFile &) = delete;
+  TrajectoryFile & operator= (const TrajectoryFile &) = delete;
+
+  /**
+   * \brief Check if a file starts as a trajectory file
+   * \param filePath the path of the file
+   * \return true if the file can be opened and starts with the header of a
+   * trajectory file
+   */
+  static bool IsTrajectoryFile (const std::string &filePath);
+
+  /**
+   * \brief Convert a CSV file into a trajectory file.
+   *
+   * Each row of the CSV file is either a position, with X and Y, or X, Y
+   * and Z, or a waypoint, with the node index, the time in seconds, X and
+   * Y, or the node index, the time, X, Y and Z (in meters). A file of
+   * positions gives one node per row, with a single waypoint at time 0, as
+   * the files read by ListPositionAllocator::Add. In a file of waypoints,
+   * the nodes are numbered from 0, every node must have at least one
+   * waypoint, and the waypoints of a node must be in increasing order of
+   * time, while the rows of different nodes can be interleaved.
+   *
+   * The file is read using CsvReader, which explains how comments and
+   * whitespace are handled.
+   *
+   * \param csvPath the path of the CSV file
+   * \param filePath the path of the trajectory file to write
+   * \param defaultZ the Z of the rows without it
+   * \param delimiter the delimiter character; see CsvReader
+   * \return the number of nodes written
+   */
+  static std::size_t ConvertCsv (const std::string &csvPath,
+                                 const std::string &filePath,
+                                 double defaultZ = 0,
+                                 char delimiter = ',');
+
+  /**
+   * \return the number of nodes
+   */
+  std::size_t GetNumNodes () const
+  {
+    return m_numNodes;
+  }
+
+  /**
+   * \param node the index of the node
+   * \return the number of waypoints of the node
+   */
+  std::size_t GetNumWaypoints (std::size_t node) const;
+
+  /**
+   * \param node the index of the node
+   * \param index the index of the waypoint of the node
+   * \return the waypoint
+   */
+  Waypoint GetWaypoint (std::size_t node, std::size_t index) const;
+
+private:
+  /**
+   * \brief A waypoint, as stored in the file
+   */
+  struct Record
+  {
+    double m_time; //!< time, in seconds
+    double m_x;    //!< X coordinate, in meters
+    double m_y;    //!< Y coordinate, in meters
+    double m_z;    //!< Z coordinate, in meters
+  };
+
+  /**
+   * \brief The header of the file
+   */
+  struct Header
+  {
+    char m_magic[8];         //!< the characters NS3TRAJ1
+    uint64_t m_numNodes;     //!< number of nodes
+    uint64_t m_numWaypoints; //!< total number of waypoints
+  };
+
+  static const char MAGIC[8]; //!< the first characters of a trajectory file
+
+  void *m_mapping {nullptr};            //!< the mapped file
+  std::size_t m_mappingSize {0};        //!< size of the mapped file
+  std::size_t m_numNodes {0};           //!< number of nodes
+  const uint64_t *m_offsets {nullptr};  //!< index of the first waypoint of each node
+  const Record *m_records {nullptr};    //!< the waypoints
+};
+
+/**
+ * \ingroup helper
+ * \brief Install the trajectories of a TrajectoryFile on the nodes
+ *
+ * Each node gets a WaypointMobilityModel, to which the waypoints of its
+ * trajectory are added a few at a time: the helper adds the next
+ * waypoints (up to the look-ahead) when the node reaches the last but one
+ * of the waypoints already added. The mobility models then hold only a
+ * small part of the trajectories, and the waypoints that are never reached
+ * are never read from the file. The file stays mapped as long as there
+ * are waypoints to add.
+ *
+ * \code
+ * TrajectoryFile::ConvertCsv ("ue-trajectories.csv", "ue-trajectories.bin");
+ * // ... in the simulations ...
+ * TrajectoryFileHelper trajectories ("ue-trajectories.bin");
+ * trajectories.Install (ueNodes);
+ * \endcode
+ *
+ * The waypoint times are simulation times, so the trajectories must be
+ * installed before the time of the first waypoint of each node.
+ */
+class TrajectoryFileHelper
+{
+public:
+  /**
+   * \brief Create a helper for a trajectory file
+   * \param filePath the path of the file
+   */
+  TrajectoryFileHelper (const std::string &filePath);
+
+  /**
+   * \brief Create a helper for a trajectory file already mapped
+   * \param file the file
+   */
+  TrajectoryFileHelper (Ptr<const TrajectoryFile> file);
+
+  /**
+   * \return the trajectory file
+   */
+  Ptr<const TrajectoryFile> GetFile () const;
+
+  /**
+   * \brief Set the number of waypoints that are added to a mobility model
+   * at a time (default 16)
+   * \param lookAhead the number of waypoints, at least 2
+   */
+  void SetLookAhead (uint32_t lookAhead);
+
+  /**
+   * \brief Install a WaypointMobilityModel on each node, with the
+   * trajectories firstNode, firstNode + 1, ... of the file
+   * \param nodes the nodes
+   * \param firstNode the index, in the file, of the trajectory of the first node
+   */
+  void Install (const NodeContainer &nodes, std::size_t firstNode = 0) const;
+
+private:
+  /**
+   * \brief Add the next waypoints of a trajectory to a mobility model, and
+   * schedule the addition of the following ones, if any
+   * \param file the trajectory file
+   * \param model the mobility model
+   * \param node the index of the trajectory in the file
+   * \param next the index of the first waypoint to add
+   * \param lookAhead the number of waypoints to add
+   */
+  static void AddWaypoints (Ptr<const TrajectoryFile> file, Ptr<WaypointMobilityModel> model,
+                            std::size_t node, std::size_t next, uint32_t lookAhead);
+
+  Ptr<const TrajectoryFile> m_file; //!< the trajectory file
+  uint32_t m_lookAhead {16};        //!< the number of waypoints added at a time
+};
+
+} // namespace ns3
+
+#endif /* TRAJECTORY_FILE_HELPER_H */
@@ -61,11 +61,39 @@ complexVector_t CreateQuasiOmniBfv (uint32_t antennaRows, uint32_t antennaColumn
   return omni;
 }
 
+/**
+ * \brief The weights of the elements of an array that point the beam toward a direction
+ * \param antenna the antenna array
+ * \param hAngleRadian the azimuth angle of the direction, in radians
+ * \param vAngleRadian the inclination angle of the direction, in radians
+ * \param power the amplitude of each weight
+ * \return the weights
+ */
+static complexVector_t
+CreateBfvToward (const Ptr<const UniformPlanarArray>& antenna,
+                 double hAngleRadian, double vAngleRadian, double power)
+{
+  // the direction is computed once, and the locations of the elements are
+  // read from the table of the array
+  const double dirX = sin (vAngleRadian) * cos (hAngleRadian);
+  const double dirY = sin (vAngleRadian) * sin (hAngleRadian);
+  const double dirZ = cos (vAngleRadian);
+  const std::vector<Vector> &locations = antenna->GetElementLocations ();
+
+  complexVector_t antennaWeights (locations.size ());
+  for (std::size_t ind = 0; ind < locations.size (); ind++)
+    {
+      double phase = -2 * M_PI * (dirX * locations[ind].x
+                                  + dirY * locations[ind].y
+                                  + dirZ * locations[ind].z);
+      antennaWeights[ind] = exp (std::complex<double> (0, phase)) * power;
+    }
+  return antennaWeights;
+}
+
 complexVector_t CreateDirectionalBfv (const Ptr<const UniformPlanarArray>& antenna,
                                       uint16_t sector, double elevation)
 {
-  complexVector_t tempVector;
-
   UintegerValue uintValueNumRows;
   antenna->GetAttribute ("NumRows", uintValueNumRows);
 
@@ -75,58 +103,29 @@ complexVector_t CreateDirectionalBfv (const Ptr<const UniformPlanarArray>& anten
   double power = 1 / sqrt (size);
   if (size == 1)
     {
-      tempVector.push_back (power);  // single AE, no BF
+      return complexVector_t (1, power);  // single AE, no BF
     }
-  else
-    {
-      for (auto ind = 0; ind < size; ind++)
-        {
-        Vector loc = antenna->GetElementLocation (ind);
-        double phase = -2 * M_PI * (sin (vAngle_radian) * cos (hAngle_radian) * loc.x
-                                    + sin (vAngle_radian) * sin (hAngle_radian) * loc.y
-                                    + cos (vAngle_radian) * loc.z);
-        tempVector.push_back (exp (std::complex<double> (0, phase)) * power);
-        }
-    }
-  return tempVector;
+  return CreateBfvToward (antenna, hAngle_radian, vAngle_radian, power);
 }
 
 complexVector_t CreateDirectionalBfvAz (const Ptr<const UniformPlanarArray>& antenna,
                                         double azimuth, double zenith)
 {
-  complexVector_t tempVector;
-
-  UintegerValue uintValueNumRows;
-  antenna->GetAttribute ("NumRows", uintValueNumRows);
-
   double hAngle_radian = azimuth * M_PI / 180;
   double vAngle_radian = zenith * M_PI / 180;
   uint16_t size = antenna->GetNumberOfElements ();
   double power = 1 / sqrt (size);
   if (size == 1)
     {
-      tempVector.push_back (power);  // single AE, no BF
-    }
-  else
-    {
-      for (auto ind = 0; ind < size; ind++)
-        {
-        Vector loc = antenna->GetElementLocation (ind);
-        double phase = -2 * M_PI * (sin (vAngle_radian) * cos (hAngle_radian) * loc.x
-                                    + sin (vAngle_radian) * sin (hAngle_radian) * loc.y
-                                    + cos (vAngle_radian) * loc.z);
-        tempVector.push_back (exp (std::complex<double> (0, phase)) * power);
-        }
+      return complexVector_t (1, power);  // single AE, no BF
     }
-  return tempVector;
+  return CreateBfvToward (antenna, hAngle_radian, vAngle_radian, power);
 }
 
 complexVector_t CreateDirectPathBfv (const Ptr<MobilityModel>& a,
                                      const Ptr<MobilityModel>& b,
                                      const Ptr<const UniformPlanarArray>& antenna)
 {
-  complexVector_t antennaWeights;
-
   // retrieve the position of the two devices
   Vector aPos = a->GetPosition ();
   Vector bPos = b->GetPosition ();
@@ -138,23 +137,11 @@ complexVector_t CreateDirectPathBfv (const Ptr<MobilityModel>& a,
 
   double vAngleRadian = completeAngle.GetInclination (); // the elevation angle
 
-  // retrieve the number of antenna elements
-  int totNoArrayElements = antenna->GetNumberOfElements ();
-
   // the total power is divided equally among the antenna elements
-  double power = 1 / sqrt (totNoArrayElements);
+  double power = 1 / sqrt (antenna->GetNumberOfElements ());
 
   // compute the antenna weights
-  for (int ind = 0; ind < totNoArrayElements; ind++)
-    {
-      Vector loc = antenna->GetElementLocation (ind);
-      double phase = -2 * M_PI * (sin (vAngleRadian) * cos (hAngleRadian) * loc.x
-                                  + sin (vAngleRadian) * sin (hAngleRadian) * loc.y
-                                  + cos (vAngleRadian) * loc.z);
-      antennaWeights.push_back (exp (std::complex<double> (0, phase)) * power);
-    }
-
-  return antennaWeights;
+  return CreateBfvToward (antenna, hAngleRadian, vAngleRadian, power);
 }
 
 }
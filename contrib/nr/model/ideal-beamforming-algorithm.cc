@@ -114,7 +114,22 @@ CellScanBeamforming::GetBeamformingVectors (const Ptr<NrSpectrumPhy>& gnbSpectru
   ueSpectrumPhy->GetAntenna ()->GetAttribute ("NumRows", uintValue);
   uint32_t rxNumRows = static_cast<uint32_t> (uintValue.Get ());
 
-  NS_ASSERT (gnbSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel> ()->GetNumberOfElements() && ueSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel> ()->GetNumberOfElements());
+  Ptr<PhasedArrayModel> gnbAntenna = gnbSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel> ();
+  Ptr<PhasedArrayModel> ueAntenna = ueSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel> ();
+  NS_ASSERT (gnbAntenna->GetNumberOfElements() && ueAntenna->GetNumberOfElements());
+
+  // The beams of the UE do not depend on the beam of the gNB: they are
+  // computed once, and not again for every beam of the gNB
+  std::vector<BeamformingVector> rxBeams;
+  for (double rxTheta = 60; rxTheta < 121; rxTheta = static_cast<uint16_t> (rxTheta + m_beamSearchAngleStep))
+    {
+      for (uint16_t rxSector = 0; rxSector <= rxNumRows; rxSector++)
+        {
+          NS_ASSERT(rxSector < UINT16_MAX);
+          rxBeams.emplace_back (CreateDirectionalBfv (ueSpectrumPhy->GetBeamManager ()->GetAntenna (), rxSector, rxTheta),
+                                BeamId (rxSector, rxTheta));
+        }
+    }
 
   for (double txTheta = 60; txTheta < 121; txTheta = txTheta + m_beamSearchAngleStep)
     {
@@ -123,52 +138,49 @@ CellScanBeamforming::GetBeamformingVectors (const Ptr<NrSpectrumPhy>& gnbSpectru
           NS_ASSERT(txSector < UINT16_MAX);
 
           gnbSpectrumPhy->GetBeamManager ()->SetSector (txSector, txTheta);
-          complexVector_t txW = gnbSpectrumPhy->GetBeamManager ()->GetCurrentBeamformingVector ();
+          const complexVector_t &txW = gnbAntenna->GetBeamformingVectorRef ();
 
           if (maxTxW.size () == 0)
             {
               maxTxW = txW; // initialize maxTxW
             }
 
-          for (double rxTheta = 60; rxTheta < 121; rxTheta = static_cast<uint16_t> (rxTheta + m_beamSearchAngleStep))
+          for (const BeamformingVector &rxBeam : rxBeams)
             {
-              for (uint16_t rxSector = 0; rxSector <= rxNumRows; rxSector++)
-                {
-                  NS_ASSERT(rxSector < UINT16_MAX);
+              const complexVector_t &rxW = rxBeam.first;
+              uint16_t rxSector = rxBeam.second.GetSector ();
+              double rxTheta = rxBeam.second.GetElevation ();
+              ueAntenna->SetBeamformingVector (rxW);
 
-                  ueSpectrumPhy->GetBeamManager ()->SetSector (rxSector, rxTheta);
-                  complexVector_t rxW = ueSpectrumPhy->GetBeamManager ()->GetCurrentBeamformingVector ();
+              if (maxRxW.size () == 0)
+                {
+                  maxRxW = rxW; // initialize maxRxW
+                }
 
-                  if (maxRxW.size () == 0)
-                    {
-                      maxRxW = rxW; // initialize maxRxW
-                    }
+              NS_ABORT_MSG_IF (txW.size()==0 || rxW.size()==0, "Beamforming vectors must be initialized in order to calculate the long term matrix.");
 
-                  NS_ABORT_MSG_IF (txW.size()==0 || rxW.size()==0, "Beamforming vectors must be initialized in order to calculate the long term matrix.");
+              Ptr<SpectrumValue> rxPsd = gnbThreeGppSpectrumPropModel->CalcRxPowerSpectralDensity (fakePsd,
+                                                                                                   gnbSpectrumPhy->GetMobility (),
+                                                                                                   ueSpectrumPhy->GetMobility (),
+                                                                                                   gnbAntenna,
+                                                                                                   ueAntenna);
 
-                  Ptr<SpectrumValue> rxPsd = gnbThreeGppSpectrumPropModel->CalcRxPowerSpectralDensity (fakePsd,
-                                                                                                       gnbSpectrumPhy->GetMobility (),
-                                                                                                       ueSpectrumPhy->GetMobility (),
-                                                                                                       gnbSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel>(),
-                                                                                                       ueSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel>());
+              size_t nbands = rxPsd->GetSpectrumModel ()->GetNumBands ();
+              double power = Sum (*rxPsd) / nbands;
 
-                  size_t nbands = rxPsd->GetSpectrumModel ()->GetNumBands ();
-                  double power = Sum (*rxPsd) / nbands;
-                  
-                  NS_LOG_LOGIC (" Rx power: "<< power << "txTheta " << txTheta << " rxTheta " << rxTheta << " tx sector " <<
-                                (M_PI *  static_cast<double> (txSector) / static_cast<double> (txNumRows) - 0.5 * M_PI) / (M_PI) * 180 << " rx sector " <<
-                                (M_PI * static_cast<double> (rxSector) / static_cast<double> (rxNumRows) - 0.5 * M_PI) / (M_PI) * 180);
+              NS_LOG_LOGIC (" Rx power: "<< power << "txTheta " << txTheta << " rxTheta " << rxTheta << " tx sector " <<
+                            (M_PI *  static_cast<double> (txSector) / static_cast<double> (txNumRows) - 0.5 * M_PI) / (M_PI) * 180 << " rx sector " <<
+                            (M_PI * static_cast<double> (rxSector) / static_cast<double> (rxNumRows) - 0.5 * M_PI) / (M_PI) * 180);
 
-                  if (max < power)
-                    {
-                      max = power;
-                      maxTxSector = txSector;
-                      maxRxSector = rxSector;
-                      maxTxTheta = txTheta;
-                      maxRxTheta = rxTheta;
-                      maxTxW = txW;
-                      maxRxW = rxW;
-                    }
+              if (max < power)
+                {
+                  max = power;
+                  maxTxSector = txSector;
+                  maxRxSector = rxSector;
+                  maxTxTheta = txTheta;
+                  maxRxTheta = rxTheta;
+                  maxTxW = txW;
+                  maxRxW = rxW;
                 }
             }
         }
@@ -232,7 +244,21 @@ CellScanBeamformingAzimuthZenith::GetBeamformingVectors (const Ptr<NrSpectrumPhy
   gnbSpectrumPhy->GetAntenna ()->GetAttribute ("NumRows", uintValue);
   ueSpectrumPhy->GetAntenna ()->GetAttribute ("NumRows", uintValue);
 
-  NS_ASSERT (gnbSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel> ()->GetNumberOfElements () && ueSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel> ()->GetNumberOfElements ());
+  Ptr<PhasedArrayModel> gnbAntenna = gnbSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel> ();
+  Ptr<PhasedArrayModel> ueAntenna = ueSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel> ();
+  NS_ASSERT (gnbAntenna->GetNumberOfElements () && ueAntenna->GetNumberOfElements ());
+
+  // The beams of the UE do not depend on the beam of the gNB: they are
+  // computed once, and not again for every beam of the gNB
+  std::vector<complexVector_t> rxBeams;
+  for (uint iii = 0; iii < m_azimuth.size (); iii++)
+    {
+      for (uint iiii = 0; iiii < m_zenith.size (); iiii++)
+        {
+          rxBeams.push_back (CreateDirectionalBfvAz (ueSpectrumPhy->GetBeamManager ()->GetAntenna (),
+                                                     m_azimuth[iii], m_zenith[iiii]));
+        }
+    }
 
   for (uint i = 0; i < m_azimuth.size (); i++)
     {
@@ -242,7 +268,7 @@ CellScanBeamformingAzimuthZenith::GetBeamformingVectors (const Ptr<NrSpectrumPhy
           double zenithTx = m_zenith [ii];
 
           gnbSpectrumPhy->GetBeamManager ()->SetSectorAz (azimuthTx, zenithTx);
-          complexVector_t txW = gnbSpectrumPhy->GetBeamManager ()->GetCurrentBeamformingVector ();
+          const complexVector_t &txW = gnbAntenna->GetBeamformingVectorRef ();
 
           if (maxTxW.size () == 0)
             {
@@ -256,8 +282,8 @@ CellScanBeamformingAzimuthZenith::GetBeamformingVectors (const Ptr<NrSpectrumPhy
                 {
                   double zenithRx = m_zenith [iiii];
 
-                  ueSpectrumPhy->GetBeamManager ()->SetSectorAz (azimuthRx, zenithRx);
-                  complexVector_t rxW = ueSpectrumPhy->GetBeamManager ()->GetCurrentBeamformingVector ();
+                  const complexVector_t &rxW = rxBeams[iii * m_zenith.size () + iiii];
+                  ueAntenna->SetBeamformingVector (rxW);
 
                   if (maxRxW.size () == 0)
                     {
@@ -271,8 +297,8 @@ CellScanBeamformingAzimuthZenith::GetBeamformingVectors (const Ptr<NrSpectrumPhy
                   Ptr<SpectrumValue> rxPsd = gnbThreeGppSpectrumPropModel->CalcRxPowerSpectralDensity (fakePsd,
                                                                                                        gnbSpectrumPhy->GetMobility (),
                                                                                                        ueSpectrumPhy->GetMobility (),
-                                                                                                       gnbSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel>(),
-                                                                                                       ueSpectrumPhy->GetAntenna ()->GetObject <PhasedArrayModel>());
+                                                                                                       gnbAntenna,
+                                                                                                       ueAntenna);
 
                   size_t nbands = rxPsd->GetSpectrumModel ()->GetNumBands ();
                   double power = Sum (*rxPsd) / nbands;
@@ -26,6 +26,7 @@
 #include "nr-error-model.h"
 #include "nr-lte-mi-error-model.h"
 #include "lena-error-model.h"
+#include "nr-eesm-error-model.h"
 #include <ns3/nr-spectrum-value-helper.h>
 namespace ns3 {
 
@@ -46,6 +47,7 @@ NrAmc::SetDlMode ()
 {
   NS_LOG_FUNCTION (this);
   m_emMode = NrErrorModel::DL;
+  m_sinrDbThresholds.clear ();
 }
 
 void
@@ -53,6 +55,7 @@ NrAmc::SetUlMode ()
 {
   NS_LOG_FUNCTION (this);
   m_emMode = NrErrorModel::UL;
+  m_sinrDbThresholds.clear ();
 }
 
 TypeId
@@ -122,6 +125,7 @@ void NrAmc::SetNumRefScPerRb(uint8_t nref)
 {
   NS_LOG_FUNCTION (this);
   m_numRefScPerRb = nref;
+  m_sinrDbThresholds.clear ();
 }
 
 uint32_t
@@ -165,92 +169,126 @@ uint8_t
 NrAmc::CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t &mcs) const
 {
   NS_LOG_FUNCTION (this);
+  return DoCreateCqiFeedbackWbTdma (sinr.GetSpectrumModel (), &(*sinr.ConstValuesBegin ()), mcs);
+}
 
-  // produces a single CQI/MCS value
+void
+NrAmc::CreateCqiFeedbackWbTdma (const Ptr<const SpectrumModel> &model, const std::vector<double> &sinr,
+                                std::vector<uint8_t> &cqi, std::vector<uint8_t> &mcs) const
+{
+  NS_LOG_FUNCTION (this << sinr.size ());
+  const std::size_t numRbs = model->GetNumBands ();
+  NS_ASSERT_MSG (numRbs > 0 && sinr.size () % numRbs == 0,
+                 "The SINR values are not a multiple of the " << numRbs << " bands");
+
+  const std::size_t numVectors = sinr.size () / numRbs;
+  cqi.resize (numVectors);
+  mcs.resize (numVectors);
+  for (std::size_t v = 0; v < numVectors; v++)
+    {
+      cqi[v] = DoCreateCqiFeedbackWbTdma (model, sinr.data () + v * numRbs, mcs[v]);
+    }
+}
 
-  //std::vector<int> cqi;
+uint8_t
+NrAmc::DoCreateCqiFeedbackWbTdma (const Ptr<const SpectrumModel> &model, const double *sinr,
+                                  uint8_t &mcs) const
+{
+  // produces a single CQI/MCS value
+  const std::size_t numRbs = model->GetNumBands ();
   uint8_t cqi = 0;
-  double seAvg = 0;
-  double mcsAvg = 0;
-  double cqiAvg = 0;
 
-  Values::const_iterator it;
   if (m_amcModel == ShannonModel)
     {
       //use shannon model
       double m_ber = GetBer();   // Shannon based model reference BER
+      double gap = (-std::log (5.0 * m_ber )) / 1.5;
+      double seAvg = 0;
       uint32_t rbNum = 0;
-      for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
+      for (std::size_t i = 0; i < numRbs; i++)
         {
-          double sinr_ = (*it);
+          double sinr_ = sinr[i];
           if (sinr_ == 0.0)
             {
-              //cqi.push_back (-1); // SINR == 0 (linear units) means no signal in this RB
-            }
-          else
-            {
-              /*
-               * Compute the spectral efficiency from the SINR
-               *                                        SINR
-               * spectralEfficiency = log2 (1 + -------------------- )
-               *                                    -ln(5*BER)/1.5
-               * NB: SINR must be expressed in linear units
-               */
-
-              double s = log2 ( 1 + ( sinr_ / ( (-std::log (5.0 * m_ber )) / 1.5) ));
-              seAvg += s;
-
-              int cqi_ = GetCqiFromSpectralEfficiency (s);
-              mcsAvg += GetMcsFromSpectralEfficiency (s);
-              cqiAvg += cqi_;
-              rbNum++;
-
-              NS_LOG_LOGIC (" PRB =" << sinr.GetSpectrumModel ()->GetNumBands ()
-                                     << ", sinr = " << sinr_
-                                     << " (=" << 10 * std::log10 (sinr_) << " dB)"
-                                     << ", spectral efficiency =" << s
-                                     << ", CQI = " << cqi_ << ", BER = " << m_ber);
-              //cqi.push_back (cqi_);
+              continue; // SINR == 0 (linear units) means no signal in this RB
             }
+
+          /*
+           * Compute the spectral efficiency from the SINR
+           *                                        SINR
+           * spectralEfficiency = log2 (1 + -------------------- )
+           *                                    -ln(5*BER)/1.5
+           * NB: SINR must be expressed in linear units
+           */
+
+          double s = log2 ( 1 + ( sinr_ / gap ));
+          seAvg += s;
+          rbNum++;
+
+          NS_LOG_LOGIC (" PRB =" << i
+                                 << ", sinr = " << sinr_
+                                 << " (=" << 10 * std::log10 (sinr_) << " dB)"
+                                 << ", spectral efficiency =" << s
+                                 << ", BER = " << m_ber);
         }
       if (rbNum != 0)
         {
           seAvg /= rbNum;
-          mcsAvg /= rbNum;
-          cqiAvg /= rbNum;
         }
-      cqi = GetCqiFromSpectralEfficiency (seAvg);   //ceil (cqiAvg);
-      mcs = GetMcsFromSpectralEfficiency (seAvg);   //ceil(mcsAvg);
+      cqi = GetCqiFromSpectralEfficiency (seAvg);
+      mcs = GetMcsFromSpectralEfficiency (seAvg);
     }
   else if (m_amcModel == ErrorModel)
     {
+      // the active RBs, one after another
       std::vector <int> rbMap;
-      int rbId = 0;
-      double sinrAvg = 0;
-      for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
+      m_activeSinr.clear ();
+      for (std::size_t i = 0; i < numRbs; i++)
         {
-          if (*it != 0.0)
+          if (sinr[i] != 0.0)
             {
-              rbMap.push_back (rbId);
-              sinrAvg += *it;
+              rbMap.push_back (static_cast<int> (i));
+              m_activeSinr.push_back (sinr[i]);
             }
-          rbId += 1;
         }
-      sinrAvg /= rbMap.size ();
 
+      // highest MCS whose TBLER is not above the target, and whether the
+      // MCS after it has been found above the target
+      bool aboveTarget = false;
       mcs = 0;
-      Ptr<NrErrorModelOutput> output;
-      while (mcs <= m_errorModel->GetMaxMcs ())
+      if (m_eesmErrorModel != nullptr)
         {
-          output = m_errorModel->GetTbDecodificationStats (sinr, rbMap,
-                                                           CalculateTbSize (mcs, rbMap.size ()),
-                                                           mcs,
-                                                           NrErrorModel::NrErrorModelHistory ());
-          if (output->m_tbler > 0.1)
+          const std::vector<double> &thresholds = GetSinrDbThresholds (m_activeSinr.size ());
+          while (mcs <= m_errorModel->GetMaxMcs ())
             {
-              break;
+              double sinrEff = m_eesmErrorModel->GetFirstTxSinrEff (m_activeSinr.data (),
+                                                                    m_activeSinr.size (), mcs);
+              if (10 * log10 (sinrEff) < thresholds.at (mcs))
+                {
+                  aboveTarget = true;
+                  break;
+                }
+              mcs++;
+            }
+        }
+      else
+        {
+          SpectrumValue sinrValue (model);
+          std::copy (sinr, sinr + numRbs, sinrValue.ValuesBegin ());
+          while (mcs <= m_errorModel->GetMaxMcs ())
+            {
+              Ptr<NrErrorModelOutput> output;
+              output = m_errorModel->GetTbDecodificationStats (sinrValue, rbMap,
+                                                               CalculateTbSize (mcs, rbMap.size ()),
+                                                               mcs,
+                                                               NrErrorModel::NrErrorModelHistory ());
+              if (output->m_tbler > m_cqiTargetBler)
+                {
+                  aboveTarget = true;
+                  break;
+                }
+              mcs++;
             }
-          mcs++;
         }
 
       if (mcs > 0)
@@ -258,7 +296,7 @@ NrAmc::CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t &mcs) const
           mcs--;
         }
 
-      if ((output->m_tbler > 0.1) && (mcs == 0))
+      if (aboveTarget && (mcs == 0))
         {
           cqi = 0;
         }
@@ -280,6 +318,24 @@ NrAmc::CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t &mcs) const
   return cqi;
 }
 
+const std::vector<double> &
+NrAmc::GetSinrDbThresholds (uint32_t numRbs) const
+{
+  auto it = m_sinrDbThresholds.find (numRbs);
+  if (it == m_sinrDbThresholds.end ())
+    {
+      NS_LOG_LOGIC ("Computing the SINR thresholds for " << numRbs << " RBs");
+      std::vector<double> thresholds (m_errorModel->GetMaxMcs () + 1);
+      for (uint8_t mcs = 0; mcs < thresholds.size (); mcs++)
+        {
+          thresholds[mcs] = m_eesmErrorModel->GetSinrDbThreshold (CalculateTbSize (mcs, numRbs) * 8,
+                                                                  mcs, m_cqiTargetBler);
+        }
+      it = m_sinrDbThresholds.emplace (numRbs, std::move (thresholds)).first;
+    }
+  return it->second;
+}
+
 uint8_t
 NrAmc::GetCqiFromSpectralEfficiency (double s) const
 {
@@ -339,6 +395,8 @@ NrAmc::SetErrorModelType (const TypeId &type)
   factory.SetTypeId (m_errorModelType);
   m_errorModel = DynamicCast<NrErrorModel> (factory.Create ());
   NS_ASSERT (m_errorModel != nullptr);
+  m_eesmErrorModel = DynamicCast<NrEesmErrorModel> (m_errorModel);
+  m_sinrDbThresholds.clear ();
 }
 
 TypeId
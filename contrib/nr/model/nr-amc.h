@@ -21,9 +21,13 @@
 
 #include <ns3/nr-phy-mac-common.h>
 #include <ns3/nr-error-model.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 
+class NrEesmErrorModel;
+
 /**
  * \ingroup error-models
  * \brief Adaptive Modulation and Coding class for the NR module
@@ -135,6 +139,26 @@ public:
    */
   uint8_t CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t &mcsWb) const;
 
+  /**
+   * \brief Create the CQI/MCS wideband feedback of several SINR vectors at once
+   *
+   * The SINR vectors (e.g., of different UEs) have the same spectrum model
+   * and are stored one after another, so that the averages and the effective
+   * SINRs are computed on a contiguous array. With an EESM error model, the
+   * highest MCS that meets the target BLER is found by comparing the
+   * effective SINR with a table of thresholds per MCS, built once for each
+   * number of active RBs, instead of querying the error model for each MCS.
+   * The result for each vector is the same of
+   * CreateCqiFeedbackWbTdma (const SpectrumValue&, uint8_t&).
+   *
+   * \param model the spectrum model of the SINR vectors
+   * \param sinr the sinr values, model->GetNumBands () for each vector
+   * \param cqi the calculated CQI of each vector
+   * \param mcsWb the calculated MCS of each vector
+   */
+  void CreateCqiFeedbackWbTdma (const Ptr<const SpectrumModel> &model, const std::vector<double> &sinr,
+                                std::vector<uint8_t> &cqi, std::vector<uint8_t> &mcsWb) const;
+
   /**
    * \brief Get CQI from a SpectralEfficiency value
    * \param s spectral efficiency
@@ -203,6 +227,24 @@ private:
    */
   double GetBer () const;
 
+  /**
+   * \brief Create a CQI/MCS wideband feedback from contiguous SINR values
+   * \param model the spectrum model of the SINR values
+   * \param sinr the sinr values, model->GetNumBands () of them
+   * \param mcsWb The calculated MCS
+   * \return The calculated CQI
+   */
+  uint8_t DoCreateCqiFeedbackWbTdma (const Ptr<const SpectrumModel> &model, const double *sinr,
+                                     uint8_t &mcsWb) const;
+
+  /**
+   * \brief Get the effective SINR threshold (in dB) of each MCS to meet the
+   * target BLER of the CQI feedback, with an EESM error model
+   * \param numRbs the number of active RBs
+   * \return the thresholds, indexed by MCS
+   */
+  const std::vector<double> & GetSinrDbThresholds (uint32_t numRbs) const;
+
 private:
   AmcModel m_amcModel;             //!< Type of the CQI feedback model
   Ptr<NrErrorModel> m_errorModel;  //!< Pointer to an instance of ErrorModel
@@ -210,6 +252,10 @@ private:
   uint8_t m_numRefScPerRb {1};     //!< number of reference subcarriers per RB
   NrErrorModel::Mode m_emMode {NrErrorModel::DL}; //!< Error model mode
   static const unsigned int m_crcLen = 24 / 8; //!< CRC length (in bytes)
+  static constexpr double m_cqiTargetBler = 0.1; //!< Target TBLER of the MCS in the CQI feedback
+  Ptr<NrEesmErrorModel> m_eesmErrorModel; //!< The error model, if it is an EESM model
+  mutable std::unordered_map<uint32_t, std::vector<double> > m_sinrDbThresholds; //!< Thresholds per MCS, per number of active RBs
+  mutable std::vector<double> m_activeSinr; //!< SINR of the active RBs, reused across the feedbacks
 };
 
 } // end namespace ns3
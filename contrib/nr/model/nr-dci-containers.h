@@ -0,0 +1,572 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2019 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NR_DCI_CONTAINERS_H
+#define NR_DCI_CONTAINERS_H
+
+#include <ns3/abort.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup utils
+ * \brief A vector with one element per stream, stored inline
+ *
+ * The DCI carries some values (MCS, TBS, NDI, RV) for each stream. As the
+ * number of streams is small and bounded, they are stored in a fixed-size
+ * array, so that creating or copying a DCI does not allocate memory.
+ *
+ * The class offers the subset of the std::vector interface used for the
+ * per-stream values, and converts from and to std::vector.
+ */
+template <typename T>
+class StreamVector
+{
+public:
+  static constexpr std::size_t MAX_STREAMS = 4; //!< Maximum number of elements
+
+  typedef T value_type;              //!< Type of the elements
+  typedef std::size_t size_type;     //!< Type of the size
+  typedef T * iterator;              //!< Iterator
+  typedef const T * const_iterator;  //!< Const iterator
+
+  /**
+   * \brief Build an empty StreamVector
+   */
+  StreamVector () = default;
+
+  /**
+   * \brief Build a StreamVector with n copies of value
+   * \param n number of elements
+   * \param value value of the elements
+   */
+  StreamVector (size_type n, const T &value)
+  {
+    NS_ABORT_MSG_IF (n > MAX_STREAMS, "Too many streams: " << n);
+    m_size = static_cast<uint8_t> (n);
+    std::fill (m_data.begin (), m_data.begin () + n, value);
+  }
+
+  /**
+   * \brief Build a StreamVector from a list of values
+   * \param values the values
+   */
+  StreamVector (std::initializer_list<T> values)
+  {
+    NS_ABORT_MSG_IF (values.size () > MAX_STREAMS, "Too many streams: " << values.size ());
+    m_size = static_cast<uint8_t> (values.size ());
+    std::copy (values.begin (), values.end (), m_data.begin ());
+  }
+
+  /**
+   * \brief Build a StreamVector from a std::vector
+   * \param values the values
+   */
+  StreamVector (const std::vector<T> &values)
+  {
+    NS_ABORT_MSG_IF (values.size () > MAX_STREAMS, "Too many streams: " << values.size ());
+    m_size = static_cast<uint8_t> (values.size ());
+    std::copy (values.begin (), values.end (), m_data.begin ());
+  }
+
+  /**
+   * \return a std::vector with the same values
+   */
+  operator std::vector<T> () const
+  {
+    return std::vector<T> (begin (), end ());
+  }
+
+  /**
+   * \return the number of elements
+   */
+  size_type size () const
+  {
+    return m_size;
+  }
+
+  /**
+   * \return true if there are no elements
+   */
+  bool empty () const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * \brief Append an element
+   * \param value the element
+   */
+  void push_back (const T &value)
+  {
+    NS_ABORT_MSG_IF (m_size == MAX_STREAMS, "Too many streams");
+    m_data[m_size++] = value;
+  }
+
+  /**
+   * \brief Remove all the elements
+   */
+  void clear ()
+  {
+    m_size = 0;
+  }
+
+  /**
+   * \param i index
+   * \return the element at the index i, aborting if it does not exist
+   */
+  T & at (size_type i)
+  {
+    NS_ABORT_MSG_IF (i >= m_size, "Stream index " << i << " out of range " << +m_size);
+    return m_data[i];
+  }
+
+  /**
+   * \param i index
+   * \return the element at the index i, aborting if it does not exist
+   */
+  const T & at (size_type i) const
+  {
+    NS_ABORT_MSG_IF (i >= m_size, "Stream index " << i << " out of range " << +m_size);
+    return m_data[i];
+  }
+
+  /**
+   * \param i index
+   * \return the element at the index i
+   */
+  T & operator [] (size_type i)
+  {
+    return m_data[i];
+  }
+
+  /**
+   * \param i index
+   * \return the element at the index i
+   */
+  const T & operator [] (size_type i) const
+  {
+    return m_data[i];
+  }
+
+  /**
+   * \return the first element
+   */
+  const T & front () const
+  {
+    return at (0);
+  }
+
+  /**
+   * \return the last element
+   */
+  const T & back () const
+  {
+    return at (m_size - 1);
+  }
+
+  iterator begin ()
+  {
+    return m_data.data ();
+  }
+  iterator end ()
+  {
+    return m_data.data () + m_size;
+  }
+  const_iterator begin () const
+  {
+    return m_data.data ();
+  }
+  const_iterator end () const
+  {
+    return m_data.data () + m_size;
+  }
+
+  /**
+   * \param o the other StreamVector
+   * \return true if the two StreamVector have the same elements
+   */
+  bool operator == (const StreamVector &o) const
+  {
+    return m_size == o.m_size && std::equal (begin (), end (), o.begin ());
+  }
+
+  /**
+   * \param o the other StreamVector
+   * \return true if the two StreamVector have different elements
+   */
+  bool operator != (const StreamVector &o) const
+  {
+    return ! (*this == o);
+  }
+
+private:
+  std::array<T, MAX_STREAMS> m_data {}; //!< Elements
+  uint8_t m_size {0};                   //!< Number of elements
+};
+
+/**
+ * \ingroup utils
+ * \brief The RBG bitmask of a DCI, stored as a bitset
+ *
+ * One bit is used for each RBG. Up to INLINE_RBG RBGs the bits are stored
+ * inside the object; with wider bandwidths (or RBGs of a single RB) they are
+ * stored in a std::vector.
+ *
+ * The class offers the subset of the std::vector<uint8_t> interface used
+ * for the RBG bitmask (the values are 0 or 1), and converts from and to
+ * std::vector<uint8_t>. The iterators are read-only and return the values,
+ * while the operator [] and at() return a proxy that can be assigned.
+ */
+class RbgBitmask
+{
+public:
+  static constexpr std::size_t INLINE_RBG = 256; //!< Number of RBGs that do not need allocations
+
+  typedef uint8_t value_type;    //!< Type of the elements
+  typedef std::size_t size_type; //!< Type of the size
+
+  /**
+   * \brief A reference to one RBG of the bitmask
+   */
+  class Reference
+  {
+  public:
+    /**
+     * \brief Reference constructor
+     * \param word the word that contains the bit
+     * \param mask the mask of the bit
+     */
+    Reference (uint64_t *word, uint64_t mask)
+      : m_word (word), m_mask (mask)
+    {
+    }
+
+    /**
+     * \return 1 if the RBG is used, 0 otherwise
+     */
+    operator uint8_t () const
+    {
+      return (*m_word & m_mask) != 0 ? 1 : 0;
+    }
+
+    /**
+     * \brief Set the RBG
+     * \param value 0 if the RBG is not used, 1 (or any other value) otherwise
+     * \return this reference
+     */
+    Reference & operator = (uint8_t value)
+    {
+      if (value != 0)
+        {
+          *m_word |= m_mask;
+        }
+      else
+        {
+          *m_word &= ~m_mask;
+        }
+      return *this;
+    }
+
+    /**
+     * \brief Set the RBG to the value of another RBG
+     * \param o the other RBG
+     * \return this reference
+     */
+    Reference & operator = (const Reference &o)
+    {
+      return *this = static_cast<uint8_t> (o);
+    }
+
+  private:
+    uint64_t *m_word; //!< Word that contains the bit
+    uint64_t m_mask;  //!< Mask of the bit
+  };
+
+  /**
+   * \brief Read-only iterator over the RBGs, returning 0 or 1
+   */
+  class ConstIterator
+  {
+  public:
+    typedef std::input_iterator_tag iterator_category; //!< Category
+    typedef uint8_t value_type;                        //!< Value type
+    typedef std::ptrdiff_t difference_type;            //!< Difference type
+    typedef const uint8_t * pointer;                   //!< Pointer type
+    typedef uint8_t reference;                         //!< Reference type (a value)
+
+    /**
+     * \brief ConstIterator constructor
+     * \param bitmask the bitmask
+     * \param index the position
+     */
+    ConstIterator (const RbgBitmask *bitmask, size_type index)
+      : m_bitmask (bitmask), m_index (index)
+    {
+    }
+
+    uint8_t operator * () const
+    {
+      return (*m_bitmask)[m_index];
+    }
+    ConstIterator & operator ++ ()
+    {
+      ++m_index;
+      return *this;
+    }
+    ConstIterator operator ++ (int)
+    {
+      ConstIterator ret = *this;
+      ++m_index;
+      return ret;
+    }
+    bool operator == (const ConstIterator &o) const
+    {
+      return m_index == o.m_index;
+    }
+    bool operator != (const ConstIterator &o) const
+    {
+      return m_index != o.m_index;
+    }
+
+  private:
+    const RbgBitmask *m_bitmask; //!< Bitmask
+    size_type m_index;           //!< Position
+  };
+
+  typedef ConstIterator const_iterator; //!< Const iterator
+  typedef ConstIterator iterator;       //!< Iterators are read-only
+
+  /**
+   * \brief Build an empty bitmask
+   */
+  RbgBitmask () = default;
+
+  /**
+   * \brief Build a bitmask of n RBGs, all set to value
+   * \param n number of RBGs
+   * \param value the value of all the RBGs
+   */
+  RbgBitmask (size_type n, uint8_t value)
+  {
+    Resize (n);
+    if (value != 0)
+      {
+        uint64_t *words = Words ();
+        for (size_type w = 0; w < NumWords (n); ++w)
+          {
+            words[w] = ~UINT64_C (0);
+          }
+        ClearUnusedBits ();
+      }
+  }
+
+  /**
+   * \brief Build a bitmask from a std::vector of 0 and 1
+   * \param values the RBG values
+   */
+  RbgBitmask (const std::vector<uint8_t> &values)
+  {
+    Resize (values.size ());
+    uint64_t *words = Words ();
+    for (size_type i = 0; i < values.size (); ++i)
+      {
+        if (values[i] != 0)
+          {
+            words[i / 64] |= UINT64_C (1) << (i % 64);
+          }
+      }
+  }
+
+  /**
+   * \return a std::vector of 0 and 1 with the RBG values
+   */
+  operator std::vector<uint8_t> () const
+  {
+    std::vector<uint8_t> ret (m_size, 0);
+    for (size_type i = 0; i < m_size; ++i)
+      {
+        ret[i] = (*this)[i];
+      }
+    return ret;
+  }
+
+  /**
+   * \return the number of RBGs
+   */
+  size_type size () const
+  {
+    return m_size;
+  }
+
+  /**
+   * \return true if the bitmask has no RBGs
+   */
+  bool empty () const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * \param i RBG index
+   * \return 1 if the RBG is used, 0 otherwise
+   */
+  uint8_t operator [] (size_type i) const
+  {
+    return (Words ()[i / 64] >> (i % 64)) & 1;
+  }
+
+  /**
+   * \param i RBG index
+   * \return an assignable reference to the RBG
+   */
+  Reference operator [] (size_type i)
+  {
+    return Reference (&Words ()[i / 64], UINT64_C (1) << (i % 64));
+  }
+
+  /**
+   * \param i RBG index
+   * \return 1 if the RBG is used, 0 otherwise; aborts if i is out of range
+   */
+  uint8_t at (size_type i) const
+  {
+    NS_ABORT_MSG_IF (i >= m_size, "RBG index " << i << " out of range " << m_size);
+    return (*this)[i];
+  }
+
+  /**
+   * \param i RBG index
+   * \return an assignable reference to the RBG; aborts if i is out of range
+   */
+  Reference at (size_type i)
+  {
+    NS_ABORT_MSG_IF (i >= m_size, "RBG index " << i << " out of range " << m_size);
+    return (*this)[i];
+  }
+
+  const_iterator begin () const
+  {
+    return ConstIterator (this, 0);
+  }
+  const_iterator end () const
+  {
+    return ConstIterator (this, m_size);
+  }
+
+  /**
+   * \return the number of RBGs that are used
+   */
+  size_type Count () const
+  {
+    size_type ret = 0;
+    const uint64_t *words = Words ();
+    for (size_type w = 0; w < NumWords (m_size); ++w)
+      {
+        ret += static_cast<size_type> (__builtin_popcountll (words[w]));
+      }
+    return ret;
+  }
+
+  /**
+   * \param o the other bitmask
+   * \return true if the two bitmasks have the same size and values
+   */
+  bool operator == (const RbgBitmask &o) const
+  {
+    if (m_size != o.m_size)
+      {
+        return false;
+      }
+    return std::equal (Words (), Words () + NumWords (m_size), o.Words ());
+  }
+
+  /**
+   * \param o the other bitmask
+   * \return true if the two bitmasks are different
+   */
+  bool operator != (const RbgBitmask &o) const
+  {
+    return ! (*this == o);
+  }
+
+private:
+  /**
+   * \param n number of RBGs
+   * \return the number of words needed to store n RBGs
+   */
+  static size_type NumWords (size_type n)
+  {
+    return (n + 63) / 64;
+  }
+
+  /**
+   * \brief Set the number of RBGs, all cleared
+   * \param n the number of RBGs
+   */
+  void Resize (size_type n)
+  {
+    m_size = n;
+    m_inline.fill (0);
+    if (n > INLINE_RBG)
+      {
+        m_overflow.assign (NumWords (n), 0);
+      }
+    else
+      {
+        m_overflow.clear ();
+      }
+  }
+
+  /**
+   * \brief Clear the bits after the last RBG, so that Count() and the
+   * comparison can work on whole words
+   */
+  void ClearUnusedBits ()
+  {
+    if (m_size % 64 != 0)
+      {
+        Words ()[m_size / 64] &= (UINT64_C (1) << (m_size % 64)) - 1;
+      }
+  }
+
+  uint64_t * Words ()
+  {
+    return m_size > INLINE_RBG ? m_overflow.data () : m_inline.data ();
+  }
+  const uint64_t * Words () const
+  {
+    return m_size > INLINE_RBG ? m_overflow.data () : m_inline.data ();
+  }
+
+  std::array<uint64_t, INLINE_RBG / 64> m_inline {}; //!< Bits, when they fit
+  std::vector<uint64_t> m_overflow;                  //!< Bits, for wide bandwidths
+  size_type m_size {0};                              //!< Number of RBGs
+};
+
+} // namespace ns3
+
+#endif /* NR_DCI_CONTAINERS_H */
@@ -23,6 +23,7 @@
 #include "ns3/log.h"
 #include <cmath>
 #include <algorithm>
+#include <limits>
 #include "ns3/enum.h"
 #include "nr-phy-mac-common.h"
 
@@ -135,7 +136,7 @@ NrEesmErrorModel::MappingSinrBler (double sinr, uint8_t mcs, uint32_t cbSizeBit)
   // Get the index of CBSIZE in the map
   NS_LOG_INFO ("For sinr " << sinr << " and mcs " << +mcs <<
                 " CbSizebit " << cbSizeBit << " we got bg type " << m_bgTypeName[bg_type]);
-  auto cbMap = GetSimulatedBlerFromSINR ()->at (bg_type).at (mcs);
+  const auto &cbMap = GetSimulatedBlerFromSINR ()->at (bg_type).at (mcs);
   auto cbIt = cbMap.upper_bound (cbSizeBit);
 
   if (cbIt != cbMap.begin ())
@@ -416,5 +417,67 @@ NrEesmErrorModel::GetMaxMcs () const
   return static_cast<uint8_t> (GetMcsEcrTable ()->size () - 1);
 }
 
+double
+NrEesmErrorModel::GetFirstTxSinrEff (const double *sinr, std::size_t numRbs, uint8_t mcs) const
+{
+  NS_ABORT_MSG_IF (numRbs == 0,
+                   " Error: number of allocated RBs cannot be 0 - EESM method - SinrEff function");
+
+  // same operations, in the same order, of SinrEff (sinr, map, mcs, 0, map.size ())
+  double beta = GetBetaTable ()->at (mcs);
+  double sinrExpSum = 0.0;
+  for (std::size_t i = 0; i < numRbs; i++)
+    {
+      sinrExpSum += exp (-sinr[i] / beta);
+    }
+  return -beta * log ((0.0 + sinrExpSum) / static_cast<double> (numRbs));
+}
+
+double
+NrEesmErrorModel::GetSinrDbThreshold (uint32_t sizeBit, uint8_t mcs, double targetBler) const
+{
+  NS_LOG_FUNCTION (this << sizeBit << +mcs << targetBler);
+  NS_ABORT_IF (mcs > GetMaxMcs ());
+
+  // same base graph, code block segmentation and BLER curve of
+  // GetTbBitDecodificationStats and MappingSinrBler for a first transmission
+  GraphType bg_type = GetBaseGraphType (sizeBit, mcs);
+  std::pair<uint32_t, uint32_t> cbSeg = CodeBlockSegmentation (sizeBit + 24, bg_type);
+  uint32_t K = cbSeg.first;
+  uint32_t C = cbSeg.second;
+
+  const auto &cbMap = GetSimulatedBlerFromSINR ()->at (bg_type).at (mcs);
+  auto cbIt = cbMap.upper_bound (K);
+  if (cbIt != cbMap.begin ())
+    {
+      cbIt--;
+    }
+  const DoubleVector &sinrDb = std::get<0> (cbIt->second);
+  const DoubleVector &bler = std::get<1> (cbIt->second);
+
+  auto tbler = [C] (double cbler)
+    {
+      return C != 1 ? 1.0 - pow (1.0 - cbler, C) : cbler;
+    };
+
+  // Above the last SINR of the curve the BLER is 0; at each SINR of the curve,
+  // and up to the next one, it is the BLER of that point. Walk back the curve
+  // while the target is met.
+  double threshold = std::nextafter (sinrDb.back (), std::numeric_limits<double>::infinity ());
+  std::size_t k = sinrDb.size ();
+  while (k > 0 && !(tbler (bler.at (k - 1)) > targetBler))
+    {
+      k--;
+      threshold = sinrDb.at (k);
+    }
+  NS_ASSERT_MSG (std::none_of (bler.begin (), bler.begin () + k,
+                               [&tbler, targetBler] (double b) { return !(tbler (b) > targetBler); }),
+                 "The BLER curve of MCS " << +mcs << " increases with the SINR");
+
+  NS_LOG_LOGIC ("TBS " << sizeBit << " MCS " << +mcs << " needs an effective SINR of " <<
+                threshold << " dB");
+  return threshold;
+}
+
 } // namespace ns3
 
@@ -160,6 +160,37 @@ public:
   */
   virtual uint8_t GetMaxMcs () const override;
 
+  /**
+   * \brief Get the effective SINR of the first transmission of a TB, when the
+   * SINR of the active RBs are contiguous in memory
+   *
+   * It is the effective SINR that GetTbDecodificationStats computes when there
+   * is no history, with the SINR of the RBs of the map given one after another.
+   *
+   * \param sinr the SINR of the active RBs (linear)
+   * \param numRbs the number of active RBs
+   * \param mcs the MCS of the TB
+   * \return the effective SINR (linear)
+   */
+  double GetFirstTxSinrEff (const double *sinr, std::size_t numRbs, uint8_t mcs) const;
+
+  /**
+   * \brief Get the lowest effective SINR for which the first transmission of
+   * a TB has a TBLER not above a target
+   *
+   * The simulated BLER curves do not increase with the SINR: a first
+   * transmission of a TB with this size and MCS has a TBLER not above
+   * the target if and only if 10 * log10 of its effective SINR is not below
+   * the returned value. With the threshold, the highest MCS that meets the
+   * target is found without mapping the SINR to the BLER of each MCS.
+   *
+   * \param sizeBit the TB size in bits
+   * \param mcs the MCS of the TB
+   * \param targetBler the target TBLER
+   * \return the threshold of the effective SINR, in dB
+   */
+  double GetSinrDbThreshold (uint32_t sizeBit, uint8_t mcs, double targetBler) const;
+
   typedef std::vector<double> DoubleVector;
   typedef std::tuple<DoubleVector, DoubleVector> DoubleTuple;
   typedef std::vector<std::vector<std::map<uint32_t, DoubleTuple> > > SimulatedBlerFromSINR;
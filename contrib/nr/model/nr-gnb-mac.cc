@@ -51,10 +51,6 @@ NS_OBJECT_ENSURE_REGISTERED (NrGnbMac);
 // member SAP forwarders
 // //////////////////////////////////////
 
-std::vector<uint64_t> m_scheduledAgeValues; // 스케줄링 후 계산된 UE의 Age를 저장하는 벡터
-std::unordered_map<uint16_t, uint64_t> m_packetCreationTimeMap;
-std::unordered_map<uint16_t, uint64_t> m_packetReceiveTimeMap;
-
 class NrGnbMacMemberEnbCmacSapProvider : public LteEnbCmacSapProvider
 {
 public:
@@ -350,6 +346,11 @@ private:
   NrGnbMac *m_mac;
 };
 
+NrMacMemberMacCschedSapUser::NrMacMemberMacCschedSapUser (NrGnbMac *mac)
+  : m_mac (mac)
+{
+}
+
 void
 NrMacMemberMacCschedSapUser::CschedCellConfigCnf (
     const struct CschedCellConfigCnfParameters &params)
@@ -664,14 +665,10 @@ NrGnbMac::DoSlotUlIndication (const SfnSf &sfnSf, LteNrTddSlotType type)
 
   if (m_cgScheduling)
     {
-      static bool cgr_configuration = false;
-      static SfnSf m_cgr_configuration = SfnSf (0, 0, 0, sfnSf.GetNumerology ());
-      static uint8_t posCG = 0;
-
       uint8_t numberOfSlot_insideOneSubframe = pow (2, (sfnSf.GetNumerology ()));
 
       // Send CGR info to the scheduler in order to allocate resources:
-      if (!cgr_configuration || m_currentSlot < m_cgr_configuration)
+      if (!m_cgrConfigured || m_currentSlot < m_cgrConfigurationSlot)
         {
           for (const auto &v : m_srRntiList)
             {
@@ -681,56 +678,56 @@ NrGnbMac::DoSlotUlIndication (const SfnSf &sfnSf, LteNrTddSlotType type)
                   number_slots_for_processing_configurationPeriod;
               if (v != 0)
                 {
-                  if (!cgr_configuration)
+                  if (!m_cgrConfigured)
                     {
                       // We calculate from how many slots on
                       // the transmissions will be done using only the pre-allocated resources
-                      cgr_configuration = true;
-                      m_cgr_configuration = m_currentSlot;
-                      m_cgr_configuration.Add (number_slots_configuration);
-                      paramsCG_rntiSlot[posCG].m_snfSf = m_cgr_configuration;
+                      m_cgrConfigured = true;
+                      m_cgrConfigurationSlot = m_currentSlot;
+                      m_cgrConfigurationSlot.Add (number_slots_configuration);
+                      paramsCG_rntiSlot[m_posCG].m_snfSf = m_cgrConfigurationSlot;
                     }
                   else
                     {
-                      posCG++;
+                      m_posCG++;
                       m_cgrNextTxSlot = m_currentSlot;
                       m_cgrNextTxSlot.Add (number_slots_configuration);
-                      paramsCG_rntiSlot[posCG].m_snfSf = m_cgrNextTxSlot;
+                      paramsCG_rntiSlot[m_posCG].m_snfSf = m_cgrNextTxSlot;
                     }
-                  paramsCG_rntiSlot[posCG].m_srList.insert (
-                      paramsCG_rntiSlot[posCG].m_srList.begin (), m_srRntiList.begin (),
+                  paramsCG_rntiSlot[m_posCG].m_srList.insert (
+                      paramsCG_rntiSlot[m_posCG].m_srList.begin (), m_srRntiList.begin (),
                       m_srRntiList.end ());
-                  paramsCG_rntiSlot[posCG].m_bufCgr.insert (
-                      paramsCG_rntiSlot[posCG].m_bufCgr.begin (), m_cgrBufSizeList.begin (),
+                  paramsCG_rntiSlot[m_posCG].m_bufCgr.insert (
+                      paramsCG_rntiSlot[m_posCG].m_bufCgr.begin (), m_cgrBufSizeList.begin (),
                       m_cgrBufSizeList.end ());
-                  paramsCG_rntiSlot[posCG].m_TraffPCgr.insert (
-                      paramsCG_rntiSlot[posCG].m_TraffPCgr.begin (), m_cgrTraffP.begin (),
+                  paramsCG_rntiSlot[m_posCG].m_TraffPCgr.insert (
+                      paramsCG_rntiSlot[m_posCG].m_TraffPCgr.begin (), m_cgrTraffP.begin (),
                       m_cgrTraffP.end ());
-                  paramsCG_rntiSlot[posCG].lcid = lcid_configuredGrant;
-                  paramsCG_rntiSlot[posCG].m_TraffInitCgr.insert (
-                      paramsCG_rntiSlot[posCG].m_TraffInitCgr.begin (), m_cgrTraffInit.begin (),
+                  paramsCG_rntiSlot[m_posCG].lcid = lcid_configuredGrant;
+                  paramsCG_rntiSlot[m_posCG].m_TraffInitCgr.insert (
+                      paramsCG_rntiSlot[m_posCG].m_TraffInitCgr.begin (), m_cgrTraffInit.begin (),
                       m_cgrTraffInit.end ());
-                  paramsCG_rntiSlot[posCG].m_TraffDeadlineCgr.insert (
-                      paramsCG_rntiSlot[posCG].m_TraffDeadlineCgr.begin (),
+                  paramsCG_rntiSlot[m_posCG].m_TraffDeadlineCgr.insert (
+                      paramsCG_rntiSlot[m_posCG].m_TraffDeadlineCgr.begin (),
                       m_cgrTraffDeadline.begin (), m_cgrTraffDeadline.end ());
-                  countCG_slots = posCG;
+                  countCG_slots = m_posCG;
                   break;
                 }
             }
         }
       else
         {
-          posCG = 0;
-          while (posCG <= countCG_slots)
+          m_posCG = 0;
+          while (m_posCG <= countCG_slots)
             {
-              if (paramsCG_rntiSlot[posCG].m_snfSf == m_currentSlot)
+              if (paramsCG_rntiSlot[m_posCG].m_snfSf == m_currentSlot)
                 {
-                  auto rntiIt = paramsCG_rntiSlot[posCG].m_srList.begin ();
-                  auto bufIt = paramsCG_rntiSlot[posCG].m_bufCgr.begin ();
-                  auto traffPIt = paramsCG_rntiSlot[posCG].m_TraffPCgr.begin ();
-                  auto traffInitIt = paramsCG_rntiSlot[posCG].m_TraffInitCgr.begin ();
-                  auto traffDeadlineIt = paramsCG_rntiSlot[posCG].m_TraffDeadlineCgr.begin ();
-                  while (rntiIt != paramsCG_rntiSlot[posCG].m_srList.end ())
+                  auto rntiIt = paramsCG_rntiSlot[m_posCG].m_srList.begin ();
+                  auto bufIt = paramsCG_rntiSlot[m_posCG].m_bufCgr.begin ();
+                  auto traffPIt = paramsCG_rntiSlot[m_posCG].m_TraffPCgr.begin ();
+                  auto traffInitIt = paramsCG_rntiSlot[m_posCG].m_TraffInitCgr.begin ();
+                  auto traffDeadlineIt = paramsCG_rntiSlot[m_posCG].m_TraffDeadlineCgr.begin ();
+                  while (rntiIt != paramsCG_rntiSlot[m_posCG].m_srList.end ())
                     {
                       m_ccmMacSapUser->UlReceiveCgr (*rntiIt, componentCarrierId_configuredGrant,
                                                      *bufIt, lcid_configuredGrant, *traffPIt,
@@ -739,15 +736,15 @@ NrGnbMac::DoSlotUlIndication (const SfnSf &sfnSf, LteNrTddSlotType type)
                       uint8_t number_slots_configurateGrantPeriod =
                           *traffPIt * numberOfSlot_insideOneSubframe;
                       m_cgrNextTxSlot.Add (number_slots_configurateGrantPeriod);
-                      paramsCG_rntiSlot[posCG].m_snfSf = m_cgrNextTxSlot;
+                      paramsCG_rntiSlot[m_posCG].m_snfSf = m_cgrNextTxSlot;
                       rntiIt++;
                       bufIt++;
                       traffPIt++;
                     }
-                  posCG = 0;
+                  m_posCG = 0;
                   break;
                 }
-              posCG++;
+              m_posCG++;
             }
         }
 
@@ -1243,13 +1240,16 @@ NrGnbMac::DoSchedConfigIndication (NrMacSchedSapUser::SchedConfigIndParameters i
 
   SendRar (ind.m_buildRarList);
 
+#ifndef NR_DISABLE_STATISTICS
   m_scheduledAgeValues.clear (); // 스케줄링 후 계산된 각 UE의 Age를 계산하는 벡터를 초기화
+#endif
 
   // for 문 시작
   for (unsigned islot = 0; islot < ind.m_slotAllocInfo.m_varTtiAllocInfo.size (); islot++)
     {
       VarTtiAllocInfo &varTtiAllocInfo = ind.m_slotAllocInfo.m_varTtiAllocInfo[islot];
 
+#ifndef NR_DISABLE_STATISTICS
       uint16_t rnti = varTtiAllocInfo.m_dci->m_rnti; // dci 메시지 전달대상인 UE의 rnti 불러오기
 
       // 스케줄링 수행 gNB MAC 계층에 데이터 패킷이 ?
@@ -1271,6 +1271,7 @@ NrGnbMac::DoSchedConfigIndication (NrMacSchedSapUser::SchedConfigIndParameters i
           // 스케줄링된 Age 값을 벡터에 추가
           m_scheduledAgeValues.push_back (aoi);
         }
+#endif
 
       if (varTtiAllocInfo.m_dci->m_type != DciInfoElementTdma::CTRL &&
           varTtiAllocInfo.m_dci->m_format == DciInfoElementTdma::DL)
@@ -1369,25 +1370,30 @@ NrGnbMac::DoSchedConfigIndication (NrMacSchedSapUser::SchedConfigIndParameters i
               m_macPduMap.erase (mapRet.first); // delete map entry
             }
 
-          for (uint8_t stream = 0; stream < dciElem->m_tbSize.size (); stream++)
+#ifndef NR_DISABLE_STATISTICS
+          if (!m_dlScheduling.IsEmpty ())
             {
-              NrSchedulingCallbackInfo traceInfo;
-              traceInfo.m_frameNum = ind.m_sfnSf.GetFrame ();
-              traceInfo.m_subframeNum = ind.m_sfnSf.GetSubframe ();
-              traceInfo.m_slotNum = ind.m_sfnSf.GetSlot ();
-              traceInfo.m_symStart = dciElem->m_symStart;
-              traceInfo.m_numSym = dciElem->m_numSym;
-              traceInfo.m_streamId = stream;
-              traceInfo.m_tbSize = dciElem->m_tbSize.at (stream);
-              traceInfo.m_mcs = dciElem->m_mcs.at (stream);
-              traceInfo.m_rnti = dciElem->m_rnti;
-              traceInfo.m_bwpId = GetBwpId ();
-              traceInfo.m_ndi = dciElem->m_ndi.at (stream);
-              traceInfo.m_rv = dciElem->m_rv.at (stream);
-              traceInfo.m_harqId = dciElem->m_harqProcess;
-
-              m_dlScheduling (traceInfo);
+              for (uint8_t stream = 0; stream < dciElem->m_tbSize.size (); stream++)
+                {
+                  NrSchedulingCallbackInfo traceInfo;
+                  traceInfo.m_frameNum = ind.m_sfnSf.GetFrame ();
+                  traceInfo.m_subframeNum = ind.m_sfnSf.GetSubframe ();
+                  traceInfo.m_slotNum = ind.m_sfnSf.GetSlot ();
+                  traceInfo.m_symStart = dciElem->m_symStart;
+                  traceInfo.m_numSym = dciElem->m_numSym;
+                  traceInfo.m_streamId = stream;
+                  traceInfo.m_tbSize = dciElem->m_tbSize.at (stream);
+                  traceInfo.m_mcs = dciElem->m_mcs.at (stream);
+                  traceInfo.m_rnti = dciElem->m_rnti;
+                  traceInfo.m_bwpId = GetBwpId ();
+                  traceInfo.m_ndi = dciElem->m_ndi.at (stream);
+                  traceInfo.m_rv = dciElem->m_rv.at (stream);
+                  traceInfo.m_harqId = dciElem->m_harqProcess;
+
+                  m_dlScheduling (traceInfo);
+                }
             }
+#endif
         }
       else if (varTtiAllocInfo.m_dci->m_type != DciInfoElementTdma::CTRL &&
                varTtiAllocInfo.m_dci->m_type != DciInfoElementTdma::SRS &&
@@ -1395,29 +1401,35 @@ NrGnbMac::DoSchedConfigIndication (NrMacSchedSapUser::SchedConfigIndParameters i
         {
           //UL scheduling info trace
           // Call RLC entities to generate RLC PDUs
-          auto dciElem = varTtiAllocInfo.m_dci;
-          for (uint8_t stream = 0; stream < dciElem->m_tbSize.size (); stream++)
+#ifndef NR_DISABLE_STATISTICS
+          if (!m_ulScheduling.IsEmpty ())
             {
-              NrSchedulingCallbackInfo traceInfo;
-              traceInfo.m_frameNum = ind.m_sfnSf.GetFrame ();
-              traceInfo.m_subframeNum = ind.m_sfnSf.GetSubframe ();
-              traceInfo.m_slotNum = ind.m_sfnSf.GetSlot ();
-              traceInfo.m_symStart = dciElem->m_symStart;
-              traceInfo.m_numSym = dciElem->m_numSym;
-              traceInfo.m_streamId = stream;
-              traceInfo.m_tbSize = dciElem->m_tbSize.at (stream);
-              traceInfo.m_mcs = dciElem->m_mcs.at (stream);
-              traceInfo.m_rnti = dciElem->m_rnti;
-              traceInfo.m_bwpId = GetBwpId ();
-              traceInfo.m_ndi = dciElem->m_ndi.at (stream);
-              traceInfo.m_rv = dciElem->m_rv.at (stream);
-              traceInfo.m_harqId = dciElem->m_harqProcess;
-
-              m_ulScheduling (traceInfo);
+              auto dciElem = varTtiAllocInfo.m_dci;
+              for (uint8_t stream = 0; stream < dciElem->m_tbSize.size (); stream++)
+                {
+                  NrSchedulingCallbackInfo traceInfo;
+                  traceInfo.m_frameNum = ind.m_sfnSf.GetFrame ();
+                  traceInfo.m_subframeNum = ind.m_sfnSf.GetSubframe ();
+                  traceInfo.m_slotNum = ind.m_sfnSf.GetSlot ();
+                  traceInfo.m_symStart = dciElem->m_symStart;
+                  traceInfo.m_numSym = dciElem->m_numSym;
+                  traceInfo.m_streamId = stream;
+                  traceInfo.m_tbSize = dciElem->m_tbSize.at (stream);
+                  traceInfo.m_mcs = dciElem->m_mcs.at (stream);
+                  traceInfo.m_rnti = dciElem->m_rnti;
+                  traceInfo.m_bwpId = GetBwpId ();
+                  traceInfo.m_ndi = dciElem->m_ndi.at (stream);
+                  traceInfo.m_rv = dciElem->m_rv.at (stream);
+                  traceInfo.m_harqId = dciElem->m_harqProcess;
+
+                  m_ulScheduling (traceInfo);
+                }
             }
+#endif
         }
     }
   // for문 끝
+#ifndef NR_DISABLE_STATISTICS
   // 여기서 스케줄링 후 평균 Age 출력
   if (!m_scheduledAgeValues.empty ())
     {
@@ -1426,6 +1438,7 @@ NrGnbMac::DoSchedConfigIndication (NrMacSchedSapUser::SchedConfigIndParameters i
       uint64_t avgAge = sumAge / m_scheduledAgeValues.size ();
       NS_LOG_INFO ("\n스케줄링 후 평균 Age 값 : " << avgAge);
     }
+#endif
 }
 
 // ////////////////////////////////////////////
@@ -1506,9 +1519,9 @@ NrGnbMac::GetDlCtrlDci () const
   NS_ASSERT (bwInRbg > 0);
   std::vector<uint8_t> rbgBitmask (bwInRbg, 1);
 
-  return std::make_shared<DciInfoElementTdma> (0, m_macSchedSapProvider->GetDlCtrlSyms (),
-                                               DciInfoElementTdma::DL, DciInfoElementTdma::CTRL,
-                                               rbgBitmask);
+  return CreatePooledDci (0, m_macSchedSapProvider->GetDlCtrlSyms (),
+                          DciInfoElementTdma::DL, DciInfoElementTdma::CTRL,
+                          rbgBitmask);
 }
 
 std::shared_ptr<DciInfoElementTdma>
@@ -1519,9 +1532,9 @@ NrGnbMac::GetUlCtrlDci () const // 업링크 dci를 반환하는 함수
   NS_ASSERT (m_bandwidthInRbg > 0);
   std::vector<uint8_t> rbgBitmask (m_bandwidthInRbg, 1);
 
-  return std::make_shared<DciInfoElementTdma> (0, m_macSchedSapProvider->GetUlCtrlSyms (),
-                                               DciInfoElementTdma::UL, DciInfoElementTdma::CTRL,
-                                               rbgBitmask);
+  return CreatePooledDci (0, m_macSchedSapProvider->GetUlCtrlSyms (),
+                          DciInfoElementTdma::UL, DciInfoElementTdma::CTRL,
+                          rbgBitmask);
 }
 
 void
@@ -40,10 +40,6 @@ namespace ns3 {
 class NrControlMessage;
 class NrRarMessage;
 class BeamConfId;
-extern std::unordered_map<uint16_t, uint64_t>
-    m_packetCreationTimeMap; // RNTI와 패킷 생성 시간을 저장할 맵
-extern std::vector<uint64_t> m_scheduledAgeValues; // 스케줄링 나이를 계산
-extern std::unordered_map<uint16_t, uint64_t> m_packetReceiveTimeMap;
 
 /**
  * \ingroup gnb-mac
@@ -452,6 +448,17 @@ private:
   std::list<Time> m_cgrTraffDeadline;
   SfnSf m_cgrNextTxSlot;
   uint8_t countCG_slots = 0;
+  // Per-instance, so that the CG state of a simulation does not leak into
+  // the next one in the same process
+  bool m_cgrConfigured {false};   //!< True once the first CGR has been stored
+  SfnSf m_cgrConfigurationSlot;   //!< Slot from which only the pre-allocated resources are used
+  uint8_t m_posCG {0};            //!< Current position in paramsCG_rntiSlot
+
+  // Age of information. Per-instance, as the gNBs of different cells may
+  // run in different threads with the MultithreadedSimulatorImpl
+  std::unordered_map<uint16_t, uint64_t> m_packetCreationTimeMap; //!< Age (ns) of the last packet received from each RNTI
+  std::unordered_map<uint16_t, uint64_t> m_packetReceiveTimeMap;  //!< Reception time (ns) of the last packet of each RNTI
+  std::vector<uint64_t> m_scheduledAgeValues;                     //!< AoI (ns) of the UEs scheduled in the slot
 };
 uint64_t CalculateAgeForRnti (uint16_t rnti); // Age 계산 함수 선언
 } // namespace ns3
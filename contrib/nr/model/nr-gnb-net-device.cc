@@ -132,6 +132,16 @@ NrGnbNetDevice::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
 
+  auto & registry = GetBwpIdRegistry ();
+  for (const auto &it: m_ccMap)
+    {
+      auto entry = registry.find (it.second->GetCellId ());
+      if (entry != registry.end () && entry->second == this)
+        {
+          registry.erase (entry);
+        }
+    }
+
   m_rrc->Dispose ();
   m_rrc = nullptr;
   for (const auto &it: m_ccMap)
@@ -197,6 +207,34 @@ NrGnbNetDevice::GetBwpId (uint8_t index) const
   return m_ccMap.at(index)->GetCellId ();
 }
 
+std::unordered_map<uint16_t, NrGnbNetDevice *> &
+NrGnbNetDevice::GetBwpIdRegistry ()
+{
+  static std::unordered_map<uint16_t, NrGnbNetDevice *> registry;
+  return registry;
+}
+
+void
+NrGnbNetDevice::RegisterBwpId (uint16_t bwpId, const Ptr<NrGnbNetDevice> &gnb)
+{
+  NS_LOG_FUNCTION (bwpId << gnb);
+  // A raw pointer, otherwise the registry would keep the device alive
+  // after Simulator::Destroy; DoDispose removes it.
+  GetBwpIdRegistry ()[bwpId] = PeekPointer (gnb);
+}
+
+Ptr<NrGnbNetDevice>
+NrGnbNetDevice::GetGnbByBwpId (uint16_t bwpId)
+{
+  const auto & registry = GetBwpIdRegistry ();
+  auto it = registry.find (bwpId);
+  if (it == registry.end ())
+    {
+      return nullptr;
+    }
+  return it->second;
+}
+
 uint16_t
 NrGnbNetDevice::GetEarfcn (uint8_t index) const
 {
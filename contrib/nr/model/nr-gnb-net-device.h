@@ -22,6 +22,8 @@
 
 #include "nr-net-device.h"
 
+#include <unordered_map>
+
 namespace ns3 {
 
 class Packet;
@@ -112,6 +114,25 @@ public:
    */
   void UpdateConfig ();
 
+  /**
+   * \brief Register the gNB that serves a BWP (cell) id
+   *
+   * The registry allows the ideal RRC protocol to find the peer gNB of a UE
+   * without walking the NodeList. The entries of a gNB are removed when the
+   * gNB is disposed.
+   *
+   * \param bwpId the BWP id, as returned by GetBwpId()
+   * \param gnb the gNB device
+   */
+  static void RegisterBwpId (uint16_t bwpId, const Ptr<NrGnbNetDevice> &gnb);
+
+  /**
+   * \brief Get the gNB that serves a BWP (cell) id
+   * \param bwpId the BWP id
+   * \return the gNB registered with RegisterBwpId(), or nullptr
+   */
+  static Ptr<NrGnbNetDevice> GetGnbByBwpId (uint16_t bwpId);
+
 protected:
   virtual void DoInitialize (void);
 
@@ -127,6 +148,11 @@ private:
 
   Ptr<LteEnbComponentCarrierManager> m_componentCarrierManager; ///< the component carrier manager of this eNb
 
+  /**
+   * \return the registry of the gNBs, indexed by BWP id
+   */
+  static std::unordered_map<uint16_t, NrGnbNetDevice *> & GetBwpIdRegistry ();
+
 };
 
 }
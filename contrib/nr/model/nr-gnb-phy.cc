@@ -475,17 +475,49 @@ NrGnbPhy::SetTddPattern (const std::vector<LteNrTddSlotType> &pattern)
 
   m_tddPattern = pattern;
 
-  m_generateDl.clear ();
-  m_generateUl.clear ();
-  m_toSendDl.clear ();
-  m_toSendUl.clear ();
-  m_dlHarqfbPosition.clear ();
-
-  GenerateStructuresFromPattern (pattern, &m_toSendDl, &m_toSendUl,
-                                 &m_generateDl, &m_generateUl,
-                                 &m_dlHarqfbPosition, 0,
+  std::map<uint32_t, std::vector<uint32_t>> toSendDl;
+  std::map<uint32_t, std::vector<uint32_t>> toSendUl;
+  std::map<uint32_t, std::vector<uint32_t>> generateDl;
+  std::map<uint32_t, std::vector<uint32_t>> generateUl;
+  std::map<uint32_t, uint32_t> dlHarqfbPosition;
+
+  GenerateStructuresFromPattern (pattern, &toSendDl, &toSendUl,
+                                 &generateDl, &generateUl,
+                                 &dlHarqfbPosition, 0,
                                  GetN2Delay (), GetN1Delay (),
                                  GetL1L2CtrlLatency ());
+
+  // Flatten the structures in a table indexed by the position in the pattern,
+  // resolving also the type of the slots to generate, so that every slot
+  // reads them without searching
+  const uint32_t n = static_cast<uint32_t> (pattern.size ());
+  m_patternSlotInfo.assign (n, PatternSlotInfo ());
+  for (const auto & v : toSendDl)
+    {
+      m_patternSlotInfo.at (v.first).m_toSendDl = v.second;
+    }
+  for (const auto & v : toSendUl)
+    {
+      m_patternSlotInfo.at (v.first).m_toSendUl = v.second;
+    }
+  for (const auto & v : generateDl)
+    {
+      for (const auto & k : v.second)
+        {
+          m_patternSlotInfo.at (v.first).m_generateDl.push_back ({k, pattern[(v.first + k) % n]});
+        }
+    }
+  for (const auto & v : generateUl)
+    {
+      for (const auto & k : v.second)
+        {
+          m_patternSlotInfo.at (v.first).m_generateUl.push_back ({k, pattern[(v.first + k) % n]});
+        }
+    }
+  for (const auto & v : dlHarqfbPosition)
+    {
+      m_patternSlotInfo.at (v.first).m_dlHarqfbPosition = v.second;
+    }
 }
 
 void
@@ -667,40 +699,37 @@ void
 NrGnbPhy::CallMacForSlotIndication (const SfnSf &currentSlot)
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (!m_generateDl.empty() || !m_generateUl.empty());
+  NS_ASSERT (m_patternSlotInfo.size () == m_tddPattern.size ());
 
   m_phySapUser->SetCurrentSfn (currentSlot);
 
   uint64_t currentSlotN = currentSlot.Normalize () % m_tddPattern.size ();
+  const PatternSlotInfo &slotInfo = m_patternSlotInfo[currentSlotN];
 
   NS_LOG_INFO ("Start Slot " << currentSlot << ". In position " <<
                currentSlotN << " there is a slot of type " <<
                m_tddPattern[currentSlotN]);
 
-  for (const auto & k2WithLatency : m_generateUl[currentSlotN])
+  for (const auto & k2WithLatency : slotInfo.m_generateUl)
     {
       SfnSf targetSlot = currentSlot;
-      targetSlot.Add (k2WithLatency);
-
-      uint64_t pos = targetSlot.Normalize () % m_tddPattern.size ();
+      targetSlot.Add (k2WithLatency.m_k);
 
       NS_LOG_INFO (" in slot " << currentSlot << " generate UL for " <<
-                     targetSlot << " which is of type " << m_tddPattern[pos]);
+                     targetSlot << " which is of type " << k2WithLatency.m_type);
 
-      m_phySapUser->SlotUlIndication (targetSlot, m_tddPattern[pos]);
+      m_phySapUser->SlotUlIndication (targetSlot, k2WithLatency.m_type);
     }
 
-  for (const auto & k0WithLatency : m_generateDl[currentSlotN])
+  for (const auto & k0WithLatency : slotInfo.m_generateDl)
     {
       SfnSf targetSlot = currentSlot;
-      targetSlot.Add (k0WithLatency);
-
-      uint64_t pos = targetSlot.Normalize () % m_tddPattern.size ();
+      targetSlot.Add (k0WithLatency.m_k);
 
       NS_LOG_INFO (" in slot " << currentSlot << " generate DL for " <<
-                     targetSlot << " which is of type " << m_tddPattern[pos]);
+                     targetSlot << " which is of type " << k0WithLatency.m_type);
 
-      m_phySapUser->SlotDlIndication (targetSlot, m_tddPattern[pos]);
+      m_phySapUser->SlotDlIndication (targetSlot, k0WithLatency.m_type);
     }
 }
 
@@ -903,6 +932,10 @@ void
 NrGnbPhy::GenerateAllocationStatistics (const SlotAllocInfo &allocInfo) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_phySlotDataStats.IsEmpty () && m_phySlotCtrlStats.IsEmpty ())
+    {
+      return;
+    }
   std::unordered_set<uint16_t> activeUe;
   uint32_t availRb = GetRbNum ();
   uint32_t dataReg = 0;
@@ -915,8 +948,7 @@ NrGnbPhy::GenerateAllocationStatistics (const SlotAllocInfo &allocInfo) const
 
   for (const auto & allocation : allocInfo.m_varTtiAllocInfo)
     {
-      uint32_t rbg = std::count (allocation.m_dci->m_rbgBitmask.begin (),
-                                 allocation.m_dci->m_rbgBitmask.end (), 1);
+      uint32_t rbg = allocation.m_dci->m_rbgBitmask.Count ();
 
       // First: Store the RNTI of the UE in the active list
       if (allocation.m_dci->m_rnti != 0)
@@ -981,7 +1013,9 @@ NrGnbPhy::DoStartSlot ()
 
   NS_LOG_DEBUG ("Start Slot " << m_currentSlot << " of type " << m_tddPattern[currentSlotN]);
 
+#ifndef NR_DISABLE_STATISTICS
   GenerateAllocationStatistics (m_currSlotAllocInfo);
+#endif
 
   if (m_currSlotAllocInfo.m_varTtiAllocInfo.size () == 0)
     {
@@ -1007,6 +1041,12 @@ NrGnbPhy::PrepareRbgAllocationMap (const std::deque<VarTtiAllocInfo> &allocation
   // Start with a clean RBG allocation bitmask
   m_rbgAllocationPerSym.clear ();
 
+#ifndef NR_DISABLE_STATISTICS
+  const bool rbStatistics = !m_rbStatistics.IsEmpty ();
+#else
+  const bool rbStatistics = false;
+#endif
+
   // Create RBG map to know where to put power in DL
   for (const auto & allocation : allocations)
     {
@@ -1020,10 +1060,18 @@ NrGnbPhy::PrepareRbgAllocationMap (const std::deque<VarTtiAllocInfo> &allocation
             }
 
           // For statistics, store UL/DL allocations
-          StoreRBGAllocation (&m_rbgAllocationPerSymDataStat, allocation.m_dci);
+          if (rbStatistics)
+            {
+              StoreRBGAllocation (&m_rbgAllocationPerSymDataStat, allocation.m_dci);
+            }
         }
     }
 
+  if (!rbStatistics)
+    {
+      return;
+    }
+
   for (const auto & s : m_rbgAllocationPerSymDataStat)
     {
       auto & rbgAllocation = s.second;
@@ -1148,11 +1196,12 @@ NrGnbPhy::RetrieveMsgsFromDCIs (const SfnSf &currentSlot)
 {
   std::list <Ptr<NrControlMessage> > ctrlMsgs;
   uint64_t currentSlotN = currentSlot.Normalize () % m_tddPattern.size ();
+  const PatternSlotInfo &slotInfo = m_patternSlotInfo[currentSlotN];
 
-  uint32_t k1delay = m_dlHarqfbPosition[currentSlotN];
+  uint32_t k1delay = slotInfo.m_dlHarqfbPosition;
 
   // TODO: copy paste :(
-  for (const auto & k0delay : m_toSendDl[currentSlotN])
+  for (const auto & k0delay : slotInfo.m_toSendDl)
     {
       SfnSf targetSlot = currentSlot;
 
@@ -1179,7 +1228,7 @@ NrGnbPhy::RetrieveMsgsFromDCIs (const SfnSf &currentSlot)
         }
     }
 
-  for (const auto & k2delay : m_toSendUl[currentSlotN])
+  for (const auto & k2delay : slotInfo.m_toSendUl)
     {
       SfnSf targetSlot = currentSlot;
 
@@ -1223,7 +1272,6 @@ NrGnbPhy::DlCtrl (const std::shared_ptr<DciInfoElementTdma> &dci)
 
   // Variable initialization
   uint8_t numberOfSlot_insideOneSubframe = pow(2,GetNumerology ());
-  static SfnSf ulSfnConfigurateGrant = SfnSf (0, 0, 0, GetNumerology ());
 
   if (m_ctrlMsgs.size () > 0)
     {
@@ -1250,13 +1298,13 @@ NrGnbPhy::DlCtrl (const std::shared_ptr<DciInfoElementTdma> &dci)
                             *
                             *
                             * If configuration period is 10ms and numerology is 1 : Number of slots = (10*2)-3-4 = 20-7 = 13 slots*/
-                           ulSfnConfigurateGrant = m_currentSlot;
+                           m_ulSfnConfiguredGrant = m_currentSlot;
                            uint8_t number_slots_for_processing_configurationPeriod = 7;
                            uint8_t number_slots_configuration = (m_configurationTime*numberOfSlot_insideOneSubframe)-number_slots_for_processing_configurationPeriod;
-                           ulSfnConfigurateGrant.Add(number_slots_configuration);
+                           m_ulSfnConfiguredGrant.Add(number_slots_configuration);
                            m_firstPacket_configuredGrant = false;
                          }
-                        if (ulSfnConfigurateGrant<m_currentSlot || ulSfnConfigurateGrant==m_currentSlot){
+                        if (m_ulSfnConfiguredGrant<m_currentSlot || m_ulSfnConfiguredGrant==m_currentSlot){
                            // Do not send CG information if we are not in configuration phase (TO_RECEIVE_CG state in the UE state machine).
                            NS_LOG_INFO ("No messages to send, skipping");
                        }else{
@@ -758,12 +758,32 @@ private:
 
   TracedCallback<const SfnSf &, uint8_t, const std::vector<int>&, uint16_t, uint16_t> m_rbStatistics;
 
-  std::map<uint32_t, std::vector<uint32_t>> m_toSendDl; //!< Map that indicates, for each slot, what DL DCI we have to send
-  std::map<uint32_t, std::vector<uint32_t>> m_toSendUl; //!< Map that indicates, for each slot, what UL DCI we have to send
-  std::map<uint32_t, std::vector<uint32_t>> m_generateUl; //!< Map that indicates, for each slot, what UL DCI we have to generate
-  std::map<uint32_t, std::vector<uint32_t>> m_generateDl; //!< Map that indicates, for each slot, what DL DCI we have to generate
+  /**
+   * \brief A delay towards a slot to generate, with the type of that slot
+   */
+  struct SlotToGenerate
+  {
+    uint32_t m_k {0};                                      //!< K0 or K2, plus the L1L2 latency
+    LteNrTddSlotType m_type {LteNrTddSlotType::F};         //!< Type of the slot at the delay
+  };
 
-  std::map<uint32_t, uint32_t> m_dlHarqfbPosition; //!< Map that indicates, for each DL slot, where the UE has to send the Harq Feedback
+  /**
+   * \brief The DCI timings of a position of the TDD pattern
+   */
+  struct PatternSlotInfo
+  {
+    std::vector<uint32_t> m_toSendDl;             //!< K0 of the DL DCI we have to send
+    std::vector<uint32_t> m_toSendUl;             //!< K2 of the UL DCI we have to send
+    std::vector<SlotToGenerate> m_generateDl;     //!< DL slots we have to generate
+    std::vector<SlotToGenerate> m_generateUl;     //!< UL slots we have to generate
+    uint32_t m_dlHarqfbPosition {0};              //!< K1: where the UE has to send the Harq Feedback
+  };
+
+  /**
+   * \brief The DCI timings of each position of the TDD pattern, built by
+   * SetTddPattern from the structures of GenerateStructuresFromPattern
+   */
+  std::vector<PatternSlotInfo> m_patternSlotInfo;
 
   /**
    * \brief Status of the channel for the PHY
@@ -792,6 +812,7 @@ private:
 
   //Configured Grant
   bool m_firstPacket_configuredGrant {true}; //! SR from configuration period (CG)
+  SfnSf m_ulSfnConfiguredGrant; //!< End of the CG configuration phase, set with the first UL DCI (per-instance, not shared by the gNBs)
 
 
   bool m_cgScheduling = true;
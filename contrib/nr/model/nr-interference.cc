@@ -45,6 +45,7 @@ void
 NrInterference::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_sinr = nullptr;
   LteInterference::DoDispose ();
 }
 
@@ -99,11 +100,21 @@ NrInterference::EndRx ()
     }
   else
     {
-      SpectrumValue snr = (*m_rxSignal) / (*m_noise);
-      double avgSnr = Sum (snr) /(snr.GetSpectrumModel ()->GetNumBands ());
-      m_snrPerProcessedChunk (avgSnr);
+      if (!m_snrPerProcessedChunk.IsEmpty ())
+        {
+          Values::const_iterator rx = m_rxSignal->ConstValuesBegin ();
+          Values::const_iterator noise = m_noise->ConstValuesBegin ();
+          const std::size_t numBands = m_rxSignal->GetValuesN ();
+          double snrSum = 0;
+          for (std::size_t i = 0; i < numBands; ++i)
+            {
+              snrSum += rx[i] / noise[i];
+            }
+          double avgSnr = snrSum / numBands;
+          m_snrPerProcessedChunk (avgSnr);
+        }
 
-      NrInterference::ConditionallyEvaluateChunk ();
+      ConditionallyEvaluateChunk ();
 
       m_receiving = false;
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
@@ -122,70 +133,64 @@ NrInterference::EndRx ()
 }
 
 void
-NrInterference::ConditionallyEvaluateChunk ()
+NrInterference::DoEvaluateChunk (Time chunkEnd)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << chunkEnd);
   if (m_receiving)
     {
       NS_LOG_DEBUG (this << " Receiving");
     }
-  NS_LOG_DEBUG (this << " now "  << Now () << " last " << m_lastChangeTime);
-  if (m_receiving && (Now () > m_lastChangeTime))
+  NS_LOG_DEBUG (this << " chunk end "  << chunkEnd << " last " << m_lastChangeTime);
+  if (m_receiving && (chunkEnd > m_lastChangeTime))
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
-      SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
-      SpectrumValue sinr = (*m_rxSignal) / interf;
+      if (m_sinr == nullptr || m_sinr->GetSpectrumModelUid () != m_rxSignal->GetSpectrumModelUid ())
+        {
+          m_sinr = Create<SpectrumValue> (m_rxSignal->GetSpectrumModel ());
+        }
+
+      // The interference and the SINR of each RB are computed in a single
+      // pass, into the buffer kept across the chunks. The RBs that do not
+      // carry the signal under reception have a null SINR.
       double rbWidth = (*m_rxSignal).GetSpectrumModel ()->Begin ()->fh - (*m_rxSignal).GetSpectrumModel ()->Begin ()->fl;
-      double rssidBm = 10 * log10 (Sum ((*m_noise + *m_allSignals) * rbWidth) * 1000);
-      m_rssiPerProcessedChunk(rssidBm);
+      Values::const_iterator rx = m_rxSignal->ConstValuesBegin ();
+      Values::const_iterator all = m_allSignals->ConstValuesBegin ();
+      Values::const_iterator noise = m_noise->ConstValuesBegin ();
+      Values::iterator sinr = m_sinr->ValuesBegin ();
+      const std::size_t numBands = m_sinr->GetValuesN ();
+      NS_ASSERT (m_allSignals->GetValuesN () == numBands && m_noise->GetValuesN () == numBands);
+      double rssiSum = 0;
+      for (std::size_t i = 0; i < numBands; ++i)
+        {
+          sinr[i] = (rx[i] != 0.0) ? rx[i] / ((all[i] - rx[i]) + noise[i]) : 0.0;
+          rssiSum += (noise[i] + all[i]) * rbWidth;
+        }
+      if (!m_rssiPerProcessedChunk.IsEmpty ())
+        {
+          double rssidBm = 10 * log10 (rssiSum * 1000);
+          m_rssiPerProcessedChunk (rssidBm);
+        }
 
       NS_LOG_DEBUG ("All signals: " << (*m_allSignals)[0] << ", rxSingal:" << (*m_rxSignal)[0] << " , noise:" << (*m_noise)[0]);
-      
-      Time duration = Now () - m_lastChangeTime;
+
+      Time duration = chunkEnd - m_lastChangeTime;
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
         {
           (*it)->EvaluateChunk (*m_rxSignal, duration);
         }
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
         {
-          (*it)->EvaluateChunk (sinr, duration);
+          (*it)->EvaluateChunk (*m_sinr, duration);
         }
-      m_lastChangeTime = Now ();
+      m_lastChangeTime = chunkEnd;
     }
 }
 
-/****************************************************************
- *       Class which records SNIR change events for a
- *       short period of time.
- ****************************************************************/
-
-NrInterference::NiChange::NiChange (Time time, double delta)
-  : m_time (time),
-    m_delta (delta)
-{
-}
-
-Time
-NrInterference::NiChange::GetTime (void) const
-{
-  return m_time;
-}
-
-double
-NrInterference::NiChange::GetDelta (void) const
-{
-  return m_delta;
-}
-
-bool
-NrInterference::NiChange::operator < (const NrInterference::NiChange& o) const
-{
-  return (m_time < o.m_time);
-}
-
 bool
 NrInterference::IsChannelBusyNow (double energyW)
 {
+  // the signals that ended up to now do not contribute anymore
+  SubtractExpiredSignals ();
   double detectedPowerW = Integral (*m_allSignals);
   double powerDbm = 10 * log10 (detectedPowerW * 1000);
 
@@ -222,9 +227,9 @@ NrInterference::GetEnergyDuration (double energyW)
 
   for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
     {
-      noiseInterferenceW += i->GetDelta ();
-      end = i->GetTime ();
-      NS_LOG_INFO ("Delta: " << i->GetDelta () << "time: " << i->GetTime ());
+      noiseInterferenceW += i->second;
+      end = i->first;
+      NS_LOG_INFO ("Delta: " << i->second << "time: " << i->first);
       if (end < now)
         {
           continue;
@@ -258,18 +263,6 @@ NrInterference::EraseEvents (void)
   m_firstPower = 0.0;
 }
 
-NrInterference::NiChanges::iterator
-NrInterference::GetPosition (Time moment)
-{
-  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
-}
-
-void
-NrInterference::AddNiChangeEvent (NiChange change)
-{
-  m_niChanges.insert (GetPosition (change.GetTime ()), change);
-}
-
 void
 NrInterference::AppendEvent (Time startTime, Time endTime, double rxPowerW)
 {
@@ -277,27 +270,28 @@ NrInterference::AppendEvent (Time startTime, Time endTime, double rxPowerW)
   
   if (!m_receiving)
     {
-      NiChanges::iterator nowIterator = GetPosition (now);
+      NiChanges::iterator nowIterator = m_niChanges.upper_bound (now);
       // We empty the list until the current moment. To do so we 
       // first we sum all the energies until the current moment 
       // and save it in m_firstPower.
       for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
         {
-          m_firstPower += i->GetDelta ();
+          m_firstPower += i->second;
         }
       // then we remove all the events up to the current moment
       m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      // we create an event that represents the new energy
-      m_niChanges.insert (m_niChanges.begin (), NiChange (startTime, rxPowerW));
+      // we create an event that represents the new energy; all the
+      // remaining events are in the future, so it goes first
+      m_niChanges.emplace_hint (m_niChanges.begin (), startTime, rxPowerW);
     }
   else
     {
       // for the startTime create the event that adds the energy
-      AddNiChangeEvent (NiChange (startTime, rxPowerW));
+      m_niChanges.emplace (startTime, rxPowerW);
     }
 
   // for the endTime create event that will substract energy
-  AddNiChangeEvent (NiChange (endTime, - rxPowerW));
+  m_niChanges.emplace (endTime, - rxPowerW);
 }
 
 } // namespace ns3
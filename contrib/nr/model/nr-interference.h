@@ -30,6 +30,7 @@
 #include <ns3/traced-callback.h>
 #include <ns3/vector.h>
 #include <ns3/lte-interference.h>
+#include <map>
 
 
 namespace ns3 {
@@ -104,70 +105,16 @@ public:
   virtual void EndRx () override;
 
 private:
-
-  /**
-     * Noise and Interference (thus Ni) event.
-     */
-    class NiChange
-    {
-    public:
-      /**
-       * Create a NiChange at the given time and the amount of NI change.
-       *
-       * \param time time of the event
-       * \param delta the power
-       */
-      NiChange (Time time, double delta);
-      /**
-       * Return the event time.
-       *
-       * \return the event time.
-       */
-      Time GetTime (void) const;
-      /**
-       * Return the power
-       *
-       * \return the power
-       */
-      double GetDelta (void) const;
-      /**
-       * Compare the event time of two NiChange objects (a < o).
-       *
-       * \param o
-       * \return true if a < o.time, false otherwise
-       */
-      bool operator < (const NiChange& o) const;
-
-    private:
-
-        Time m_time;
-        double m_delta;
-    };
-   /**
-    * typedef for a vector of NiChanges
-    */
-  typedef std::vector <NiChange> NiChanges;
-
   /**
-   * \brief Find a position in event list that corresponds to a given
-   * moment. Note that all events are saved when they start and when
-   * they end. When they start, the energy the signal brings is saved as
-   * the positive value, and the event when the energy finish is
-   * saved with a negative prefix. By using this position, one
-   * can know which signals have finished, and can be removed from
-   * the list because after the given moment they do not contribute
-   * anymore to the total energy received.
+   * \brief Map of the moments in which there is some change in the energy.
+   * When a signal starts, the energy it brings is saved as a positive value,
+   * and when it finishes the same energy is saved with a negative sign.
+   * Changes happening at the same moment are kept in insertion order.
    */
-  NrInterference::NiChanges::iterator GetPosition (Time moment);
-  
-  //inherited from LteInterference
-  virtual void ConditionallyEvaluateChunk () override;
+  typedef std::multimap<Time, double> NiChanges;
 
-  /**
-   * Add NiChange to the list at the appropriate position.
-   * \param change
-   */
-  void AddNiChangeEvent (NiChange change);
+  //inherited from LteInterference
+  virtual void DoEvaluateChunk (Time chunkEnd) override;
 
 protected:
 
@@ -182,6 +129,7 @@ protected:
   /// Used for energy duration calculation, inspired by wifi/model/interference-helper implementation
   NiChanges m_niChanges; //!< List of events in which there is some change in the energy
   double m_firstPower; //!< This contains the accumulated sum of the energy events until the certain moment it has been calculated
+  Ptr<SpectrumValue> m_sinr; //!< SINR of the last chunk, reused across the chunks
 
 
 };
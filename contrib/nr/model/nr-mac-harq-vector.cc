@@ -23,18 +23,16 @@ namespace ns3 {
 bool
 NrMacHarqVector::Erase (uint8_t id)
 {
-  at (id).Erase ();
+  NS_ASSERT (Exist (id));
+  NS_ASSERT (m_activeMask[id / 64] & (1ULL << (id % 64)));
+  m_processes[id].second.Erase ();
+  m_activeMask[id / 64] &= ~(1ULL << (id % 64));
   --m_usedSize;
 
-  uint32_t count = 0;
-  for (const auto & v : *this)
-    {
-      if (v.second.m_active)
-        {
-          ++count;
-        }
-    }
-  NS_ASSERT (count == m_usedSize);
+  NS_ASSERT (static_cast<uint32_t> (__builtin_popcountll (m_activeMask[0]) +
+                                    __builtin_popcountll (m_activeMask[1]) +
+                                    __builtin_popcountll (m_activeMask[2]) +
+                                    __builtin_popcountll (m_activeMask[3])) == m_usedSize);
   return true;
 }
 
@@ -54,10 +52,12 @@ NrMacHarqVector::Insert (uint8_t *id, const HarqProcess& element)
       return false;
     }
 
-  NS_ABORT_IF (at (*id).m_active == true);
-  at (*id) = element;
+  HarqProcess &process = m_processes[*id].second;
+  NS_ABORT_IF (process.m_active == true);
+  process = element;
+  m_activeMask[*id / 64] |= 1ULL << (*id % 64);
 
-  NS_ABORT_IF (at (*id).m_active == false);
+  NS_ABORT_IF (process.m_active == false);
   NS_ABORT_IF (this->FirstAvailableId () == *id);
 
   ++m_usedSize;
@@ -67,7 +67,7 @@ NrMacHarqVector::Insert (uint8_t *id, const HarqProcess& element)
 std::ostream &
 operator<< (std::ostream & os, NrMacHarqVector const & item)
 {
-  for (const auto & p : item)
+  for (const auto & p : item.m_processes)
     {
       os << "Process ID " << static_cast<uint32_t> (p.first)
          << ": " << p.second << std::endl;
@@ -18,7 +18,8 @@
  */
 #pragma once
 
-#include <unordered_map>
+#include <array>
+#include <vector>
 #include "nr-mac-harq-process.h"
 
 namespace ns3 {
@@ -27,29 +28,39 @@ namespace ns3 {
  * \ingroup scheduler
  * \brief Data structure to save all the HARQ process of an UE
  *
- * The data is stored as an unordered_map between the process ID and the
- * real data, saved in the structure HarqProcess. The vector (yes, it is an
- * improper name) is always full (i.e., it always contains almost 20 HARQ processes)
- * but they can be inactive (i.e., no data is stored there). The duty of finding
- * an empty spot is split between Insert and FirstAvailableId.
+ * The processes are stored in a vector indexed by the process ID, with the
+ * pair (ID, HarqProcess) as element, so the iterators behave as the ones of
+ * a map (it->first is the ID, it->second the process). The vector is always
+ * full (i.e., it always contains almost 20 HARQ processes) but they can be
+ * inactive (i.e., no data is stored there). A bitmask keeps track of the
+ * ACTIVE processes: finding an empty spot, or the next active process, is
+ * a scan of a few words instead of a scan of all the processes.
+ *
+ * The vector is allocated once in SetMaxSize, so the iterators stay valid
+ * for the lifetime of the object (the scheduler stores them in its lists
+ * of HARQ to retransmit).
  *
  * The class does not support going "out of space", or in other words, if all
  * the spots are filled with active processes, the next insert will fail.
  *
  * \see HarqProcess
  */
-class NrMacHarqVector : private std::unordered_map<uint8_t, HarqProcess>
+class NrMacHarqVector
 {
 public:
   friend std::ostream &  operator<< (std::ostream & os, NrMacHarqVector const & item);
   /**
-   * \brief iterator of the map
+   * \brief element of the vector: the process ID and the process
+   */
+  typedef std::pair<const uint8_t, HarqProcess> value_type;
+  /**
+   * \brief iterator of the vector
    */
-  typedef typename std::unordered_map<uint8_t, HarqProcess>::iterator iterator;
+  typedef typename std::vector<value_type>::iterator iterator;
   /**
-   * \brief const_iterator of the map
+   * \brief const_iterator of the vector
    */
-  typedef typename std::unordered_map<uint8_t, HarqProcess>::const_iterator const_iterator;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
 
   /**
     * \brief Default constructor
@@ -60,15 +71,19 @@ public:
    * \brief Set and reserve the size of the vector
    * \param size the vector size
    *
-   * The method will reserve and create the necessary processes.
+   * The method will reserve and create the necessary processes, all inactive.
    */
   void SetMaxSize (uint8_t size)
   {
+    NS_ABORT_MSG_IF (size == 255, "The ID 255 is reserved");
     m_maxSize = size;
-    reserve (size);
-    for (auto i = 0; i < size; ++i)
+    m_usedSize = 0;
+    m_activeMask.fill (0);
+    m_processes.clear ();
+    m_processes.reserve (size);
+    for (uint8_t i = 0; i < size; ++i)
       {
-        emplace (i, HarqProcess ());
+        m_processes.emplace_back (i, HarqProcess ());
       }
   }
 
@@ -90,12 +105,12 @@ public:
   /**
    * \brief Find a process
    * \param key ID of the process to find
-   * \return an iterator to the process
+   * \return an iterator to the process, or End () if the ID does not exist
    */
   const iterator
   Find (uint8_t key)
   {
-    return this->find (key);
+    return Exist (key) ? m_processes.begin () + key : m_processes.end ();
   }
   /**
    * \brief Begin of the vector
@@ -104,7 +119,7 @@ public:
   const iterator
   Begin ()
   {
-    return this->begin ();
+    return m_processes.begin ();
   }
   /**
    * \brief End of the vector
@@ -113,7 +128,7 @@ public:
   const iterator
   End ()
   {
-    return this->end ();
+    return m_processes.end ();
   }
   /**
    * \brief Const begin of the vector
@@ -122,7 +137,7 @@ public:
   const_iterator
   CBegin ()
   {
-    return this->cbegin ();
+    return m_processes.cbegin ();
   }
   /**
    * \brief Const end of the vector
@@ -131,7 +146,7 @@ public:
   const_iterator
   CEnd ()
   {
-    return this->cend ();
+    return m_processes.cend ();
   }
   /**
    * \brief Check if the ID exists in the map
@@ -141,8 +156,7 @@ public:
    */
   bool Exist (uint8_t id) const
   {
-    // could be id > max_size?
-    return find (id) != end ();
+    return id < m_processes.size ();
   }
   /**
    * \brief Get a reference to a process
@@ -152,7 +166,7 @@ public:
   HarqProcess & Get (uint8_t id)
   {
     NS_ASSERT (Exist (id));
-    return find (id)->second;
+    return m_processes[id].second;
   }
   /**
    * \brief Get a const reference to a process
@@ -162,7 +176,7 @@ public:
   const HarqProcess & Get (uint8_t id) const
   {
     NS_ASSERT (Exist (id));
-    return find (id)->second;
+    return m_processes[id].second;
   }
   /**
    * \brief Find the first (INACTIVE) ID
@@ -170,11 +184,38 @@ public:
    */
   uint8_t FirstAvailableId () const
   {
-    for (const auto & it : *this)
+    for (uint32_t w = 0; w < m_activeMask.size (); ++w)
       {
-        if (!it.second.m_active)
+        uint64_t free = ~m_activeMask[w];
+        if (free != 0)
+          {
+            uint32_t id = w * 64 + __builtin_ctzll (free);
+            return id < m_maxSize ? static_cast<uint8_t> (id) : 255;
+          }
+      }
+    return 255;
+  }
+  /**
+   * \brief Find the first ACTIVE ID, starting from an ID
+   * \param from the first ID to consider
+   * \return the first active ID greater or equal than from, or 255 in case
+   * there are no more active processes
+   *
+   * To visit all the active processes:
+   * for (uint8_t id = v.NextActiveId (0); id != 255; id = v.NextActiveId (id + 1))
+   */
+  uint8_t NextActiveId (uint8_t from) const
+  {
+    for (uint32_t w = from / 64; w < m_activeMask.size (); ++w)
+      {
+        uint64_t active = m_activeMask[w];
+        if (w == from / 64u)
+          {
+            active &= ~0ULL << (from % 64);
+          }
+        if (active != 0)
           {
-            return it.first;
+            return static_cast<uint8_t> (w * 64 + __builtin_ctzll (active));
           }
       }
     return 255;
@@ -197,6 +238,8 @@ public:
   }
 
 private:
+  std::vector<value_type> m_processes;         //!< Processes, indexed by ID
+  std::array<uint64_t, 4> m_activeMask {};      //!< Bit i is set if the process i is ACTIVE
   uint8_t m_maxSize  {0}; //!< Maximum size (or the number of processes stored)
   uint8_t m_usedSize {0}; //!< Number of ACTIVE processes
 };
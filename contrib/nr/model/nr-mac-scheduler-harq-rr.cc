@@ -105,8 +105,7 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
 
           auto & dciInfoReTx = harqProcess.m_dciElement;
 
-          long rbgAssigned = std::count (dciInfoReTx->m_rbgBitmask.begin (),
-                                         dciInfoReTx->m_rbgBitmask.end (), 1) * dciInfoReTx->m_numSym;
+          long rbgAssigned = dciInfoReTx->m_rbgBitmask.Count () * dciInfoReTx->m_numSym;
           uint32_t rbgAvail = (GetBandwidthInRbg () - startingPoint->m_rbg) * symPerBeam;
 
           NS_LOG_INFO ("Evaluating space to retransmit HARQ PID=" <<
@@ -172,10 +171,10 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
 
             }
 
-          auto dci = std::make_shared<DciInfoElementTdma> (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
-                                                           startingPoint->m_sym, symPerBeam,
-                                                           mcs, tbSize, ndi, rv, DciInfoElementTdma::DATA,
-                                                           dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
+          auto dci = CreatePooledDci (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
+                                      startingPoint->m_sym, symPerBeam,
+                                      mcs, tbSize, ndi, rv, DciInfoElementTdma::DATA,
+                                      dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
 
           dci->m_rbgBitmask = harqProcess.m_dciElement->m_rbgBitmask;
           dci->m_harqProcess = dciInfoReTx->m_harqProcess;
@@ -319,12 +318,12 @@ NrMacSchedulerHarqRr::ScheduleUlHarq (NrMacSchedulerNs3::PointInFTPlane *startin
           std::vector<uint8_t> rv {rvIndex};
           std::vector<uint8_t> ndi {0};
 
-          auto dci = std::make_shared<DciInfoElementTdma> (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
-                                                           startingPoint->m_sym - dciInfoReTx->m_numSym,
-                                                           dciInfoReTx->m_numSym,
-                                                           dciInfoReTx->m_mcs, dciInfoReTx->m_tbSize,
-                                                           ndi, rv, DciInfoElementTdma::DATA,
-                                                           dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
+          auto dci = CreatePooledDci (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
+                                      startingPoint->m_sym - dciInfoReTx->m_numSym,
+                                      dciInfoReTx->m_numSym,
+                                      dciInfoReTx->m_mcs, dciInfoReTx->m_tbSize,
+                                      ndi, rv, DciInfoElementTdma::DATA,
+                                      dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
 
           dci->m_rbgBitmask = harqProcess.m_dciElement->m_rbgBitmask;
           dci->m_harqProcess = harqId;
@@ -536,12 +535,12 @@ NrMacSchedulerHarqRr::ScheduleUlHarq (NrMacSchedulerNs3::PointInFTPlane *startin
 
           // Configured Grant: From starting point until last symbol
 
-          auto dci = std::make_shared<DciInfoElementTdma> (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
-                                                           priorSym,//symUsed,
-                                                           dciInfoReTx->m_numSym,
-                                                           dciInfoReTx->m_mcs, dciInfoReTx->m_tbSize,
-                                                           ndi, rv, DciInfoElementTdma::DATA,
-                                                           dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
+          auto dci = CreatePooledDci (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
+                                      priorSym,//symUsed,
+                                      dciInfoReTx->m_numSym,
+                                      dciInfoReTx->m_mcs, dciInfoReTx->m_tbSize,
+                                      ndi, rv, DciInfoElementTdma::DATA,
+                                      dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
           dci->m_rbgBitmask = harqProcess.m_dciElement->m_rbgBitmask;
           dci->m_harqProcess = harqId;
           harqProcess.m_dciElement = dci;
@@ -358,7 +358,7 @@ NrMacSchedulerNs3::SetDlNotchedRbgMask (const std::vector<uint8_t> &dlNotchedRbg
   NS_LOG_INFO ("Set DL notched mask: " << ss.str ());
 }
 
-std::vector<uint8_t>
+const std::vector<uint8_t> &
 NrMacSchedulerNs3::GetDlNotchedRbgMask (void) const
 {
   return m_dlNotchedRbgsMask;
@@ -379,7 +379,7 @@ NrMacSchedulerNs3::SetUlNotchedRbgMask (const std::vector<uint8_t> &ulNotchedRbg
   NS_LOG_INFO ("Set UL notched mask: " << ss.str ());
 }
 
-std::vector<uint8_t>
+const std::vector<uint8_t> &
 NrMacSchedulerNs3::GetUlNotchedRbgMask (void) const
 {
   return m_ulNotchedRbgsMask;
@@ -1013,8 +1013,7 @@ NrMacSchedulerNs3::ProcessHARQFeedbacks (std::vector<T> *harqInfo,
         }
       NS_ABORT_IF (ueProcess.m_dciElement == nullptr);
 
-      std::vector<uint8_t>::const_iterator rvIt;
-      rvIt = std::max_element (ueProcess.m_dciElement->m_rv.begin(), ueProcess.m_dciElement->m_rv.end());
+      auto rvIt = std::max_element (ueProcess.m_dciElement->m_rv.begin(), ueProcess.m_dciElement->m_rv.end());
       //RV number should not be greater than 3. An unscheduled stream should
       //be assigned RV = 0 in MIMO.
       NS_ASSERT (*rvIt < 4);
@@ -1058,10 +1057,11 @@ NrMacSchedulerNs3::ResetExpiredHARQ (uint16_t rnti, NrMacHarqVector *harq)
 {
   NS_LOG_FUNCTION (this << harq);
 
-  for (auto harqIt = harq->Begin (); harqIt != harq->End (); ++harqIt)
+  // Only the ACTIVE processes have a running timer
+  for (uint8_t processId = harq->NextActiveId (0); processId != 255;
+       processId = harq->NextActiveId (processId + 1))
     {
-      HarqProcess & process = harqIt->second;
-      uint8_t processId = harqIt->first;
+      HarqProcess & process = harq->Get (processId);
 
       if (process.m_status == HarqProcess::INACTIVE)
         {
@@ -1110,7 +1110,7 @@ NrMacSchedulerNs3::PrependCtrlSym (uint8_t symStart, uint8_t numSymToAllocate,
 
   for (uint8_t sym = symStart; sym < symStart + numSymToAllocate; ++sym)
     {
-      allocations->emplace_front (VarTtiAllocInfo (std::make_shared<DciInfoElementTdma> (sym, 1, mode, DciInfoElementTdma::CTRL, rbgBitmask)));
+      allocations->emplace_front (VarTtiAllocInfo (CreatePooledDci (sym, 1, mode, DciInfoElementTdma::CTRL, rbgBitmask)));
       NS_LOG_INFO ("Allocating CTRL symbol, type" << mode <<
                    " in TDMA. numSym=1, symStart=" <<
                    static_cast<uint32_t> (sym) <<
@@ -1143,7 +1143,7 @@ NrMacSchedulerNs3::AppendCtrlSym (uint8_t symStart, uint8_t numSymToAllocate,
 
   for (uint8_t sym = symStart; sym < symStart + numSymToAllocate; ++sym)
     {
-      allocations->emplace_back (VarTtiAllocInfo (std::make_shared<DciInfoElementTdma> (sym, 1, mode, DciInfoElementTdma::CTRL, rbgBitmask)));
+      allocations->emplace_back (VarTtiAllocInfo (CreatePooledDci (sym, 1, mode, DciInfoElementTdma::CTRL, rbgBitmask)));
       NS_LOG_INFO ("Allocating CTRL symbol, type" << mode <<
                    " in TDMA. numSym=1, symStart=" <<
                    static_cast<uint32_t> (sym) <<
@@ -1272,7 +1272,7 @@ NrMacSchedulerNs3::ComputeActiveUe (ActiveUeMap *activeUe,
           totBuffer += lcg->GetTotalSize ();
         }
 
-      auto harqV = GetHarqVector (ue);
+      const auto &harqV = GetHarqVector (ue);
 
       if (totBuffer > 0 && harqV.CanInsert ())
         {
@@ -2257,11 +2257,11 @@ NrMacSchedulerNs3::DoScheduleSrs (PointInFTPlane *spoint, SlotAllocInfo *allocIn
       std::vector<uint8_t> ndi = {1};
       std::vector<uint8_t> rv = {0};
 
-      auto dci = std::make_shared<DciInfoElementTdma> (rnti, DciInfoElementTdma::UL,
-                                                       spoint->m_sym, 1, mcs, tbs,
-                                                       ndi, rv,
-                                                       DciInfoElementTdma::SRS,
-                                                       GetBwpId(), GetTpc ());
+      auto dci = CreatePooledDci (rnti, DciInfoElementTdma::UL,
+                                  spoint->m_sym, 1, mcs, tbs,
+                                  ndi, rv,
+                                  DciInfoElementTdma::SRS,
+                                  GetBwpId(), GetTpc ());
       dci->m_rbgBitmask = rbgBitmask;
 
       allocInfo->m_numSymAlloc += 1;
@@ -2341,24 +2341,17 @@ NrMacSchedulerNs3::DoScheduleDl (const std::vector <DlHarqInfo> &dlHarqFeedback,
   uint8_t dataSymPerSlot = m_macSchedSapUser->GetSymbolsPerSlot () - m_dlCtrlSymbols;
   uint8_t dlSymAvail;
 
-  // Calculate available DL symbols based on the TDD pattern selected in main
-  if (type == LteNrTddSlotType::F)
+  // Calculate available DL symbols based on the TDD pattern selected in main.
+  // Without a fixed number of DL data symbols, the DL data ends where the UL
+  // symbols of the slot (the UL CTRL of the F and S slots included) start
+  if (type == LteNrTddSlotType::F && m_dlDataSymbolsF != 0)
     {
-      if (m_dlDataSymbolsF == 0)
-        {
-          dlSymAvail = m_macSchedSapUser->GetSymbolsPerSlot () - m_dlCtrlSymbols;
-        }
-      else
-        {
-          dlSymAvail = m_dlDataSymbolsF;
-        }
+      dlSymAvail = m_dlDataSymbolsF;
     }
   else
     {
-      dlSymAvail = m_macSchedSapUser->GetSymbolsPerSlot () - m_dlCtrlSymbols;
+      dlSymAvail = dataSymPerSlot - ulAllocations.m_totUlSym;
     }
-
- // uint8_t dlSymAvail = dataSymPerSlot - ulAllocations.m_totUlSym;
   PointInFTPlane dlAssignationStartPoint (0, m_dlCtrlSymbols);
 
   NS_LOG_DEBUG ("Scheduling DL for slot " << dlSfnSf <<
@@ -462,7 +462,7 @@ public:
    * \brief Get the notched (blank) RBGs Mask for the DL
    * \return The mask of notched RBGs
    */
-  std::vector<uint8_t> GetDlNotchedRbgMask (void) const;
+  const std::vector<uint8_t> & GetDlNotchedRbgMask (void) const;
 
   /**
    * \brief Set the notched (blank) RBGs Mask for the UL
@@ -474,7 +474,7 @@ public:
    * \brief Get the notched (blank) RBGs Mask for the UL
    * \return The mask of notched RBGs
    */
-  std::vector<uint8_t> GetUlNotchedRbgMask (void) const;
+  const std::vector<uint8_t> & GetUlNotchedRbgMask (void) const;
 
   /**
    * \brief Set the number of UL SRS symbols
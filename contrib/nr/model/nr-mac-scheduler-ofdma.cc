@@ -34,6 +34,51 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("NrMacSchedulerOfdma");
 NS_OBJECT_ENSURE_REGISTERED (NrMacSchedulerOfdma);
 
+namespace {
+
+/**
+ * \brief Sort again a sorted UE vector after an iteration of the assignment
+ * \param ueVector the UE vector, sorted before the iteration
+ * \param assigned the UE that got the resources in the iteration
+ * \param compare the function to sort the UEs
+ *
+ * The result is the one of std::stable_sort on the vector: the UEs with the
+ * same metric keep their order, and the UE that got the resources goes
+ * among them according to its previous position.
+ *
+ * Only the metric of the UE that got the resources is expected to change
+ * (the metric of the others is recalculated by NotAssignedDlResources, but
+ * with the same resources as before), so the UE is moved to its new position:
+ * O(log UE) comparisons instead of the O(UE log UE) of a full sort. If the
+ * metric of other UEs changed, the vector is sorted from scratch.
+ */
+void
+SortAfterAssignment (std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> *ueVector,
+                     std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>::iterator assigned,
+                     const std::function<bool (const NrMacSchedulerNs3::UePtrAndBufferReq &,
+                                               const NrMacSchedulerNs3::UePtrAndBufferReq &)> &compare)
+{
+  const auto index = assigned - ueVector->begin ();
+  auto last = ueVector->end () - 1;
+  std::rotate (assigned, assigned + 1, ueVector->end ());
+
+  if (!std::is_sorted (ueVector->begin (), last, compare))
+    {
+      // Back to the previous order, which decides the ties
+      std::rotate (ueVector->begin () + index, last, ueVector->end ());
+      std::stable_sort (ueVector->begin (), ueVector->end (), compare);
+      return;
+    }
+
+  // Among the UEs with the same metric, the ones that were before the
+  // assigned UE stay before it
+  auto range = std::equal_range (ueVector->begin (), last, *last, compare);
+  auto position = std::min (std::max (ueVector->begin () + index, range.first), range.second);
+  std::rotate (position, last, ueVector->end ());
+}
+
+} // unnamed namespace
+
 TypeId
 NrMacSchedulerOfdma::GetTypeId (void)
 {
@@ -161,6 +206,9 @@ NrMacSchedulerOfdma::GetSymPerBeam (uint32_t symAvail,
  * </pre>
  *
  * To sort the UEs, the method uses the function returned by GetUeCompareDlFn().
+ * The UEs are sorted once per beam; after every iteration only the UE
+ * that got the RBG is moved to its new position, unless the metric of the
+ * other UEs changed too.
  * Two fairness helper are hard-coded in the method: the first one is avoid
  * to assign resources to UEs that already have their buffer requirement covered,
  * and the other one is avoid to assign symbols when all the UEs have their
@@ -177,34 +225,37 @@ NrMacSchedulerOfdma::AssignDLRBG (uint32_t symAvail, const ActiveUeMap &activeDl
   GetSecond GetUeVector;
   BeamSymbolMap symPerBeam = GetSymPerBeam (symAvail, activeDl);
 
+  // The notched RBGs are the same for all the beams
+  const std::vector<uint8_t> &dlNotchedRBGsMask = GetDlNotchedRbgMask ();
+  const uint32_t dlRbgInOneSymbol = dlNotchedRBGsMask.size () > 0 ? std::count (dlNotchedRBGsMask.begin (),
+                                                                              dlNotchedRBGsMask.end (),
+                                                                              1) : GetBandwidthInRbg ();
+  NS_ASSERT (dlRbgInOneSymbol > 0);
+  const auto compareUe = GetUeCompareDlFn ();
+
   // Iterate through the different beams
   for (const auto &el : activeDl)
     {
       // Distribute the RBG evenly among UEs of the same beam
       uint32_t beamSym = symPerBeam.at (GetBeamId (el));
       uint32_t rbgAssignable = 1 * beamSym;
-      std::vector<UePtrAndBufferReq> ueVector;
+      std::vector<UePtrAndBufferReq> &ueVector = m_ueVector;
       FTResources assigned (0,0);
-      const std::vector<uint8_t> dlNotchedRBGsMask = GetDlNotchedRbgMask ();
-      uint32_t resources = dlNotchedRBGsMask.size () > 0 ? std::count (dlNotchedRBGsMask.begin (),
-                                                                     dlNotchedRBGsMask.end (),
-                                                                     1) : GetBandwidthInRbg ();
-      NS_ASSERT (resources > 0);
+      uint32_t resources = dlRbgInOneSymbol;
 
-      for (const auto &ue : GetUeVector (el))
-        {
-          ueVector.emplace_back (ue);
-        }
+      ueVector.assign (GetUeVector (el).begin (), GetUeVector (el).end ());
 
       for (auto & ue : ueVector)
         {
           BeforeDlSched (ue, FTResources (rbgAssignable * beamSym, beamSym));
         }
 
+      // Sorted once here, and kept sorted after every iteration
+      std::stable_sort (ueVector.begin (), ueVector.end (), compareUe);
+
       while (resources > 0)
         {
           GetFirst GetUe;
-          std::sort (ueVector.begin (), ueVector.end (), GetUeCompareDlFn ());
           auto schedInfoIt = ueVector.begin ();
 
           // Ensure fairness: pass over UEs which already has enough resources to transmit
@@ -308,6 +359,8 @@ NrMacSchedulerOfdma::AssignDLRBG (uint32_t symAvail, const ActiveUeMap &activeDl
                                           assigned);
                 }
             }
+
+          SortAfterAssignment (&ueVector, schedInfoIt, compareUe);
         }
     }
 
@@ -516,7 +569,7 @@ NrMacSchedulerOfdma::CreateDlDci (NrMacSchedulerNs3::PointInFTPlane *spoint,
                oss.str () << " for " << static_cast<uint32_t> (maxSym) << " SYM.");
 
 
-  std::shared_ptr<DciInfoElementTdma> dci = std::make_shared<DciInfoElementTdma>
+  std::shared_ptr<DciInfoElementTdma> dci = CreatePooledDci
       (ueInfo->m_rnti, DciInfoElementTdma::DL, spoint->m_sym, maxSym, ueInfo->m_dlMcs,
        ueInfo->m_dlTbSize, ndi, rv, DciInfoElementTdma::DATA, GetBwpId (), GetTpc());
 
@@ -597,7 +650,7 @@ NrMacSchedulerOfdma::CreateUlDci (PointInFTPlane *spoint,
   std::vector<uint8_t> rv = {0};
 
   NS_ASSERT (spoint->m_sym >= maxSym);
-  std::shared_ptr<DciInfoElementTdma> dci = std::make_shared<DciInfoElementTdma>
+  std::shared_ptr<DciInfoElementTdma> dci = CreatePooledDci
       (ueInfo->m_rnti, DciInfoElementTdma::UL, spoint->m_sym - maxSym, maxSym, ulMcs,
        ulTbs, ndi, rv, DciInfoElementTdma::DATA, GetBwpId (), GetTpc());
 
@@ -655,6 +708,12 @@ NrMacSchedulerOfdma::AssignULRBG (uint32_t symAvail, const ActiveUeMap &activeUl
   GetSecond GetRBcounter;
   bool firstSym = true;
 
+  // The notched RBGs are the same for all the beams
+  const std::vector<uint8_t> &ulNotchedRBGsMask = GetUlNotchedRbgMask ();
+  const uint32_t ulRbgInOneSymbol = ulNotchedRBGsMask.size () > 0 ? std::count (ulNotchedRBGsMask.begin (),
+                                                                              ulNotchedRBGsMask.end (),
+                                                                              1) : GetBandwidthInRbg ();
+
   // Iterate through the different beams
   if (m_schType_OFDMA == 1)
   {
@@ -663,18 +722,12 @@ NrMacSchedulerOfdma::AssignULRBG (uint32_t symAvail, const ActiveUeMap &activeUl
           // Distribute the RBG evenly among UEs of the same beam
           uint32_t beamSym = symPerBeam.at (GetBeamId (el));
           uint32_t rbgAssignable = 1 * beamSym;
-          std::vector<UePtrAndBufferReq> ueVector;
+          std::vector<UePtrAndBufferReq> &ueVector = m_ueVector;
           FTResources assigned (0,0);
-          const std::vector<uint8_t> ulNotchedRBGsMask = GetUlNotchedRbgMask ();
-          uint32_t resources = ulNotchedRBGsMask.size () > 0 ? std::count (ulNotchedRBGsMask.begin (),
-                                                                         ulNotchedRBGsMask.end (),
-                                                                         1) : GetBandwidthInRbg ();
+          uint32_t resources = ulRbgInOneSymbol;
           NS_ASSERT (resources > 0);
 
-          for (const auto &ue : GetUeVector (el))
-            {
-              ueVector.emplace_back (ue);
-            }
+          ueVector.assign (GetUeVector (el).begin (), GetUeVector (el).end ());
 
           for (auto & ue : ueVector)
             {
@@ -742,12 +795,9 @@ NrMacSchedulerOfdma::AssignULRBG (uint32_t symAvail, const ActiveUeMap &activeUl
       for (const auto &el : activeUl)
           {
             uint32_t beamSym = symPerBeam.at (GetBeamId (el));
-            std::vector<UePtrAndBufferReq> ueVector;
+            std::vector<UePtrAndBufferReq> &ueVector = m_ueVector;
             FTResources assigned (0,0);
-            const std::vector<uint8_t> ulNotchedRBGsMask = GetUlNotchedRbgMask ();
-            uint32_t rbgInOneSymbol = ulNotchedRBGsMask.size () > 0 ? std::count (ulNotchedRBGsMask.begin (),
-                                                                           ulNotchedRBGsMask.end (),
-                                                                           1) : GetBandwidthInRbg ();
+            uint32_t rbgInOneSymbol = ulRbgInOneSymbol;
 
             std::vector<SchedUeMap> ueSchedVector;
             std::vector<SchedUeMapFirstSym> ueSchedVectorFirstSym;
@@ -758,10 +808,7 @@ NrMacSchedulerOfdma::AssignULRBG (uint32_t symAvail, const ActiveUeMap &activeUl
 
             NS_ASSERT (resources > 0);
 
-            for (const auto &ue : GetUeVector (el))
-              {
-                ueVector.emplace_back (ue);
-              }
+            ueVector.assign (GetUeVector (el).begin (), GetUeVector (el).end ());
 
             for (auto & ue : ueVector)
               {
@@ -1358,7 +1405,7 @@ NrMacSchedulerOfdma::CreateUlDci (PointInFTPlane *spoint,
 
    spoint->m_rbg = lastRbg + 1;
 
-   std::shared_ptr<DciInfoElementTdma> dci = std::make_shared<DciInfoElementTdma>
+   std::shared_ptr<DciInfoElementTdma> dci = CreatePooledDci
       (ueInfo->m_rnti, DciInfoElementTdma::UL, spoint->m_sym, (ueInfo->m_ulSym), ulMcs,
        ulTbs, ndi, rv, DciInfoElementTdma::DATA, GetBwpId (), GetTpc());
 
@@ -1465,7 +1512,7 @@ NrMacSchedulerOfdma::CreateUlCGConfig (PointInFTPlane *spoint,
 
    spoint->m_rbg = lastRbg + 1;
 
-   std::shared_ptr<DciInfoElementTdma> dci = std::make_shared<DciInfoElementTdma>
+   std::shared_ptr<DciInfoElementTdma> dci = CreatePooledDci
       (ueInfo->m_rnti, DciInfoElementTdma::UL, spoint->m_sym, (ueInfo->m_ulSym), ulMcs,
        ulTbs, ndi, rv, DciInfoElementTdma::DATA, GetBwpId (), GetTpc());
 
@@ -53,21 +53,18 @@ NrMacSchedulerTdma::~NrMacSchedulerTdma ()
 {
 }
 
-std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>
-NrMacSchedulerTdma::GetUeVectorFromActiveUeMap (const NrMacSchedulerNs3::ActiveUeMap &activeUes)
+void
+NrMacSchedulerTdma::GetUeVectorFromActiveUeMap (const NrMacSchedulerNs3::ActiveUeMap &activeUes,
+                                                std::vector<UePtrAndBufferReq> *ueVector)
 {
-  std::vector<UePtrAndBufferReq> ueVector;
+  ueVector->clear ();
   for (const auto &el : activeUes)
     {
-      uint64_t size = ueVector.size ();
+      uint64_t size = ueVector->size ();
       GetSecond GetUeVector;
-      for (const auto &ue : GetUeVector (el))
-        {
-          ueVector.emplace_back (ue);
-        }
-      NS_ASSERT (size + GetUeVector (el).size () == ueVector.size ());
+      ueVector->insert (ueVector->end (), GetUeVector (el).begin (), GetUeVector (el).end ());
+      NS_ASSERT (size + GetUeVector (el).size () == ueVector->size ());
     }
-  return ueVector;
 }
 
 
@@ -131,13 +128,14 @@ NrMacSchedulerTdma::AssignRBGTDMA (uint32_t symAvail, const ActiveUeMap &activeU
                 activeUe.size () << ", # sym: " << symAvail);
 
   // Create vector of UE (without considering the beam)
-  std::vector<UePtrAndBufferReq> ueVector = GetUeVectorFromActiveUeMap (activeUe);
+  std::vector<UePtrAndBufferReq> &ueVector = m_ueVector;
+  GetUeVectorFromActiveUeMap (activeUe, &ueVector);
 
   // Distribute the symbols following the selected behaviour among UEs
   uint32_t resources = symAvail;
   FTResources assigned (0, 0);
 
-  const std::vector<uint8_t> notchedRBGsMask = type == "DL" ? GetDlNotchedRbgMask () : GetUlNotchedRbgMask ();
+  const std::vector<uint8_t> &notchedRBGsMask = type == "DL" ? GetDlNotchedRbgMask () : GetUlNotchedRbgMask ();
   int zeroes = std::count (notchedRBGsMask.begin (), notchedRBGsMask.end (), 0);
   uint32_t numOfAssignableRbgs = GetBandwidthInRbg () - zeroes;
   NS_ASSERT (numOfAssignableRbgs > 0);
@@ -396,7 +394,7 @@ NrMacSchedulerTdma::CreateDlDci (PointInFTPlane *spoint,
       return nullptr;
     }
 
-  const std::vector<uint8_t> notchedRBGsMask = GetDlNotchedRbgMask ();
+  const std::vector<uint8_t> &notchedRBGsMask = GetDlNotchedRbgMask ();
   int zeroes = std::count (notchedRBGsMask.begin (), notchedRBGsMask.end (), 0);
   uint32_t numOfAssignableRbgs = GetBandwidthInRbg () - zeroes;
 
@@ -442,7 +440,7 @@ NrMacSchedulerTdma::CreateUlDci (NrMacSchedulerNs3::PointInFTPlane *spoint,
       return nullptr;
     }
 
-  const std::vector<uint8_t> notchedRBGsMask = GetUlNotchedRbgMask ();
+  const std::vector<uint8_t> &notchedRBGsMask = GetUlNotchedRbgMask ();
   int zeroes = std::count (notchedRBGsMask.begin (), notchedRBGsMask.end (), 0);
   uint32_t numOfAssignableRbgs = GetBandwidthInRbg () - zeroes;
 
@@ -514,7 +512,7 @@ NrMacSchedulerTdma::CreateDci (NrMacSchedulerNs3::PointInFTPlane *spoint,
   NS_ASSERT (sumTbSize > 0);
   NS_ASSERT (numSym > 0);
 
-  std::shared_ptr<DciInfoElementTdma> dci = std::make_shared<DciInfoElementTdma>
+  std::shared_ptr<DciInfoElementTdma> dci = CreatePooledDci
       (ueInfo->m_rnti, fmt, spoint->m_sym, numSym, mcs, tbs, ndi, rv, DciInfoElementTdma::DATA,
        GetBwpId (), GetTpc());
 
@@ -531,7 +529,7 @@ NrMacSchedulerTdma::CreateDci (NrMacSchedulerNs3::PointInFTPlane *spoint,
   dci->m_rbgBitmask = std::move (rbgAssigned);
 
   std::ostringstream oss;
-  for (auto & x: dci->m_rbgBitmask)
+  for (auto x: dci->m_rbgBitmask)
     {
       oss << std::to_string (x) << " ";
     }
@@ -570,7 +568,7 @@ NrMacSchedulerTdma::CreateUlCGConfig (NrMacSchedulerNs3::PointInFTPlane *spoint,
       return nullptr;
     }
 
-  const std::vector<uint8_t> notchedRBGsMask = GetUlNotchedRbgMask ();
+  const std::vector<uint8_t> &notchedRBGsMask = GetUlNotchedRbgMask ();
   int zeroes = std::count (notchedRBGsMask.begin (), notchedRBGsMask.end (), 0);
   uint32_t numOfAssignableRbgs = GetBandwidthInRbg () - zeroes;
 
@@ -225,16 +225,22 @@ protected:
   CreateUlCGConfig (PointInFTPlane *spoint, const std::shared_ptr<NrMacSchedulerUeInfo> &ueInfo,
                uint32_t maxSym) const override;
 
+  /**
+   * \brief Vector of the UEs being assigned, kept across the slots so that
+   * its memory is reused by every assignment
+   */
+  mutable std::vector<UePtrAndBufferReq> m_ueVector;
+
 private:
   /**
    * \brief Retrieve the UE vector from an ActiveUeMap
    * \param activeUes UE map
-   * \return A Vector of UEs and their buffer requirements (in B)
+   * \param ueVector Vector of UEs and their buffer requirements (in B), to fill
    *
    * Really used only in TDMA scheduling. Worth moving?
    */
-  static std::vector<UePtrAndBufferReq>
-  GetUeVectorFromActiveUeMap (const ActiveUeMap &activeUes);
+  static void
+  GetUeVectorFromActiveUeMap (const ActiveUeMap &activeUes, std::vector<UePtrAndBufferReq> *ueVector);
 
 private:
   typedef std::function<void (const UePtrAndBufferReq &, const FTResources &)> BeforeSchedFn; //!< Before scheduling function
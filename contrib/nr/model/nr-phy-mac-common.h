@@ -38,6 +38,8 @@
 #include <ns3/string.h>
 
 #include "sfnsf.h"
+#include "nr-dci-containers.h"
+#include "nr-pool-allocator.h"
 
 namespace ns3 {
 
@@ -168,7 +170,7 @@ struct DciInfoElementTdma
    * \param rbgBitmask Bitmask of RBG
    */
   DciInfoElementTdma (uint8_t symStart, uint8_t numSym, DciFormat format, VarTtiType type,
-                      const std::vector<uint8_t> &rbgBitmask)
+                      const RbgBitmask &rbgBitmask)
     : m_format (format),
     m_symStart (symStart),
     m_numSym (numSym),
@@ -191,9 +193,9 @@ struct DciInfoElementTdma
    * \param rv Redundancy Version per stream
    */
   DciInfoElementTdma (uint16_t rnti, DciFormat format, uint8_t symStart,
-                      uint8_t numSym, std::vector<uint8_t> mcs,
-                      std::vector<uint32_t> tbs, std::vector<uint8_t> ndi,
-                      std::vector<uint8_t> rv, VarTtiType type,
+                      uint8_t numSym, const StreamVector<uint8_t> &mcs,
+                      const StreamVector<uint32_t> &tbs, const StreamVector<uint8_t> &ndi,
+                      const StreamVector<uint8_t> &rv, VarTtiType type,
                       uint8_t bwpIndex, uint8_t tpc)
     : m_rnti (rnti), m_format (format), m_symStart (symStart),
     m_numSym (numSym), m_mcs (mcs), m_tbSize (tbs), m_ndi (ndi), m_rv (rv),
@@ -210,8 +212,8 @@ struct DciInfoElementTdma
    * \param rv Retransmission value
    * \param o Other object from which copy all that is not specified as parameter
    */
-  DciInfoElementTdma (uint8_t symStart, uint8_t numSym, std::vector<uint8_t> ndi,
-                      std::vector<uint8_t> rv, const DciInfoElementTdma &o)
+  DciInfoElementTdma (uint8_t symStart, uint8_t numSym, const StreamVector<uint8_t> &ndi,
+                      const StreamVector<uint8_t> &rv, const DciInfoElementTdma &o)
     : m_rnti (o.m_rnti),
       m_format (o.m_format),
       m_symStart (symStart),
@@ -230,8 +232,8 @@ struct DciInfoElementTdma
 
   
   DciInfoElementTdma (uint16_t rnti, DciFormat format, uint8_t symStart,
-                      uint8_t numSym, std::vector<uint8_t> mcs, std::vector<uint32_t> tbs, std::vector<uint8_t> ndi,
-                      std::vector<uint8_t> rv, VarTtiType type, uint8_t bwpIndex, uint8_t m_harqProcess, const std::vector<uint8_t> &rbgBitmask, uint8_t tpc)
+                      uint8_t numSym, const StreamVector<uint8_t> &mcs, const StreamVector<uint32_t> &tbs, const StreamVector<uint8_t> &ndi,
+                      const StreamVector<uint8_t> &rv, VarTtiType type, uint8_t bwpIndex, uint8_t m_harqProcess, const RbgBitmask &rbgBitmask, uint8_t tpc)
     : m_rnti (rnti), m_format (format), m_symStart (symStart),
     m_numSym (numSym), m_mcs (mcs), m_tbSize (tbs), m_ndi (ndi), m_rv (rv), m_type (type),
     m_bwpIndex (bwpIndex), m_harqProcess(0) ,m_rbgBitmask(rbgBitmask),m_tpc(tpc)
@@ -242,17 +244,37 @@ struct DciInfoElementTdma
   const DciFormat m_format    {DL}; //!< DCI format
   const uint8_t m_symStart    {0}; //!< starting symbol index for flexible TTI scheme
   const uint8_t m_numSym      {0}; //!< number of symbols for flexible TTI scheme
-  const std::vector<uint8_t> m_mcs; //!< MCS per stream
-  const std::vector<uint32_t> m_tbSize; //!< TB size per stream
-  const std::vector<uint8_t> m_ndi; //!< New Data Indicator per stream (Old comment: By default is retransmission. Zoraze to check if it has any effect)
-  const std::vector<uint8_t> m_rv; //!< Redundancy Version per stream (Old comment: // not used for UL DCI. Zoraze to check why?)
+  const StreamVector<uint8_t> m_mcs; //!< MCS per stream
+  const StreamVector<uint32_t> m_tbSize; //!< TB size per stream
+  const StreamVector<uint8_t> m_ndi; //!< New Data Indicator per stream (Old comment: By default is retransmission. Zoraze to check if it has any effect)
+  const StreamVector<uint8_t> m_rv; //!< Redundancy Version per stream (Old comment: // not used for UL DCI. Zoraze to check why?)
   const VarTtiType m_type     {SRS}; //!< Var TTI type
   const uint8_t m_bwpIndex    {0}; //!< BWP Index to identify to which BWP this DCI applies to.
   uint8_t m_harqProcess       {0}; //!< HARQ process id
-  std::vector<uint8_t> m_rbgBitmask  {};   //!< RBG mask: 0 if the RBG is not used, 1 otherwise
+  RbgBitmask m_rbgBitmask  {};       //!< RBG mask: 0 if the RBG is not used, 1 otherwise
   const uint8_t m_tpc         {0}; //!< Tx power control command
 };
 
+/**
+ * \ingroup utils
+ * \brief Create a DCI, taking its memory from a pool
+ *
+ * The DCIs are created and destroyed at every slot by the schedulers and by
+ * the PHYs: this function recycles the memory of the DCIs that are not
+ * used anymore. The arguments are the same of the DciInfoElementTdma
+ * constructors.
+ *
+ * \param args the arguments of the DciInfoElementTdma constructor
+ * \return a shared pointer to the new DCI
+ */
+template <typename... Args>
+std::shared_ptr<DciInfoElementTdma>
+CreatePooledDci (Args &&... args)
+{
+  return std::allocate_shared<DciInfoElementTdma> (NrPoolAllocator<DciInfoElementTdma> (),
+                                                   std::forward<Args> (args)...);
+}
+
 /**
  * \ingroup utils
  * \brief The TbAllocInfo struct
@@ -146,6 +146,14 @@ public:
    */
   virtual uint32_t GetRbNum () const = 0;
 
+  /**
+   * \brief Notify the PHY that the MAC has new work to do (e.g., a BSR was
+   * received from the upper layers)
+   *
+   * A PHY that skips idle slots must process the next slot boundary.
+   */
+  virtual void NotifyMacActivity () = 0;
+
   // Configured Grant
   virtual Time GetTbUlEncodeLatency () const = 0;
 };
@@ -298,6 +306,24 @@ public:
    */
   virtual void SlotIndication (SfnSf s) = 0;
 
+  /**
+   * \brief Indicate to the MAC a slot that the PHY did not process because
+   * the UE was idle
+   * \param s SfnSf of the skipped slot
+   * \param slotStart the time at which the slot started
+   *
+   * Only the MAC slot counters are updated: the MAC was idle when the slot
+   * started, so nothing else would have happened in SlotIndication().
+   */
+  virtual void SkippedSlotIndication (SfnSf s, Time slotStart) = 0;
+
+  /**
+   * \brief Ask the MAC if it has something to do at the next slot indications
+   * \return true if the next slot indications would only update the MAC slot
+   * counters (no SR or configured grant work pending)
+   */
+  virtual bool IsIdle () const = 0;
+
   /**
    * \brief Retrieve the number of HARQ processes configured
    * \return the number of the configured HARQ processes.
@@ -72,6 +72,8 @@ public:
 
   virtual uint32_t GetRbNum () const override;
 
+  virtual void NotifyMacActivity () override;
+
   // Configured Grant
   virtual Time GetTbUlEncodeLatency () const override;
 
@@ -157,6 +159,12 @@ NrMemberPhySapProvider::GetRbNum () const
   return m_phy->GetRbNum ();
 }
 
+void
+NrMemberPhySapProvider::NotifyMacActivity ()
+{
+  m_phy->NotifyPendingActivity ();
+}
+
 // Configured Grant
 Time
 NrMemberPhySapProvider::GetTbUlEncodeLatency() const
@@ -463,6 +471,7 @@ NrPhy::EnqueueCtrlMessage (const Ptr<NrControlMessage> &m)
   NS_LOG_FUNCTION (this);
 
   m_controlMessageQueue.at (m_controlMessageQueue.size () - 1).push_back (m);
+  NotifyPendingActivity ();
 }
 
 void
@@ -471,6 +480,7 @@ NrPhy::EnqueueCtrlMsgNow (const Ptr<NrControlMessage> &msg)
   NS_LOG_FUNCTION (this);
 
   m_controlMessageQueue.at (0).push_back (msg);
+  NotifyPendingActivity ();
 }
 
 void
@@ -480,6 +490,7 @@ NrPhy::EnqueueCtrlMsgNow (const std::list<Ptr<NrControlMessage> > &listOfMsgs)
     {
       m_controlMessageQueue.at (0).push_back (msg);
     }
+  NotifyPendingActivity ();
 }
 
 void
@@ -487,6 +498,7 @@ NrPhy::EncodeCtrlMsg (const Ptr<NrControlMessage> &msg)
 {
   NS_LOG_FUNCTION (this);
   m_ctrlMsgs.push_back (msg);
+  NotifyPendingActivity ();
 }
 
 bool
@@ -739,6 +751,14 @@ NrPhy::PushBackSlotAllocInfo (const SlotAllocInfo &slotAllocInfo)
       output << alloc;
     }
   NS_LOG_INFO (output.str ());
+
+  NotifyPendingActivity ();
+}
+
+void
+NrPhy::NotifyPendingActivity ()
+{
+  NS_LOG_FUNCTION (this);
 }
 
 void
@@ -871,6 +891,43 @@ NrPhy::IsCtrlMsgListEmpty() const
   return m_controlMessageQueue.empty () || m_controlMessageQueue.at (0).empty();
 }
 
+bool
+NrPhy::HasPendingCtrlMsgs () const
+{
+  NS_LOG_FUNCTION (this);
+  if (! m_ctrlMsgs.empty ())
+    {
+      return true;
+    }
+  for (const auto & msgList : m_controlMessageQueue)
+    {
+      if (! msgList.empty ())
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+uint32_t
+NrPhy::GetSlotsToNextAllocation (const SfnSf &sfnsf, uint32_t maxSlots) const
+{
+  NS_LOG_FUNCTION (this);
+  // The frame number wraps around at 2^16; compute distances modulo the
+  // corresponding number of slots.
+  const uint64_t slotsInWrap = (UINT64_C (1) << 16) * SfnSf::GetSubframesPerFrame ()
+      * sfnsf.GetSlotPerSubframe ();
+  const uint64_t from = sfnsf.Normalize ();
+
+  uint64_t ret = maxSlots;
+  for (const auto & alloc : m_slotAllocInfo)
+    {
+      uint64_t distance = (alloc.m_sfnSf.Normalize () + slotsInWrap - from) % slotsInWrap;
+      ret = std::min (ret, distance);
+    }
+  return static_cast<uint32_t> (ret);
+}
+
 Ptr<const SpectrumModel>
 NrPhy::GetSpectrumModel ()
 {
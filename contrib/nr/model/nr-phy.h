@@ -134,6 +134,15 @@ public:
    */
   void PushBackSlotAllocInfo (const SlotAllocInfo &slotAllocInfo);
 
+  /**
+   * \brief Notify the PHY that something has to be done in the next slots
+   *
+   * Called when a CTRL message or an allocation is stored, or when the MAC
+   * has new work to do (through the SAP). A PHY that skips its idle slots
+   * has to resume the slot processing; by default, nothing is done.
+   */
+  virtual void NotifyPendingActivity ();
+
   /**
    * \brief Notify PHY about the successful RRC connection
    * establishment.
@@ -547,6 +556,23 @@ protected:
    */
   bool IsCtrlMsgListEmpty () const;
 
+  /**
+   * \brief Check if there are CTRL messages waiting to be sent, in any slot
+   * \return true if the CTRL message queue, or the list of encoded messages,
+   * is not empty
+   */
+  bool HasPendingCtrlMsgs () const;
+
+  /**
+   * \brief Get the distance to the first slot that has an allocation stored
+   * \param sfnsf the slot from which the search starts
+   * \param maxSlots the maximum distance to return
+   * \return the number of slots between sfnsf and the first slot, starting
+   * from sfnsf included, for which an allocation is stored; maxSlots if there
+   * is none before maxSlots
+   */
+  uint32_t GetSlotsToNextAllocation (const SfnSf &sfnsf, uint32_t maxSlots) const;
+
   /**
    * \brief Enqueue a CTRL message without considering L1L2CtrlLatency
    * \param msg The message to enqueue
@@ -0,0 +1,128 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2019 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NR_POOL_ALLOCATOR_H
+#define NR_POOL_ALLOCATOR_H
+
+#include <ns3/size-class-pool.h>
+
+#include <cstddef>
+
+namespace ns3 {
+
+/**
+ * \ingroup utils
+ * \brief A standard allocator that recycles the memory of the objects
+ *
+ * The memory is taken from a SizeClassPool shared by all the NrPoolAllocator
+ * instances: the memory released with deallocate() is kept in the free list
+ * of its size class, in the releasing thread, and given back by the next
+ * allocate() of the same size class. It is meant for the objects that are
+ * created and destroyed at every slot, such as the DCIs: after the first
+ * slots, their creation does not reach the system allocator anymore.
+ *
+ * As for the events, each thread keeps at most
+ * SizeClassPool::MAX_CACHED blocks per size class and releases them when
+ * it exits, and the allocations larger than the size classes use the
+ * global allocator. GetStats() reports the use of the pool.
+ *
+ * The allocator is stateless, and it can be used with std::allocate_shared:
+ * in that case, the pooled blocks contain both the object and the reference
+ * counters.
+ */
+template <typename T>
+class NrPoolAllocator
+{
+public:
+  typedef T value_type; //!< Type of the allocated objects
+
+  /**
+   * \brief The pool of all the NrPoolAllocator instances
+   */
+  typedef SizeClassPool<NrPoolAllocator<void> > Pool;
+
+  /**
+   * \brief NrPoolAllocator constructor
+   */
+  NrPoolAllocator () noexcept = default;
+
+  /**
+   * \brief Rebind constructor
+   */
+  template <typename U>
+  NrPoolAllocator (const NrPoolAllocator<U> &) noexcept
+  {
+  }
+
+  /**
+   * \brief Allocate the memory for n objects
+   * \param n the number of objects
+   * \return the memory, taken from the free list of its size class if it
+   * is not empty
+   */
+  T * allocate (std::size_t n)
+  {
+    return static_cast<T *> (Pool::Allocate (n * sizeof (T)));
+  }
+
+  /**
+   * \brief Release the memory of n objects
+   * \param p the memory, previously obtained with allocate()
+   * \param n the number of objects
+   */
+  void deallocate (T *p, std::size_t n) noexcept
+  {
+    Pool::Deallocate (p, n * sizeof (T));
+  }
+
+  /**
+   * \return the statistics of the pool of all the NrPoolAllocator instances,
+   * for the calling thread and the threads that have exited
+   */
+  static typename Pool::Stats GetStats ()
+  {
+    return Pool::GetStats ();
+  }
+};
+
+/**
+ * \brief All the NrPoolAllocator instances are equivalent
+ * \return true
+ */
+template <typename T, typename U>
+bool
+operator == (const NrPoolAllocator<T> &, const NrPoolAllocator<U> &)
+{
+  return true;
+}
+
+/**
+ * \brief All the NrPoolAllocator instances are equivalent
+ * \return false
+ */
+template <typename T, typename U>
+bool
+operator != (const NrPoolAllocator<T> &, const NrPoolAllocator<U> &)
+{
+  return false;
+}
+
+} // namespace ns3
+
+#endif /* NR_POOL_ALLOCATOR_H */
@@ -32,6 +32,8 @@
 #include "nr-ue-net-device.h"
 #include "nr-gnb-net-device.h"
 
+#include <mutex>
+
 NS_LOG_COMPONENT_DEFINE ("nrRrcProtocolIdeal");
 
 
@@ -177,10 +179,12 @@ nrUeRrcProtocolIdeal::SetEnbRrcSapProvider ()
 {
   uint16_t bwpId = m_rrc->GetCellId ();
 
-  // walk list of all nodes to get the peer gNB
-  Ptr<NrGnbNetDevice> gnbDev;
+  // the gNBs installed by the NrHelper are in the registry
+  Ptr<NrGnbNetDevice> gnbDev = NrGnbNetDevice::GetGnbByBwpId (bwpId);
+  bool found = gnbDev != nullptr;
+
+  // otherwise, walk list of all nodes to get the peer gNB
   NodeList::Iterator listEnd = NodeList::End ();
-  bool found = false;
   for (NodeList::Iterator i = NodeList::Begin ();
        (i != listEnd) && (!found);
        ++i)
@@ -381,10 +385,15 @@ NrGnbRrcProtocolIdeal::DoSendRrcConnectionReject (uint16_t rnti, LteRrcSap::RrcC
  * actual message in a global map, so that then we can just encode the
  * key in a header and send that between gNBs over X2.
  *
+ * The message is encoded by a gNB and decoded by another one, which may run
+ * in a different thread with the MultithreadedSimulatorImpl: the map is
+ * protected by a mutex.
+ *
  */
 
 static std::map<uint32_t, LteRrcSap::HandoverPreparationInfo> g_handoverPreparationInfoMsgMap;
 static uint32_t g_handoverPreparationInfoMsgIdCounter = 0;
+static std::mutex g_handoverPreparationInfoMsgMutex;
 
 /*
  * This header encodes the map key discussed above. We keep this
@@ -462,6 +471,7 @@ uint32_t NrIdealHandoverPreparationInfoHeader::Deserialize (Buffer::Iterator sta
 Ptr<Packet>
 NrGnbRrcProtocolIdeal::DoEncodeHandoverPreparationInformation (LteRrcSap::HandoverPreparationInfo msg)
 {
+  std::lock_guard<std::mutex> lock (g_handoverPreparationInfoMsgMutex);
   uint32_t msgId = ++g_handoverPreparationInfoMsgIdCounter;
   NS_ASSERT_MSG (g_handoverPreparationInfoMsgMap.find (msgId) == g_handoverPreparationInfoMsgMap.end (), "msgId " << msgId << " already in use");
   NS_LOG_INFO (" encoding msgId = " << msgId);
@@ -480,6 +490,7 @@ NrGnbRrcProtocolIdeal::DoDecodeHandoverPreparationInformation (Ptr<Packet> p)
   p->RemoveHeader (h);
   uint32_t msgId = h.GetMsgId ();
   NS_LOG_INFO (" decoding msgId = " << msgId);
+  std::lock_guard<std::mutex> lock (g_handoverPreparationInfoMsgMutex);
   std::map<uint32_t, LteRrcSap::HandoverPreparationInfo>::iterator it = g_handoverPreparationInfoMsgMap.find (msgId);
   NS_ASSERT_MSG (it != g_handoverPreparationInfoMsgMap.end (), "msgId " << msgId << " not found");
   LteRrcSap::HandoverPreparationInfo msg = it->second;
@@ -491,6 +502,7 @@ NrGnbRrcProtocolIdeal::DoDecodeHandoverPreparationInformation (Ptr<Packet> p)
 
 static std::map<uint32_t, LteRrcSap::RrcConnectionReconfiguration> g_handoverCommandMsgMap;
 static uint32_t g_handoverCommandMsgIdCounter = 0;
+static std::mutex g_handoverCommandMsgMutex;
 
 /*
  * This header encodes the map key discussed above. We keep this
@@ -568,6 +580,7 @@ uint32_t NrIdealHandoverCommandHeader::Deserialize (Buffer::Iterator start)
 Ptr<Packet>
 NrGnbRrcProtocolIdeal::DoEncodeHandoverCommand (LteRrcSap::RrcConnectionReconfiguration msg)
 {
+  std::lock_guard<std::mutex> lock (g_handoverCommandMsgMutex);
   uint32_t msgId = ++g_handoverCommandMsgIdCounter;
   NS_ASSERT_MSG (g_handoverCommandMsgMap.find (msgId) == g_handoverCommandMsgMap.end (), "msgId " << msgId << " already in use");
   NS_LOG_INFO (" encoding msgId = " << msgId);
@@ -586,6 +599,7 @@ NrGnbRrcProtocolIdeal::DoDecodeHandoverCommand (Ptr<Packet> p)
   p->RemoveHeader (h);
   uint32_t msgId = h.GetMsgId ();
   NS_LOG_INFO (" decoding msgId = " << msgId);
+  std::lock_guard<std::mutex> lock (g_handoverCommandMsgMutex);
   std::map<uint32_t, LteRrcSap::RrcConnectionReconfiguration>::iterator it = g_handoverCommandMsgMap.find (msgId);
   NS_ASSERT_MSG (it != g_handoverCommandMsgMap.end (), "msgId " << msgId << " not found");
   LteRrcSap::RrcConnectionReconfiguration msg = it->second;
@@ -504,7 +504,7 @@ NrSpectrumPhy::StartTxDataFrames (const Ptr<PacketBurst>& pb, const std::list<Pt
         txParams->ctrlMsgList = ctrlMsgList;
 
         /* This section is used for trace */
-        if (IsEnb ())
+        if (IsEnb () && !m_txPacketTraceEnb.IsEmpty ())
           {
             GnbPhyPacketCountParameter traceParam;
             traceParam.m_noBytes = (txParams->packetBurst) ? txParams->packetBurst->GetSize () : 0;
@@ -1125,8 +1125,10 @@ NrSpectrumPhy::EndRxData ()
   NS_LOG_FUNCTION (this);
   m_interferenceData->EndRx ();
 
+#ifndef NR_DISABLE_STATISTICS
   Ptr<NrGnbNetDevice> enbRx = DynamicCast<NrGnbNetDevice> (GetDevice ());
   Ptr<NrUeNetDevice> ueRx = DynamicCast<NrUeNetDevice> (GetDevice ());
+#endif
 
   NS_ASSERT (m_state == RX_DATA);
 
@@ -1238,47 +1240,52 @@ NrSpectrumPhy::EndRxData ()
               NS_LOG_INFO ("TB failed");
             }
 
-          RxPacketTraceParams traceParams;
-          traceParams.m_tbSize = GetTBInfo(*itTb).m_expected.m_tbSize;
-          traceParams.m_frameNum = GetTBInfo(*itTb).m_expected.m_sfn.GetFrame ();
-          traceParams.m_subframeNum = GetTBInfo(*itTb).m_expected.m_sfn.GetSubframe ();
-          traceParams.m_slotNum = GetTBInfo(*itTb).m_expected.m_sfn.GetSlot ();
-          traceParams.m_rnti = rnti;
-          traceParams.m_mcs = GetTBInfo(*itTb).m_expected.m_mcs;
-          traceParams.m_rv = GetTBInfo(*itTb).m_expected.m_rv;
-          traceParams.m_sinr = GetTBInfo(*itTb).m_sinrAvg;
-          traceParams.m_sinrMin = GetTBInfo(*itTb).m_sinrMin;
-          if (m_dataErrorModelEnabled)
+#ifndef NR_DISABLE_STATISTICS
+          if ((enbRx && !m_rxPacketTraceEnb.IsEmpty ()) || (ueRx && !m_rxPacketTraceUe.IsEmpty ()))
             {
-              traceParams.m_tbler = GetTBInfo (*itTb).m_outputOfEM->m_tbler;
-              traceParams.m_corrupt = GetTBInfo (*itTb).m_isCorrupted;
-            }
-          else
-            {
-              //when error model is disabled a received TB has no
-              //error, thus, TBLER would be 0 and it would be
-              //considered as not corrupt.
-              traceParams.m_tbler = 0;
-              traceParams.m_corrupt = false;
-            }
-          traceParams.m_symStart = GetTBInfo(*itTb).m_expected.m_symStart;
-          traceParams.m_numSym = GetTBInfo(*itTb).m_expected.m_numSym;
-          traceParams.m_bwpId = GetBwpId ();
-          traceParams.m_streamId = m_streamId;
-          traceParams.m_rbAssignedNum = static_cast<uint32_t> (GetTBInfo(*itTb).m_expected.m_rbBitmap.size ());
+              RxPacketTraceParams traceParams;
+              traceParams.m_tbSize = GetTBInfo(*itTb).m_expected.m_tbSize;
+              traceParams.m_frameNum = GetTBInfo(*itTb).m_expected.m_sfn.GetFrame ();
+              traceParams.m_subframeNum = GetTBInfo(*itTb).m_expected.m_sfn.GetSubframe ();
+              traceParams.m_slotNum = GetTBInfo(*itTb).m_expected.m_sfn.GetSlot ();
+              traceParams.m_rnti = rnti;
+              traceParams.m_mcs = GetTBInfo(*itTb).m_expected.m_mcs;
+              traceParams.m_rv = GetTBInfo(*itTb).m_expected.m_rv;
+              traceParams.m_sinr = GetTBInfo(*itTb).m_sinrAvg;
+              traceParams.m_sinrMin = GetTBInfo(*itTb).m_sinrMin;
+              if (m_dataErrorModelEnabled)
+                {
+                  traceParams.m_tbler = GetTBInfo (*itTb).m_outputOfEM->m_tbler;
+                  traceParams.m_corrupt = GetTBInfo (*itTb).m_isCorrupted;
+                }
+              else
+                {
+                  //when error model is disabled a received TB has no
+                  //error, thus, TBLER would be 0 and it would be
+                  //considered as not corrupt.
+                  traceParams.m_tbler = 0;
+                  traceParams.m_corrupt = false;
+                }
+              traceParams.m_symStart = GetTBInfo(*itTb).m_expected.m_symStart;
+              traceParams.m_numSym = GetTBInfo(*itTb).m_expected.m_numSym;
+              traceParams.m_bwpId = GetBwpId ();
+              traceParams.m_streamId = m_streamId;
+              traceParams.m_rbAssignedNum = static_cast<uint32_t> (GetTBInfo(*itTb).m_expected.m_rbBitmap.size ());
 
-          if (enbRx)
-            {
-              traceParams.m_cellId = enbRx->GetCellId ();
-              m_rxPacketTraceEnb (traceParams);
-            }
-          else if (ueRx)
-            {
-              traceParams.m_cellId = ueRx->GetTargetEnb ()->GetCellId ();
-              Ptr<NrUePhy> phy = (DynamicCast<NrUePhy>(m_phy));
-              traceParams.m_cqi = phy->ComputeCqi (m_sinrPerceived);
-              m_rxPacketTraceUe (traceParams);
+              if (enbRx)
+                {
+                  traceParams.m_cellId = enbRx->GetCellId ();
+                  m_rxPacketTraceEnb (traceParams);
+                }
+              else if (ueRx)
+                {
+                  traceParams.m_cellId = ueRx->GetTargetEnb ()->GetCellId ();
+                  Ptr<NrUePhy> phy = (DynamicCast<NrUePhy>(m_phy));
+                  traceParams.m_cqi = phy->ComputeCqi (m_sinrPerceived);
+                  m_rxPacketTraceUe (traceParams);
+                }
             }
+#endif
 
 
           // send HARQ feedback (if not already done for this TB)
@@ -40,7 +40,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("NrUeMac");
 NS_OBJECT_ENSURE_REGISTERED (NrUeMac);
 
-uint8_t NrUeMac::g_raPreambleId = 0;
+std::atomic<uint8_t> NrUeMac::g_raPreambleId (0);
 
 ///////////////////////////////////////////////////////////
 // SAP forwarders
@@ -170,6 +170,10 @@ public:
 
   virtual void SlotIndication (SfnSf sfn) override;
 
+  virtual void SkippedSlotIndication (SfnSf sfn, Time slotStart) override;
+
+  virtual bool IsIdle () const override;
+
   //virtual void NotifyHarqDeliveryFailure (uint8_t harqId);
 
   virtual uint8_t GetNumHarqProcess () const override;
@@ -202,6 +206,18 @@ MacUeMemberPhySapUser::SlotIndication (SfnSf sfn)
   m_mac->DoSlotIndication (sfn);
 }
 
+void
+MacUeMemberPhySapUser::SkippedSlotIndication (SfnSf sfn, Time slotStart)
+{
+  m_mac->DoSkippedSlotIndication (sfn, slotStart);
+}
+
+bool
+MacUeMemberPhySapUser::IsIdle () const
+{
+  return m_mac->IsIdle ();
+}
+
 uint8_t
 MacUeMemberPhySapUser::GetNumHarqProcess () const
 {
@@ -397,6 +413,10 @@ NrUeMac::DoReportBufferStatus (LteMacSapProvider::ReportBufferStatusParameters p
 
   NS_LOG_INFO ("Received BSR for LC Id" << static_cast<uint32_t> (params.lcid));
 
+  // Let the PHY catch up with the current slot (if it was skipping idle
+  // slots) before the state machine leaves the idle state
+  m_phySapProvider->NotifyMacActivity ();
+
   if (it != m_ulBsrReceived.end ())
     {
       // update entry
@@ -585,6 +605,28 @@ NrUeMac::DoSlotIndication (const SfnSf &sfn)
   // Feedback missing
 }
 
+void
+NrUeMac::DoSkippedSlotIndication (const SfnSf &sfn, const Time &slotStart)
+{
+  NS_LOG_FUNCTION (this);
+  m_currentSlot = sfn;
+  // Same as the idle branch of DoSlotIndication_configuredGrant
+  m_startSlotTime = slotStart;
+  NS_LOG_INFO ("Skipped slot " << m_currentSlot);
+}
+
+bool
+NrUeMac::IsIdle () const
+{
+  NS_LOG_FUNCTION (this);
+  if (m_cgScheduling)
+    {
+      return m_srState_configuredGrant != TO_SEND_TrafficInfo
+          && m_srState_configuredGrant != SCH_CG_DATA;
+    }
+  return m_srState != TO_SEND;
+}
+
 void
 NrUeMac::SendSR () const
 {
@@ -663,7 +705,7 @@ NrUeMac::ProcessUlDci (const Ptr<NrUlDciMessage> &dciMsg)
   // It represents the TO_RECEIVE_CG state
   if (m_cgScheduling)
     {
-      m_dciGranted_stored[cg_slot_counter_DCI] = std::make_shared<DciInfoElementTdma> (
+      m_dciGranted_stored[cg_slot_counter_DCI] = CreatePooledDci (
           m_ulDci->m_rnti, m_ulDci->m_format, m_ulDci->m_symStart, m_ulDci->m_numSym,
           m_ulDci->m_mcs, m_ulDci->m_tbSize, m_ulDci->m_ndi, m_ulDci->m_rv, m_ulDci->m_type,
           m_ulDci->m_bwpIndex, m_ulDci->m_harqProcess, m_ulDci->m_rbgBitmask, m_ulDci->m_tpc);
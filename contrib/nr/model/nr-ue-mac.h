@@ -29,6 +29,7 @@
 #include <ns3/lte-ccm-mac-sap.h>
 #include <ns3/traced-callback.h>
 
+#include <atomic>
 #include <unordered_map>
 
 namespace ns3 {
@@ -262,6 +263,20 @@ private:
    */
   void DoSlotIndication (const SfnSf &sfn);
 
+  /**
+   * \brief A slot was skipped by the PHY while we were idle: only update the
+   * slot counters
+   * \param sfn the skipped slot
+   * \param slotStart the time at which the slot started
+   */
+  void DoSkippedSlotIndication (const SfnSf &sfn, const Time &slotStart);
+
+  /**
+   * \brief Check if the next slot indications have nothing to do
+   * \return true if neither a SR nor configured grant work is pending
+   */
+  bool IsIdle () const;
+
   /**
    * \brief Get the total size of the RLC buffers.
    * \return The number of bytes that are in the RLC buffers
@@ -501,7 +516,12 @@ private:
   uint16_t m_rnti {0};
 
   bool m_waitingForRaResponse {true}; //!< Indicates if we are waiting for a RA response
-  static uint8_t g_raPreambleId; //!< Preamble ID, fixed, the UEs will not have any collision
+  /**
+   * Next preamble ID: each UE takes a different one, so that the UEs do not
+   * collide. Shared by all the UEs, which may run in different threads with
+   * the MultithreadedSimulatorImpl, hence atomic
+   */
+  static std::atomic<uint8_t> g_raPreambleId;
 
   /**
    * Trace information regarding Ue MAC Received Control Messages
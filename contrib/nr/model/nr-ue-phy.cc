@@ -158,6 +158,15 @@ NrUePhy::GetTypeId (void)
                    MakeDoubleAccessor (&NrUePhy::SetRiSinrThreshold2,
                                        &NrUePhy::GetRiSinrThreshold2),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("IdleSlotFastForward",
+                   "If true, the slots in which the UE has nothing to do (no "
+                   "allocations, no CTRL messages to send, idle MAC) are not "
+                   "processed, and the PHY jumps directly to the next slot with "
+                   "an allocation. Any new activity or CTRL reception resumes "
+                   "the slot processing.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NrUePhy::m_idleSlotFastForward),
+                   MakeBooleanChecker ())
     .AddTraceSource ("DlDataSinr",
                      "DL DATA SINR statistics.",
                      MakeTraceSourceAccessor (&NrUePhy::m_dlDataSinrTrace),
@@ -481,6 +490,8 @@ NrUePhy::PhyCtrlMessagesReceived (const Ptr<NrControlMessage> &msg)
 {
   NS_LOG_FUNCTION (this);
 
+  ResumeSlotInProgress ();
+
   if (msg->GetMessageType () == NrControlMessage::DL_DCI)
     {
       auto dciMsg = DynamicCast<NrDlDciMessage> (msg);
@@ -722,9 +733,9 @@ NrUePhy::PushCtrlAllocations (const SfnSf currentSfnSf)
   if (m_tddPattern.size () == 0)
     {
       NS_LOG_INFO ("TDD Pattern unknown, insert DL CTRL at the beginning of the slot");
-      VarTtiAllocInfo dlCtrlSlot (std::make_shared<DciInfoElementTdma> (0, m_dlCtrlSyms,
-                                                                        DciInfoElementTdma::DL,
-                                                                        DciInfoElementTdma::CTRL, rbgBitmask));
+      VarTtiAllocInfo dlCtrlSlot (CreatePooledDci (0, m_dlCtrlSyms,
+                                                   DciInfoElementTdma::DL,
+                                                   DciInfoElementTdma::CTRL, rbgBitmask));
       m_currSlotAllocInfo.m_varTtiAllocInfo.push_front (dlCtrlSlot);
       return;
     }
@@ -736,9 +747,9 @@ NrUePhy::PushCtrlAllocations (const SfnSf currentSfnSf)
       NS_LOG_INFO ("The current TDD pattern indicates that we are in a " <<
                    m_tddPattern[currentSlotN] <<
                    " slot, so insert DL CTRL at the beginning of the slot");
-      VarTtiAllocInfo dlCtrlSlot (std::make_shared<DciInfoElementTdma> (0, m_dlCtrlSyms,
-                                                                        DciInfoElementTdma::DL,
-                                                                        DciInfoElementTdma::CTRL, rbgBitmask));
+      VarTtiAllocInfo dlCtrlSlot (CreatePooledDci (0, m_dlCtrlSyms,
+                                                   DciInfoElementTdma::DL,
+                                                   DciInfoElementTdma::CTRL, rbgBitmask));
       m_currSlotAllocInfo.m_varTtiAllocInfo.push_front (dlCtrlSlot);
     }
   if (m_tddPattern[currentSlotN] > LteNrTddSlotType::DL)
@@ -746,10 +757,10 @@ NrUePhy::PushCtrlAllocations (const SfnSf currentSfnSf)
       NS_LOG_INFO ("The current TDD pattern indicates that we are in a " <<
                    m_tddPattern[currentSlotN] <<
                    " slot, so insert UL CTRL at the end of the slot");
-      VarTtiAllocInfo ulCtrlSlot (std::make_shared<DciInfoElementTdma> (GetSymbolsPerSlot () - m_ulCtrlSyms,
-                                                                        m_ulCtrlSyms,
-                                                                        DciInfoElementTdma::UL,
-                                                                        DciInfoElementTdma::CTRL, rbgBitmask));
+      VarTtiAllocInfo ulCtrlSlot (CreatePooledDci (GetSymbolsPerSlot () - m_ulCtrlSyms,
+                                                   m_ulCtrlSyms,
+                                                   DciInfoElementTdma::UL,
+                                                   DciInfoElementTdma::CTRL, rbgBitmask));
       m_currSlotAllocInfo.m_varTtiAllocInfo.push_back (ulCtrlSlot);
     }
 }
@@ -1040,7 +1051,10 @@ NrUePhy::DlData (const std::shared_ptr<DciInfoElementTdma> &dci)
                                                          dci->m_harqProcess, dci->m_rv.at (streamIndex), true,
                                                          dci->m_symStart, dci->m_numSym, m_currentSlot);
                                                          
-          m_reportDlTbSize (m_netDevice->GetObject <NrUeNetDevice> ()->GetImsi (), dci->m_tbSize.at (streamIndex));
+          if (!m_reportDlTbSize.IsEmpty ())
+            {
+              m_reportDlTbSize (m_netDevice->GetObject <NrUeNetDevice> ()->GetImsi (), dci->m_tbSize.at (streamIndex));
+            }
           NS_LOG_DEBUG ("UE" << m_rnti << " stream " << +streamIndex <<
                         " RXing DL DATA frame for"
                         " symbols "  << +dci->m_symStart <<
@@ -1086,7 +1100,10 @@ NrUePhy::UlData(const std::shared_ptr<DciInfoElementTdma> &dci)
       // if there is no data for him...
       NS_FATAL_ERROR ("The UE " << dci->m_rnti << " has been scheduled without data");
     }
-  m_reportUlTbSize (m_netDevice->GetObject <NrUeNetDevice> ()->GetImsi (), dci->m_tbSize.at (0));
+  if (!m_reportUlTbSize.IsEmpty ())
+    {
+      m_reportUlTbSize (m_netDevice->GetObject <NrUeNetDevice> ()->GetImsi (), dci->m_tbSize.at (0));
+    }
 
   NS_LOG_DEBUG ("UE" << m_rnti <<
                 " TXing UL DATA frame for" <<
@@ -1156,10 +1173,7 @@ NrUePhy::EndVarTti (const std::shared_ptr<DciInfoElementTdma> &dci)
   if (m_currSlotAllocInfo.m_varTtiAllocInfo.size () == 0)
     {
       // end of slot
-      m_currentSlot.Add (1);
-
-      Simulator::Schedule (m_lastSlotStart + GetSlotPeriod () - Simulator::Now (),
-                           &NrUePhy::StartSlot, this, m_currentSlot);
+      ScheduleNextSlot ();
     }
   else
     {
@@ -1221,6 +1235,160 @@ NrUePhy::EndVarTti (const std::shared_ptr<DciInfoElementTdma> &dci)
   m_receptionEnabled = false;
 }
 
+void
+NrUePhy::ScheduleNextSlot ()
+{
+  NS_LOG_FUNCTION (this);
+
+  SfnSf nextSlot = m_currentSlot;
+  nextSlot.Add (1);
+
+  uint32_t idleSlots = 0;
+  if (m_idleSlotFastForward && IsIdleForFastForward ())
+    {
+      // Do not look further than one frame, the decision is re-evaluated there
+      uint32_t maxSlots = SfnSf::GetSubframesPerFrame () * nextSlot.GetSlotPerSubframe ();
+      idleSlots = GetSlotsToNextAllocation (nextSlot, maxSlots);
+    }
+
+  if (idleSlots == 0)
+    {
+      m_currentSlot = nextSlot;
+      Simulator::Schedule (m_lastSlotStart + GetSlotPeriod () - Simulator::Now (),
+                           &NrUePhy::StartSlot, this, m_currentSlot);
+      return;
+    }
+
+  // m_currentSlot and m_lastSlotStart keep referring to the last processed
+  // slot: they are used to compute the slot in progress if we are woken up.
+  nextSlot.Add (idleSlots);
+  NS_LOG_INFO ("UE " << m_rnti << " idle after slot " << m_currentSlot <<
+               ", skipping " << idleSlots << " slots until " << nextSlot);
+  m_idleSlotEvent = Simulator::Schedule (m_lastSlotStart + GetSlotPeriod () * (idleSlots + 1) - Simulator::Now (),
+                                         &NrUePhy::StartSlot, this, nextSlot);
+}
+
+bool
+NrUePhy::IsIdleForFastForward () const
+{
+  NS_LOG_FUNCTION (this);
+  // Before the RRC connection, the random access has its own timings
+  return m_rnti != 0
+         && m_currSlotAllocInfo.m_varTtiAllocInfo.empty ()
+         && ! HasPendingCtrlMsgs ()
+         && m_phySapUser->IsIdle ();
+}
+
+SfnSf
+NrUePhy::GetSlotInProgress (Time &slotStart) const
+{
+  NS_LOG_FUNCTION (this);
+  Time elapsed = Simulator::Now () - m_lastSlotStart;
+  uint64_t slots = 0;
+  if (elapsed.IsStrictlyPositive ())
+    {
+      slots = (elapsed.GetTimeStep () - 1) / GetSlotPeriod ().GetTimeStep ();
+    }
+
+  SfnSf ret = m_currentSlot;
+  ret.Add (static_cast<uint32_t> (slots));
+  slotStart = m_lastSlotStart + GetSlotPeriod () * slots;
+  return ret;
+}
+
+void
+NrUePhy::NotifyPendingActivity ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (! m_idleSlotEvent.IsRunning ())
+    {
+      return;
+    }
+
+  Time slotStart;
+  SfnSf slot = GetSlotInProgress (slotStart);
+  if (! (slot == m_currentSlot))
+    {
+      // The MAC was idle when the slot in progress started
+      m_phySapUser->SkippedSlotIndication (slot, slotStart);
+    }
+
+  slot.Add (1);
+  NS_LOG_INFO ("UE " << m_rnti << " resuming the slot processing at " << slot);
+  m_idleSlotEvent.Cancel ();
+  m_idleSlotEvent = Simulator::Schedule (slotStart + GetSlotPeriod () - Simulator::Now (),
+                                         &NrUePhy::StartSlot, this, slot);
+}
+
+void
+NrUePhy::ResumeSlotInProgress ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (! m_idleSlotEvent.IsRunning ())
+    {
+      return;
+    }
+
+  Time slotStart;
+  SfnSf slot = GetSlotInProgress (slotStart);
+  if (slot == m_currentSlot)
+    {
+      // The last processed slot is still in progress, nothing to join
+      NotifyPendingActivity ();
+      return;
+    }
+
+  m_idleSlotEvent.Cancel ();
+  m_phySapUser->SkippedSlotIndication (slot, slotStart);
+  m_currentSlot = slot;
+  m_lastSlotStart = slotStart;
+
+  if (SlotAllocInfoExists (m_currentSlot))
+    {
+      m_currSlotAllocInfo = RetrieveSlotAllocInfo (m_currentSlot);
+    }
+  else
+    {
+      m_currSlotAllocInfo = SlotAllocInfo (m_currentSlot);
+    }
+  PushCtrlAllocations (m_currentSlot);
+
+  // Being idle, we had nothing to do in the allocations that have already
+  // started, apart listening to the DL CTRL that is being received.
+  while (! m_currSlotAllocInfo.m_varTtiAllocInfo.empty ())
+    {
+      auto dci = m_currSlotAllocInfo.m_varTtiAllocInfo.front ().m_dci;
+      Time varTtiStart = m_lastSlotStart + GetSymbolPeriod () * dci->m_symStart;
+      Time varTtiEnd = varTtiStart + GetSymbolPeriod () * dci->m_numSym;
+      if (varTtiStart >= Simulator::Now ())
+        {
+          break;
+        }
+      m_currSlotAllocInfo.m_varTtiAllocInfo.pop_front ();
+
+      if (dci->m_type == DciInfoElementTdma::CTRL && dci->m_format == DciInfoElementTdma::DL
+          && varTtiEnd > Simulator::Now ())
+        {
+          NS_LOG_INFO ("UE " << m_rnti << " joining slot " << m_currentSlot << " in the DL CTRL");
+          m_receptionEnabled = false;
+          varTtiEnd = varTtiStart + DlCtrl (dci);
+          Simulator::Schedule (varTtiEnd - Simulator::Now (), &NrUePhy::EndVarTti, this, dci);
+          return;
+        }
+    }
+
+  // Too late to join this slot: the DCIs will be discarded, as it happens
+  // when they are received after the DL CTRL
+  NS_LOG_INFO ("UE " << m_rnti << " cannot join slot " << m_currentSlot);
+  m_currSlotAllocInfo.m_varTtiAllocInfo.clear ();
+  SfnSf nextSlot = m_currentSlot;
+  nextSlot.Add (1);
+  Simulator::Schedule (m_lastSlotStart + GetSlotPeriod () - Simulator::Now (),
+                       &NrUePhy::StartSlot, this, nextSlot);
+}
+
 void
 NrUePhy::PhyDataPacketReceived (const Ptr<Packet> &p)
 {
@@ -1277,7 +1445,11 @@ NrUePhy::GenerateDlCqiReport (const SpectrumValue& sinr, uint8_t streamId)
   // Not totally sure what this is about. We have to check.
   if (m_ulConfigured && (m_rnti > 0) && m_receptionEnabled)
     {
-      m_dlDataSinrTrace (GetCellId (), m_rnti, ComputeAvgSinr (sinr), GetBwpId (), streamId);
+      double avgSinr = ComputeAvgSinr (sinr);
+      if (!m_dlDataSinrTrace.IsEmpty ())
+        {
+          m_dlDataSinrTrace (GetCellId (), m_rnti, avgSinr, GetBwpId (), streamId);
+        }
 
       // TODO
       // Not sure what this IF is about, seems that it can be removed,
@@ -1298,7 +1470,7 @@ NrUePhy::GenerateDlCqiReport (const SpectrumValue& sinr, uint8_t streamId)
 
       NS_ASSERT (streamId < m_prevDlWbCqi.size ());
       m_prevDlWbCqi [streamId] = wbCqi;
-      double avrgSinrdB = 10 * log10 (ComputeAvgSinr (sinr));
+      double avrgSinrdB = 10 * log10 (avgSinr);
       avrgSinr [streamId] = avrgSinrdB;
       NS_LOG_DEBUG ("Stream " << +streamId << " WB CQI " << +wbCqi << " avrg MCS " << +mcs << " avrg SINR (dB) " << avrgSinrdB);
       m_dlCqiFeedbackCounter++;
@@ -1517,6 +1689,10 @@ void
 NrUePhy::ReportDlCtrlSinr (const SpectrumValue& sinr, uint8_t streamId)
 {
   NS_LOG_FUNCTION (this);
+  if (m_dlCtrlSinrTrace.IsEmpty ())
+    {
+      return;
+    }
   uint32_t rbUsed = 0;
   double sinrSum = 0.0;
 
@@ -436,6 +436,14 @@ public:
 
   const SfnSf & GetCurrentSfnSf () const override;
 
+  /**
+   * \brief Resume the slot processing at the next slot boundary, if we were
+   * skipping idle slots
+   *
+   * \see IdleSlotFastForward attribute
+   */
+  virtual void NotifyPendingActivity () override;
+
   // From nr phy. Not used in the UE
   virtual BeamConfId GetBeamConfId (uint16_t rnti) const override;
 
@@ -630,6 +638,44 @@ private:
    */
   void EndVarTti (const std::shared_ptr<DciInfoElementTdma> &dci);
 
+  /**
+   * \brief Schedule the start of the next slot, at the end of the current one
+   *
+   * If IdleSlotFastForward is enabled and the UE has nothing to do, the
+   * slots without allocations are not processed: the next StartSlot() is
+   * scheduled directly at the first slot that has an allocation (looking
+   * at most one frame ahead). Any new activity (CTRL message, allocation,
+   * MAC work, CTRL reception) resumes the slot processing.
+   */
+  void ScheduleNextSlot ();
+
+  /**
+   * \brief Check if the slots can be skipped
+   * \return true if no CTRL message is waiting, the current slot has no
+   * allocations left, and the MAC is idle
+   */
+  bool IsIdleForFastForward () const;
+
+  /**
+   * \brief Compute the slot in progress while slots are being skipped
+   * \param slotStart will contain the start time of the slot in progress
+   * \return the slot in progress
+   *
+   * A slot that starts exactly now is not considered in progress: its
+   * StartSlot() would still be waiting in the event queue.
+   */
+  SfnSf GetSlotInProgress (Time &slotStart) const;
+
+  /**
+   * \brief Join the slot in progress after CTRL messages have been received
+   * while skipping idle slots
+   *
+   * The slot is joined only if its DL CTRL is still in progress (the DCIs
+   * that are being received refer to it); otherwise, the processing is
+   * resumed at the next slot boundary.
+   */
+  void ResumeSlotInProgress ();
+
   /**
    * \brief Set the Tx power spectral density based on the RB index vector
    * \param mask vector of the index of the RB (in SpectrumValue array)
@@ -834,6 +880,8 @@ private:
   Time m_lbtThresholdForCtrl; //!< Threshold for LBT before the UL CTRL
   bool m_tryToPerformLbt {false}; //!< Boolean value set in DlCtrl() method
   EventId m_lbtEvent;
+  bool m_idleSlotFastForward {false}; //!< Skip the idle slots (attribute)
+  EventId m_idleSlotEvent; //!< StartSlot() event, when idle slots are being skipped
   uint8_t m_dlCtrlSyms {1}; //!< Number of CTRL symbols in DL
   uint8_t m_ulCtrlSyms {1}; //!< Number of CTRL symbols in UL
 
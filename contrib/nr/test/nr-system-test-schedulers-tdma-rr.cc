@@ -19,6 +19,10 @@
 
 #include "ns3/test.h"
 #include "system-scheduler-test.h"
+#include <ns3/nr-module.h>
+#include <ns3/internet-module.h>
+#include <ns3/antenna-module.h>
+#include <tuple>
 
 using namespace ns3;
 
@@ -225,3 +229,301 @@ NrSystemTestSchedulerTdmaRrDlUlSuite::NrSystemTestSchedulerTdmaRrDlUlSuite ()
 static NrSystemTestSchedulerTdmaRrDlUlSuite nrSystemTestSchedulerTdmaRrDlUlSuite;
 
 // ----------------------------------------------------------------------------
+
+/**
+ * \brief Periodic UL traffic with configured grant, with the UEs skipping
+ * their idle slots
+ *
+ * Each UE sends a packet to trigger the configuration of its grant, then,
+ * once the configuration time (60 ms) is over, a packet every 10 ms, directly
+ * through its NrUeNetDevice (as the scratch program ConfiguredGrant_firstTest
+ * does). The simulation is run with the NrUePhy IdleSlotFastForward attribute
+ * enabled and disabled: the RLC of the gNB must receive the same PDUs, at the
+ * same times and with the same delays, and the UEs skipping their idle slots
+ * must execute fewer events.
+ */
+class NrConfiguredGrantIdleSlotFastForwardTest : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param name the name of the test case
+   * \param ueNum the number of UEs
+   * \param numerology the numerology
+   */
+  NrConfiguredGrantIdleSlotFastForwardTest (const std::string & name, uint32_t ueNum,
+                                            uint32_t numerology);
+
+private:
+  virtual void DoRun (void) override;
+
+  /// A PDU received by the RLC of the gNB: time (ns), RNTI, size, delay (ns)
+  typedef std::tuple<int64_t, uint16_t, uint32_t, uint64_t> RxPdu;
+
+  /**
+   * \brief Run the simulation
+   * \param idleSlotFastForward the value of the NrUePhy IdleSlotFastForward attribute
+   * \param events will contain the number of events executed
+   * \return the PDUs received by the RLC of the gNB, sorted
+   */
+  std::vector<RxPdu> Simulate (bool idleSlotFastForward, uint64_t &events);
+  /**
+   * \brief Send an UL packet and schedule the next one
+   * \param device the UE device
+   * \param dest the address of the gNB device
+   * \param sent the number of packets already sent by the UE
+   */
+  void SendPacket (Ptr<NetDevice> device, Address dest, uint32_t sent);
+  /**
+   * \brief Store a PDU received by the RLC of the gNB
+   * \param path the trace path
+   * \param rnti the RNTI of the UE
+   * \param lcid the LCID
+   * \param bytes the PDU size
+   * \param delay the RLC delay
+   */
+  void RxRlcPdu (std::string path, uint16_t rnti, uint8_t lcid, uint32_t bytes, uint64_t delay);
+  /**
+   * \brief Connect the RLC of the gNB bearers to RxRlcPdu
+   */
+  void ConnectRlc (void);
+
+  uint32_t m_ueNum {0};              //!< Number of UEs
+  uint32_t m_numerology {0};         //!< Numerology
+  std::vector<RxPdu> m_rxPdus;       //!< PDUs received by the RLC of the gNB
+};
+
+NrConfiguredGrantIdleSlotFastForwardTest::NrConfiguredGrantIdleSlotFastForwardTest (const std::string & name,
+                                                                                    uint32_t ueNum,
+                                                                                    uint32_t numerology)
+  : TestCase (name),
+    m_ueNum (ueNum),
+    m_numerology (numerology)
+{
+}
+
+void
+NrConfiguredGrantIdleSlotFastForwardTest::SendPacket (Ptr<NetDevice> device, Address dest, uint32_t sent)
+{
+  // Size, periodicity (ms) and deadline (ns) of the traffic, as read by the
+  // configured grant scheduling
+  Ptr<Packet> pkt = Create<Packet> (10, 10, 10000000);
+  Ipv4Header ipv4Header;
+  ipv4Header.SetProtocol (Ipv4L3Protocol::PROT_NUMBER);
+  pkt->AddHeader (ipv4Header);
+  device->Send (pkt, dest, Ipv4L3Protocol::PROT_NUMBER);
+
+  // The first packet asks for the grant: wait for its configuration
+  Time next = sent == 0 ? MilliSeconds (60) : MilliSeconds (10);
+  Simulator::Schedule (next, &NrConfiguredGrantIdleSlotFastForwardTest::SendPacket,
+                       this, device, dest, sent + 1);
+}
+
+void
+NrConfiguredGrantIdleSlotFastForwardTest::RxRlcPdu ([[maybe_unused]] std::string path, uint16_t rnti,
+                                                    [[maybe_unused]] uint8_t lcid, uint32_t bytes,
+                                                    uint64_t delay)
+{
+  m_rxPdus.emplace_back (Simulator::Now ().GetNanoSeconds (), rnti, bytes, delay);
+}
+
+void
+NrConfiguredGrantIdleSlotFastForwardTest::ConnectRlc (void)
+{
+  Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/UeMap/*/DataRadioBearerMap/*/LteRlc/RxPDU",
+                   MakeCallback (&NrConfiguredGrantIdleSlotFastForwardTest::RxRlcPdu, this));
+}
+
+std::vector<NrConfiguredGrantIdleSlotFastForwardTest::RxPdu>
+NrConfiguredGrantIdleSlotFastForwardTest::Simulate (bool idleSlotFastForward, uint64_t &events)
+{
+  m_rxPdus.clear ();
+
+  Config::SetDefault ("ns3::NrUePhy::IdleSlotFastForward", BooleanValue (idleSlotFastForward));
+  Config::SetDefault ("ns3::ThreeGppChannelModel::UpdatePeriod", TimeValue (MilliSeconds (0)));
+
+  NodeContainer gNbNodes;
+  NodeContainer ueNodes;
+  gNbNodes.Create (1);
+  ueNodes.Create (m_ueNum);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 10.0));
+  for (uint32_t i = 0; i < m_ueNum; ++i)
+    {
+      positionAlloc->Add (Vector (1.0 + 0.5 * i, 5.0, 1.5));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (gNbNodes);
+  mobility.Install (ueNodes);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<IdealBeamformingHelper> idealBeamformingHelper = CreateObject<IdealBeamformingHelper> ();
+  idealBeamformingHelper->SetAttribute ("BeamformingMethod",
+                                        TypeIdValue (QuasiOmniDirectPathBeamforming::GetTypeId ()));
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetBeamformingHelper (idealBeamformingHelper);
+  nrHelper->SetEpcHelper (epcHelper);
+  nrHelper->SetHarqEnabled (false);
+
+  // Configured grant scheduling, in the UEs and in the gNB
+  uint8_t configurationTime = 60;
+  nrHelper->SetUeMacAttribute ("CG", BooleanValue (true));
+  nrHelper->SetUePhyAttribute ("CG", BooleanValue (true));
+  nrHelper->SetGnbMacAttribute ("CG", BooleanValue (true));
+  nrHelper->SetGnbPhyAttribute ("CG", BooleanValue (true));
+  nrHelper->SetUeMacAttribute ("ConfigurationTime", UintegerValue (configurationTime));
+  nrHelper->SetUePhyAttribute ("ConfigurationTime", UintegerValue (configurationTime));
+  nrHelper->SetGnbMacAttribute ("ConfigurationTime", UintegerValue (configurationTime));
+  nrHelper->SetGnbPhyAttribute ("ConfigurationTime", UintegerValue (configurationTime));
+
+  nrHelper->SetSchedulerTypeId (NrMacSchedulerTdmaRR::GetTypeId ());
+  nrHelper->SetSchedulerAttribute ("SrsSymbols", UintegerValue (0));
+  nrHelper->SetSchedulerAttribute ("EnableHarqReTx", BooleanValue (false));
+  nrHelper->SetSchedulerAttribute ("FixedMcsUl", BooleanValue (true));
+  nrHelper->SetSchedulerAttribute ("StartingMcsUl", UintegerValue (12));
+  nrHelper->SetPathlossAttribute ("ShadowingEnabled", BooleanValue (false));
+
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (2));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (4));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbPhyAttribute ("Numerology", UintegerValue (m_numerology));
+
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConf (3550e6, 20e6, 1, BandwidthPartInfo::UMi_StreetCanyon_LoS);
+  OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc (bandConf);
+  nrHelper->InitializeOperationBand (&band);
+  BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps ({band});
+
+  NetDeviceContainer gNbNetDevs = nrHelper->InstallGnbDevice (gNbNodes, allBwps);
+  NetDeviceContainer ueNetDevs = nrHelper->InstallUeDevice (ueNodes, allBwps);
+
+  int64_t randomStream = 1;
+  randomStream += nrHelper->AssignStreams (gNbNetDevs, randomStream);
+  randomStream += nrHelper->AssignStreams (ueNetDevs, randomStream);
+
+  for (auto it = gNbNetDevs.Begin (); it != gNbNetDevs.End (); ++it)
+    {
+      DynamicCast<NrGnbNetDevice> (*it)->UpdateConfig ();
+    }
+  for (auto it = ueNetDevs.Begin (); it != ueNetDevs.End (); ++it)
+    {
+      DynamicCast<NrUeNetDevice> (*it)->UpdateConfig ();
+    }
+
+  InternetStackHelper internet;
+  internet.Install (ueNodes);
+  epcHelper->AssignUeIpv4Address (ueNetDevs);
+  nrHelper->AttachToClosestEnb (ueNetDevs, gNbNetDevs);
+
+  for (uint32_t i = 0; i < m_ueNum; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (100), &NrConfiguredGrantIdleSlotFastForwardTest::SendPacket,
+                           this, ueNetDevs.Get (i), gNbNetDevs.Get (0)->GetAddress (), 0);
+    }
+  // The data radio bearers are set up by then
+  Simulator::Schedule (MilliSeconds (90), &NrConfiguredGrantIdleSlotFastForwardTest::ConnectRlc, this);
+
+  Simulator::Stop (MilliSeconds (400));
+  Simulator::Run ();
+  events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  // The order of the PDUs received at the same time depends on the order of
+  // the events scheduled for the same time, which is not the same
+  std::vector<RxPdu> rxPdus = m_rxPdus;
+  std::sort (rxPdus.begin (), rxPdus.end ());
+  return rxPdus;
+}
+
+void
+NrConfiguredGrantIdleSlotFastForwardTest::DoRun (void)
+{
+  uint64_t events = 0;
+  std::vector<RxPdu> rxPdus = Simulate (true, events);
+  uint64_t refEvents = 0;
+  std::vector<RxPdu> refRxPdus = Simulate (false, refEvents);
+
+  // The packets sent after the configuration of the grant, from 160 ms
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (refRxPdus.size (), m_ueNum * 24,
+                               "Too few UL PDUs delivered with configured grant");
+  NS_TEST_ASSERT_MSG_EQ (rxPdus.size (), refRxPdus.size (),
+                         "Different UL PDUs delivered skipping the idle slots");
+  for (std::size_t i = 0; i < std::min (rxPdus.size (), refRxPdus.size ()); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((rxPdus.at (i) == refRxPdus.at (i)), true,
+                             "PDU " << i << " of RNTI " << std::get<1> (refRxPdus.at (i)) <<
+                             " received at " << std::get<0> (refRxPdus.at (i)) <<
+                             " ns is different skipping the idle slots");
+    }
+  NS_TEST_ASSERT_MSG_LT (events, refEvents, "No event saved skipping the idle slots");
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * \brief The TDMA RR scheduler system test suite, with UEs skipping their
+ * idle slots
+ *
+ * It will check Tdma RR, with the NrUePhy IdleSlotFastForward attribute
+ * enabled, with:
+ *
+ * - DL
+ * - UEs per beam: 1, 4
+ * - beams: 1
+ * - numerologies: 0, 1
+ *
+ * Each case is run also with the attribute disabled: the same packets must be
+ * delivered, and skipping the idle slots must save at least one event per
+ * idle slot of each UE before the start of the traffic.
+ *
+ * The UL traffic of these cases is not delivered with the configured grant
+ * scheduling of the gNB MAC (see the UL suite above): the periodic UL traffic
+ * with configured grant is checked by NrConfiguredGrantIdleSlotFastForwardTest,
+ * with 1 and 4 UEs and numerologies 0 and 1.
+ */
+class NrSystemTestSchedulerTdmaRrIdleSlotFastForwardSuite : public TestSuite
+{
+public:
+  /**
+   * \brief constructor
+   */
+  NrSystemTestSchedulerTdmaRrIdleSlotFastForwardSuite ();
+};
+
+NrSystemTestSchedulerTdmaRrIdleSlotFastForwardSuite::NrSystemTestSchedulerTdmaRrIdleSlotFastForwardSuite ()
+  : TestSuite ("nr-system-test-schedulers-tdma-rr-idle-slot-fast-forward", SYSTEM)
+{
+  std::list<uint32_t>    uesPerBeamList  = {1, 4};
+  std::list<uint32_t>    numerologies    = {0, 1};
+
+  for (const auto & num : numerologies)
+    {
+      for (const auto & uesPerBeam : uesPerBeamList)
+        {
+          std::stringstream ss;
+          ss << ", Num " << num << ", DL, Tdma RR, "
+             << uesPerBeam << " UE per beam, 1 beam, idle slot fast-forward";
+
+          AddTestCase (new SystemSchedulerTest (ss.str(), uesPerBeam, 1, num,
+                                                20e6, true, false,
+                                                "ns3::NrMacSchedulerTdmaRR", true),
+                       TestCase::QUICK);
+
+          std::stringstream cg;
+          cg << ", Num " << num << ", UL configured grant, Tdma RR, "
+             << uesPerBeam << " UE, idle slot fast-forward";
+          AddTestCase (new NrConfiguredGrantIdleSlotFastForwardTest (cg.str (), uesPerBeam, num),
+                       TestCase::QUICK);
+        }
+    }
+}
+
+static NrSystemTestSchedulerTdmaRrIdleSlotFastForwardSuite nrSystemTestSchedulerTdmaRrIdleSlotFastForwardSuite;
+
+// ----------------------------------------------------------------------------
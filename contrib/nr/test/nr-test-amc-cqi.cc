@@ -0,0 +1,233 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/nr-amc.h>
+#include <ns3/nr-eesm-cc-t1.h>
+#include <ns3/nr-eesm-cc-t2.h>
+#include <ns3/nr-eesm-ir-t1.h>
+#include <ns3/nr-eesm-ir-t2.h>
+#include <ns3/nr-lte-mi-error-model.h>
+#include <ns3/double.h>
+#include <ns3/enum.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/type-id.h>
+#include <cmath>
+
+/**
+ * \file nr-test-amc-cqi.cc
+ * \ingroup test
+ *
+ * \brief Check that the wideband CQI/MCS feedback of NrAmc, computed with
+ * the SINR thresholds per MCS of the EESM error models, is the same that
+ * is obtained querying the error model for every MCS, and that the feedback
+ * of several SINR vectors at once is the same of each vector alone.
+ */
+namespace ns3 {
+
+/**
+ * \brief NrAmc CQI feedback testcase
+ */
+class NrAmcCqiTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param errorModel the type of the error model
+   * \param amcModel the AMC model
+   * \param dl true for the DL mode, false for the UL mode
+   */
+  NrAmcCqiTestCase (const TypeId &errorModel, NrAmc::AmcModel amcModel, bool dl);
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief The CQI/MCS feedback of the error model, computing the TBLER of
+   * every MCS until the first one above the target
+   * \param amc the AMC
+   * \param sinr the SINR values
+   * \param mcs the MCS
+   * \return the CQI
+   */
+  uint8_t GetReferenceCqi (const Ptr<NrAmc> &amc, const SpectrumValue &sinr, uint8_t &mcs) const;
+
+  TypeId m_errorModel;       //!< Type of the error model
+  NrAmc::AmcModel m_amcModel; //!< AMC model
+  bool m_dl;                 //!< DL or UL mode
+};
+
+NrAmcCqiTestCase::NrAmcCqiTestCase (const TypeId &errorModel, NrAmc::AmcModel amcModel, bool dl)
+  : TestCase (errorModel.GetName () + (amcModel == NrAmc::ErrorModel ? " ErrorModel" : " ShannonModel")
+              + (dl ? " DL" : " UL")),
+    m_errorModel (errorModel),
+    m_amcModel (amcModel),
+    m_dl (dl)
+{
+}
+
+uint8_t
+NrAmcCqiTestCase::GetReferenceCqi (const Ptr<NrAmc> &amc, const SpectrumValue &sinr, uint8_t &mcs) const
+{
+  ObjectFactory factory;
+  factory.SetTypeId (m_errorModel);
+  Ptr<NrErrorModel> em = DynamicCast<NrErrorModel> (factory.Create ());
+
+  std::vector <int> rbMap;
+  for (uint32_t i = 0; i < sinr.GetSpectrumModel ()->GetNumBands (); i++)
+    {
+      if (sinr[i] != 0.0)
+        {
+          rbMap.push_back (i);
+        }
+    }
+
+  mcs = 0;
+  Ptr<NrErrorModelOutput> output;
+  while (mcs <= em->GetMaxMcs ())
+    {
+      output = em->GetTbDecodificationStats (sinr, rbMap, amc->CalculateTbSize (mcs, rbMap.size ()),
+                                             mcs, NrErrorModel::NrErrorModelHistory ());
+      if (output->m_tbler > 0.1)
+        {
+          break;
+        }
+      mcs++;
+    }
+  if (mcs > 0)
+    {
+      mcs--;
+    }
+
+  uint8_t cqi = 0;
+  if ((output->m_tbler > 0.1) && (mcs == 0))
+    {
+      cqi = 0;
+    }
+  else if (mcs == em->GetMaxMcs ())
+    {
+      cqi = 15;
+    }
+  else
+    {
+      double s = em->GetSpectralEfficiencyForMcs (mcs);
+      while ((cqi < 15) && (em->GetSpectralEfficiencyForCqi (cqi + 1) <= s))
+        {
+          ++cqi;
+        }
+    }
+  return cqi;
+}
+
+void
+NrAmcCqiTestCase::DoRun ()
+{
+  Ptr<NrAmc> amc = CreateObject<NrAmc> ();
+  amc->SetAttribute ("ErrorModelType", TypeIdValue (m_errorModel));
+  amc->SetAttribute ("AmcModel", EnumValue (m_amcModel));
+  if (m_dl)
+    {
+      amc->SetDlMode ();
+    }
+  else
+    {
+      amc->SetUlMode ();
+    }
+
+  Ptr<UniformRandomVariable> sinrDb = CreateObject<UniformRandomVariable> ();
+  sinrDb->SetStream (1);
+  sinrDb->SetAttribute ("Min", DoubleValue (-10.0));
+  sinrDb->SetAttribute ("Max", DoubleValue (35.0));
+  Ptr<UniformRandomVariable> active = CreateObject<UniformRandomVariable> ();
+  active->SetStream (2);
+
+  for (uint32_t numRbs : {2, 24, 106})
+    {
+      std::vector<double> freqs;
+      for (uint32_t i = 0; i < numRbs; i++)
+        {
+          freqs.push_back (28e9 + i * 180e3);
+        }
+      Ptr<const SpectrumModel> model = Create<SpectrumModel> (freqs);
+
+      // vectors around the same mean, and with a different part of the RBs
+      // without signal, so that the thresholds of several numbers of RBs
+      // are used
+      const uint32_t numVectors = 40;
+      std::vector<double> sinr (numVectors * numRbs);
+      for (uint32_t v = 0; v < numVectors; v++)
+        {
+          double mean = sinrDb->GetValue ();
+          for (uint32_t i = 0; i < numRbs; i++)
+            {
+              bool on = (i == 0) || (active->GetValue () > 0.2);
+              sinr[v * numRbs + i] = on ? std::pow (10.0, (mean + 0.1 * sinrDb->GetValue ()) / 10) : 0.0;
+            }
+        }
+
+      std::vector<uint8_t> cqis;
+      std::vector<uint8_t> mcss;
+      amc->CreateCqiFeedbackWbTdma (model, sinr, cqis, mcss);
+      NS_TEST_ASSERT_MSG_EQ (cqis.size (), numVectors, "Wrong number of CQIs");
+      NS_TEST_ASSERT_MSG_EQ (mcss.size (), numVectors, "Wrong number of MCSs");
+
+      for (uint32_t v = 0; v < numVectors; v++)
+        {
+          SpectrumValue value (model);
+          for (uint32_t i = 0; i < numRbs; i++)
+            {
+              value[i] = sinr[v * numRbs + i];
+            }
+
+          uint8_t mcs = 0;
+          uint8_t cqi = amc->CreateCqiFeedbackWbTdma (value, mcs);
+          NS_TEST_ASSERT_MSG_EQ (+cqis[v], +cqi, "The CQI of the vector " << v << " differs in the batch");
+          NS_TEST_ASSERT_MSG_EQ (+mcss[v], +mcs, "The MCS of the vector " << v << " differs in the batch");
+
+          if (m_amcModel == NrAmc::ErrorModel)
+            {
+              uint8_t refMcs = 0;
+              uint8_t refCqi = GetReferenceCqi (amc, value, refMcs);
+              NS_TEST_ASSERT_MSG_EQ (+cqi, +refCqi, "Wrong CQI with " << numRbs << " RBs");
+              NS_TEST_ASSERT_MSG_EQ (+mcs, +refMcs, "Wrong MCS with " << numRbs << " RBs");
+            }
+        }
+    }
+}
+
+/**
+ * \brief NrAmc CQI feedback test suite
+ */
+class NrTestAmcCqi : public TestSuite
+{
+public:
+  NrTestAmcCqi () : TestSuite ("nr-test-amc-cqi", UNIT)
+  {
+    for (const TypeId &em : {NrEesmCcT1::GetTypeId (), NrEesmCcT2::GetTypeId (),
+                             NrEesmIrT1::GetTypeId (), NrEesmIrT2::GetTypeId (),
+                             NrLteMiErrorModel::GetTypeId ()})
+      {
+        AddTestCase (new NrAmcCqiTestCase (em, NrAmc::ErrorModel, true), QUICK);
+        AddTestCase (new NrAmcCqiTestCase (em, NrAmc::ErrorModel, false), QUICK);
+      }
+    AddTestCase (new NrAmcCqiTestCase (NrEesmCcT1::GetTypeId (), NrAmc::ShannonModel, true), QUICK);
+  }
+};
+
+static NrTestAmcCqi g_nrTestAmcCqi; //!< Nr AMC CQI test suite
+
+}  // namespace ns3
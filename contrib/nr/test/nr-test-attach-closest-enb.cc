@@ -0,0 +1,211 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/nr-helper.h>
+#include <ns3/epc-helper.h>
+#include <ns3/nr-gnb-net-device.h>
+#include <ns3/nr-ue-net-device.h>
+#include <ns3/cc-bwp-helper.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/mobility-model.h>
+#include <ns3/position-allocator.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/node-container.h>
+#include <ns3/simulator.h>
+
+#include <cmath>
+#include <limits>
+
+/**
+ * \file nr-test-attach-closest-enb.cc
+ * \ingroup test
+ *
+ * \brief Test of NrHelper::AttachToClosestEnb. The UEs are attached with the
+ * grid lookup of the method that takes a container of UEs, and the test
+ * checks that every UE is attached to the gNB found by a linear scan of all
+ * the gNBs, the first one in the container at the minimum distance, as the
+ * method that takes a single UE does.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ *
+ * \brief Compare the grid lookup with the linear scan on a layout
+ */
+class NrAttachToClosestEnbTestCase : public TestCase
+{
+public:
+  /**
+   * \brief The layouts of the gNBs and of the UEs
+   */
+  enum Layout
+  {
+    RANDOM,        //!< Random gNBs, UEs in and around their bounding box
+    SINGLE_GNB,    //!< A single gNB
+    TIES,          //!< gNBs on a lattice, UEs on the lattice and between its points
+    ALIGNED        //!< gNBs on a line, so that the grid has a single row
+  };
+
+  /**
+   * \brief Constructor
+   * \param name the name of the layout
+   * \param layout the layout
+   * \param numGnbs the number of gNBs (of each side of the lattice, for TIES)
+   * \param numUes the number of UEs
+   */
+  NrAttachToClosestEnbTestCase (const std::string &name, Layout layout,
+                                uint32_t numGnbs, uint32_t numUes)
+    : TestCase ("AttachToClosestEnb with " + name),
+      m_layout (layout),
+      m_numGnbs (numGnbs),
+      m_numUes (numUes)
+  {}
+
+private:
+  virtual void DoRun (void) override;
+
+  Layout m_layout;         //!< The layout
+  uint32_t m_numGnbs {0};  //!< Number of gNBs
+  uint32_t m_numUes {0};   //!< Number of UEs
+};
+
+void
+NrAttachToClosestEnbTestCase::DoRun ()
+{
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (7);
+
+  Ptr<ListPositionAllocator> gnbPositions = CreateObject<ListPositionAllocator> ();
+  Ptr<ListPositionAllocator> uePositions = CreateObject<ListPositionAllocator> ();
+  uint32_t numGnbs = m_numGnbs;
+  switch (m_layout)
+    {
+    case RANDOM:
+    case SINGLE_GNB:
+      for (uint32_t i = 0; i < numGnbs; ++i)
+        {
+          gnbPositions->Add (Vector (random->GetValue (0, 1000), random->GetValue (0, 500), 25.0));
+        }
+      // A third of the UEs are outside the bounding box of the gNBs
+      for (uint32_t i = 0; i < m_numUes; ++i)
+        {
+          uePositions->Add (Vector (random->GetValue (-500, 1500), random->GetValue (-250, 750), 1.5));
+        }
+      break;
+    case TIES:
+      // The UEs on the points, on the sides and in the centers of the
+      // squares of the lattice are at the same distance from 1, 2 or 4 gNBs
+      numGnbs = m_numGnbs * m_numGnbs;
+      for (uint32_t i = 0; i < numGnbs; ++i)
+        {
+          gnbPositions->Add (Vector (100.0 * (i % m_numGnbs), 100.0 * (i / m_numGnbs), 25.0));
+        }
+      for (uint32_t i = 0; i < m_numUes; ++i)
+        {
+          double x = 50.0 * std::floor (random->GetValue (-2, 2 * m_numGnbs + 1));
+          double y = 50.0 * std::floor (random->GetValue (-2, 2 * m_numGnbs + 1));
+          uePositions->Add (Vector (x, y, 25.0));
+        }
+      break;
+    case ALIGNED:
+      for (uint32_t i = 0; i < numGnbs; ++i)
+        {
+          gnbPositions->Add (Vector (random->GetValue (0, 1000), 0.0, 25.0));
+        }
+      for (uint32_t i = 0; i < m_numUes; ++i)
+        {
+          uePositions->Add (Vector (random->GetValue (-200, 1200), random->GetValue (-300, 300), 1.5));
+        }
+      break;
+    }
+
+  NodeContainer gnbNodes;
+  gnbNodes.Create (numGnbs);
+  NodeContainer ueNodes;
+  ueNodes.Create (m_numUes);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (gnbPositions);
+  mobility.Install (gnbNodes);
+  mobility.SetPositionAllocator (uePositions);
+  mobility.Install (ueNodes);
+
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConf (28e9, 100e6, 1, BandwidthPartInfo::UMi_StreetCanyon);
+  OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc (bandConf);
+  nrHelper->InitializeOperationBand (&band);
+  BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps ({band});
+
+  NetDeviceContainer gnbDevs = nrHelper->InstallGnbDevice (gnbNodes, allBwps);
+  NetDeviceContainer ueDevs = nrHelper->InstallUeDevice (ueNodes, allBwps);
+
+  nrHelper->AttachToClosestEnb (ueDevs, gnbDevs);
+
+  for (uint32_t i = 0; i < m_numUes; ++i)
+    {
+      Vector uePos = ueNodes.Get (i)->GetObject<MobilityModel> ()->GetPosition ();
+      double minDistance = std::numeric_limits<double>::infinity ();
+      uint32_t closest = 0;
+      for (uint32_t j = 0; j < gnbNodes.GetN (); ++j)
+        {
+          double distance = CalculateDistance (uePos, gnbNodes.Get (j)->GetObject<MobilityModel> ()->GetPosition ());
+          if (distance < minDistance)
+            {
+              minDistance = distance;
+              closest = j;
+            }
+        }
+
+      Ptr<const NrGnbNetDevice> gnb = DynamicCast<NrUeNetDevice> (ueDevs.Get (i))->GetTargetEnb ();
+      NS_TEST_ASSERT_MSG_NE (gnb, nullptr, "UE " << i << " is not attached");
+      NS_TEST_ASSERT_MSG_EQ (gnb->GetNode ()->GetId (), gnbNodes.Get (closest)->GetId (),
+                             "Wrong gNB for the UE " << i << " at " << uePos);
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup test
+ *
+ * \brief Test suite of NrHelper::AttachToClosestEnb
+ */
+class NrAttachToClosestEnbTestSuite : public TestSuite
+{
+public:
+  /** \brief Constructor */
+  NrAttachToClosestEnbTestSuite ()
+    : TestSuite ("nr-attach-to-closest-enb", UNIT)
+  {
+    AddTestCase (new NrAttachToClosestEnbTestCase ("random gNBs", NrAttachToClosestEnbTestCase::RANDOM, 40, 300),
+                 TestCase::QUICK);
+    AddTestCase (new NrAttachToClosestEnbTestCase ("a single gNB", NrAttachToClosestEnbTestCase::SINGLE_GNB, 1, 20),
+                 TestCase::QUICK);
+    AddTestCase (new NrAttachToClosestEnbTestCase ("ties on a lattice", NrAttachToClosestEnbTestCase::TIES, 5, 200),
+                 TestCase::QUICK);
+    AddTestCase (new NrAttachToClosestEnbTestCase ("aligned gNBs", NrAttachToClosestEnbTestCase::ALIGNED, 10, 100),
+                 TestCase::QUICK);
+  }
+};
+
+/// Static variable for test initialization
+static NrAttachToClosestEnbTestSuite g_nrAttachToClosestEnbTestSuite;
+
+} // namespace ns3
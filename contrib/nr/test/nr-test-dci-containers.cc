@@ -0,0 +1,139 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2019 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/nr-phy-mac-common.h>
+
+#include <algorithm>
+
+/**
+ * \file nr-test-dci-containers.cc
+ * \ingroup test
+ *
+ * \brief Unit-testing for the containers of the DCI. The test checks that
+ * the RBG bitmask gives back the same values of the std::vector it was built
+ * from (with and without the inline storage), and that the DCIs created from
+ * the pool keep their values when the memory of released DCIs is reused.
+ */
+namespace ns3 {
+
+class TestRbgBitmaskTestCase : public TestCase
+{
+public:
+  TestRbgBitmaskTestCase (uint32_t numRbg, const std::string &name)
+    : TestCase (name),
+      m_numRbg (numRbg)
+  {}
+
+private:
+  virtual void DoRun (void) override;
+  uint32_t m_numRbg {0};
+};
+
+void
+TestRbgBitmaskTestCase::DoRun ()
+{
+  std::vector<uint8_t> values (m_numRbg, 0);
+  for (uint32_t i = 0; i < m_numRbg; ++i)
+    {
+      values[i] = (i % 3 == 0) ? 1 : 0;
+    }
+
+  RbgBitmask bitmask (values);
+  NS_TEST_ASSERT_MSG_EQ (bitmask.size (), values.size (), "Wrong size");
+  NS_TEST_ASSERT_MSG_EQ (bitmask.Count (),
+                         static_cast<std::size_t> (std::count (values.begin (), values.end (), 1)),
+                         "Wrong count");
+  NS_TEST_ASSERT_MSG_EQ ((static_cast<std::vector<uint8_t> > (bitmask) == values), true,
+                         "Conversion to std::vector changed the values");
+
+  uint32_t i = 0;
+  for (auto x : bitmask)
+    {
+      NS_TEST_ASSERT_MSG_EQ (+x, +values[i], "Wrong value at RBG " << i);
+      ++i;
+    }
+
+  bitmask.at (m_numRbg - 1) = 1;
+  bitmask[0] = 0;
+  NS_TEST_ASSERT_MSG_EQ (+bitmask.at (m_numRbg - 1), 1, "Assignment failed");
+  NS_TEST_ASSERT_MSG_EQ (+bitmask.at (0), 0, "Assignment failed");
+
+  RbgBitmask full (m_numRbg, 1);
+  NS_TEST_ASSERT_MSG_EQ (full.Count (), m_numRbg, "All the RBGs should be used");
+  NS_TEST_ASSERT_MSG_EQ ((full == RbgBitmask (std::vector<uint8_t> (m_numRbg, 1))), true,
+                         "Equal bitmasks compare different");
+}
+
+class TestDciPoolTestCase : public TestCase
+{
+public:
+  TestDciPoolTestCase ()
+    : TestCase ("DCI created from the pool")
+  {}
+
+private:
+  virtual void DoRun (void) override;
+};
+
+void
+TestDciPoolTestCase::DoRun ()
+{
+  std::vector<std::shared_ptr<DciInfoElementTdma> > dcis;
+  for (uint32_t round = 0; round < 3; ++round)
+    {
+      for (uint16_t rnti = 1; rnti <= 10; ++rnti)
+        {
+          auto dci = CreatePooledDci (rnti, DciInfoElementTdma::DL, 2, 4,
+                                      std::vector<uint8_t> {static_cast<uint8_t> (rnti)},
+                                      std::vector<uint32_t> {rnti * 100U},
+                                      std::vector<uint8_t> {1}, std::vector<uint8_t> {0},
+                                      DciInfoElementTdma::DATA, 0, 1);
+          dci->m_rbgBitmask = std::vector<uint8_t> (rnti, 1);
+          dcis.push_back (dci);
+        }
+
+      for (uint16_t rnti = 1; rnti <= 10; ++rnti)
+        {
+          const auto & dci = dcis.at (rnti - 1);
+          NS_TEST_ASSERT_MSG_EQ (dci->m_rnti, rnti, "Wrong RNTI");
+          NS_TEST_ASSERT_MSG_EQ (+dci->m_mcs.at (0), rnti, "Wrong MCS");
+          NS_TEST_ASSERT_MSG_EQ (dci->m_tbSize.at (0), rnti * 100U, "Wrong TBS");
+          NS_TEST_ASSERT_MSG_EQ (dci->m_rbgBitmask.Count (), rnti, "Wrong RBG bitmask");
+        }
+
+      // Release the DCIs, so that the next round reuses their memory
+      dcis.clear ();
+    }
+}
+
+class TestDciContainers : public TestSuite
+{
+public:
+  TestDciContainers () : TestSuite ("nr-test-dci-containers", UNIT)
+  {
+    AddTestCase (new TestRbgBitmaskTestCase (17, "RbgBitmask with 17 RBG"), QUICK);
+    AddTestCase (new TestRbgBitmaskTestCase (64, "RbgBitmask with 64 RBG"), QUICK);
+    AddTestCase (new TestRbgBitmaskTestCase (275, "RbgBitmask with 275 RBG"), QUICK);
+    AddTestCase (new TestDciPoolTestCase (), QUICK);
+  }
+};
+
+static TestDciContainers testDciContainers; //!< DCI containers test
+
+}  // namespace ns3
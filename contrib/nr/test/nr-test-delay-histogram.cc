@@ -0,0 +1,124 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/nr-delay-histogram.h>
+#include <ns3/basic-data-calculators.h>
+
+#include <algorithm>
+#include <sstream>
+
+/**
+ * \file nr-test-delay-histogram.cc
+ * \ingroup test
+ *
+ * \brief Test of the NrDelayHistogram. The quantiles of a set of delays,
+ * from nanoseconds to seconds, are compared with the exact ones; the
+ * running statistics with the ones of MinMaxAvgTotalCalculator. The test
+ * also checks that the histogram is the same after a Serialize and a
+ * Deserialize, and after a Reset.
+ */
+namespace ns3 {
+
+class NrDelayHistogramTestCase : public TestCase
+{
+public:
+  NrDelayHistogramTestCase ()
+    : TestCase ("Quantiles and statistics of the delay histogram")
+  {}
+
+private:
+  virtual void DoRun (void) override;
+};
+
+void
+NrDelayHistogramTestCase::DoRun ()
+{
+  for (uint32_t bucket = 0; bucket < NrDelayHistogram::N_BUCKETS; ++bucket)
+    {
+      uint64_t start = NrDelayHistogram::GetBucketStart (bucket);
+      NS_TEST_ASSERT_MSG_EQ (NrDelayHistogram::GetBucket (start), bucket, "Wrong start of bucket " << bucket);
+      if (bucket > 0)
+        {
+          NS_TEST_ASSERT_MSG_EQ (NrDelayHistogram::GetBucket (start - 1), bucket - 1,
+                                 "Wrong end of bucket " << bucket - 1);
+        }
+    }
+
+  NrDelayHistogram histogram;
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0.5), 0, "Quantile without values");
+
+  Ptr<MinMaxAvgTotalCalculator<uint64_t> > reference = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
+  std::vector<uint64_t> values;
+  uint64_t v = 1;
+  for (uint32_t i = 0; i < 100000; ++i)
+    {
+      // Pseudo-random values, spread over 9 orders of magnitude
+      v = v * 6364136223846793005ULL + 1442695040888963407ULL;
+      uint64_t value = (v >> 33) % (1ULL << (i % 30 + 1));
+      values.push_back (value);
+      histogram.Update (value);
+      reference->Update (value);
+    }
+  std::sort (values.begin (), values.end ());
+
+  const NrRunningStats &stats = histogram.GetStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.GetCount (), values.size (), "Wrong count");
+  NS_TEST_ASSERT_MSG_EQ (stats.GetMin (), reference->getMin (), "Wrong min");
+  NS_TEST_ASSERT_MSG_EQ (stats.GetMax (), reference->getMax (), "Wrong max");
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.GetMean (), reference->getMean (), 1e-6 * reference->getMean (), "Wrong mean");
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.GetStddev (), reference->getStddev (), 1e-6 * reference->getStddev (),
+                             "Wrong standard deviation");
+
+  for (double q : {0.0, 0.1, 0.5, 0.9, 0.99, 0.999, 0.99999, 1.0})
+    {
+      uint64_t rank = std::max<uint64_t> (static_cast<uint64_t> (std::ceil (q * values.size ())), 1);
+      double exact = values[rank - 1];
+      double estimate = histogram.GetQuantile (q);
+      NS_TEST_ASSERT_MSG_EQ_TOL (estimate, exact, std::max (exact / 32, 1.0), "Wrong quantile " << q);
+    }
+
+  std::stringstream buffer;
+  histogram.Serialize (buffer);
+  NrDelayHistogram copy;
+  NS_TEST_ASSERT_MSG_EQ (copy.Deserialize (buffer), true, "Deserialize failed");
+  NS_TEST_ASSERT_MSG_EQ (copy.GetStats ().GetCount (), stats.GetCount (), "Wrong count of the copy");
+  NS_TEST_ASSERT_MSG_EQ_TOL (copy.GetStats ().GetStddev (), stats.GetStddev (), 1e-9, "Wrong stddev of the copy");
+  for (double q : {0.5, 0.99999})
+    {
+      NS_TEST_ASSERT_MSG_EQ (copy.GetQuantile (q), histogram.GetQuantile (q), "Wrong quantile " << q << " of the copy");
+    }
+  NS_TEST_ASSERT_MSG_EQ (copy.Deserialize (buffer), false, "Deserialize after the end");
+
+  histogram.Reset ();
+  histogram.Update (1000);
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetStats ().GetCount (), 1, "Wrong count after Reset");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0.0), 1000, "Wrong quantile after Reset");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (1.0), 1000, "Wrong quantile after Reset");
+}
+
+class NrDelayHistogramTestSuite : public TestSuite
+{
+public:
+  NrDelayHistogramTestSuite () : TestSuite ("nr-test-delay-histogram", UNIT)
+  {
+    AddTestCase (new NrDelayHistogramTestCase (), QUICK);
+  }
+};
+
+static NrDelayHistogramTestSuite nrDelayHistogramTestSuite; //!< Delay histogram test
+
+}  // namespace ns3
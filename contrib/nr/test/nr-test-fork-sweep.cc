@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/nr-fork-sweep-helper.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/node.h>
+#include <ns3/simulator.h>
+#include <ns3/system-path.h>
+
+#include <cerrno>
+#include <fstream>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * \file nr-test-fork-sweep.cc
+ * \ingroup test
+ *
+ * \brief Test of the NrForkSweepHelper. A node records its position every
+ * millisecond; the variants change the position after the checkpoint, and
+ * write the recorded positions in their output directory. The test checks
+ * that every variant has the positions of the shared part of the
+ * simulation, followed by the ones of its own attributes.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ *
+ * \brief Run three variants, with a maximum number of children in parallel.
+ * The test also forks a child of its own, which ends with a failure status
+ * before the variants are forked, and checks that the helper does not count
+ * it as a failed variant.
+ */
+class NrForkSweepTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param maxParallel the maximum number of children that run at the same time
+   */
+  NrForkSweepTestCase (uint32_t maxParallel)
+    : TestCase ("Fork sweep with " + std::to_string (maxParallel) + " children in parallel"),
+      m_maxParallel (maxParallel)
+  {}
+
+private:
+  virtual void DoRun (void) override;
+  /**
+   * \brief Record the position of the node, every millisecond
+   */
+  void Record (void);
+
+  uint32_t m_maxParallel {0};      //!< Maximum number of children in parallel
+  Ptr<MobilityModel> m_mobility;   //!< Mobility model of the node
+  std::vector<double> m_records;   //!< Recorded x coordinates of the node
+};
+
+void
+NrForkSweepTestCase::Record ()
+{
+  m_records.push_back (m_mobility->GetPosition ().x);
+  Simulator::Schedule (MilliSeconds (1), &NrForkSweepTestCase::Record, this);
+}
+
+void
+NrForkSweepTestCase::DoRun ()
+{
+  const std::vector<double> values = {10.0, 20.0, 30.0};
+  Ptr<Node> node = CreateObject<Node> ();
+  m_mobility = CreateObject<ConstantPositionMobilityModel> ();
+  m_mobility->SetPosition (Vector (1.0, 0.0, 0.0));
+  node->AggregateObject (m_mobility);
+  m_records.clear ();
+  Simulator::Schedule (MilliSeconds (0), &NrForkSweepTestCase::Record, this);
+
+  std::string path = "/NodeList/" + std::to_string (node->GetId ()) +
+    "/$ns3::ConstantPositionMobilityModel/Position";
+  NrForkSweepHelper sweep;
+  sweep.SetCheckpointTime (MicroSeconds (4500));
+  sweep.SetStopTime (MicroSeconds (9500));
+  sweep.SetOutputDirectory (CreateTempDirFilename ("nr-fork-sweep"));
+  sweep.SetMaxParallel (m_maxParallel);
+  for (uint32_t i = 0; i < values.size (); ++i)
+    {
+      sweep.AddVariant ("v" + std::to_string (i), {{path, std::to_string (values[i]) + ":0:0"}});
+    }
+
+  // A child that is not a variant. Wait for its end without reaping it:
+  // the helper is then the first to see it
+  pid_t other = fork ();
+  NS_TEST_ASSERT_MSG_NE (other, -1, "fork() failed");
+  if (other == 0)
+    {
+      _exit (3);
+    }
+  siginfo_t info;
+  NS_TEST_ASSERT_MSG_EQ (waitid (P_PID, other, &info, WEXITED | WNOWAIT), 0, "waitid() failed");
+
+  int32_t variant = sweep.ForkVariants ();
+  if (variant != NrForkSweepHelper::PARENT)
+    {
+      Simulator::Run ();
+      std::ofstream out ("records.txt");
+      for (const auto & r : m_records)
+        {
+          out << r << std::endl;
+        }
+      out.close ();
+      _exit (out.fail () ? 1 : 0);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (sweep.GetNFailedVariants (), 0, "Some variants failed");
+  int status = 0;
+  NS_TEST_ASSERT_MSG_EQ ((waitpid (other, &status, 0) < 0 && errno == ECHILD), true,
+                         "The other child has not been reaped by the helper");
+  for (uint32_t i = 0; i < values.size (); ++i)
+    {
+      std::ifstream in (SystemPath::Append (sweep.GetVariantOutputDirectory (i), "records.txt"));
+      std::vector<double> records;
+      double r;
+      while (in >> r)
+        {
+          records.push_back (r);
+        }
+      NS_TEST_ASSERT_MSG_EQ (records.size (), 10, "Wrong number of records for variant " << i);
+      for (uint32_t ms = 0; ms < records.size (); ++ms)
+        {
+          double expected = ms < 5 ? 1.0 : values[i];
+          NS_TEST_ASSERT_MSG_EQ_TOL (records[ms], expected, 1e-9,
+                                     "Wrong position at " << ms << " ms for variant " << i);
+        }
+    }
+
+  // The parent stopped at the checkpoint
+  NS_TEST_ASSERT_MSG_EQ (m_records.size (), 5, "The parent should not run after the checkpoint");
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup test
+ *
+ * \brief Test suite of the NrForkSweepHelper
+ */
+class NrForkSweepTestSuite : public TestSuite
+{
+public:
+  /** \brief Constructor */
+  NrForkSweepTestSuite () : TestSuite ("nr-test-fork-sweep", UNIT)
+  {
+    AddTestCase (new NrForkSweepTestCase (1), QUICK);
+    AddTestCase (new NrForkSweepTestCase (3), QUICK);
+  }
+};
+
+static NrForkSweepTestSuite nrForkSweepTestSuite; //!< Fork sweep test
+
+}  // namespace ns3
@@ -0,0 +1,238 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/nr-mac-harq-vector.h>
+#include <ns3/random-variable-stream.h>
+
+#include <iterator>
+#include <set>
+
+/**
+ * \file nr-test-harq-vector.cc
+ * \ingroup test
+ *
+ * \brief Unit test of the NrMacHarqVector. The processes are inserted and
+ * erased, and after every operation the vector is compared with a set of
+ * the active IDs: Find, the iteration over all the processes, the first
+ * available ID and the iteration over the active IDs with NextActiveId.
+ * The vectors are large enough to use more than one word of the mask of
+ * the active processes, and the active IDs are placed on both sides of the
+ * word boundaries.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ *
+ * \brief Compare a NrMacHarqVector with the set of its active IDs
+ */
+class NrMacHarqVectorTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param maxSize the size of the vector
+   */
+  NrMacHarqVectorTestCase (uint8_t maxSize)
+    : TestCase ("HARQ vector with " + std::to_string (maxSize) + " processes"),
+      m_maxSize (maxSize)
+  {}
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Insert a process, and add its ID to the active IDs
+   * \return the ID of the process
+   */
+  uint8_t Insert (void);
+  /**
+   * \brief Erase a process, and remove its ID from the active IDs
+   * \param id the ID of the process
+   */
+  void Erase (uint8_t id);
+  /**
+   * \brief Check the vector against the active IDs
+   */
+  void Check (void);
+
+  uint8_t m_maxSize {0};      //!< Size of the vector
+  NrMacHarqVector m_vector;   //!< The vector under test
+  std::set<uint8_t> m_active; //!< The active IDs
+};
+
+uint8_t
+NrMacHarqVectorTestCase::Insert ()
+{
+  uint8_t id = 255;
+  HarqProcess process (true, HarqProcess::WAITING_FEEDBACK, 0, nullptr);
+  bool inserted = m_vector.Insert (&id, process);
+  NS_TEST_EXPECT_MSG_EQ (inserted, true, "Insert failed with " << m_active.size () << " active processes");
+  m_active.insert (id);
+  return id;
+}
+
+void
+NrMacHarqVectorTestCase::Erase (uint8_t id)
+{
+  m_vector.Erase (id);
+  m_active.erase (id);
+}
+
+void
+NrMacHarqVectorTestCase::Check ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_vector.Size (), m_active.size (), "Wrong number of active processes");
+  NS_TEST_ASSERT_MSG_EQ (m_vector.CanInsert (), (m_active.size () < m_maxSize), "Wrong CanInsert");
+
+  // The first available ID is the lowest one that is not active
+  uint8_t firstAvailable = 255;
+  for (uint32_t id = 0; id < m_maxSize; ++id)
+    {
+      if (m_active.count (static_cast<uint8_t> (id)) == 0)
+        {
+          firstAvailable = static_cast<uint8_t> (id);
+          break;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (+m_vector.FirstAvailableId (), +firstAvailable, "Wrong first available ID");
+
+  // Find returns every ID of the vector, active or not, and End () after it
+  for (uint32_t id = 0; id < m_maxSize; ++id)
+    {
+      auto it = m_vector.Find (static_cast<uint8_t> (id));
+      NS_TEST_ASSERT_MSG_EQ ((it != m_vector.End ()), true, "ID " << id << " not found");
+      NS_TEST_ASSERT_MSG_EQ (+it->first, id, "Find returned the wrong ID");
+      NS_TEST_ASSERT_MSG_EQ (it->second.m_active, (m_active.count (static_cast<uint8_t> (id)) == 1),
+                             "Wrong state of the ID " << id);
+    }
+  NS_TEST_ASSERT_MSG_EQ ((m_vector.Find (m_maxSize) == m_vector.End ()), true,
+                         "The ID after the last one was found");
+
+  // The iterators visit all the processes, in the order of the IDs
+  uint32_t expectedId = 0;
+  for (auto it = m_vector.Begin (); it != m_vector.End (); ++it)
+    {
+      NS_TEST_ASSERT_MSG_EQ (+it->first, expectedId, "Wrong iteration order");
+      ++expectedId;
+    }
+  NS_TEST_ASSERT_MSG_EQ (expectedId, m_maxSize, "Wrong number of processes in the iteration");
+
+  // NextActiveId visits the active IDs in increasing order
+  auto expected = m_active.begin ();
+  for (uint8_t id = m_vector.NextActiveId (0); id != 255; id = m_vector.NextActiveId (id + 1))
+    {
+      NS_TEST_ASSERT_MSG_EQ ((expected != m_active.end ()), true, "Too many active IDs: " << +id);
+      NS_TEST_ASSERT_MSG_EQ (+id, +*expected, "Wrong active ID");
+      ++expected;
+    }
+  NS_TEST_ASSERT_MSG_EQ ((expected == m_active.end ()), true, "Active ID not visited: " << +*expected);
+
+  // NextActiveId from any ID, including the ones at the word boundaries
+  for (uint32_t from = 0; from < 255; ++from)
+    {
+      auto next = m_active.lower_bound (static_cast<uint8_t> (from));
+      uint8_t expectedNext = next == m_active.end () ? 255 : *next;
+      NS_TEST_ASSERT_MSG_EQ (+m_vector.NextActiveId (static_cast<uint8_t> (from)), +expectedNext,
+                             "Wrong next active ID from " << from);
+    }
+}
+
+void
+NrMacHarqVectorTestCase::DoRun ()
+{
+  m_vector.SetMaxSize (m_maxSize);
+  m_active.clear ();
+  Check ();
+
+  // Fill the vector: the IDs are given in increasing order
+  for (uint32_t i = 0; i < m_maxSize; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (+Insert (), i, "Wrong ID of the inserted process");
+    }
+  Check ();
+  uint8_t id = 255;
+  HarqProcess process (true, HarqProcess::WAITING_FEEDBACK, 0, nullptr);
+  NS_TEST_ASSERT_MSG_EQ (m_vector.Insert (&id, process), false, "Insert in a full vector");
+
+  // Keep active only the IDs around the word boundaries, and the last one
+  for (uint32_t i = 0; i < m_maxSize; ++i)
+    {
+      bool boundary = i % 64 == 0 || i % 64 == 63 || i + 1 == m_maxSize;
+      if (!boundary)
+        {
+          Erase (static_cast<uint8_t> (i));
+        }
+    }
+  Check ();
+
+  // Only the first ID of each word after the first
+  for (uint32_t i = 0; i < m_maxSize; ++i)
+    {
+      if (m_active.count (static_cast<uint8_t> (i)) == 1 && (i < 64 || i % 64 != 0))
+        {
+          Erase (static_cast<uint8_t> (i));
+        }
+    }
+  Check ();
+
+  // Random inserts and erases
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  for (uint32_t step = 0; step < 2000; ++step)
+    {
+      if (m_active.empty () || (m_active.size () < m_maxSize && random->GetValue () < 0.5))
+        {
+          Insert ();
+        }
+      else
+        {
+          auto it = m_active.begin ();
+          std::advance (it, random->GetInteger (0, static_cast<uint32_t> (m_active.size ()) - 1));
+          Erase (*it);
+        }
+      if (step % 50 == 0)
+        {
+          Check ();
+        }
+    }
+  Check ();
+}
+
+/**
+ * \ingroup test
+ *
+ * \brief Test suite of the NrMacHarqVector
+ */
+class NrMacHarqVectorTestSuite : public TestSuite
+{
+public:
+  /** \brief Constructor */
+  NrMacHarqVectorTestSuite ()
+    : TestSuite ("nr-mac-harq-vector", UNIT)
+  {
+    AddTestCase (new NrMacHarqVectorTestCase (20), TestCase::QUICK);
+    AddTestCase (new NrMacHarqVectorTestCase (64), TestCase::QUICK);
+    AddTestCase (new NrMacHarqVectorTestCase (130), TestCase::QUICK);
+    AddTestCase (new NrMacHarqVectorTestCase (254), TestCase::QUICK);
+  }
+};
+
+/// Static variable for test initialization
+static NrMacHarqVectorTestSuite g_nrMacHarqVectorTestSuite;
+
+} // namespace ns3
@@ -0,0 +1,411 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/nr-interference.h>
+#include <ns3/lte-chunk-processor.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/spectrum-model.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simulator.h>
+
+#include <cmath>
+
+/**
+ * \file nr-test-interference-chunk.cc
+ * \ingroup test
+ *
+ * \brief Test of the SINR, SNR and RSSI computed by NrInterference and
+ * averaged by LteChunkProcessor. The same random receptions and interferers
+ * are given to NrInterference and to a reference model that computes the
+ * values of each chunk with the SpectrumValue operators, and sums them in a
+ * new SpectrumValue for each reception. The values must be bit-identical.
+ * The spectrum model changes between the receptions, so that the buffers
+ * kept across the chunks and across the receptions are reallocated.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ *
+ * \brief Chunk processor that averages the values with the SpectrumValue
+ * operators, in a new SpectrumValue for each reception
+ */
+class NrReferenceChunkProcessor : public LteChunkProcessor
+{
+public:
+  virtual void AddCallback (LteChunkProcessorCallback c) override
+  {
+    m_callbacks.push_back (c);
+  }
+  virtual void Start () override
+  {
+    m_sumValues = nullptr;
+    m_totDuration = MicroSeconds (0);
+  }
+  virtual void EvaluateChunk (const SpectrumValue& sinr, Time duration) override
+  {
+    if (m_sumValues == nullptr)
+      {
+        m_sumValues = Create<SpectrumValue> (sinr.GetSpectrumModel ());
+      }
+    (*m_sumValues) += sinr * duration.GetSeconds ();
+    m_totDuration += duration;
+  }
+  virtual void End () override
+  {
+    if (m_totDuration.GetSeconds () > 0)
+      {
+        for (const auto & c : m_callbacks)
+          {
+            c ((*m_sumValues) / m_totDuration.GetSeconds ());
+          }
+      }
+  }
+
+private:
+  Ptr<SpectrumValue> m_sumValues;                      //!< Sum of the values of the chunks
+  Time m_totDuration;                                  //!< Duration of the chunks
+  std::vector<LteChunkProcessorCallback> m_callbacks;  //!< Callbacks of the average
+};
+
+/**
+ * \ingroup test
+ *
+ * \brief NrInterference that computes the SINR, the SNR and the RSSI
+ * with the SpectrumValue operators
+ */
+class NrReferenceInterference : public NrInterference
+{
+public:
+  virtual void EndRx () override
+  {
+    if (m_receiving)
+      {
+        SpectrumValue snr = (*m_rxSignal) / (*m_noise);
+        double avgSnr = Sum (snr) / (snr.GetSpectrumModel ()->GetNumBands ());
+        m_snrPerProcessedChunk (avgSnr);
+
+        ConditionallyEvaluateChunk ();
+
+        m_receiving = false;
+        for (const auto & p : m_sinrChunkProcessorList)
+          {
+            p->End ();
+          }
+      }
+  }
+
+private:
+  virtual void DoEvaluateChunk (Time chunkEnd) override
+  {
+    if (m_receiving && (chunkEnd > m_lastChangeTime))
+      {
+        SpectrumValue interf = (*m_allSignals) - (*m_rxSignal) + (*m_noise);
+        SpectrumValue sinr = (*m_rxSignal) / interf;
+        double rbWidth = (*m_rxSignal).GetSpectrumModel ()->Begin ()->fh - (*m_rxSignal).GetSpectrumModel ()->Begin ()->fl;
+        double rssidBm = 10 * log10 (Sum ((*m_noise + *m_allSignals) * rbWidth) * 1000);
+        m_rssiPerProcessedChunk (rssidBm);
+
+        Time duration = chunkEnd - m_lastChangeTime;
+        for (const auto & p : m_sinrChunkProcessorList)
+          {
+            p->EvaluateChunk (sinr, duration);
+          }
+        m_lastChangeTime = chunkEnd;
+      }
+  }
+};
+
+/**
+ * \ingroup test
+ *
+ * \brief The values reported by an interference model
+ */
+struct NrInterferenceValues
+{
+  /**
+   * \brief Store the average SINR of a reception
+   * \param sinr the SINR
+   */
+  void Sinr (const SpectrumValue &sinr)
+  {
+    m_sinr.push_back (sinr);
+  }
+  /**
+   * \brief Store the SNR of a reception
+   * \param snr the SNR
+   */
+  void Snr (double snr)
+  {
+    m_snr.push_back (snr);
+  }
+  /**
+   * \brief Store the RSSI of a chunk
+   * \param rssi the RSSI
+   */
+  void Rssi (double rssi)
+  {
+    m_rssi.push_back (rssi);
+  }
+
+  std::vector<SpectrumValue> m_sinr; //!< Average SINR of each reception
+  std::vector<double> m_snr;         //!< SNR of each reception
+  std::vector<double> m_rssi;        //!< RSSI of each chunk
+};
+
+/**
+ * \ingroup test
+ *
+ * \brief Compare NrInterference with the reference model on random receptions
+ */
+class NrInterferenceChunkTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrInterferenceChunkTestCase ()
+    : TestCase ("SINR, SNR and RSSI of NrInterference on random receptions")
+  {}
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Create a random PSD on a random subset of the RBs
+   * \param model the spectrum model
+   * \param probability the probability that a RB is used
+   * \return the PSD
+   */
+  Ptr<SpectrumValue> CreatePsd (Ptr<const SpectrumModel> model, double probability);
+  /**
+   * \brief Schedule a reception, with its interferers
+   * \param start the start time of the reception
+   * \param model the spectrum model of the reception
+   */
+  void ScheduleReception (Time start, Ptr<const SpectrumModel> model);
+  /**
+   * \brief Set the noise of both interference models
+   * \param noise the noise PSD
+   */
+  void SetNoise (Ptr<const SpectrumValue> noise);
+  /**
+   * \brief Add a signal to both interference models
+   * \param spd the PSD of the signal
+   * \param duration the duration of the signal
+   * \param rx whether the signal is under reception
+   */
+  void AddSignal (Ptr<const SpectrumValue> spd, Time duration, bool rx);
+  /**
+   * \brief End the reception of both interference models
+   */
+  void EndRx (void);
+
+  Ptr<UniformRandomVariable> m_random;      //!< Random variable
+  Ptr<NrInterference> m_interference;       //!< The model under test
+  Ptr<NrInterference> m_reference;          //!< The reference model
+  NrInterferenceValues m_values;            //!< Values of the model under test
+  NrInterferenceValues m_referenceValues;   //!< Values of the reference model
+};
+
+Ptr<SpectrumValue>
+NrInterferenceChunkTestCase::CreatePsd (Ptr<const SpectrumModel> model, double probability)
+{
+  Ptr<SpectrumValue> psd = Create<SpectrumValue> (model);
+  for (auto it = psd->ValuesBegin (); it != psd->ValuesEnd (); ++it)
+    {
+      *it = m_random->GetValue () < probability ? std::pow (10.0, m_random->GetValue (-19, -15)) : 0.0;
+    }
+  return psd;
+}
+
+void
+NrInterferenceChunkTestCase::SetNoise (Ptr<const SpectrumValue> noise)
+{
+  m_interference->SetNoisePowerSpectralDensity (noise);
+  m_reference->SetNoisePowerSpectralDensity (noise);
+}
+
+void
+NrInterferenceChunkTestCase::AddSignal (Ptr<const SpectrumValue> spd, Time duration, bool rx)
+{
+  for (const auto & interference : {m_interference, m_reference})
+    {
+      interference->AddSignal (spd, duration);
+      if (rx)
+        {
+          interference->StartRx (spd);
+        }
+    }
+}
+
+void
+NrInterferenceChunkTestCase::EndRx ()
+{
+  m_interference->EndRx ();
+  m_reference->EndRx ();
+}
+
+void
+NrInterferenceChunkTestCase::ScheduleReception (Time start, Ptr<const SpectrumModel> model)
+{
+  const Time duration = MicroSeconds (500);
+
+  // One or two signals under reception, on disjoint RBs
+  Ptr<SpectrumValue> first = CreatePsd (model, 0.5);
+  Ptr<SpectrumValue> second = CreatePsd (model, 0.5);
+  for (std::size_t rb = 0; rb < first->GetValuesN (); ++rb)
+    {
+      if (first->ConstValuesBegin ()[rb] != 0.0)
+        {
+          second->ValuesBegin ()[rb] = 0.0;
+        }
+    }
+  Simulator::Schedule (start, &NrInterferenceChunkTestCase::AddSignal, this,
+                       first, duration, true);
+  if (m_random->GetValue () < 0.5)
+    {
+      Simulator::Schedule (start, &NrInterferenceChunkTestCase::AddSignal, this,
+                           second, duration, true);
+    }
+
+  // Interferers that start during the reception, and can end after it
+  uint32_t numInterferers = m_random->GetInteger (0, 3);
+  for (uint32_t i = 0; i < numInterferers; ++i)
+    {
+      Time offset = MicroSeconds (m_random->GetInteger (0, 499));
+      Time interfDuration = MicroSeconds (m_random->GetInteger (50, 800));
+      Simulator::Schedule (start + offset, &NrInterferenceChunkTestCase::AddSignal, this,
+                           CreatePsd (model, 0.7), interfDuration, false);
+    }
+
+  Simulator::Schedule (start + duration, &NrInterferenceChunkTestCase::EndRx, this);
+}
+
+void
+NrInterferenceChunkTestCase::DoRun ()
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (3);
+
+  // Two spectrum models, with different numbers of RBs
+  std::vector<Ptr<const SpectrumModel> > models;
+  std::vector<Ptr<const SpectrumValue> > noises;
+  for (const auto & conf : std::vector<std::pair<uint32_t, double> > {{24, 180e3}, {51, 360e3}})
+    {
+      std::vector<double> centerFrequencies;
+      for (uint32_t rb = 0; rb < conf.first; ++rb)
+        {
+          centerFrequencies.push_back (28e9 + conf.second * rb);
+        }
+      Ptr<const SpectrumModel> model = Create<SpectrumModel> (centerFrequencies);
+      Ptr<SpectrumValue> noise = Create<SpectrumValue> (model);
+      for (auto it = noise->ValuesBegin (); it != noise->ValuesEnd (); ++it)
+        {
+          *it = 4e-21 * m_random->GetValue (1.0, 10.0);
+        }
+      models.push_back (model);
+      noises.push_back (noise);
+    }
+
+  m_interference = CreateObject<NrInterference> ();
+  m_reference = CreateObject<NrReferenceInterference> ();
+  for (const auto & p : {std::make_pair (m_interference, &m_values),
+                         std::make_pair (m_reference, &m_referenceValues)})
+    {
+      Ptr<LteChunkProcessor> processor;
+      if (p.first == m_interference)
+        {
+          processor = Create<LteChunkProcessor> ();
+        }
+      else
+        {
+          processor = Create<NrReferenceChunkProcessor> ();
+        }
+      processor->AddCallback (MakeCallback (&NrInterferenceValues::Sinr, p.second));
+      p.first->AddSinrChunkProcessor (processor);
+      p.first->TraceConnectWithoutContext ("SnrPerProcessedChunk",
+                                           MakeCallback (&NrInterferenceValues::Snr, p.second));
+      p.first->TraceConnectWithoutContext ("RssiPerProcessedChunk",
+                                           MakeCallback (&NrInterferenceValues::Rssi, p.second));
+    }
+
+  // The spectrum model changes every few receptions, between them
+  const uint32_t numReceptions = 200;
+  uint32_t model = 0;
+  for (uint32_t r = 0; r < numReceptions; ++r)
+    {
+      Time start = MilliSeconds (r);
+      if (r % 7 == 0)
+        {
+          model = (r / 7) % models.size ();
+          Simulator::Schedule (start, &NrInterferenceChunkTestCase::SetNoise, this, noises.at (model));
+        }
+      ScheduleReception (start + MicroSeconds (100), models.at (model));
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_values.m_sinr.size (), numReceptions, "Wrong number of SINR values");
+  NS_TEST_ASSERT_MSG_EQ (m_values.m_snr.size (), numReceptions, "Wrong number of SNR values");
+  NS_TEST_ASSERT_MSG_GT (m_values.m_rssi.size (), numReceptions, "Too few RSSI values");
+  NS_TEST_ASSERT_MSG_EQ (m_values.m_sinr.size (), m_referenceValues.m_sinr.size (), "Different number of SINR values");
+  NS_TEST_ASSERT_MSG_EQ (m_values.m_snr.size (), m_referenceValues.m_snr.size (), "Different number of SNR values");
+  NS_TEST_ASSERT_MSG_EQ (m_values.m_rssi.size (), m_referenceValues.m_rssi.size (), "Different number of RSSI values");
+
+  for (std::size_t i = 0; i < m_values.m_sinr.size (); ++i)
+    {
+      const SpectrumValue &sinr = m_values.m_sinr.at (i);
+      const SpectrumValue &expected = m_referenceValues.m_sinr.at (i);
+      NS_TEST_ASSERT_MSG_EQ (sinr.GetSpectrumModelUid (), expected.GetSpectrumModelUid (),
+                             "Different spectrum model of the SINR of the reception " << i);
+      for (std::size_t rb = 0; rb < sinr.GetValuesN (); ++rb)
+        {
+          // exact comparison: the values must be bit-identical
+          NS_TEST_ASSERT_MSG_EQ (sinr.ConstValuesBegin ()[rb], expected.ConstValuesBegin ()[rb],
+                                 "Different SINR of the RB " << rb << " of the reception " << i);
+        }
+      NS_TEST_ASSERT_MSG_EQ (m_values.m_snr.at (i), m_referenceValues.m_snr.at (i),
+                             "Different SNR of the reception " << i);
+    }
+  for (std::size_t i = 0; i < m_values.m_rssi.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_values.m_rssi.at (i), m_referenceValues.m_rssi.at (i),
+                             "Different RSSI of the chunk " << i);
+    }
+}
+
+/**
+ * \ingroup test
+ *
+ * \brief Test suite of the chunk evaluation of NrInterference
+ */
+class NrInterferenceChunkTestSuite : public TestSuite
+{
+public:
+  /** \brief Constructor */
+  NrInterferenceChunkTestSuite ()
+    : TestSuite ("nr-interference-chunk", UNIT)
+  {
+    AddTestCase (new NrInterferenceChunkTestCase, TestCase::QUICK);
+  }
+};
+
+/// Static variable for test initialization
+static NrInterferenceChunkTestSuite g_nrInterferenceChunkTestSuite;
+
+} // namespace ns3
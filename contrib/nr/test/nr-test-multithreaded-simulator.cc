@@ -0,0 +1,280 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/internet-module.h>
+#include <ns3/applications-module.h>
+#include <ns3/point-to-point-helper.h>
+#include <ns3/nr-module.h>
+#include <ns3/antenna-module.h>
+#include <ns3/multithreaded-simulator-impl.h>
+
+/**
+ * \file nr-test-multithreaded-simulator.cc
+ * \ingroup test
+ *
+ * \brief Test of NrHelper::AssignSimulatorPartitions with the
+ * MultithreadedSimulatorImpl. Two gNBs on different carriers serve two UEs
+ * each, and a remote host sends UDP packets to every UE through the EPC, so
+ * that the packets cross from the partition of the EPC to the ones of the
+ * cells on the S1-U links, whose delay gives the lookahead. The test checks
+ * that the packets received by each UE are the same with the
+ * DefaultSimulatorImpl. There is no UL traffic: with the configured grant
+ * scheduling of the gNB MAC the UL transmissions of the UEs of a cell overlap
+ * in frequency.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ *
+ * \brief Run the scenario with a simulator implementation, and compare the
+ * received packets with the ones of the DefaultSimulatorImpl.
+ */
+class NrMultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param threads the maximum number of threads
+   */
+  NrMultithreadedSimulatorTestCase (uint32_t threads)
+    : TestCase ("Partitioned NR scenario with " + std::to_string (threads) + " threads"),
+      m_threads (threads)
+  {}
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Run the scenario
+   * \param simulatorType the simulator implementation
+   * \return the packets received by each UE
+   */
+  std::vector<uint64_t> RunScenario (const std::string &simulatorType);
+
+  static const uint32_t N_GNBS = 2;        //!< Number of gNBs
+  static const uint32_t N_UES_PER_GNB = 2; //!< Number of UEs of each gNB
+  static const uint32_t N_PACKETS = 50;    //!< Packets sent to each UE
+
+  uint32_t m_threads {0};     //!< Maximum number of threads
+  Time m_lookahead;           //!< Lookahead set by the helper
+  uint32_t m_partitions {0};  //!< Number of partitions set by the helper
+};
+
+std::vector<uint64_t>
+NrMultithreadedSimulatorTestCase::RunScenario (const std::string &simulatorType)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (simulatorType));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (m_threads));
+  // The attach and the bearer setup use direct calls between the gNBs and
+  // the EPC: they must be done before the parallel phase
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ParallelStartTime", TimeValue (MilliSeconds (300)));
+  Config::SetDefault ("ns3::ThreeGppChannelModel::UpdatePeriod", TimeValue (MilliSeconds (0)));
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  NodeContainer gnbNodes;
+  gnbNodes.Create (N_GNBS);
+  std::vector<NodeContainer> ueNodes (N_GNBS);
+
+  Ptr<ListPositionAllocator> gnbPositions = CreateObject<ListPositionAllocator> ();
+  Ptr<ListPositionAllocator> uePositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < N_GNBS; ++i)
+    {
+      gnbPositions->Add (Vector (200.0 * i, 0.0, 10.0));
+      ueNodes.at (i).Create (N_UES_PER_GNB);
+      for (uint32_t j = 0; j < N_UES_PER_GNB; ++j)
+        {
+          uePositions->Add (Vector (200.0 * i + 10.0, 10.0 * j, 1.5));
+        }
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (gnbPositions);
+  mobility.Install (gnbNodes);
+  mobility.SetPositionAllocator (uePositions);
+  for (const auto & ues : ueNodes)
+    {
+      mobility.Install (ues);
+    }
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  // The S1-U links connect the partitions: their delay is the lookahead
+  epcHelper->SetAttribute ("S1uLinkDelay", TimeValue (MilliSeconds (1)));
+
+  Ptr<IdealBeamformingHelper> idealBeamformingHelper = CreateObject<IdealBeamformingHelper> ();
+  idealBeamformingHelper->SetAttribute ("BeamformingMethod", TypeIdValue (DirectPathBeamforming::GetTypeId ()));
+  // The periodic update touches all the cells: keep it out of the simulation
+  idealBeamformingHelper->SetAttribute ("BeamformingPeriodicity", TimeValue (Seconds (10)));
+
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetBeamformingHelper (idealBeamformingHelper);
+  nrHelper->SetEpcHelper (epcHelper);
+  nrHelper->SetPathlossAttribute ("ShadowingEnabled", BooleanValue (false));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  // One band for each gNB, so that the cells are in different partitions
+  CcBwpCreator ccBwpCreator;
+  std::vector<OperationBandInfo> bands;
+  for (uint32_t i = 0; i < N_GNBS; ++i)
+    {
+      CcBwpCreator::SimpleOperationBandConf bandConf (28e9 + 200e6 * i, 100e6, 1,
+                                                      BandwidthPartInfo::UMi_StreetCanyon_LoS);
+      bands.push_back (ccBwpCreator.CreateOperationBandContiguousCc (bandConf));
+    }
+
+  NetDeviceContainer gnbDevs;
+  NetDeviceContainer ueDevs;
+  std::vector<NetDeviceContainer> ueDevsOfGnb;
+  for (uint32_t i = 0; i < N_GNBS; ++i)
+    {
+      nrHelper->InitializeOperationBand (&bands.at (i));
+      BandwidthPartInfoPtrVector bwps = CcBwpCreator::GetAllBwps ({bands.at (i)});
+      gnbDevs.Add (nrHelper->InstallGnbDevice (NodeContainer (gnbNodes.Get (i)), bwps));
+      ueDevsOfGnb.push_back (nrHelper->InstallUeDevice (ueNodes.at (i), bwps));
+      ueDevs.Add (ueDevsOfGnb.back ());
+    }
+
+  int64_t randomStream = 1;
+  randomStream += nrHelper->AssignStreams (gnbDevs, randomStream);
+  randomStream += nrHelper->AssignStreams (ueDevs, randomStream);
+
+  for (auto it = gnbDevs.Begin (); it != gnbDevs.End (); ++it)
+    {
+      DynamicCast<NrGnbNetDevice> (*it)->UpdateConfig ();
+    }
+  for (auto it = ueDevs.Begin (); it != ueDevs.End (); ++it)
+    {
+      DynamicCast<NrUeNetDevice> (*it)->UpdateConfig ();
+    }
+
+  Ptr<Node> pgw = epcHelper->GetPgwNode ();
+  NodeContainer remoteHostContainer;
+  remoteHostContainer.Create (1);
+  Ptr<Node> remoteHost = remoteHostContainer.Get (0);
+  InternetStackHelper internet;
+  internet.Install (remoteHostContainer);
+  PointToPointHelper p2ph;
+  p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+  p2ph.SetDeviceAttribute ("Mtu", UintegerValue (2500));
+  p2ph.SetChannelAttribute ("Delay", TimeValue (Seconds (0.000)));
+  NetDeviceContainer internetDevices = p2ph.Install (pgw, remoteHost);
+  Ipv4AddressHelper ipv4h;
+  ipv4h.SetBase ("1.0.0.0", "255.0.0.0");
+  ipv4h.Assign (internetDevices);
+
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (remoteHost->GetObject<Ipv4> ());
+  remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+
+  ApplicationContainer clientApps;
+  const uint16_t dlPort = 1234;
+  for (uint32_t i = 0; i < N_GNBS; ++i)
+    {
+      internet.Install (ueNodes.at (i));
+      Ipv4InterfaceContainer ueIpIface = epcHelper->AssignUeIpv4Address (ueDevsOfGnb.at (i));
+      for (uint32_t j = 0; j < N_UES_PER_GNB; ++j)
+        {
+          Ptr<Node> ue = ueNodes.at (i).Get (j);
+          Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ue->GetObject<Ipv4> ());
+          ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+          nrHelper->AttachToEnb (ueDevsOfGnb.at (i).Get (j), gnbDevs.Get (i));
+        }
+    }
+
+  std::vector<Ptr<UdpServer> > dlServers;
+  for (uint32_t u = 0; u < ueDevs.GetN (); ++u)
+    {
+      Ptr<Node> ue = ueDevs.Get (u)->GetNode ();
+      Ipv4Address ueAddr = ue->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ();
+
+      UdpServerHelper dlServer (dlPort);
+      ApplicationContainer dlServerApp = dlServer.Install (ue);
+      dlServers.push_back (DynamicCast<UdpServer> (dlServerApp.Get (0)));
+      UdpClientHelper dlClient (ueAddr, dlPort);
+      dlClient.SetAttribute ("MaxPackets", UintegerValue (N_PACKETS));
+      dlClient.SetAttribute ("Interval", TimeValue (MilliSeconds (2)));
+      dlClient.SetAttribute ("PacketSize", UintegerValue (500));
+      clientApps.Add (dlClient.Install (remoteHost));
+    }
+  clientApps.Start (MilliSeconds (400));
+  clientApps.Stop (MilliSeconds (600));
+
+  if (simulatorType == "ns3::MultithreadedSimulatorImpl")
+    {
+      m_lookahead = nrHelper->AssignSimulatorPartitions (gnbDevs, ueDevs);
+      Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+      m_partitions = impl->GetNPartitions ();
+    }
+
+  Simulator::Stop (MilliSeconds (700));
+  Simulator::Run ();
+
+  std::vector<uint64_t> received;
+  for (const auto & server : dlServers)
+    {
+      received.push_back (server->GetReceived ());
+    }
+  Simulator::Destroy ();
+
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  return received;
+}
+
+void
+NrMultithreadedSimulatorTestCase::DoRun ()
+{
+  auto expected = RunScenario ("ns3::DefaultSimulatorImpl");
+  auto received = RunScenario ("ns3::MultithreadedSimulatorImpl");
+
+  // One partition for each cell, plus the one of the EPC
+  NS_TEST_ASSERT_MSG_EQ (m_partitions, N_GNBS + 1, "Wrong number of partitions");
+  NS_TEST_ASSERT_MSG_GT (m_lookahead, Time (0), "The partitions would not run in parallel");
+  NS_TEST_ASSERT_MSG_EQ (received.size (), expected.size (), "Wrong number of servers");
+  for (uint32_t i = 0; i < expected.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_GT (expected.at (i), N_PACKETS / 2, "Too few packets received by the server " << i);
+      NS_TEST_ASSERT_MSG_EQ (received.at (i), expected.at (i),
+                             "Different packets received by the server " << i);
+    }
+}
+
+/**
+ * \ingroup test
+ *
+ * \brief Test suite of NrHelper::AssignSimulatorPartitions
+ */
+class NrMultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  /** \brief Constructor */
+  NrMultithreadedSimulatorTestSuite ()
+    : TestSuite ("nr-multithreaded-simulator", SYSTEM)
+  {
+    AddTestCase (new NrMultithreadedSimulatorTestCase (1), TestCase::QUICK);
+    AddTestCase (new NrMultithreadedSimulatorTestCase (3), TestCase::QUICK);
+  }
+};
+
+/// Static variable for test initialization
+static NrMultithreadedSimulatorTestSuite g_nrMultithreadedSimulatorTestSuite;
+
+} // namespace ns3
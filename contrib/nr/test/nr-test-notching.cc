@@ -57,6 +57,7 @@ public:
   virtual void SetSlotAllocInfo (const SlotAllocInfo &slotAllocInfo) override;
   virtual void NotifyConnectionSuccessful () override;
   virtual uint32_t GetRbNum () const override;
+  virtual void NotifyMacActivity () override;
   virtual BeamConfId GetBeamConfId (uint8_t rnti) const override;
   void SetParams (uint32_t numOfUesPerBeam, uint32_t numOfBeams);
 
@@ -148,6 +149,10 @@ TestNotchingPhySapProvider::GetRbNum () const
   return 53;
 }
 
+void
+TestNotchingPhySapProvider::NotifyMacActivity ()
+{}
+
 BeamConfId
 TestNotchingPhySapProvider::GetBeamConfId (uint8_t rnti) const
 {
@@ -235,7 +240,7 @@ TestNotchingGnbMac::DoSchedConfigIndication (NrMacSchedSapUser::SchedConfigIndPa
       if (m_verboseMac)
         {
           std::ostringstream oss;
-          for (auto & x: varTtiAllocInfo.m_dci->m_rbgBitmask)
+          for (auto x: varTtiAllocInfo.m_dci->m_rbgBitmask)
             {
               oss << std::to_string (x) << " ";
             }
@@ -0,0 +1,421 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/trajectory-file-helper.h>
+#include <ns3/file-scenario-helper.h>
+#include <ns3/position-allocator.h>
+#include <ns3/node-container.h>
+#include <ns3/simulator.h>
+#include <ns3/waypoint-mobility-model.h>
+
+#include <cstdio>
+#include <fstream>
+
+#if defined (HAVE_UNISTD_H) && defined (HAVE_SYS_WAIT_H)
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * \file nr-test-trajectory-file.cc
+ * \ingroup test
+ *
+ * \brief Test of the TrajectoryFile and of the TrajectoryFileHelper. The
+ * CSV files of positions and of waypoints are converted and read back, and
+ * the nodes that get the waypoints a few at a time must follow the same
+ * trajectories of reference nodes that get all of them at the start.
+ * FileScenarioHelper reads the sites and the UT trajectories from the
+ * trajectory files.
+ */
+namespace ns3 {
+
+/**
+ * \brief Conversion of the CSV files
+ */
+class NrTrajectoryFileConvertTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrTrajectoryFileConvertTestCase ();
+
+private:
+  virtual void DoRun (void) override;
+};
+
+NrTrajectoryFileConvertTestCase::NrTrajectoryFileConvertTestCase ()
+  : TestCase ("Convert the CSV files of positions and waypoints")
+{
+}
+
+void
+NrTrajectoryFileConvertTestCase::DoRun ()
+{
+  std::string csvPath = CreateTempDirFilename ("nr-trajectory-positions.csv");
+  std::string filePath = CreateTempDirFilename ("nr-trajectory-positions.bin");
+  {
+    std::ofstream csv (csvPath);
+    csv << "# X, Y, Z\n"
+        << "1.5, 2.5, 30\n"
+        << "\n"
+        << "-10, 20\n";
+  }
+  NS_TEST_ASSERT_MSG_EQ (TrajectoryFile::IsTrajectoryFile (csvPath), false, "A CSV file is a trajectory file");
+  std::size_t numNodes = TrajectoryFile::ConvertCsv (csvPath, filePath, 25.0);
+  NS_TEST_ASSERT_MSG_EQ (numNodes, 2, "Wrong number of positions");
+  NS_TEST_ASSERT_MSG_EQ (TrajectoryFile::IsTrajectoryFile (filePath), true, "The converted file is not a trajectory file");
+  {
+    TrajectoryFile file (filePath);
+    NS_TEST_ASSERT_MSG_EQ (file.GetNumNodes (), 2, "Wrong number of nodes");
+    NS_TEST_ASSERT_MSG_EQ (file.GetNumWaypoints (0), 1, "A position has more than one waypoint");
+    NS_TEST_ASSERT_MSG_EQ (file.GetNumWaypoints (1), 1, "A position has more than one waypoint");
+    NS_TEST_ASSERT_MSG_EQ (file.GetWaypoint (0, 0).time, Seconds (0), "Wrong time of a position");
+    NS_TEST_ASSERT_MSG_EQ (file.GetWaypoint (0, 0).position, Vector (1.5, 2.5, 30), "Wrong position");
+    NS_TEST_ASSERT_MSG_EQ (file.GetWaypoint (1, 0).position, Vector (-10, 20, 25), "Wrong position without Z");
+  }
+  std::remove (csvPath.c_str ());
+  std::remove (filePath.c_str ());
+
+  // the rows of the nodes are interleaved
+  csvPath = CreateTempDirFilename ("nr-trajectory-waypoints.csv");
+  filePath = CreateTempDirFilename ("nr-trajectory-waypoints.bin");
+  {
+    std::ofstream csv (csvPath);
+    csv << "# node, time, X, Y, Z\n"
+        << "1, 0.5, 0, 0, 1.5\n"
+        << "0, 0, 10, 10\n"
+        << "1, 1.5, 20, 0, 1.5\n"
+        << "0, 2, 10, 30\n"
+        << "1, 2, 20, 40, 1.5\n";
+  }
+  numNodes = TrajectoryFile::ConvertCsv (csvPath, filePath, 1.0);
+  NS_TEST_ASSERT_MSG_EQ (numNodes, 2, "Wrong number of trajectories");
+  {
+    TrajectoryFile file (filePath);
+    NS_TEST_ASSERT_MSG_EQ (file.GetNumWaypoints (0), 2, "Wrong number of waypoints");
+    NS_TEST_ASSERT_MSG_EQ (file.GetNumWaypoints (1), 3, "Wrong number of waypoints");
+    NS_TEST_ASSERT_MSG_EQ (file.GetWaypoint (0, 1).time, Seconds (2), "Wrong time");
+    NS_TEST_ASSERT_MSG_EQ (file.GetWaypoint (0, 1).position, Vector (10, 30, 1), "Wrong position");
+    NS_TEST_ASSERT_MSG_EQ (file.GetWaypoint (1, 0).time, Seconds (0.5), "Wrong time");
+    NS_TEST_ASSERT_MSG_EQ (file.GetWaypoint (1, 2).position, Vector (20, 40, 1.5), "Wrong position");
+  }
+  std::remove (csvPath.c_str ());
+  std::remove (filePath.c_str ());
+}
+
+/**
+ * \brief The nodes follow the trajectories of the file
+ */
+class NrTrajectoryFileInstallTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param lookAhead the number of waypoints added at a time
+   */
+  NrTrajectoryFileInstallTestCase (uint32_t lookAhead);
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Compare the positions of the nodes with the reference nodes
+   */
+  void CheckPositions ();
+
+  uint32_t m_lookAhead;     //!< the number of waypoints added at a time
+  NodeContainer m_nodes;    //!< the nodes that get the waypoints on demand
+  NodeContainer m_refNodes; //!< the nodes that get all the waypoints
+};
+
+NrTrajectoryFileInstallTestCase::NrTrajectoryFileInstallTestCase (uint32_t lookAhead)
+  : TestCase ("Follow the trajectories, adding " + std::to_string (lookAhead) + " waypoints at a time"),
+    m_lookAhead (lookAhead)
+{
+}
+
+void
+NrTrajectoryFileInstallTestCase::CheckPositions ()
+{
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      Ptr<WaypointMobilityModel> model = m_nodes.Get (i)->GetObject<WaypointMobilityModel> ();
+      Ptr<WaypointMobilityModel> refModel = m_refNodes.Get (i)->GetObject<WaypointMobilityModel> ();
+      Vector pos = model->GetPosition ();
+      Vector refPos = refModel->GetPosition ();
+      NS_TEST_ASSERT_MSG_EQ_TOL (pos.x, refPos.x, 1e-9, "Wrong X of node " << i << " at " << Simulator::Now ().As (Time::S));
+      NS_TEST_ASSERT_MSG_EQ_TOL (pos.y, refPos.y, 1e-9, "Wrong Y of node " << i << " at " << Simulator::Now ().As (Time::S));
+      NS_TEST_ASSERT_MSG_EQ_TOL (pos.z, refPos.z, 1e-9, "Wrong Z of node " << i << " at " << Simulator::Now ().As (Time::S));
+      NS_TEST_ASSERT_MSG_EQ (((model->GetVelocity () - refModel->GetVelocity ()).GetLength () < 1e-9), true,
+                             "Wrong velocity of node " << i << " at " << Simulator::Now ().As (Time::S));
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (model->WaypointsLeft (), m_lookAhead, "Too many waypoints added to node " << i);
+    }
+}
+
+void
+NrTrajectoryFileInstallTestCase::DoRun ()
+{
+  std::string csvPath = CreateTempDirFilename ("nr-trajectory-install.csv");
+  std::string filePath = CreateTempDirFilename ("nr-trajectory-install.bin");
+  {
+    // a node that moves, a node that does not move, and a node that
+    // starts moving later
+    std::ofstream csv (csvPath);
+    for (uint32_t t = 0; t < 20; t++)
+      {
+        csv << "0, " << 0.1 * t << ", " << (t % 3) * 5.0 << ", " << t * 1.0 << ", 1.5\n";
+      }
+    csv << "1, 0, 100, 100, 1.5\n";
+    for (uint32_t t = 0; t < 7; t++)
+      {
+        csv << "2, " << 0.5 + 0.25 * t << ", " << -1.0 * t << ", " << t * t << "\n";
+      }
+  }
+  TrajectoryFile::ConvertCsv (csvPath, filePath, 1.5);
+  std::remove (csvPath.c_str ());
+
+  TrajectoryFileHelper helper (filePath);
+  helper.SetLookAhead (m_lookAhead);
+  m_nodes.Create (3);
+  helper.Install (m_nodes);
+
+  Ptr<const TrajectoryFile> file = helper.GetFile ();
+  m_refNodes.Create (3);
+  for (uint32_t i = 0; i < m_refNodes.GetN (); i++)
+    {
+      Ptr<WaypointMobilityModel> model = CreateObject<WaypointMobilityModel> ();
+      m_refNodes.Get (i)->AggregateObject (model);
+      for (std::size_t w = 0; w < file->GetNumWaypoints (i); w++)
+        {
+          model->AddWaypoint (file->GetWaypoint (i, w));
+        }
+    }
+
+  for (uint32_t t = 0; t <= 250; t++)
+    {
+      Simulator::Schedule (MilliSeconds (10 * t + 3), &NrTrajectoryFileInstallTestCase::CheckPositions, this);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::remove (filePath.c_str ());
+}
+
+/**
+ * \brief The sites and the UT trajectories of FileScenarioHelper read from
+ * trajectory files
+ */
+class NrFileScenarioTrajectoryTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrFileScenarioTrajectoryTestCase ();
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Check that a UT is at a waypoint of the file
+   * \param file the UT trajectory file
+   * \param ut the index of the UT
+   * \param waypoint the index of the waypoint
+   */
+  void CheckPosition (Ptr<const TrajectoryFile> file, uint32_t ut, std::size_t waypoint);
+
+  NodeContainer m_uts;  //!< the UTs of the scenario
+};
+
+NrFileScenarioTrajectoryTestCase::NrFileScenarioTrajectoryTestCase ()
+  : TestCase ("Sites and UT trajectories of FileScenarioHelper from trajectory files")
+{
+}
+
+void
+NrFileScenarioTrajectoryTestCase::CheckPosition (Ptr<const TrajectoryFile> file, uint32_t ut, std::size_t waypoint)
+{
+  Vector pos = m_uts.Get (ut)->GetObject<MobilityModel> ()->GetPosition ();
+  Vector expected = file->GetWaypoint (ut, waypoint).position;
+  NS_TEST_ASSERT_MSG_EQ_TOL (pos.x, expected.x, 1e-9, "Wrong X of UT " << ut << " at " << Simulator::Now ().As (Time::S));
+  NS_TEST_ASSERT_MSG_EQ_TOL (pos.y, expected.y, 1e-9, "Wrong Y of UT " << ut << " at " << Simulator::Now ().As (Time::S));
+  NS_TEST_ASSERT_MSG_EQ_TOL (pos.z, expected.z, 1e-9, "Wrong Z of UT " << ut << " at " << Simulator::Now ().As (Time::S));
+}
+
+void
+NrFileScenarioTrajectoryTestCase::DoRun ()
+{
+  std::string csvPath = CreateTempDirFilename ("nr-scenario-sites.csv");
+  std::string sitesPath = CreateTempDirFilename ("nr-scenario-sites.bin");
+  std::string xyPath = CreateTempDirFilename ("nr-scenario-sites-xy.csv");
+  std::string utsPath = CreateTempDirFilename ("nr-scenario-uts.bin");
+  {
+    // the second site has no Z, and gets the default Z of the conversion
+    std::ofstream csv (csvPath);
+    csv << "-1000, 0, 30\n";
+    csv << "1000, 0\n";
+  }
+  TrajectoryFile::ConvertCsv (csvPath, sitesPath, 25.0);
+  {
+    // a site without Z in a CSV file, that gets the BS height
+    std::ofstream csv (xyPath);
+    csv << "0, 200\n";
+  }
+  {
+    // the UTs start at different times, with the same number of waypoints
+    std::ofstream csv (csvPath);
+    for (uint32_t ut = 0; ut < 3; ut++)
+      {
+        for (uint32_t t = 0; t < 4; t++)
+          {
+            csv << ut << ", " << 0.25 * ut + t << ", " << 10.0 * t << ", " << -5.0 * ut * t << ", " << 1.5 + ut << "\n";
+          }
+      }
+  }
+  TrajectoryFile::ConvertCsv (csvPath, utsPath, 1.5);
+  std::remove (csvPath.c_str ());
+
+  FileScenarioHelper scenario;
+  scenario.SetSectorization (ScenarioParameters::SINGLE);
+  scenario.SetScenarioParameters ("UMi");
+  scenario.SetBsHeight (12.0);
+  scenario.Add (sitesPath);
+  scenario.Add (xyPath);
+  scenario.SetUtNumber (3);
+  scenario.SetUtTrajectories (utsPath, 2);
+  scenario.CreateScenario ();
+  // the deployment plot is written in the working directory
+  std::remove ("list-topology.gnuplot");
+
+  NS_TEST_ASSERT_MSG_EQ (scenario.GetNumSites (), 3U, "Wrong number of sites");
+  NS_TEST_ASSERT_MSG_EQ (scenario.GetSitePosition (0), Vector (-1000, 0, 30), "Wrong Z of a site of the trajectory file");
+  NS_TEST_ASSERT_MSG_EQ (scenario.GetSitePosition (1), Vector (1000, 0, 25),
+                         "Wrong Z of a site of the trajectory file, converted without Z");
+  NS_TEST_ASSERT_MSG_EQ (scenario.GetSitePosition (2), Vector (0, 200, 12), "The BS height is not the Z of a CSV site");
+
+  // the UTs follow the trajectories of the file, instead of being dropped
+  Ptr<const TrajectoryFile> file = Create<TrajectoryFile> (utsPath);
+  m_uts = scenario.GetUserTerminals ();
+  NS_TEST_ASSERT_MSG_EQ (m_uts.GetN (), 3U, "Wrong number of UTs");
+  for (uint32_t i = 0; i < m_uts.GetN (); i++)
+    {
+      NS_TEST_ASSERT_MSG_NE (m_uts.Get (i)->GetObject<WaypointMobilityModel> (), nullptr,
+                             "UT " << i << " does not follow a trajectory");
+    }
+  for (uint32_t i = 0; i < m_uts.GetN (); i++)
+    {
+      for (std::size_t w = 0; w < file->GetNumWaypoints (i); w++)
+        {
+          Simulator::Schedule (file->GetWaypoint (i, w).time,
+                               &NrFileScenarioTrajectoryTestCase::CheckPosition, this, file, i, w);
+        }
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::remove (sitesPath.c_str ());
+  std::remove (xyPath.c_str ());
+  std::remove (utsPath.c_str ());
+}
+
+#if defined (HAVE_UNISTD_H) && defined (HAVE_SYS_WAIT_H)
+/**
+ * \brief FileScenarioHelper::CreateScenario with fewer UT trajectories than
+ * UTs must abort. The scenario is created in a child process.
+ */
+class NrFileScenarioTooFewTrajectoriesTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrFileScenarioTooFewTrajectoriesTestCase ();
+
+private:
+  virtual void DoRun (void) override;
+};
+
+NrFileScenarioTooFewTrajectoriesTestCase::NrFileScenarioTooFewTrajectoriesTestCase ()
+  : TestCase ("FileScenarioHelper aborts with fewer UT trajectories than UTs")
+{
+}
+
+void
+NrFileScenarioTooFewTrajectoriesTestCase::DoRun ()
+{
+  std::string csvPath = CreateTempDirFilename ("nr-scenario-sites.csv");
+  std::string utsPath = CreateTempDirFilename ("nr-scenario-uts.bin");
+  {
+    std::ofstream csv (csvPath);
+    csv << "0, 0, 1.5\n";
+    csv << "1, 10, 1.5\n";
+  }
+  TrajectoryFile::ConvertCsv (csvPath, utsPath, 1.5);
+  {
+    std::ofstream csv (csvPath);
+    csv << "-1000, 0\n";
+    csv << "1000, 0\n";
+  }
+
+  pid_t pid = fork ();
+  NS_TEST_ASSERT_MSG_NE (pid, -1, "fork failed");
+  if (pid == 0)
+    {
+      // the abort message is expected
+      std::freopen ("/dev/null", "w", stderr);
+      FileScenarioHelper scenario;
+      scenario.SetSectorization (ScenarioParameters::SINGLE);
+      scenario.SetScenarioParameters ("UMi");
+      scenario.Add (csvPath);
+      scenario.SetUtNumber (3);
+      scenario.SetUtTrajectories (utsPath);
+      scenario.CreateScenario ();
+      _exit (0);
+    }
+  int status = 0;
+  NS_TEST_ASSERT_MSG_EQ (waitpid (pid, &status, 0), pid, "waitpid failed");
+  NS_TEST_ASSERT_MSG_EQ ((WIFSIGNALED (status) && WTERMSIG (status) == SIGABRT), true,
+                         "CreateScenario did not abort");
+
+  std::remove (csvPath.c_str ());
+  std::remove (utsPath.c_str ());
+}
+#endif
+
+/**
+ * \brief Test suite of the trajectory files
+ */
+class NrTestTrajectoryFile : public TestSuite
+{
+public:
+  NrTestTrajectoryFile () : TestSuite ("nr-test-trajectory-file", UNIT)
+  {
+    AddTestCase (new NrTrajectoryFileConvertTestCase (), QUICK);
+    AddTestCase (new NrTrajectoryFileInstallTestCase (2), QUICK);
+    AddTestCase (new NrTrajectoryFileInstallTestCase (5), QUICK);
+    AddTestCase (new NrFileScenarioTrajectoryTestCase (), QUICK);
+#if defined (HAVE_UNISTD_H) && defined (HAVE_SYS_WAIT_H)
+    AddTestCase (new NrFileScenarioTooFewTrajectoriesTestCase (), QUICK);
+#endif
+  }
+};
+
+static NrTestTrajectoryFile g_nrTestTrajectoryFile; //!< Trajectory file test suite
+
+}  // namespace ns3
@@ -41,7 +41,8 @@ SystemSchedulerTest::CountPkts ([[maybe_unused]] Ptr<const Packet> pkt)
 SystemSchedulerTest::SystemSchedulerTest (const std::string & name, uint32_t usersPerBeamNum,
                                           uint32_t beamsNum, uint32_t numerology,
                                           double bw1, bool isDownlnk, bool isUplink,
-                                          const std::string & schedulerType)
+                                          const std::string & schedulerType,
+                                          bool idleSlotFastForward)
   : TestCase (name)
 {
   m_numerology = numerology;
@@ -52,6 +53,7 @@ SystemSchedulerTest::SystemSchedulerTest (const std::string & name, uint32_t use
   NS_ABORT_MSG_UNLESS (beamsNum <= 4, "Test program is designed to support up to 4 beams per gNB" );
   m_beamsNum = beamsNum;
   m_schedulerType = schedulerType;
+  m_idleSlotFastForward = idleSlotFastForward;
   m_name = name;
 }
 
@@ -66,6 +68,38 @@ SystemSchedulerTest::DoRun (void)
 {
   NS_ABORT_IF (!m_isUplink && !m_isDownlink);
 
+  uint64_t events = 0;
+  double dataRecv = Simulate (m_idleSlotFastForward, events);
+  uint32_t packets = m_packets;
+
+  DataRate udpRate = DataRate ("320kbps");   // 400 packets of 800 bits
+  uint32_t ueNum = m_usersPerBeamNum * m_beamsNum;
+  double expectedBitRate = udpRate.GetBitRate () * ueNum * ((m_isUplink && m_isDownlink) ? 2 : 1);
+  NS_TEST_ASSERT_MSG_EQ_TOL (dataRecv, expectedBitRate, expectedBitRate * 0.05, "Wrong total DL + UL throughput");
+
+  if (m_idleSlotFastForward)
+    {
+      // The same simulation, with the UEs processing every slot: the same
+      // packets must be delivered, and the UEs that skip their idle slots,
+      // between the attachment and the start of the traffic at 500 ms,
+      // must save at least one event per skipped slot
+      uint64_t refEvents = 0;
+      double refDataRecv = Simulate (false, refEvents);
+      NS_TEST_ASSERT_MSG_EQ (packets, m_packets, "Different packets delivered skipping the idle slots");
+      NS_TEST_ASSERT_MSG_EQ_TOL (dataRecv, refDataRecv, 1e-9, "Different data received skipping the idle slots");
+
+      uint64_t minSkippedSlots = static_cast<uint64_t> (ueNum) * 300 * (1 << m_numerology);
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (refEvents, events + minSkippedSlots,
+                                   "Too few events saved skipping the idle slots: " << events
+                                   << " instead of " << refEvents);
+    }
+}
+
+double
+SystemSchedulerTest::Simulate (bool idleSlotFastForward, uint64_t &events)
+{
+  m_packets = 0;
+
   // set simulation time and mobility
   Time simTime = MilliSeconds (1500);
   Time udpAppStartTimeDl = MilliSeconds (500);
@@ -75,7 +109,6 @@ SystemSchedulerTest::DoRun (void)
   uint16_t gNbNum = 1;
   uint32_t packetSize = 100;
   uint32_t maxPackets = 400;
-  DataRate udpRate = DataRate ("320kbps");   // 400 packets of 800 bits
 
   Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (999999999));
   Config::SetDefault ("ns3::LteRlcUm::ReorderingTimer", TimeValue (Seconds (1)));
@@ -83,6 +116,7 @@ SystemSchedulerTest::DoRun (void)
 
   Config::SetDefault ("ns3::NrUePhy::EnableUplinkPowerControl", BooleanValue (false));   // scheduler tests are designed to expect the maximum transmit power, maximum MCS,
                                                                                          // thus uplink power control is not compatible, because it will adjust
+  Config::SetDefault ("ns3::NrUePhy::IdleSlotFastForward", BooleanValue (idleSlotFastForward));
 
   // create base stations and mobile terminals
   NodeContainer gNbNodes;
@@ -367,6 +401,7 @@ SystemSchedulerTest::DoRun (void)
   //nrHelper->EnableTraces();
   Simulator::Stop (simTime);
   Simulator::Run ();
+  events = Simulator::GetEventCount ();
 
   double dataRecvDl = 0;
   double dataRecvUl = 0;
@@ -390,10 +425,8 @@ SystemSchedulerTest::DoRun (void)
         }
     }
 
-  double expectedBitRate = udpRate.GetBitRate () * ueNodes.GetN () * ((m_isUplink && m_isDownlink) ? 2 : 1);
-  NS_TEST_ASSERT_MSG_EQ_TOL (dataRecvDl + dataRecvUl, expectedBitRate, expectedBitRate * 0.05, "Wrong total DL + UL throughput");
-
   Simulator::Destroy ();
+  return dataRecvDl + dataRecvUl;
 }
 
 } // namespace ns3
@@ -56,10 +56,14 @@ public:
    * \param isDownlink Is the downlink traffic going to be present in the test case
    * \param isUplink Is the uplink traffic going to be present in the test case
    * \param schedulerType Which scheduler is going to be used in the test case Ofdma/Tdma" and the scheduling logic RR, PF, of MR
+   * \param idleSlotFastForward Whether the UEs skip the slots in which they are idle.
+   * If true, the simulation is repeated with the UEs processing every slot, and
+   * the test checks that the same packets are delivered with fewer events
    */
   SystemSchedulerTest (const std::string & name, uint32_t usersPerBeamNum, uint32_t beamsNum,
                        uint32_t numerology, double bw1, bool isDownlink,
-                       bool isUplink, const std::string & schedulerType);
+                       bool isUplink, const std::string & schedulerType,
+                       bool idleSlotFastForward = false);
   /**
    * \brief ~SystemSchedulerTest
    */
@@ -69,6 +73,14 @@ private:
   virtual void DoRun (void);
   void CountPkts (Ptr<const Packet> pkt);
 
+  /**
+   * \brief Run the simulation
+   * \param idleSlotFastForward the value of the NrUePhy IdleSlotFastForward attribute
+   * \param events will contain the number of events executed
+   * \return the data received in DL and UL, in bits
+   */
+  double Simulate (bool idleSlotFastForward, uint64_t &events);
+
   uint32_t m_numerology; //!< the numerology to be used
   double m_bw1;          //!< bandwidth of bandwidth part 1
   bool m_isDownlink;     //!< whether to generate the downlink traffic
@@ -76,6 +88,7 @@ private:
   uint32_t m_usersPerBeamNum; //!< number of users
   uint32_t m_beamsNum;   //!< currently the test is supposed to work with maximum 4 beams per gNb
   std::string m_schedulerType; //!< Sched type
+  bool m_idleSlotFastForward;  //!< Whether the UEs skip their idle slots
   std::string m_name;          //!< Name of the test
   uint32_t m_packets {0};      //!< Packets received correctly
   uint32_t m_limit {0};        //!< Total amount of packets, depending on the parameters of the test
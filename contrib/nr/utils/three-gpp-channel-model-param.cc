@@ -148,15 +148,19 @@ ThreeGppChannelModelParam::GetNewChannel (Ptr<const ThreeGppChannelParams> chann
   // NOTE Since each of the strongest 2 clusters are divided into 3 sub-clusters,
   // the total cluster will be numReducedCLuster + 4.
 
-  H_usn.resize (uSize);
-  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+  // The sub-clusters 2 and 3 of the strongest clusters follow the
+  // m_reducedClusterNumber clusters, in the order of the cluster index
+  std::vector<uint8_t> subClusterPage (channelParams->m_reducedClusterNumber, 0);
+  uint8_t numPages = channelParams->m_reducedClusterNumber;
+  for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
     {
-      H_usn[uIndex].resize (sSize);
-      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+      if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
         {
-          H_usn[uIndex][sIndex].resize (channelParams->m_reducedClusterNumber);
+          subClusterPage[nIndex] = numPages;
+          numPages += 2;
         }
     }
+  H_usn.Resize (uSize, sSize, numPages);
 
   NS_ASSERT (channelParams->m_reducedClusterNumber <= channelParams->m_clusterPhase.size ());
   NS_ASSERT (channelParams->m_reducedClusterNumber <= channelParams->m_clusterPower.size ());
@@ -185,15 +189,36 @@ ThreeGppChannelModelParam::GetNewChannel (Ptr<const ThreeGppChannelParams> chann
   Angles sAngle (uMob->GetPosition (), sMob->GetPosition ());
   Angles uAngle (sMob->GetPosition (), uMob->GetPosition ());
 
+  // The field patterns do not depend on the antenna elements: they are
+  // computed once for all the rays (index n * raysPerCluster + m)
+  const uint8_t numRays = table3gpp->m_raysPerCluster;
+  std::vector<Angles> rxAngles;
+  std::vector<Angles> txAngles;
+  for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
+    {
+      for (uint8_t mIndex = 0; mIndex < numRays; mIndex++)
+        {
+          rxAngles.emplace_back (rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]);
+          txAngles.emplace_back (rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]);
+        }
+    }
+  std::vector<std::pair<double, double> > rxFieldPatterns;
+  std::vector<std::pair<double, double> > txFieldPatterns;
+  uAntenna->GetElementFieldPatterns (rxAngles, rxFieldPatterns);
+  sAntenna->GetElementFieldPatterns (txAngles, txFieldPatterns);
+
+  const std::vector<Vector> &uLocations = uAntenna->GetElementLocations ();
+  const std::vector<Vector> &sLocations = sAntenna->GetElementLocations ();
+
   // The following for loops computes the channel coefficients
   for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
     {
-      Vector uLoc = uAntenna->GetElementLocation (uIndex);
+      const Vector &uLoc = uLocations[uIndex];
 
       for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
         {
 
-          Vector sLoc = sAntenna->GetElementLocation (sIndex);
+          const Vector &sLoc = sLocations[sIndex];
 
           for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
             {
@@ -228,8 +253,8 @@ ThreeGppChannelModelParam::GetNewChannel (Ptr<const ThreeGppChannelParams> chann
                       // NOTE Doppler is computed in the CalcBeamformingGain function and is simplified to only account for the center angle of each cluster.
 
                       double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]));
+                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = rxFieldPatterns[nIndex * numRays + mIndex];
+                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = txFieldPatterns[nIndex * numRays + mIndex];
 
                       rays += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
                                +exp (std::complex<double> (0, initialPhase[1])) * Ro * rxFieldPatternTheta * txFieldPatternPhi +
@@ -239,7 +264,7 @@ ThreeGppChannelModelParam::GetNewChannel (Ptr<const ThreeGppChannelParams> chann
                         * exp (std::complex<double> (0, txPhaseDiff));
                     }
                   rays *= sqrt (channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                  H_usn[uIndex][sIndex][nIndex] = rays;
+                  H_usn (uIndex, sIndex, nIndex) = rays;
                 }
               else  //(7.5-28)
                 {
@@ -271,8 +296,8 @@ ThreeGppChannelModelParam::GetNewChannel (Ptr<const ThreeGppChannelParams> chann
                                                        + cos (rayZodRadian[nIndex][mIndex]) * sLoc.z);
 
                       double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]));
+                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = rxFieldPatterns[nIndex * numRays + mIndex];
+                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = txFieldPatterns[nIndex * numRays + mIndex];
 
                       switch (mIndex)
                         {
@@ -313,11 +338,11 @@ ThreeGppChannelModelParam::GetNewChannel (Ptr<const ThreeGppChannelParams> chann
                   raysSub1 *= sqrt (channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
                   raysSub2 *= sqrt (channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
                   raysSub3 *= sqrt (channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                  H_usn[uIndex][sIndex][nIndex] = raysSub1;
-                  H_usn[uIndex][sIndex].push_back (raysSub2);
-                  H_usn[uIndex][sIndex].push_back (raysSub3);
+                  H_usn (uIndex, sIndex, nIndex) = raysSub1;
+                  H_usn (uIndex, sIndex, subClusterPage[nIndex]) = raysSub2;
+                  H_usn (uIndex, sIndex, subClusterPage[nIndex] + 1) = raysSub3;
 
-                  NS_LOG_DEBUG ("H_usn[uIndex][sIndex][nIndex]:"<< H_usn[uIndex][sIndex][nIndex]<< " uIndex:"<<uIndex<<", sIndex:"<<sIndex<<"nIndex:"<< +nIndex);
+                  NS_LOG_DEBUG ("H_usn[uIndex][sIndex][nIndex]:"<< H_usn (uIndex, sIndex, nIndex)<< " uIndex:"<<uIndex<<", sIndex:"<<sIndex<<"nIndex:"<< +nIndex);
                 }
             }
           if (channelParams->m_losCondition == ChannelCondition::LOS) //(7.5-29) && (7.5-30)
@@ -343,12 +368,11 @@ ThreeGppChannelModelParam::GetNewChannel (Ptr<const ThreeGppChannelParams> chann
 
               double K_linear = pow (10, channelParams->m_K_factor / 10);
               // the LOS path should be attenuated if blockage is enabled.
-              H_usn[uIndex][sIndex][0] = sqrt (1 / (K_linear + 1)) * H_usn[uIndex][sIndex][0] + sqrt (K_linear / (1 + K_linear)) * ray / pow (10, channelParams->m_attenuation_dB[0] / 10);           //(7.5-30) for tau = tau1
-              double tempSize = H_usn[uIndex][sIndex].size ();
-              for (uint8_t nIndex = 1; nIndex < tempSize; nIndex++)
+              H_usn (uIndex, sIndex, 0) = sqrt (1 / (K_linear + 1)) * H_usn (uIndex, sIndex, 0) + sqrt (K_linear / (1 + K_linear)) * ray / pow (10, channelParams->m_attenuation_dB[0] / 10);           //(7.5-30) for tau = tau1
+              for (uint8_t nIndex = 1; nIndex < numPages; nIndex++)
                 {
-                  H_usn[uIndex][sIndex][nIndex] *= sqrt (1 / (K_linear + 1)); //(7.5-30) for tau = tau2...taunN
-                  NS_LOG_DEBUG ("LOS H_usn[uIndex][sIndex][nIndex]:"<< H_usn[uIndex][sIndex][nIndex]<< " uIndex:"<<uIndex<<", sIndex:"<<sIndex<<"nIndex:"<< +nIndex);
+                  H_usn (uIndex, sIndex, nIndex) *= sqrt (1 / (K_linear + 1)); //(7.5-30) for tau = tau2...taunN
+                  NS_LOG_DEBUG ("LOS H_usn[uIndex][sIndex][nIndex]:"<< H_usn (uIndex, sIndex, nIndex)<< " uIndex:"<<uIndex<<", sIndex:"<<sIndex<<"nIndex:"<< +nIndex);
                 }
 
             }
@@ -356,18 +380,18 @@ ThreeGppChannelModelParam::GetNewChannel (Ptr<const ThreeGppChannelParams> chann
     }
 
   NS_LOG_DEBUG ("Husn (sAntenna, uAntenna):" << sAntenna->GetId () << ", " << uAntenna->GetId ());
-  for (auto& i:H_usn)
+  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
     {
-      for (auto& j:i)
+      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
         {
-          for (auto& k:j)
+          for (uint8_t nIndex = 0; nIndex < numPages; nIndex++)
             {
-              NS_LOG_DEBUG (" " << k << ",");
+              NS_LOG_DEBUG (" " << H_usn (uIndex, sIndex, nIndex) << ",");
             }
         }
     }
-  NS_LOG_INFO ("size of coefficient matrix =[" << H_usn.size () << "][" << H_usn[0].size () << "][" << H_usn[0][0].size () << "]");
-  channelMatrix->m_channel = H_usn;
+  NS_LOG_INFO ("size of coefficient matrix =[" << H_usn.GetNumRows () << "][" << H_usn.GetNumCols () << "][" << H_usn.GetNumPages () << "]");
+  channelMatrix->m_channel = std::move (H_usn);
   return channelMatrix;
 }
 
@@ -23,6 +23,7 @@
 #include <ns3/uinteger.h>
 #include <ns3/boolean.h>
 #include <ns3/pointer.h>
+#include <cstring>
 
 namespace ns3 {
 
@@ -91,6 +92,19 @@ PhasedArrayModel::SetBeamformingVector (const ComplexVector &beamformingVector)
                  beamformingVector.size () << " != " << GetNumberOfElements ());
   m_beamformingVector = beamformingVector;
   m_isBfVectorValid = true;
+
+  // FNV-1a hash of the bits of the elements
+  uint64_t hash = 14695981039346656037ULL;
+  for (const auto &w : m_beamformingVector)
+    {
+      for (double part : {w.real (), w.imag ()})
+        {
+          uint64_t bits;
+          std::memcpy (&bits, &part, sizeof (bits));
+          hash = (hash ^ bits) * 1099511628211ULL;
+        }
+    }
+  m_beamformingVectorHash = hash;
 }
 
 
@@ -103,6 +117,22 @@ PhasedArrayModel::GetBeamformingVector () const
 }
 
 
+const PhasedArrayModel::ComplexVector &
+PhasedArrayModel::GetBeamformingVectorRef () const
+{
+  NS_ASSERT_MSG (m_isBfVectorValid, "The beamforming vector should be Set before it's Get, and should refer to the current array configuration");
+  return m_beamformingVector;
+}
+
+
+uint64_t
+PhasedArrayModel::GetBeamformingVectorHash () const
+{
+  NS_ASSERT_MSG (m_isBfVectorValid, "The beamforming vector should be Set before it's Get, and should refer to the current array configuration");
+  return m_beamformingVectorHash;
+}
+
+
 double
 PhasedArrayModel::ComputeNorm (const ComplexVector &vector)
 {
@@ -136,20 +166,86 @@ PhasedArrayModel::GetBeamformingVector (Angles a) const
 
 
 
+void
+PhasedArrayModel::ComputeSteeringVector (const std::vector<Vector> &locations, const Angles &a,
+                                         ComplexVector &steeringVector)
+{
+  // the direction is computed once, and the phases of all the elements in a
+  // loop without calls, which the compiler can vectorize
+  const double dirX = sin (a.GetInclination ()) * cos (a.GetAzimuth ());
+  const double dirY = sin (a.GetInclination ()) * sin (a.GetAzimuth ());
+  const double dirZ = cos (a.GetInclination ());
+  const std::size_t numElements = locations.size ();
+  steeringVector.resize (numElements);
+
+  std::vector<double> phases (numElements);
+  for (std::size_t i = 0; i < numElements; i++)
+    {
+      phases[i] = -2 * M_PI * (dirX * locations[i].x + dirY * locations[i].y + dirZ * locations[i].z);
+    }
+  for (std::size_t i = 0; i < numElements; i++)
+    {
+      steeringVector[i] = std::polar<double> (1.0, phases[i]);
+    }
+}
+
+
 PhasedArrayModel::ComplexVector
 PhasedArrayModel::GetSteeringVector (Angles a) const
 {
   ComplexVector steeringVector;
-  steeringVector.resize (GetNumberOfElements ());
-  for (uint64_t i = 0; i < GetNumberOfElements (); i++)
+  ComputeSteeringVector (GetElementLocations (), a, steeringVector);
+  return steeringVector;
+}
+
+
+std::vector<PhasedArrayModel::ComplexVector>
+PhasedArrayModel::GetSteeringVectors (const std::vector<Angles> &angles) const
+{
+  NS_LOG_FUNCTION (this << angles.size ());
+  const std::vector<Vector> &locations = GetElementLocations ();
+  std::vector<ComplexVector> steeringVectors (angles.size ());
+  for (std::size_t j = 0; j < angles.size (); j++)
     {
-      Vector loc = GetElementLocation (i);
-      double phase = -2 * M_PI * (sin (a.GetInclination ()) * cos (a.GetAzimuth ()) * loc.x +
-                                  sin (a.GetInclination ()) * sin (a.GetAzimuth ()) * loc.y +
-                                  cos (a.GetInclination ()) * loc.z);
-      steeringVector[i] = std::polar<double> (1.0, phase);
+      ComputeSteeringVector (locations, angles[j], steeringVectors[j]);
     }
-  return steeringVector;
+  return steeringVectors;
+}
+
+
+void
+PhasedArrayModel::GetElementFieldPatterns (const std::vector<Angles> &angles,
+                                           std::vector<std::pair<double, double> > &fieldPatterns) const
+{
+  NS_LOG_FUNCTION (this << angles.size ());
+  fieldPatterns.resize (angles.size ());
+  for (std::size_t j = 0; j < angles.size (); j++)
+    {
+      fieldPatterns[j] = GetElementFieldPattern (angles[j]);
+    }
+}
+
+
+const std::vector<Vector> &
+PhasedArrayModel::GetElementLocations () const
+{
+  if (m_elementLocations.empty ())
+    {
+      uint64_t numElements = GetNumberOfElements ();
+      m_elementLocations.reserve (numElements);
+      for (uint64_t i = 0; i < numElements; i++)
+        {
+          m_elementLocations.push_back (GetElementLocation (i));
+        }
+    }
+  return m_elementLocations;
+}
+
+
+void
+PhasedArrayModel::InvalidateElementLocations ()
+{
+  m_elementLocations.clear ();
 }
 
 
@@ -67,6 +67,20 @@ public:
   virtual std::pair<double, double> GetElementFieldPattern (Angles a) const = 0;
 
 
+  /**
+   * Returns the horizontal and vertical components of the antenna element field
+   * pattern at many directions at once, as GetElementFieldPattern does for each
+   * of them. The default implementation calls GetElementFieldPattern for each
+   * direction; subclasses can override it to share the computations that do not
+   * depend on the direction.
+   * \param angles the directions
+   * \param fieldPatterns the field patterns, resized to the number of directions,
+   *        in the format returned by GetElementFieldPattern
+   */
+  virtual void GetElementFieldPatterns (const std::vector<Angles> &angles,
+                                        std::vector<std::pair<double, double> > &fieldPatterns) const;
+
+
   /**
    * Returns the location of the antenna element with the specified
    * index, normalized with respect to the wavelength.
@@ -83,6 +97,16 @@ public:
   virtual uint64_t GetNumberOfElements (void) const = 0;
 
 
+  /**
+   * Returns the locations of all the antenna elements, as returned by
+   * GetElementLocation. The locations are computed the first time they are
+   * needed and kept until the configuration of the array changes.
+   * \return the 3D vectors of the positions of the elements, in the order of
+   *         their indices
+   */
+  const std::vector<Vector> & GetElementLocations (void) const;
+
+
   /**
    * Sets the beamforming vector to be used
    * \param beamformingVector the beamforming vector
@@ -97,6 +121,24 @@ public:
   ComplexVector GetBeamformingVector (void) const;
 
 
+  /**
+   * Returns a reference to the beamforming vector that is currently being
+   * used, to read it without a copy
+   * \return the current beamforming vector
+   */
+  const ComplexVector & GetBeamformingVectorRef (void) const;
+
+
+  /**
+   * Returns a hash of the beamforming vector that is currently being used.
+   * Equal vectors have the same hash, so it can be used as a key to cache
+   * the values computed with a beamforming vector; different vectors have
+   * different hashes with a very high probability.
+   * \return the hash of the current beamforming vector
+   */
+  uint64_t GetBeamformingVectorHash (void) const;
+
+
   /**
    * Returns the beamforming vector that points towards the specified position
    * \param a the beamforming angle
@@ -113,6 +155,15 @@ public:
   ComplexVector GetSteeringVector (Angles a) const;
 
 
+  /**
+   * Returns the steering vectors that point toward many directions, each equal
+   * to the one returned by GetSteeringVector
+   * \param angles the steering angles
+   * \return the steering vectors, in the order of the angles
+   */
+  std::vector<ComplexVector> GetSteeringVectors (const std::vector<Angles> &angles) const;
+
+
   /**
    * Sets the antenna model to be used
    * \param antennaElement the antenna model
@@ -140,11 +191,30 @@ protected:
    */
   static double ComputeNorm (const ComplexVector &vector);
 
+  /**
+   * Discard the cached locations of the elements. Subclasses call it when
+   * the geometry of the array changes.
+   */
+  void InvalidateElementLocations (void);
+
   ComplexVector m_beamformingVector; //!< the beamforming vector in use
   Ptr<AntennaModel> m_antennaElement; //!< the model of the antenna element in use
   bool m_isBfVectorValid; //!< ensures the validity of the beamforming vector
+  uint64_t m_beamformingVectorHash {0}; //!< the hash of the beamforming vector in use
   static uint32_t m_idCounter; //!< the ID counter that is used to determine the unique antenna array ID
   uint32_t m_id {0}; //!< the ID of this antenna array instance
+
+private:
+  /**
+   * Computes the steering vector toward a direction
+   * \param locations the locations of the elements
+   * \param a the steering angle
+   * \param steeringVector the steering vector, of the size of locations
+   */
+  static void ComputeSteeringVector (const std::vector<Vector> &locations, const Angles &a,
+                                     ComplexVector &steeringVector);
+
+  mutable std::vector<Vector> m_elementLocations; //!< the cached locations of the elements, empty if not computed
 };
 
 /**
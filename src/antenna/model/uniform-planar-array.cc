@@ -96,6 +96,7 @@ UniformPlanarArray::SetNumColumns (uint32_t n)
   if (n != m_numColumns)
     {
       m_isBfVectorValid = false;
+      InvalidateElementLocations ();
     }
   m_numColumns = n;
 }
@@ -115,6 +116,7 @@ UniformPlanarArray::SetNumRows (uint32_t n)
   if (n != m_numRows)
     {
       m_isBfVectorValid = false;
+      InvalidateElementLocations ();
     }
   m_numRows = n;
 }
@@ -132,6 +134,7 @@ UniformPlanarArray::SetAlpha (double alpha)
   m_alpha = alpha;
   m_cosAlpha = cos (m_alpha);
   m_sinAlpha = sin (m_alpha);
+  InvalidateElementLocations ();
 }
 
 void
@@ -140,6 +143,7 @@ UniformPlanarArray::SetBeta (double beta)
   m_beta = beta;
   m_cosBeta = cos (m_beta);
   m_sinBeta = sin (m_beta);
+  InvalidateElementLocations ();
 }
 
 void
@@ -159,6 +163,7 @@ UniformPlanarArray::SetAntennaHorizontalSpacing (double s)
   if (s != m_disH)
     {
       m_isBfVectorValid = false;
+      InvalidateElementLocations ();
     }
   m_disH = s;
 }
@@ -180,6 +185,7 @@ UniformPlanarArray::SetAntennaVerticalSpacing (double s)
   if (s != m_disV)
     {
       m_isBfVectorValid = false;
+      InvalidateElementLocations ();
     }
   m_disV = s;
 }
@@ -213,8 +219,9 @@ UniformPlanarArray::GetElementFieldPattern (Angles a) const
   // NOTE: the slant angle (assumed to be 0) differs from the polarization slant angle
   // (m_polSlant, given by the attribute), in 3GPP TR 38.901
   double aPrimeDb = m_antennaElement->GetGainDb (aPrime);
-  double fieldThetaPrime = pow (10, aPrimeDb / 20) * m_cosPolSlant; // convert to linear magnitude
-  double fieldPhiPrime = pow (10, aPrimeDb / 20) * m_sinPolSlant; // convert to linear magnitude
+  double aPrimeLinear = pow (10, aPrimeDb / 20); // convert to linear magnitude
+  double fieldThetaPrime = aPrimeLinear * m_cosPolSlant;
+  double fieldPhiPrime = aPrimeLinear * m_sinPolSlant;
 
   // compute psi using eq. 7.1-15 in 3GPP TR 38.901, assuming that the slant
   // angle (gamma) is 0
@@ -223,14 +230,62 @@ UniformPlanarArray::GetElementFieldPattern (Angles a) const
 
   // convert the antenna element field pattern to GCS using eq. 7.1-11
   // in 3GPP TR 38.901
-  double fieldTheta = cos (psi) * fieldThetaPrime - sin (psi) * fieldPhiPrime;
-  double fieldPhi = sin (psi) * fieldThetaPrime + cos (psi) * fieldPhiPrime;
+  double cosPsi = cos (psi);
+  double sinPsi = sin (psi);
+  double fieldTheta = cosPsi * fieldThetaPrime - sinPsi * fieldPhiPrime;
+  double fieldPhi = sinPsi * fieldThetaPrime + cosPsi * fieldPhiPrime;
   NS_LOG_DEBUG (RadiansToDegrees (a.GetAzimuth ()) << " " << RadiansToDegrees (a.GetInclination ()) << " " << fieldTheta * fieldTheta + fieldPhi * fieldPhi);
 
   return std::make_pair (fieldPhi, fieldTheta);
 }
 
 
+void
+UniformPlanarArray::GetElementFieldPatterns (const std::vector<Angles> &angles,
+                                             std::vector<std::pair<double, double> > &fieldPatterns) const
+{
+  NS_LOG_FUNCTION (this << angles.size ());
+
+  // The same computations of GetElementFieldPattern, in a pass for each
+  // step: the conversion to the LCS of all the directions, the gains of the
+  // element, and the conversion of the field patterns to the GCS
+  const std::size_t numAngles = angles.size ();
+  std::vector<double> cosIncl (numAngles);
+  std::vector<double> sinIncl (numAngles);
+  std::vector<double> cosAzim (numAngles);
+  std::vector<double> sinAzim (numAngles);
+  for (std::size_t j = 0; j < numAngles; j++)
+    {
+      cosIncl[j] = cos (angles[j].GetInclination ());
+      sinIncl[j] = sin (angles[j].GetInclination ());
+      cosAzim[j] = cos (angles[j].GetAzimuth () - m_alpha);
+      sinAzim[j] = sin (angles[j].GetAzimuth () - m_alpha);
+    }
+
+  // eq. 7.1-7 and 7.1-8 in 3GPP TR 38.901, and the element gains
+  std::vector<double> aPrimeLinear (numAngles);
+  for (std::size_t j = 0; j < numAngles; j++)
+    {
+      double thetaPrime = std::acos (m_cosBeta * cosIncl[j] + m_sinBeta * cosAzim[j] * sinIncl[j]);
+      double phiPrime = std::arg (std::complex<double> (m_cosBeta * sinIncl[j] * cosAzim[j] - m_sinBeta * cosIncl[j], sinAzim[j] * sinIncl[j]));
+      aPrimeLinear[j] = pow (10, m_antennaElement->GetGainDb (Angles (phiPrime, thetaPrime)) / 20);
+    }
+
+  // eq. 7.1-15 and 7.1-11 in 3GPP TR 38.901
+  fieldPatterns.resize (numAngles);
+  for (std::size_t j = 0; j < numAngles; j++)
+    {
+      double fieldThetaPrime = aPrimeLinear[j] * m_cosPolSlant;
+      double fieldPhiPrime = aPrimeLinear[j] * m_sinPolSlant;
+      double psi = std::arg (std::complex<double> (m_cosBeta * sinIncl[j] - m_sinBeta * cosIncl[j] * cosAzim[j], m_sinBeta * sinAzim[j]));
+      double cosPsi = cos (psi);
+      double sinPsi = sin (psi);
+      fieldPatterns[j].first = sinPsi * fieldThetaPrime + cosPsi * fieldPhiPrime;
+      fieldPatterns[j].second = cosPsi * fieldThetaPrime - sinPsi * fieldPhiPrime;
+    }
+}
+
+
 Vector
 UniformPlanarArray::GetElementLocation (uint64_t index) const
 {
@@ -67,6 +67,19 @@ public:
   std::pair<double, double> GetElementFieldPattern (Angles a) const override;
 
 
+  /**
+   * Returns the horizontal and vertical components of the antenna element field
+   * pattern at many directions at once, equal to those returned by
+   * GetElementFieldPattern. The computation is split in passes over all the
+   * directions, so that the conversions between the coordinate systems run in
+   * loops without virtual calls.
+   * \param angles the directions
+   * \param fieldPatterns the field patterns, resized to the number of directions
+   */
+  void GetElementFieldPatterns (const std::vector<Angles> &angles,
+                                std::vector<std::pair<double, double> > &fieldPatterns) const override;
+
+
   /**
   * Returns the location of the antenna element with the specified
   * index assuming the left bottom corner is (0,0,0), normalized
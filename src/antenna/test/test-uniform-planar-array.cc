@@ -172,6 +172,90 @@ UniformPlanarArrayTestCase::DoRun ()
 }
 
 
+/**
+ * \ingroup antenna-tests
+ *
+ * \brief Test that the field patterns and the steering vectors computed for
+ * many directions at once, and the cached element locations, are equal to
+ * those computed one at a time, also after the array is reconfigured
+ */
+class UniformPlanarArrayBatchTestCase : public TestCase
+{
+public:
+  UniformPlanarArrayBatchTestCase ();
+
+private:
+  /**
+   * Run the test
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Compare the batch and the single computations
+   * \param a the antenna array
+   * \param angles the directions
+   */
+  void CheckBatch (Ptr<UniformPlanarArray> a, const std::vector<Angles> &angles);
+};
+
+UniformPlanarArrayBatchTestCase::UniformPlanarArrayBatchTestCase ()
+  : TestCase ("batch field patterns, steering vectors and element locations")
+{}
+
+void
+UniformPlanarArrayBatchTestCase::CheckBatch (Ptr<UniformPlanarArray> a, const std::vector<Angles> &angles)
+{
+  const std::vector<Vector> &locations = a->GetElementLocations ();
+  NS_TEST_ASSERT_MSG_EQ (locations.size (), a->GetNumberOfElements (), "wrong number of element locations");
+  for (uint64_t i = 0; i < a->GetNumberOfElements (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (locations[i], a->GetElementLocation (i), "wrong location of element " << i);
+    }
+
+  std::vector<std::pair<double, double> > fieldPatterns;
+  a->GetElementFieldPatterns (angles, fieldPatterns);
+  std::vector<PhasedArrayModel::ComplexVector> steeringVectors = a->GetSteeringVectors (angles);
+  NS_TEST_ASSERT_MSG_EQ (fieldPatterns.size (), angles.size (), "wrong number of field patterns");
+  NS_TEST_ASSERT_MSG_EQ (steeringVectors.size (), angles.size (), "wrong number of steering vectors");
+  for (std::size_t j = 0; j < angles.size (); j++)
+    {
+      std::pair<double, double> fieldPattern = a->GetElementFieldPattern (angles[j]);
+      NS_TEST_ASSERT_MSG_EQ (fieldPatterns[j].first, fieldPattern.first, "wrong horizontal field pattern at " << angles[j]);
+      NS_TEST_ASSERT_MSG_EQ (fieldPatterns[j].second, fieldPattern.second, "wrong vertical field pattern at " << angles[j]);
+      NS_TEST_ASSERT_MSG_EQ ((steeringVectors[j] == a->GetSteeringVector (angles[j])), true, "wrong steering vector at " << angles[j]);
+    }
+}
+
+void
+UniformPlanarArrayBatchTestCase::DoRun ()
+{
+  Ptr<UniformPlanarArray> a = CreateObject<UniformPlanarArray> ();
+  a->SetAttribute ("AntennaElement", PointerValue (CreateObject<ThreeGppAntennaModel> ()));
+  a->SetAttribute ("NumRows", UintegerValue (4));
+  a->SetAttribute ("NumColumns", UintegerValue (8));
+  a->SetAttribute ("BearingAngle", DoubleValue (DegreesToRadians (30)));
+  a->SetAttribute ("DowntiltAngle", DoubleValue (DegreesToRadians (10)));
+
+  std::vector<Angles> angles;
+  for (double azimuth = -180; azimuth < 180; azimuth += 25)
+    {
+      for (double inclination = 0; inclination <= 180; inclination += 15)
+        {
+          angles.emplace_back (DegreesToRadians (azimuth), DegreesToRadians (inclination));
+        }
+    }
+  CheckBatch (a, angles);
+
+  // the cached locations follow the configuration of the array
+  a->SetAttribute ("NumColumns", UintegerValue (2));
+  a->SetAttribute ("AntennaHorizontalSpacing", DoubleValue (0.7));
+  a->SetAttribute ("BearingAngle", DoubleValue (DegreesToRadians (-60)));
+  a->SetAttribute ("DowntiltAngle", DoubleValue (DegreesToRadians (-5)));
+  CheckBatch (a, angles);
+  CheckBatch (a, std::vector<Angles> ());
+}
+
+
 /**
  * \ingroup antenna-tests
  *
@@ -211,6 +295,8 @@ UniformPlanarArrayTestSuite::UniformPlanarArrayTestSuite ()
   AddTestCase (new UniformPlanarArrayTestCase (     tgpp,   10,   10,      0.5,      0.5, DegreesToRadians    (0), DegreesToRadians   (0),  Angles (DegreesToRadians    (0), DegreesToRadians   (90)),           28.0), TestCase::QUICK);
   AddTestCase (new UniformPlanarArrayTestCase (     tgpp,   10,   10,      0.5,      0.5, DegreesToRadians   (90), DegreesToRadians   (0),  Angles (DegreesToRadians   (90), DegreesToRadians   (90)),           28.0), TestCase::QUICK);
   AddTestCase (new UniformPlanarArrayTestCase (     tgpp,   10,   10,      0.5,      0.5, DegreesToRadians    (0), DegreesToRadians  (45),  Angles (DegreesToRadians    (0), DegreesToRadians  (135)),           28.0), TestCase::QUICK);
+
+  AddTestCase (new UniformPlanarArrayBatchTestCase (), TestCase::QUICK);
 }
 
 static UniformPlanarArrayTestSuite staticUniformPlanarArrayTestSuiteInstance;
@@ -26,6 +26,7 @@
 #include "pointer.h"
 #include "log.h"
 
+#include <map>
 #include <sstream>
 
 /**
@@ -199,6 +200,14 @@ public:
    * \returns \c true if the index matches the Config Path.
    */
   bool Matches (std::size_t i) const;
+  /**
+   * Test if the Config path specification is a single index, which
+   * matches only one element.
+   *
+   * \param [out] index The index.
+   * \returns \c true if the specification is a single index.
+   */
+  bool IsIndex (std::size_t *index) const;
 
 private:
   /**
@@ -284,6 +293,24 @@ ArrayMatcher::Matches (std::size_t i) const
   return false;
 }
 
+bool
+ArrayMatcher::IsIndex (std::size_t *index) const
+{
+  NS_LOG_FUNCTION (this << index);
+  if (m_element.empty () || m_element.size () > 9
+      || m_element.find_first_not_of ("0123456789") != std::string::npos)
+    {
+      return false;
+    }
+  uint32_t value;
+  if (!StringToUint32 (m_element, &value))
+    {
+      return false;
+    }
+  *index = value;
+  return true;
+}
+
 bool
 ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 {
@@ -294,6 +321,34 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
   return !iss.bad () && !iss.fail ();
 }
 
+/**
+ * \ingroup config-impl
+ * The objects resolved during a batch of Config operations, shared by
+ * the Resolver instances of the batch.
+ *
+ * The cache is valid only as long as the objects and their attributes
+ * are not changed, so it lives only for the duration of the batch.
+ */
+class ResolverCache
+{
+public:
+  /** The objects matched by a Config path, with their contexts. */
+  struct Matches
+  {
+    std::vector<Ptr<Object> > m_objects;  //!< The matched objects
+    std::vector<std::string> m_contexts;  //!< The path of every object
+  };
+
+  /**
+   * The objects matched by the Config paths resolved so far, and by
+   * their leading parts, indexed by the path without the final slash.
+   */
+  std::map<std::string, Matches> m_prefixes;
+  /** The containers read from the attributes of the objects. */
+  std::map<std::pair<Ptr<Object>, std::string>, ObjectPtrContainerValue> m_containers;
+
+};  // class ResolverCache
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -318,6 +373,20 @@ public:
    *                  in the Config path.
    */
   void Resolve (Ptr<Object> root);
+  /**
+   * Record the objects found while parsing the path, and read the
+   * containers from the cache.
+   *
+   * When the path of this resolver is the trailing part of a longer
+   * path, whose leading part is already resolved, the object passed to
+   * Resolve() is one of the objects matched by the leading part.
+   *
+   * \param [in] cache The cache of the batch.
+   * \param [in] prefix The leading part of the path, already resolved.
+   * \param [in] context The context of the object matched by the
+   *                     leading part.
+   */
+  void SetCache (ResolverCache *cache, std::string prefix, std::string context);
 
 private:
   /** Ensure the Config path starts and ends with a '/'. */
@@ -361,11 +430,18 @@ private:
   std::vector<std::string> m_workStack;
   /** The Config path. */
   std::string m_path;
+  /** The cache of the batch, if any. */
+  ResolverCache *m_cache;
+  /** The leading part of the path, already resolved. */
+  std::string m_prefix;
+  /** The context of the object matched by the leading part. */
+  std::string m_context;
 
 };  // class Resolver
 
 Resolver::Resolver (std::string path)
-  : m_path (path)
+  : m_path (path),
+    m_cache (0)
 {
   NS_LOG_FUNCTION (this << path);
   Canonicalize ();
@@ -402,12 +478,21 @@ Resolver::Resolve (Ptr<Object> root)
   DoResolve (m_path, root);
 }
 
+void
+Resolver::SetCache (ResolverCache *cache, std::string prefix, std::string context)
+{
+  NS_LOG_FUNCTION (this << cache << prefix << context);
+  m_cache = cache;
+  m_prefix = prefix;
+  m_context = context;
+}
+
 std::string
 Resolver::GetResolvedPath (void) const
 {
   NS_LOG_FUNCTION (this);
 
-  std::string fullPath = "/";
+  std::string fullPath = m_context.empty () ? "/" : m_context;
   for (std::vector<std::string>::const_iterator i = m_workStack.begin (); i != m_workStack.end (); i++)
     {
       fullPath += *i + "/";
@@ -431,6 +516,15 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   NS_ASSERT ((path.find ("/")) == 0);
   std::string::size_type next = path.find ("/", 1);
 
+  if (m_cache != 0 && root != 0 && path.size () < m_path.size ())
+    {
+      // The part of the path parsed so far matched this object
+      ResolverCache::Matches &matches =
+        m_cache->m_prefixes[m_prefix + m_path.substr (0, m_path.size () - path.size ())];
+      matches.m_objects.push_back (root);
+      matches.m_contexts.push_back (GetResolvedPath ());
+    }
+
   if (next == std::string::npos)
     {
       //
@@ -559,10 +653,25 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
                 {
                   NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
                   foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
                   m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
+                  if (m_cache != 0)
+                    {
+                      auto key = std::make_pair (root, info.name);
+                      auto cached = m_cache->m_containers.find (key);
+                      if (cached == m_cache->m_containers.end ())
+                        {
+                          ObjectPtrContainerValue vector;
+                          root->GetAttribute (info.name, vector);
+                          cached = m_cache->m_containers.insert (std::make_pair (key, vector)).first;
+                        }
+                      DoArrayResolve (pathLeft, cached->second);
+                    }
+                  else
+                    {
+                      ObjectPtrContainerValue vector;
+                      root->GetAttribute (info.name, vector);
+                      DoArrayResolve (pathLeft, vector);
+                    }
                   m_workStack.pop_back ();
                 }
               // this could be anything else and we don't know what to do with it.
@@ -596,6 +705,21 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
   std::string pathLeft = path.substr (next, path.size () - next);
 
   ArrayMatcher matcher = ArrayMatcher (item);
+  std::size_t index;
+  if (matcher.IsIndex (&index))
+    {
+      // Look up the element, instead of testing all of them
+      Ptr<Object> object = container.Get (index);
+      if (object != 0)
+        {
+          std::ostringstream oss;
+          oss << index;
+          m_workStack.push_back (oss.str ());
+          DoResolve (pathLeft, object);
+          m_workStack.pop_back ();
+        }
+      return;
+    }
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
@@ -633,6 +757,14 @@ public:
   void Disconnect (std::string path, const CallbackBase &cb);
   /** \copydoc ns3::Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
+  /**
+   * Connect the callbacks of a list, sharing the resolution of the paths.
+   * \param [in] connections The paths and the callbacks to connect.
+   * \param [in] withContext Whether the callbacks receive the context.
+   * \param [out] failed The paths which did not match any trace source.
+   */
+  void ConnectMany (const ConnectionList &connections, bool withContext,
+                    std::vector<std::string> *failed);
 
   /** \copydoc ns3::Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -653,6 +785,14 @@ private:
    * \param [in,out] leaf The trailing part of the \pname{path}.
    */
   void ParsePath (std::string path, std::string *root, std::string *leaf) const;
+  /**
+   * Find the objects matching a path, starting from the objects already
+   * matched by its longest leading part found in the cache.
+   * \param [in] path The path to match.
+   * \param [in,out] cache The cache of the batch, or 0 if none.
+   * \returns The matching objects.
+   */
+  MatchContainer LookupMatches (std::string path, ResolverCache *cache);
 
   /** Container type to hold the root Config path tokens. */
   typedef std::vector<Ptr<Object> > Roots;
@@ -751,6 +891,13 @@ MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
+  return LookupMatches (path, 0);
+}
+
+MatchContainer
+ConfigImpl::LookupMatches (std::string path, ResolverCache *cache)
+{
+  NS_LOG_FUNCTION (this << path << cache);
   class LookupMatchesResolver : public Resolver
   {
 public:
@@ -765,7 +912,74 @@ public:
     }
     std::vector<Ptr<Object> > m_objects;
     std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  };
+
+  // The key of the path in the cache: it starts with a slash, and
+  // does not end with one.  The paths of the name service are not
+  // cached, since they are resolved from a null root.
+  std::string key = (path.find ("/") == 0) ? path : "/" + path;
+  while (key.size () > 1 && key[key.size () - 1] == '/')
+    {
+      key.erase (key.size () - 1);
+    }
+  if (cache != 0 && key.find ("/Names") != 0)
+    {
+      auto found = cache->m_prefixes.find (key);
+      if (found != cache->m_prefixes.end ())
+        {
+          NS_LOG_DEBUG ("Path " << key << " found in the cache");
+          return MatchContainer (found->second.m_objects, found->second.m_contexts, path);
+        }
+
+      std::string::size_type slash = key.rfind ("/");
+      while (slash != 0 && slash != std::string::npos)
+        {
+          found = cache->m_prefixes.find (key.substr (0, slash));
+          if (found != cache->m_prefixes.end ())
+            {
+              break;
+            }
+          slash = key.rfind ("/", slash - 1);
+        }
+
+      LookupMatchesResolver resolver = LookupMatchesResolver (path);
+      if (found != cache->m_prefixes.end ())
+        {
+          // Resolve the rest of the path from the objects matched by
+          // the leading part.  The matches of the leading part are
+          // copied, since the resolution adds elements to the cache.
+          NS_LOG_DEBUG ("Leading part " << found->first << " of " << key << " found in the cache");
+          std::string prefix = found->first;
+          ResolverCache::Matches leading = found->second;
+          for (std::size_t i = 0; i < leading.m_objects.size (); ++i)
+            {
+              LookupMatchesResolver rest = LookupMatchesResolver (key.substr (slash));
+              rest.SetCache (cache, prefix, leading.m_contexts[i]);
+              rest.Resolve (leading.m_objects[i]);
+              resolver.m_objects.insert (resolver.m_objects.end (),
+                                         rest.m_objects.begin (), rest.m_objects.end ());
+              resolver.m_contexts.insert (resolver.m_contexts.end (),
+                                          rest.m_contexts.begin (), rest.m_contexts.end ());
+            }
+        }
+      else
+        {
+          resolver.SetCache (cache, "", "");
+          for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
+            {
+              resolver.Resolve (*i);
+            }
+          resolver.Resolve (0);
+        }
+      if (resolver.m_objects.empty ())
+        {
+          // Also the paths that do not match anything are cached
+          cache->m_prefixes[key];
+        }
+      return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+    }
+
+  LookupMatchesResolver resolver = LookupMatchesResolver (path);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -781,6 +995,27 @@ public:
   return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
 }
 
+void
+ConfigImpl::ConnectMany (const ConnectionList &connections, bool withContext,
+                         std::vector<std::string> *failed)
+{
+  NS_LOG_FUNCTION (this << connections.size () << withContext);
+  ResolverCache cache;
+  for (const auto &connection : connections)
+    {
+      std::string root, leaf;
+      ParsePath (connection.first, &root, &leaf);
+      MatchContainer container = LookupMatches (root, &cache);
+      bool ok = withContext
+        ? container.ConnectFailSafe (leaf, connection.second)
+        : container.ConnectWithoutContextFailSafe (leaf, connection.second);
+      if (!ok)
+        {
+          failed->push_back (connection.first);
+        }
+    }
+}
+
 void
 ConfigImpl::RegisterRootNamespaceObject (Ptr<Object> obj)
 {
@@ -937,6 +1172,44 @@ Disconnect (std::string path, const CallbackBase &cb)
   NS_LOG_FUNCTION (path << &cb);
   ConfigImpl::Get ()->Disconnect (path, cb);
 }
+void
+ConnectMany (const ConnectionList &connections)
+{
+  NS_LOG_FUNCTION (connections.size ());
+  std::vector<std::string> failed;
+  ConfigImpl::Get ()->ConnectMany (connections, true, &failed);
+  if (!failed.empty ())
+    {
+      NS_FATAL_ERROR ("Could not connect callback to " << failed.front ());
+    }
+}
+bool
+ConnectManyFailSafe (const ConnectionList &connections)
+{
+  NS_LOG_FUNCTION (connections.size ());
+  std::vector<std::string> failed;
+  ConfigImpl::Get ()->ConnectMany (connections, true, &failed);
+  return failed.empty ();
+}
+void
+ConnectWithoutContextMany (const ConnectionList &connections)
+{
+  NS_LOG_FUNCTION (connections.size ());
+  std::vector<std::string> failed;
+  ConfigImpl::Get ()->ConnectMany (connections, false, &failed);
+  if (!failed.empty ())
+    {
+      NS_FATAL_ERROR ("Could not connect callback to " << failed.front ());
+    }
+}
+bool
+ConnectWithoutContextManyFailSafe (const ConnectionList &connections)
+{
+  NS_LOG_FUNCTION (connections.size ());
+  std::vector<std::string> failed;
+  ConfigImpl::Get ()->ConnectMany (connections, false, &failed);
+  return failed.empty ();
+}
 MatchContainer LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (path);
@@ -23,6 +23,7 @@
 #include "ptr.h"
 #include <string>
 #include <vector>
+#include <utility>
 
 /**
  * \file
@@ -181,6 +182,63 @@ bool ConnectFailSafe (std::string path, const CallbackBase &cb);
  */
 void Disconnect (std::string path, const CallbackBase &cb);
 
+/**
+ * \ingroup config
+ * A list of paths to match trace sources, each one with the callback
+ * to connect to the matching trace sources.
+ */
+typedef std::vector<std::pair<std::string, CallbackBase> > ConnectionList;
+
+/**
+ * \ingroup config
+ * \param [in] connections The paths and the callbacks to connect.
+ *
+ * Same as calling Config::Connect for each element of the list, but
+ * the objects matched by the leading parts of the paths are resolved
+ * only once for the whole list: when many paths share their prefix
+ * (e.g., "/NodeList/ * /DeviceList/ * /BandwidthPartMap/ *" followed
+ * by the name of a trace source) the cost of the list is linear in the
+ * number of matched objects, instead of walking all the nodes for every
+ * path. (The spaces around the wildcards are only there to keep this
+ * comment valid.)
+ *
+ * The objects are resolved when this function is called, and the
+ * resolution is not kept afterwards: objects created later are not
+ * matched, as with Config::Connect.
+ *
+ * If no trace source matches one of the paths, this method will throw
+ * a fatal error.  Use ConnectManyFailSafe if the absence of matching
+ * trace sources should not be fatal.
+ */
+void ConnectMany (const ConnectionList &connections);
+/**
+ * \ingroup config
+ * \param [in] connections The paths and the callbacks to connect.
+ *
+ * Same as Config::ConnectMany, but no error is thrown when a path
+ * does not match any trace source.
+ * \returns \c true if every path matched some trace source.
+ */
+bool ConnectManyFailSafe (const ConnectionList &connections);
+/**
+ * \ingroup config
+ * \param [in] connections The paths and the callbacks to connect.
+ *
+ * Same as calling Config::ConnectWithoutContext for each element of
+ * the list, sharing the resolution of the paths as in
+ * Config::ConnectMany.
+ */
+void ConnectWithoutContextMany (const ConnectionList &connections);
+/**
+ * \ingroup config
+ * \param [in] connections The paths and the callbacks to connect.
+ *
+ * Same as Config::ConnectWithoutContextMany, but no error is thrown when
+ * a path does not match any trace source.
+ * \returns \c true if every path matched some trace source.
+ */
+bool ConnectWithoutContextManyFailSafe (const ConnectionList &connections);
+
 /**
  * \ingroup config
  * \brief hold a set of objects which match a specific search string.
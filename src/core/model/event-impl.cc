@@ -31,6 +31,25 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+void *
+EventImpl::operator new (std::size_t size)
+{
+  return SizeClassPool<EventImpl>::Allocate (size);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  SizeClassPool<EventImpl>::Deallocate (p, size);
+}
+
+EventImpl::AllocationStats
+EventImpl::GetAllocationStats (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return SizeClassPool<EventImpl>::GetStats ();
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
@@ -59,6 +78,12 @@ EventImpl::Cancel (void)
   m_cancel = true;
 }
 
+void
+EventImpl::CopyArguments (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
 bool
 EventImpl::IsCancelled (void)
 {
@@ -21,7 +21,9 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
+#include "size-class-pool.h"
 
 /**
  * \file
@@ -40,6 +42,13 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The events are allocated from a SizeClassPool: per-thread free lists,
+ * one for each size class of 16 bytes up to 256 bytes, so that scheduling
+ * an event does not usually call malloc and free. An event can be released by a thread
+ * other than the one that created it (e.g., with ScheduleWithContext from
+ * a realtime thread): its memory goes to the free lists of the thread
+ * that releases it. The larger events use the global allocator.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -65,6 +74,36 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * Replace the arguments bound to the event which are shared with the
+   * scheduling thread by copies of their own (see EventArgumentCopy()).
+   *
+   * Called by the simulator implementations which hand the event over to
+   * another thread before it is invoked. The default does nothing.
+   */
+  virtual void CopyArguments (void);
+
+  /** Statistics of the allocation of the events. */
+  typedef SizeClassPool<EventImpl>::Stats AllocationStats;
+
+  /**
+   * \returns the allocation statistics of the calling thread, plus the ones
+   * of the threads that have already exited.
+   */
+  static AllocationStats GetAllocationStats (void);
+
+  /**
+   * Allocate an event from the free list of its size class.
+   * \param [in] size The size of the event.
+   * \returns The memory for the event.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release an event to the free list of its size class.
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *p, std::size_t size);
 
 protected:
   /**
@@ -366,6 +366,23 @@ struct EventMemberImplObjTraits<T *>
   }
 };
 
+/**
+ * \ingroup makeeventmemptr
+ * Copy an argument bound to an event, before the event is handed over
+ * to another thread (see EventImpl::CopyArguments()).
+ *
+ * This is the generic version, which keeps the argument as it is. The
+ * types whose instances cannot be shared by two threads, like the packets
+ * with their reference counts that are not atomic, overload it in their
+ * own namespace, where the MakeEvent() functions find the overload by
+ * argument-dependent lookup.
+ *
+ * \tparam T \deduced The argument type.
+ */
+template <typename T>
+void EventArgumentCopy (T &)
+{}
+
 template <typename MEM, typename OBJ>
 EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
 {
@@ -415,6 +432,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -446,6 +467,11 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -479,6 +505,12 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+      EventArgumentCopy (m_a3);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -514,6 +546,13 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+      EventArgumentCopy (m_a3);
+      EventArgumentCopy (m_a4);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -552,6 +591,14 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+      EventArgumentCopy (m_a3);
+      EventArgumentCopy (m_a4);
+      EventArgumentCopy (m_a5);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -592,6 +639,15 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+      EventArgumentCopy (m_a3);
+      EventArgumentCopy (m_a4);
+      EventArgumentCopy (m_a5);
+      EventArgumentCopy (m_a6);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -628,6 +684,10 @@ EventImpl * MakeEvent (void (*f)(U1), T1 a1)
     {
       (*m_function)(m_a1);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
   } *ev = new EventFunctionImpl1 (f, a1);
@@ -659,6 +719,11 @@ EventImpl * MakeEvent (void (*f)(U1,U2), T1 a1, T2 a2)
     {
       (*m_function)(m_a1, m_a2);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -693,6 +758,12 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3), T1 a1, T2 a2, T3 a3)
     {
       (*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+      EventArgumentCopy (m_a3);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -729,6 +800,13 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4), T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+      EventArgumentCopy (m_a3);
+      EventArgumentCopy (m_a4);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -767,6 +845,14 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5), T1 a1, T2 a2, T3 a3, T4 a4, T5
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+      EventArgumentCopy (m_a3);
+      EventArgumentCopy (m_a4);
+      EventArgumentCopy (m_a5);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -807,6 +893,15 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual void CopyArguments (void)
+    {
+      EventArgumentCopy (m_a1);
+      EventArgumentCopy (m_a2);
+      EventArgumentCopy (m_a3);
+      EventArgumentCopy (m_a4);
+      EventArgumentCopy (m_a5);
+      EventArgumentCopy (m_a6);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -0,0 +1,774 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "simulator.h"
+#include "multithreaded-simulator-impl.h"
+
+#include "scheduler.h"
+#include "assert.h"
+#include "abort.h"
+#include "log.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::m_currentPartition = nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("Lookahead",
+                   "Minimum delay of the events scheduled for a context of another "
+                   "partition. The partitions run in parallel in windows of this "
+                   "duration; zero disables the parallel execution.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::m_lookahead),
+                   MakeTimeChecker ())
+    .AddAttribute ("ParallelStartTime",
+                   "Time before which the partitions are run by a single thread, "
+                   "in timestamp order.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::m_parallelStartTime),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxThreads",
+                   "Maximum number of threads, including the one that calls "
+                   "Simulator::Run; zero uses the number of hardware threads.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_maxThreads),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_started (false),
+    m_maxThreads (0),
+    m_stop (false),
+    m_stopTs (std::numeric_limits<uint64_t>::max ()),
+    m_running (false),
+    m_parallelWindow (false),
+    m_windowEnd (0),
+    m_globalTs (0),
+    m_windowGeneration (0),
+    m_shutdown (false),
+    m_nextPartition (0),
+    m_pendingPartitions (0)
+{
+  NS_LOG_FUNCTION (this);
+  // Simulator::SetImplementation replaces it with the configured scheduler,
+  // but the partitions can be created before that
+  m_schedulerFactory.SetTypeId ("ns3::MapScheduler");
+  GetOrCreatePartition (0);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  StopWorkers ();
+  MergeInboxes ();
+
+  for (auto & p : m_partitions)
+    {
+      while (!p->m_events->IsEmpty ())
+        {
+          Scheduler::Event next = p->m_events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      p->m_events = 0;
+    }
+  m_partitions.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  m_schedulerFactory = schedulerFactory;
+
+  for (auto & p : m_partitions)
+    {
+      Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+      while (!p->m_events->IsEmpty ())
+        {
+          scheduler->Insert (p->m_events->RemoveNext ());
+        }
+      p->m_events = scheduler;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetPartition (uint32_t context, uint32_t partition)
+{
+  NS_LOG_FUNCTION (this << context << partition);
+  NS_ABORT_MSG_IF (m_started, "Partitions must be assigned before Simulator::Run");
+  NS_ABORT_MSG_IF (context == Simulator::NO_CONTEXT, "Events without context belong to the partition 0");
+
+  if (context >= m_partitionOfContext.size ())
+    {
+      m_partitionOfContext.resize (context + 1, 0);
+    }
+  m_partitionOfContext[context] = partition;
+  GetOrCreatePartition (partition);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition (uint32_t context) const
+{
+  return context < m_partitionOfContext.size () ? m_partitionOfContext[context] : 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions (void) const
+{
+  return static_cast<uint32_t> (m_partitions.size ());
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetOrCreatePartition (uint32_t index)
+{
+  while (m_partitions.size () <= index)
+    {
+      auto p = std::make_unique<Partition> ();
+      p->m_events = m_schedulerFactory.Create<Scheduler> ();
+      p->m_index = static_cast<uint32_t> (m_partitions.size ());
+      p->m_uid = m_partitions.empty () ? static_cast<uint32_t> (EventId::UID::VALID)
+                                       : m_partitions.front ()->m_uid;
+      p->m_currentUid = EventId::UID::INVALID;
+      p->m_currentTs = m_globalTs;
+      p->m_currentContext = Simulator::NO_CONTEXT;
+      m_partitions.push_back (std::move (p));
+    }
+  return m_partitions.at (index).get ();
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetCurrentPartition (void) const
+{
+  if (m_currentPartition != nullptr)
+    {
+      return m_currentPartition;
+    }
+  NS_ABORT_MSG_IF (m_running, "Simulator invoked by a thread that is not running a partition");
+  return m_partitions.front ().get ();
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetPartitionOfEvent (const EventId &id) const
+{
+  // Before the first run, all the events are in the partition 0
+  if (!m_started)
+    {
+      return m_partitions.front ().get ();
+    }
+  return m_partitions.at (GetPartition (id.GetContext ())).get ();
+}
+
+Scheduler::EventKey
+MultithreadedSimulatorImpl::Insert (Partition *p, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  ev.key.m_uid = p->m_uid;
+  p->m_uid++;
+  p->m_unscheduledEvents++;
+  p->m_events->Insert (ev);
+  return ev.key;
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+void
+MultithreadedSimulatorImpl::Redistribute (void)
+{
+  NS_LOG_FUNCTION (this);
+  Partition *first = m_partitions.front ().get ();
+  std::vector<Scheduler::Event> events;
+  while (!first->m_events->IsEmpty ())
+    {
+      events.push_back (first->m_events->RemoveNext ());
+    }
+
+  // The events keep their uid, so the EventId given to the models are
+  // still valid; the new uids of every partition start after them.
+  for (const auto & ev : events)
+    {
+      Partition *p = m_partitions.at (GetPartition (ev.key.m_context)).get ();
+      p->m_events->Insert (ev);
+      if (p != first)
+        {
+          p->m_unscheduledEvents++;
+          first->m_unscheduledEvents--;
+        }
+    }
+  for (auto & p : m_partitions)
+    {
+      p->m_uid = first->m_uid;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::MergeInboxes (void)
+{
+  for (auto & p : m_partitions)
+    {
+      if (p->m_inbox.empty ())
+        {
+          continue;
+        }
+      // The order of arrival depends on the threads: sort the events so that
+      // their uids, and then the order of the events with the same timestamp,
+      // do not.
+      std::sort (p->m_inbox.begin (), p->m_inbox.end (),
+                 [] (const InboxEvent &a, const InboxEvent &b)
+                 {
+                   if (a.timestamp != b.timestamp)
+                     {
+                       return a.timestamp < b.timestamp;
+                     }
+                   if (a.source != b.source)
+                     {
+                       return a.source < b.source;
+                     }
+                   return a.sequence < b.sequence;
+                 });
+      for (const auto & ev : p->m_inbox)
+        {
+          Insert (p.get (), ev.timestamp, ev.context, ev.event);
+        }
+      p->m_inbox.clear ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition *p)
+{
+  Scheduler::Event next = p->m_events->RemoveNext ();
+
+  PreEventHook (EventId (next.impl, next.key.m_ts,
+                         next.key.m_context, next.key.m_uid));
+
+  NS_ASSERT (next.key.m_ts >= p->m_currentTs);
+  p->m_unscheduledEvents--;
+  p->m_eventCount++;
+
+  p->m_currentTs = next.key.m_ts;
+  p->m_currentContext = next.key.m_context;
+  p->m_currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow (Partition *p)
+{
+  m_currentPartition = p;
+  while (!p->m_events->IsEmpty () && !m_stop.load (std::memory_order_relaxed))
+    {
+      uint64_t ts = p->m_events->PeekNext ().key.m_ts;
+      if (ts >= m_windowEnd || ts >= m_stopTs.load (std::memory_order_relaxed))
+        {
+          break;
+        }
+      ProcessOneEvent (p);
+    }
+  m_currentPartition = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessPartitions (void)
+{
+  const uint32_t n = static_cast<uint32_t> (m_partitions.size ());
+  while (true)
+    {
+      uint32_t i = m_nextPartition.fetch_add (1);
+      if (i >= n)
+        {
+          return;
+        }
+      ProcessWindow (m_partitions[i].get ());
+      if (m_pendingPartitions.fetch_sub (1) == 1)
+        {
+          std::lock_guard<std::mutex> lock (m_windowMutex);
+          m_windowDone.notify_one ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunParallelWindow (uint64_t windowEnd)
+{
+  {
+    std::lock_guard<std::mutex> lock (m_windowMutex);
+    m_windowEnd = windowEnd;
+    m_parallelWindow = true;
+    // The counter of the pending partitions has to be ready before a
+    // thread can take a partition
+    m_pendingPartitions = static_cast<uint32_t> (m_partitions.size ());
+    m_nextPartition = 0;
+    m_windowGeneration++;
+  }
+  m_windowStart.notify_all ();
+
+  // The main thread works as well
+  ProcessPartitions ();
+
+  std::unique_lock<std::mutex> lock (m_windowMutex);
+  m_windowDone.wait (lock, [this] { return m_pendingPartitions.load () == 0; });
+  m_parallelWindow = false;
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop (void)
+{
+  uint64_t generation;
+  {
+    std::lock_guard<std::mutex> lock (m_windowMutex);
+    generation = m_windowGeneration;
+  }
+
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_windowMutex);
+        m_windowStart.wait (lock, [this, generation]
+                            { return m_shutdown || m_windowGeneration != generation; });
+        if (m_shutdown)
+          {
+            return;
+          }
+        generation = m_windowGeneration;
+      }
+      ProcessPartitions ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StartWorkers (void)
+{
+  uint32_t threads = m_maxThreads;
+  if (threads == 0)
+    {
+      threads = std::max (std::thread::hardware_concurrency (), 1U);
+    }
+  threads = std::min (threads, static_cast<uint32_t> (m_partitions.size ()));
+
+  NS_LOG_LOGIC ("Running " << m_partitions.size () << " partitions with " << threads << " threads");
+  // The thread that calls Run() is one of them
+  for (uint32_t i = 1; i < threads; ++i)
+    {
+      m_workers.emplace_back (&MultithreadedSimulatorImpl::WorkerLoop, this);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopWorkers (void)
+{
+  if (m_workers.empty ())
+    {
+      return;
+    }
+  {
+    std::lock_guard<std::mutex> lock (m_windowMutex);
+    m_shutdown = true;
+  }
+  m_windowStart.notify_all ();
+  for (auto & t : m_workers)
+    {
+      t.join ();
+    }
+  m_workers.clear ();
+  m_shutdown = false;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetNextPartition (uint64_t *ts) const
+{
+  Partition *next = nullptr;
+  for (const auto & p : m_partitions)
+    {
+      if (p->m_events->IsEmpty ())
+        {
+          continue;
+        }
+      uint64_t pTs = p->m_events->PeekNext ().key.m_ts;
+      // Ties go to the partition with the lowest index
+      if (next == nullptr || pTs < *ts)
+        {
+          next = p.get ();
+          *ts = pTs;
+        }
+    }
+  return next;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  for (const auto & p : m_partitions)
+    {
+      if (!p->m_events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (!m_running, "Simulator::Run called by an event");
+
+  if (!m_started)
+    {
+      Redistribute ();
+      m_started = true;
+    }
+  m_running = true;
+  m_stop = false;
+
+  const uint64_t lookahead = static_cast<uint64_t> (m_lookahead.GetTimeStep ());
+  const uint64_t parallelStart = static_cast<uint64_t> (m_parallelStartTime.GetTimeStep ());
+  bool stoppedAtStopTs = false;
+
+  while (!m_stop)
+    {
+      uint64_t ts = 0;
+      Partition *next = GetNextPartition (&ts);
+      if (next == nullptr)
+        {
+          // The simulator stopped naturally by lack of events: check that
+          // we didn't lose any events along the way.
+          for (const auto & p : m_partitions)
+            {
+              NS_ASSERT (p->m_unscheduledEvents == 0);
+            }
+          break;
+        }
+      if (ts >= m_stopTs)
+        {
+          stoppedAtStopTs = true;
+          break;
+        }
+
+      if (lookahead == 0 || ts < parallelStart || m_partitions.size () == 1)
+        {
+          // Single thread, in timestamp order: the events for another
+          // partition are inserted directly in its event list
+          m_currentPartition = next;
+          ProcessOneEvent (next);
+          m_currentPartition = nullptr;
+          continue;
+        }
+
+      if (m_workers.empty ())
+        {
+          StartWorkers ();
+        }
+      RunParallelWindow (std::min (ts + lookahead, m_stopTs.load ()));
+      MergeInboxes ();
+    }
+
+  StopWorkers ();
+  m_running = false;
+
+  for (const auto & p : m_partitions)
+    {
+      m_globalTs = std::max (m_globalTs, p->m_currentTs);
+    }
+  if (stoppedAtStopTs)
+    {
+      // Like the Stop event of the DefaultSimulatorImpl, the stop time is
+      // consumed: a new Run () continues from there.
+      m_globalTs = std::max (m_globalTs, m_stopTs.load ());
+      m_stopTs = std::numeric_limits<uint64_t>::max ();
+    }
+  for (auto & p : m_partitions)
+    {
+      p->m_currentTs = std::max (p->m_currentTs, m_globalTs);
+      p->m_currentContext = Simulator::NO_CONTEXT;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Stop(): Negative delay");
+  uint64_t ts = static_cast<uint64_t> ((Now () + delay).GetTimeStep ());
+  uint64_t current = m_stopTs.load ();
+  while (ts < current && !m_stopTs.compare_exchange_weak (current, ts))
+    {
+    }
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+  Partition *p = GetCurrentPartition ();
+  uint64_t ts = p->m_currentTs + static_cast<uint64_t> (delay.GetTimeStep ());
+  Scheduler::EventKey key = Insert (p, ts, GetContext (), event);
+  return EventId (event, key.m_ts, key.m_context, key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::ScheduleWithContext(): Negative delay");
+
+  Partition *current = GetCurrentPartition ();
+  uint64_t ts = current->m_currentTs + static_cast<uint64_t> (delay.GetTimeStep ());
+
+  if (!m_started)
+    {
+      Insert (current, ts, context, event);
+      return;
+    }
+
+  Partition *target = m_partitions.at (GetPartition (context)).get ();
+  if (!m_parallelWindow || target == current)
+    {
+      Insert (target, ts, context, event);
+      return;
+    }
+
+  NS_ABORT_MSG_IF (ts < m_windowEnd,
+                   "Event for context " << context << " (partition " << target->m_index <<
+                   ") scheduled by partition " << current->m_index << " with a delay of " <<
+                   delay.As (Time::US) << ", shorter than the lookahead " << m_lookahead.As (Time::US));
+
+  // the arguments of the event (e.g., the packet received by a device)
+  // must not share reference counts with the objects of this partition
+  event->CopyArguments ();
+
+  InboxEvent ev;
+  ev.timestamp = ts;
+  ev.context = context;
+  ev.source = current->m_index;
+  ev.sequence = current->m_sentEvents++;
+  ev.event = event;
+  std::lock_guard<std::mutex> lock (target->m_inboxMutex);
+  target->m_inbox.push_back (ev);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  return Schedule (Time (0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_ASSERT_MSG (!m_parallelWindow, "Simulator::ScheduleDestroy invoked in the parallel phase");
+
+  EventId id (Ptr<EventImpl> (event, false), Now ().GetTimeStep (), 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  Partition *p = m_currentPartition;
+  return TimeStep (p != nullptr ? p->m_currentTs : m_globalTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - Now ().GetTimeStep ());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == EventId::UID::DESTROY)
+    {
+      // destroy events.
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition *p = GetPartitionOfEvent (id);
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  p->m_events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  p->m_unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == EventId::UID::DESTROY)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  const Partition *p = GetPartitionOfEvent (id);
+  if (id.PeekEventImpl () == 0
+      || id.GetTs () < p->m_currentTs
+      || (id.GetTs () == p->m_currentTs && id.GetUid () <= p->m_currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  Partition *p = m_currentPartition;
+  return p != nullptr ? p->m_currentContext : Simulator::NO_CONTEXT;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  uint64_t count = 0;
+  for (const auto & p : m_partitions)
+    {
+      count += p->m_eventCount;
+    }
+  return count;
+}
+
+} // namespace ns3
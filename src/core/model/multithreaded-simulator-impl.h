@@ -0,0 +1,270 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "nstime.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * \brief A shared-memory parallel simulator implementation.
+ *
+ * The execution contexts (i.e., the nodes) are grouped in partitions with
+ * SetPartition(); the contexts that are not assigned belong to the
+ * partition 0, as well as the events without a context. Each partition has
+ * its own event list, and the partitions are run by a pool of threads.
+ *
+ * The synchronization is conservative, like the one of the
+ * DistributedSimulatorImpl, but with shared memory instead of MPI
+ * messages: the simulation advances in windows of Lookahead duration,
+ * starting from the earliest event of all the partitions. Inside a window
+ * the partitions run in parallel; an event scheduled with
+ * Simulator::ScheduleWithContext for a context of another partition is
+ * delivered at the end of the window, so its delay must not be shorter than
+ * the lookahead. The events delivered in this way are ordered by timestamp
+ * and by source partition, so that the results do not depend on the
+ * threads timing.
+ *
+ * Before ParallelStartTime, or if the lookahead is zero, the partitions are
+ * run by a single thread in timestamp order, which is useful to let the
+ * models that are not partitioned (e.g., the attach procedures) do their
+ * work before the parallel phase.
+ *
+ * The implementation does not make the models thread-safe: during the
+ * parallel phase, the objects of a partition must be touched only by
+ * the events of that partition, and the partitions can interact only
+ * through events scheduled with a context, like the packets sent on a
+ * channel. In particular, the partitions must not share channels with a
+ * delay shorter than the lookahead, trace sinks that write to the same
+ * file or container, or objects that are called directly across nodes.
+ * An event can be cancelled or queried (Simulator::IsExpired,
+ * Simulator::GetDelayLeft) only by the partition that owns it.
+ *
+ * The packets can be created and released by any partition, as the packet
+ * uids and the free lists of the packet buffers are thread-safe; the uids
+ * are unique, but they are not assigned in the same order in each run. The
+ * reference counts of a packet and of its buffers are not atomic, though:
+ * when an event is scheduled for another partition, its arguments are
+ * replaced by copies of their own with EventImpl::CopyArguments, which
+ * makes a deep copy of the packets (see EventArgumentCopy). The events
+ * made from a lambda or from a std::function cannot be copied, so they
+ * must not capture a packet for another partition.
+ *
+ * Simulator::Stop (delay) stops the simulation before the first event at
+ * or after the stop time, and Simulator::Stop () called by an event stops
+ * the partitions after the event they are running.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  /**
+   * \brief Assign a context to a partition
+   *
+   * It must be called before Simulator::Run. The events already scheduled
+   * for the context are moved to the partition when the simulation starts.
+   *
+   * \param context the context (usually, the node id)
+   * \param partition the partition
+   */
+  void SetPartition (uint32_t context, uint32_t partition);
+  /**
+   * \param context the context
+   * \return the partition of the context
+   */
+  uint32_t GetPartition (uint32_t context) const;
+  /**
+   * \return the number of partitions
+   */
+  uint32_t GetNPartitions (void) const;
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** An event sent to another partition during a parallel window. */
+  struct InboxEvent
+  {
+    uint64_t timestamp;   //!< Absolute event timestamp
+    uint32_t context;     //!< The event context
+    uint32_t source;      //!< The partition that scheduled the event
+    uint64_t sequence;    //!< Order of the event among the ones sent by the source
+    EventImpl *event;     //!< The event implementation
+  };
+
+  /** The state of a partition. */
+  struct Partition
+  {
+    Ptr<Scheduler> m_events;           //!< The event priority queue
+    uint32_t m_index {0};              //!< Index of the partition
+    uint32_t m_uid {0};                //!< Next event unique id
+    uint32_t m_currentUid {0};         //!< Unique id of the current event
+    uint64_t m_currentTs {0};          //!< Timestamp of the current event
+    uint32_t m_currentContext {0};     //!< Execution context of the current event
+    uint64_t m_eventCount {0};         //!< The event count
+    int m_unscheduledEvents {0};       //!< Events inserted but not yet run
+    uint64_t m_sentEvents {0};         //!< Events sent to other partitions
+    std::mutex m_inboxMutex;           //!< Mutex for the inbox
+    std::vector<InboxEvent> m_inbox;   //!< Events sent by other partitions
+  };
+
+  /**
+   * \param index partition index
+   * \return the partition, created if it does not exist
+   */
+  Partition * GetOrCreatePartition (uint32_t index);
+  /**
+   * \return the partition that runs the current event, or the partition 0
+   * if the caller is not running an event
+   */
+  Partition * GetCurrentPartition (void) const;
+  /**
+   * \param id the event
+   * \return the partition that owns the event
+   */
+  Partition * GetPartitionOfEvent (const EventId &id) const;
+  /**
+   * \brief Insert an event in the event list of a partition
+   * \param p the partition
+   * \param ts absolute timestamp
+   * \param context the event context
+   * \param event the event implementation
+   * \return the event key
+   */
+  Scheduler::EventKey Insert (Partition *p, uint64_t ts, uint32_t context, EventImpl *event);
+  /** Move the events to the partition of their context, after SetPartition() */
+  void Redistribute (void);
+  /** Move the events sent during the last window to the event lists. */
+  void MergeInboxes (void);
+  /**
+   * \brief Process the next event of a partition
+   * \param p the partition
+   */
+  void ProcessOneEvent (Partition *p);
+  /**
+   * \brief Process the events of a partition until the end of the window
+   * \param p the partition
+   */
+  void ProcessWindow (Partition *p);
+  /**
+   * \brief Run a window on all the partitions, with the threads
+   * \param windowEnd end of the window (excluded)
+   */
+  void RunParallelWindow (uint64_t windowEnd);
+  /**
+   * \brief Take the partitions of the current window until there are none
+   */
+  void ProcessPartitions (void);
+  /** The loop of the worker threads. */
+  void WorkerLoop (void);
+  /** Start the worker threads. */
+  void StartWorkers (void);
+  /** Stop the worker threads. */
+  void StopWorkers (void);
+  /**
+   * \param [out] ts the timestamp of the earliest event
+   * \return the partition with the earliest event, or nullptr if there are
+   * no events
+   */
+  Partition * GetNextPartition (uint64_t *ts) const;
+
+  /** The partition run by the current thread, nullptr if it is not running events. */
+  static thread_local Partition *m_currentPartition;
+
+  std::vector<std::unique_ptr<Partition> > m_partitions; //!< The partitions
+  std::vector<uint32_t> m_partitionOfContext;  //!< Partition of each context
+  bool m_started;                              //!< The events have been moved to their partitions
+  ObjectFactory m_schedulerFactory;            //!< Factory of the event lists
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+
+  Time m_lookahead;                  //!< Minimum delay of the events between partitions
+  Time m_parallelStartTime;          //!< Time at which the parallel phase starts
+  uint32_t m_maxThreads;             //!< Maximum number of threads, 0 for the hardware concurrency
+
+  std::atomic<bool> m_stop;          //!< Flag calling for the end of the simulation
+  std::atomic<uint64_t> m_stopTs;    //!< Timestamp at which the simulation stops
+  bool m_running;                    //!< Run() is in progress
+  bool m_parallelWindow;             //!< A parallel window is in progress
+  uint64_t m_windowEnd;              //!< End of the current window (excluded)
+  uint64_t m_globalTs;               //!< Time seen by the main thread out of the events
+
+  std::vector<std::thread> m_workers;       //!< The worker threads
+  std::mutex m_windowMutex;                 //!< Mutex of the window state
+  std::condition_variable m_windowStart;    //!< Signals a new window to the workers
+  std::condition_variable m_windowDone;     //!< Signals the end of the window to the main thread
+  uint64_t m_windowGeneration;              //!< Incremented at every window
+  bool m_shutdown;                          //!< The workers have to exit
+  std::atomic<uint32_t> m_nextPartition;    //!< Next partition to be taken in the window
+  std::atomic<uint32_t> m_pendingPartitions; //!< Partitions not yet completed in the window
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SIZE_CLASS_POOL_H
+#define SIZE_CLASS_POOL_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::SizeClassPool declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ * \brief Per-thread free lists of memory blocks, one for each size class.
+ *
+ * The blocks are grouped in size classes of 16 bytes, up to 256 bytes.
+ * A released block is kept in the free list of its class, in the thread
+ * that releases it, and given back by the next allocation of the same
+ * class in that thread. A block can be released by a thread other than
+ * the one that allocated it. Larger blocks use the global allocator.
+ *
+ * Each thread keeps at most MAX_CACHED blocks per class: the blocks
+ * released beyond that go back to the global allocator, so that a burst
+ * of allocations does not stay pinned for the whole run. The free lists
+ * of a thread are released when it exits, and its counters are added to
+ * the statistics of the exited threads. The blocks released after that
+ * (e.g., by static destructors) use the global allocator.
+ *
+ * Each \p Tag has its own free lists and statistics. The free lists are
+ * bypassed in AddressSanitizer builds, so that the use of the released
+ * memory is still detected.
+ *
+ * \tparam Tag \explicit The type that identifies the pool.
+ */
+template <typename Tag>
+class SizeClassPool
+{
+public:
+  /** Granularity of the size classes, in bytes. */
+  static constexpr std::size_t GRANULARITY = 16;
+  /** Number of size classes: the largest is 256 bytes. */
+  static constexpr std::size_t CLASSES = 16;
+  /** Maximum number of free blocks of each size class kept by a thread. */
+  static constexpr uint32_t MAX_CACHED = 4096;
+
+  /** Statistics of the allocations. */
+  struct Stats
+  {
+    uint64_t allocations;       //!< Blocks allocated
+    uint64_t poolHits;          //!< Allocations served by a free list
+    uint64_t largeAllocations;  //!< Blocks larger than the size classes
+    uint64_t deallocations;     //!< Blocks released
+    uint64_t cachedBlocks;      //!< Blocks in the free lists of the calling thread
+  };
+
+  /**
+   * Allocate a block from the free list of its size class.
+   * \param [in] size The size of the block.
+   * \returns The memory.
+   */
+  static void * Allocate (std::size_t size);
+
+  /**
+   * Release a block to the free list of its size class.
+   * \param [in] p The memory, obtained from Allocate().
+   * \param [in] size The size passed to Allocate().
+   */
+  static void Deallocate (void *p, std::size_t size);
+
+  /**
+   * \returns the statistics of the calling thread, plus the ones of the
+   * threads that have already exited.
+   */
+  static Stats GetStats (void);
+
+private:
+  /** A free block, linked in the free list of its size class. */
+  struct FreeBlock
+  {
+    FreeBlock *next; //!< Next free block
+  };
+
+  /** Counters of the allocations. */
+  struct Counters
+  {
+    uint64_t allocations {0};       //!< Blocks allocated
+    uint64_t poolHits {0};          //!< Allocations served by a free list
+    uint64_t largeAllocations {0};  //!< Blocks larger than the size classes
+    uint64_t deallocations {0};     //!< Blocks released
+  };
+
+  /** The free lists of a thread. */
+  struct Cache
+  {
+    FreeBlock *m_free[CLASSES] {};  //!< Free list of each size class
+    uint32_t m_cached[CLASSES] {};  //!< Length of each free list
+    Counters m_counters;            //!< Counters of the thread
+
+    /** Release the free blocks, and keep the counters of the thread. */
+    ~Cache ();
+  };
+
+  /**
+   * \returns the counters of the threads that have exited, and their mutex
+   */
+  static std::pair<Counters *, std::mutex *> ExitedCounters (void);
+
+  /**
+   * \returns the flag set when the free lists of the calling thread have
+   * been destroyed
+   */
+  static bool & IsDestroyed (void);
+
+  /**
+   * \returns the free lists of the calling thread
+   */
+  static Cache & GetCache (void);
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename Tag>
+SizeClassPool<Tag>::Cache::~Cache ()
+{
+  for (std::size_t c = 0; c < CLASSES; ++c)
+    {
+      while (m_free[c] != nullptr)
+        {
+          FreeBlock *block = m_free[c];
+          m_free[c] = block->next;
+          ::operator delete (block);
+        }
+    }
+  auto exited = ExitedCounters ();
+  std::lock_guard<std::mutex> lock (*exited.second);
+  exited.first->allocations += m_counters.allocations;
+  exited.first->poolHits += m_counters.poolHits;
+  exited.first->largeAllocations += m_counters.largeAllocations;
+  exited.first->deallocations += m_counters.deallocations;
+  IsDestroyed () = true;
+}
+
+template <typename Tag>
+std::pair<typename SizeClassPool<Tag>::Counters *, std::mutex *>
+SizeClassPool<Tag>::ExitedCounters (void)
+{
+  static Counters counters;
+  static std::mutex mutex;
+  return std::make_pair (&counters, &mutex);
+}
+
+template <typename Tag>
+bool &
+SizeClassPool<Tag>::IsDestroyed (void)
+{
+  static thread_local bool destroyed = false;
+  return destroyed;
+}
+
+template <typename Tag>
+typename SizeClassPool<Tag>::Cache &
+SizeClassPool<Tag>::GetCache (void)
+{
+  static thread_local Cache cache;
+  return cache;
+}
+
+template <typename Tag>
+void *
+SizeClassPool<Tag>::Allocate (std::size_t size)
+{
+#ifndef __SANITIZE_ADDRESS__
+  std::size_t c = (size - 1) / GRANULARITY;
+  if (c < CLASSES && !IsDestroyed ())
+    {
+      Cache &cache = GetCache ();
+      ++cache.m_counters.allocations;
+      FreeBlock *block = cache.m_free[c];
+      if (block != nullptr)
+        {
+          cache.m_free[c] = block->next;
+          --cache.m_cached[c];
+          ++cache.m_counters.poolHits;
+          return block;
+        }
+      return ::operator new ((c + 1) * GRANULARITY);
+    }
+  if (!IsDestroyed ())
+    {
+      Cache &cache = GetCache ();
+      ++cache.m_counters.allocations;
+      ++cache.m_counters.largeAllocations;
+    }
+#endif
+  return ::operator new (size);
+}
+
+template <typename Tag>
+void
+SizeClassPool<Tag>::Deallocate (void *p, std::size_t size)
+{
+#ifndef __SANITIZE_ADDRESS__
+  if (p == nullptr)
+    {
+      return;
+    }
+  if (IsDestroyed ())
+    {
+      ::operator delete (p);
+      return;
+    }
+  Cache &cache = GetCache ();
+  ++cache.m_counters.deallocations;
+  std::size_t c = (size - 1) / GRANULARITY;
+  if (c < CLASSES && cache.m_cached[c] < MAX_CACHED)
+    {
+      FreeBlock *block = static_cast<FreeBlock *> (p);
+      block->next = cache.m_free[c];
+      cache.m_free[c] = block;
+      ++cache.m_cached[c];
+      return;
+    }
+#endif
+  ::operator delete (p);
+}
+
+template <typename Tag>
+typename SizeClassPool<Tag>::Stats
+SizeClassPool<Tag>::GetStats (void)
+{
+  Stats stats {0, 0, 0, 0, 0};
+  {
+    auto exited = ExitedCounters ();
+    std::lock_guard<std::mutex> lock (*exited.second);
+    stats.allocations = exited.first->allocations;
+    stats.poolHits = exited.first->poolHits;
+    stats.largeAllocations = exited.first->largeAllocations;
+    stats.deallocations = exited.first->deallocations;
+  }
+  if (!IsDestroyed ())
+    {
+      const Cache &cache = GetCache ();
+      stats.allocations += cache.m_counters.allocations;
+      stats.poolHits += cache.m_counters.poolHits;
+      stats.largeAllocations += cache.m_counters.largeAllocations;
+      stats.deallocations += cache.m_counters.deallocations;
+      for (std::size_t c = 0; c < CLASSES; ++c)
+        {
+          stats.cachedBlocks += cache.m_cached[c];
+        }
+    }
+  return stats;
+}
+
+} // namespace ns3
+
+#endif /* SIZE_CLASS_POOL_H */
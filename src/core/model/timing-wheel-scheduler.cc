@@ -0,0 +1,320 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "timing-wheel-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include "uinteger.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::TimingWheelScheduler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TimingWheelScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (TimingWheelScheduler);
+
+namespace {
+
+/**
+ * \ingroup scheduler
+ * Order of the heap of the current bucket: the earliest event is on top.
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \pname{a} comes after \pname{b}.
+ */
+inline bool
+LaterFirst (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return b.key < a.key;
+}
+
+} // unnamed namespace
+
+TypeId
+TimingWheelScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TimingWheelScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<TimingWheelScheduler> ()
+    .AddAttribute ("SlotWidth",
+                   "The duration of a bucket of the wheel.",
+                   TimeValue (MicroSeconds (1)),
+                   MakeTimeAccessor (&TimingWheelScheduler::m_slotWidthTime),
+                   MakeTimeChecker (TimeStep (1)))
+    .AddAttribute ("NumSlots",
+                   "The number of buckets of the wheel, rounded up to a power of 2.",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&TimingWheelScheduler::m_numSlotsAttr),
+                   MakeUintegerChecker<uint32_t> (1, 1U << 24))
+  ;
+  return tid;
+}
+
+TimingWheelScheduler::TimingWheelScheduler ()
+  : m_numSlotsAttr (4096),
+    m_width (1),
+    m_mask (0),
+    m_base (0),
+    m_current (0),
+    m_heap (true),
+    m_wheelSize (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TimingWheelScheduler::~TimingWheelScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TimingWheelScheduler::Init (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_width = std::max<int64_t> (m_slotWidthTime.GetTimeStep (), 1);
+  uint32_t nSlots = 1;
+  while (nSlots < m_numSlotsAttr)
+    {
+      nSlots <<= 1;
+    }
+  m_slots.resize (nSlots);
+  m_mask = nSlots - 1;
+  NS_LOG_DEBUG ("Wheel of " << nSlots << " buckets of " << m_width << " time steps");
+}
+
+bool
+TimingWheelScheduler::InWheel (uint64_t ts) const
+{
+  NS_ASSERT (ts >= m_base);
+  return (ts - m_base) / m_width <= m_mask;
+}
+
+uint32_t
+TimingWheelScheduler::Bucket (uint64_t ts) const
+{
+  return static_cast<uint32_t> ((ts / m_width) & m_mask);
+}
+
+void
+TimingWheelScheduler::DoInsert (const Scheduler::Event &ev)
+{
+  if (InWheel (ev.key.m_ts))
+    {
+      uint32_t bucket = Bucket (ev.key.m_ts);
+      Slot &slot = m_slots[bucket];
+      slot.push_back (ev);
+      if (bucket == m_current && m_heap)
+        {
+          std::push_heap (slot.begin (), slot.end (), LaterFirst);
+        }
+      ++m_wheelSize;
+    }
+  else
+    {
+      std::pair<Overflow::iterator, bool> result;
+      result = m_overflow.insert (std::make_pair (ev.key, ev.impl));
+      NS_ASSERT (result.second);
+    }
+}
+
+void
+TimingWheelScheduler::MoveBack (uint64_t ts)
+{
+  NS_LOG_FUNCTION (this << ts);
+  uint64_t base = ts - ts % m_width;
+  uint64_t n = std::min<uint64_t> ((m_base - base) / m_width, m_mask + 1);
+  // The buckets between the new and the old cursor hold the end of the
+  // horizon, which moves back too: their events go to the overflow
+  uint32_t bucket = Bucket (base);
+  for (uint64_t k = 0; k < n; ++k)
+    {
+      Slot &slot = m_slots[(bucket + k) & m_mask];
+      for (const auto &ev : slot)
+        {
+          std::pair<Overflow::iterator, bool> result;
+          result = m_overflow.insert (std::make_pair (ev.key, ev.impl));
+          NS_ASSERT (result.second);
+        }
+      m_wheelSize -= slot.size ();
+      slot.clear ();
+    }
+  m_base = base;
+  m_current = bucket;
+  m_heap = true;
+}
+
+void
+TimingWheelScheduler::Advance (void)
+{
+  if (m_wheelSize == 0)
+    {
+      if (m_overflow.empty ())
+        {
+          return;
+        }
+      // Jump to the first event of the overflow
+      uint64_t ts = m_overflow.begin ()->first.m_ts;
+      m_base = ts - ts % m_width;
+      m_current = Bucket (m_base);
+      m_heap = false;
+      while (!m_overflow.empty () && InWheel (m_overflow.begin ()->first.m_ts))
+        {
+          auto i = m_overflow.begin ();
+          DoInsert ({i->second, i->first});
+          m_overflow.erase (i);
+        }
+    }
+
+  while (m_slots[m_current].empty ())
+    {
+      m_base += m_width;
+      m_current = (m_current + 1) & m_mask;
+      m_heap = false;
+      // The last bucket of the horizon is a new one: it takes its
+      // events from the overflow
+      while (!m_overflow.empty () && InWheel (m_overflow.begin ()->first.m_ts))
+        {
+          auto i = m_overflow.begin ();
+          DoInsert ({i->second, i->first});
+          m_overflow.erase (i);
+        }
+    }
+
+  if (!m_heap)
+    {
+      Slot &slot = m_slots[m_current];
+      std::make_heap (slot.begin (), slot.end (), LaterFirst);
+      m_heap = true;
+    }
+}
+
+void
+TimingWheelScheduler::Insert (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  if (m_slots.empty ())
+    {
+      Init ();
+    }
+
+  if (IsEmpty ())
+    {
+      m_base = ev.key.m_ts - ev.key.m_ts % m_width;
+      m_current = Bucket (m_base);
+      m_heap = true;
+    }
+  else if (ev.key.m_ts < m_base)
+    {
+      MoveBack (ev.key.m_ts);
+    }
+
+  DoInsert (ev);
+}
+
+bool
+TimingWheelScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_wheelSize == 0 && m_overflow.empty ();
+}
+
+Scheduler::Event
+TimingWheelScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (m_wheelSize == 0)
+    {
+      Overflow::const_iterator i = m_overflow.begin ();
+      return {i->second, i->first};
+    }
+  // The overflow events are all after the wheel ones
+  uint32_t bucket = m_current;
+  while (m_slots[bucket].empty ())
+    {
+      bucket = (bucket + 1) & m_mask;
+    }
+  const Slot &slot = m_slots[bucket];
+  if (bucket == m_current && m_heap)
+    {
+      return slot.front ();
+    }
+  return *std::min_element (slot.begin (), slot.end (),
+                            [] (const Scheduler::Event &a, const Scheduler::Event &b)
+                            {
+                              return a.key < b.key;
+                            });
+}
+
+Scheduler::Event
+TimingWheelScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  // The cursor moves only up to the bucket of the event, so that the
+  // events scheduled by it (at or after its timestamp) are never behind
+  Advance ();
+  Slot &slot = m_slots[m_current];
+  std::pop_heap (slot.begin (), slot.end (), LaterFirst);
+  Scheduler::Event ev = slot.back ();
+  slot.pop_back ();
+  --m_wheelSize;
+  NS_LOG_DEBUG (this << ": " << ev.impl << ", " << ev.key.m_ts << ", " << ev.key.m_uid);
+  return ev;
+}
+
+void
+TimingWheelScheduler::Remove (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  if (ev.key.m_ts >= m_base && InWheel (ev.key.m_ts))
+    {
+      uint32_t bucket = Bucket (ev.key.m_ts);
+      Slot &slot = m_slots[bucket];
+      auto i = std::find_if (slot.begin (), slot.end (),
+                             [&ev] (const Scheduler::Event &e)
+                             {
+                               return e.key.m_uid == ev.key.m_uid && e.key.m_ts == ev.key.m_ts;
+                             });
+      NS_ASSERT (i != slot.end ());
+      NS_ASSERT (i->impl == ev.impl);
+      *i = slot.back ();
+      slot.pop_back ();
+      if (bucket == m_current)
+        {
+          m_heap = false;
+        }
+      --m_wheelSize;
+    }
+  else
+    {
+      Overflow::iterator i = m_overflow.find (ev.key);
+      NS_ASSERT (i != m_overflow.end ());
+      NS_ASSERT (i->second == ev.impl);
+      m_overflow.erase (i);
+    }
+}
+
+} // namespace ns3
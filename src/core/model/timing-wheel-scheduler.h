@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TIMING_WHEEL_SCHEDULER_H
+#define TIMING_WHEEL_SCHEDULER_H
+
+#include "scheduler.h"
+#include "nstime.h"
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::TimingWheelScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a timing wheel event scheduler
+ *
+ * This event scheduler keeps the events of the near future in a wheel of
+ * NumSlots buckets, each one SlotWidth long, and the events after the
+ * wheel horizon (NumSlots x SlotWidth after the current bucket) in an
+ * overflow std::map. The wheel moves forward one bucket at a time; when
+ * a bucket enters the horizon, the overflow events that fall into it are
+ * moved to the wheel.
+ *
+ * The buckets are unsorted vectors; only the current bucket is kept as a
+ * binary heap, built when the bucket becomes the current one. This suits
+ * the models with many periodic events scheduled a little ahead of the
+ * current time, like the slot and symbol events of the NR and LTE models,
+ * where the cost of inserting and extracting an event depends only on the
+ * events of a bucket, not on all the pending events.
+ * The defaults (4096 buckets of 1 us) cover about 4 ms.
+ *
+ * The wheel moves lazily: RemoveNext() moves the current bucket only up
+ * to the bucket of the event it returns, and PeekNext() looks for the
+ * next non-empty bucket without moving it. The events scheduled by an
+ * event, with a zero delay too, are never before the current bucket.
+ * Inserting an event before it (which can happen only before the
+ * simulation starts, or after Simulator::SetScheduler) moves the wheel
+ * back; the buckets it passes over hold the end of the old horizon, and
+ * their events are moved to the overflow.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | `std::vector::push_back()`; logarithmic in the overflow
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | ~Constant       | Scan of the empty buckets up to the next event
+ * Remove()     | ~Constant       | Search within bucket; logarithmic in the overflow
+ * RemoveNext() | ~Constant       | Scan of the empty buckets; heap of the current bucket
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | NumSlots x 3 x `sizeof (*)`      | `std::vector` buckets
+ * Per Event | 0 (wheel), 32 bytes (overflow)   | `std::vector`, red-black tree
+ */
+class TimingWheelScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  TimingWheelScheduler ();
+  /** Destructor. */
+  virtual ~TimingWheelScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Allocate the buckets, with the values of the attributes. */
+  void Init (void);
+  /**
+   * Insert an event in the wheel or in the overflow, without moving the
+   * current bucket.
+   * \param [in] ev The event.
+   */
+  void DoInsert (const Scheduler::Event &ev);
+  /**
+   * Move the wheel so that it starts at an earlier time, moving to the
+   * overflow the events after the new horizon.
+   * \param [in] ts The new start time of the wheel.
+   */
+  void MoveBack (uint64_t ts);
+  /**
+   * Move the current bucket to the first non-empty one, moving the events
+   * from the overflow when needed, and make it a heap. Called only when
+   * an event is removed.
+   */
+  void Advance (void);
+  /**
+   * \param [in] ts The timestamp.
+   * \return true if the timestamp is in the wheel horizon.
+   */
+  inline bool InWheel (uint64_t ts) const;
+  /**
+   * \param [in] ts The timestamp.
+   * \return The bucket of the timestamp.
+   */
+  inline uint32_t Bucket (uint64_t ts) const;
+
+  /** Bucket type: a vector of events. */
+  typedef std::vector<Scheduler::Event> Slot;
+  /** Overflow type: the events sorted by key. */
+  typedef std::map<Scheduler::EventKey, EventImpl *> Overflow;
+
+  Time m_slotWidthTime;            //!< Duration of a bucket (attribute)
+  uint32_t m_numSlotsAttr;         //!< Requested number of buckets (attribute)
+
+  std::vector<Slot> m_slots;       //!< The buckets of the wheel
+  uint64_t m_width;                //!< Duration of a bucket, in time steps
+  uint32_t m_mask;                 //!< Number of buckets minus one
+  uint64_t m_base;                 //!< Start time of the current bucket
+  uint32_t m_current;              //!< Index of the current bucket
+  bool m_heap;                     //!< The current bucket is a heap
+  uint32_t m_wheelSize;            //!< Number of events in the wheel
+  Overflow m_overflow;             //!< Events after the horizon
+};
+
+} // namespace ns3
+
+#endif /* TIMING_WHEEL_SCHEDULER_H */
@@ -832,6 +832,138 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test for the batched trace connections: Config::ConnectMany must
+ * connect the same trace sources, with the same contexts, as a
+ * Config::Connect call for each path.
+ */
+class ConnectManyConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ConnectManyConfigTestCase ();
+  /** Destructor. */
+  virtual ~ConnectManyConfigTestCase ()
+  {}
+
+  /**
+   * Trace callback of the batched connections.
+   * \param path The context path.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceMany (std::string path, [[maybe_unused]] int16_t old, [[maybe_unused]] int16_t newValue)
+  {
+    m_many.push_back (path);
+  }
+  /**
+   * Trace callback of the single connections.
+   * \param path The context path.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceSingle (std::string path, [[maybe_unused]] int16_t old, [[maybe_unused]] int16_t newValue)
+  {
+    m_single.push_back (path);
+  }
+  /**
+   * Trace callback without context.
+   * \param oldValue The old value.
+   * \param newValue The new value.
+   */
+  void Trace ([[maybe_unused]] int16_t oldValue, int16_t newValue)
+  {
+    m_newValue = newValue;
+  }
+
+private:
+  virtual void DoRun (void);
+
+  std::vector<std::string> m_many;   //!< Contexts of the batched connections
+  std::vector<std::string> m_single; //!< Contexts of the single connections
+  int16_t m_newValue;                //!< Value of the trace without context
+};
+
+ConnectManyConfigTestCase::ConnectManyConfigTestCase ()
+  : TestCase ("Check that the batched trace connections match the single ones")
+{}
+
+void
+ConnectManyConfigTestCase::DoRun (void)
+{
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeA (a);
+  Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject> ();
+  a->SetNodeB (b);
+
+  // Four objects under /NodeA/NodeB/NodesB, each one with some objects
+  // under NodesA
+  std::vector<Ptr<ConfigTestObject> > objects;
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      Ptr<ConfigTestObject> obj = CreateObject<ConfigTestObject> ();
+      b->AddNodeB (obj);
+      objects.push_back (obj);
+      for (uint32_t j = 0; j < i % 3; ++j)
+        {
+          Ptr<ConfigTestObject> child = CreateObject<ConfigTestObject> ();
+          obj->AddNodeA (child);
+          objects.push_back (child);
+        }
+    }
+
+  // Paths sharing their leading parts, in an order that uses both the
+  // cached paths and their leading parts
+  std::vector<std::string> paths = {
+    "/NodeA/NodeB/NodesB/*/Source",
+    "/NodeA/NodeB/NodesB/2/Source",
+    "/NodeA/NodeB/NodesB/*/NodesA/*/Source",
+    "/NodeA/NodeB/NodesB/[0-1]|3/Source",
+    "/NodeA/NodeB/NodesB/*/NodesA/1/Source",
+    "/NodeA/NodeB/NodesB/*/Source",
+    "/NodeA/Source",
+  };
+  Config::ConnectionList connections;
+  for (const auto &path : paths)
+    {
+      connections.push_back (std::make_pair (path, MakeCallback (&ConnectManyConfigTestCase::TraceMany, this)));
+      Config::Connect (path, MakeCallback (&ConnectManyConfigTestCase::TraceSingle, this));
+    }
+  Config::ConnectMany (connections);
+
+  int16_t value = 0;
+  for (auto &obj : objects)
+    {
+      obj->SetAttribute ("Source", IntegerValue (++value));
+    }
+  a->SetAttribute ("Source", IntegerValue (++value));
+
+  NS_TEST_ASSERT_MSG_EQ (m_single.size (), 4 + 1 + 3 + 3 + 1 + 4 + 1, "Wrong number of single connections");
+  NS_TEST_ASSERT_MSG_EQ (m_many.size (), m_single.size (), "Wrong number of batched connections");
+  for (std::size_t i = 0; i < m_single.size () && i < m_many.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_many[i], m_single[i], "Wrong context of the batched connection " << i);
+    }
+
+  // A path that does not match is reported, without stopping the others
+  Config::ConnectionList failSafe;
+  failSafe.push_back (std::make_pair ("/NodeA/NodeB/Missing/Source",
+                                      MakeCallback (&ConnectManyConfigTestCase::Trace, this)));
+  failSafe.push_back (std::make_pair ("/NodeA/NodeB/NodesB/3/Source",
+                                      MakeCallback (&ConnectManyConfigTestCase::Trace, this)));
+  NS_TEST_ASSERT_MSG_EQ (Config::ConnectWithoutContextManyFailSafe (failSafe), false,
+                         "The missing path was not reported");
+  m_newValue = 0;
+  // The last object is /NodeA/NodeB/NodesB/3
+  objects.back ()->SetAttribute ("Source", IntegerValue (-1));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -1, "The trace without context did not fire");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -850,6 +982,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new ConnectManyConfigTestCase);
 }
 
 /**
@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/test.h"
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+#include "ns3/ptr.h"
+#include "ns3/size-class-pool.h"
+
+#include <array>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup core-tests
+ * EventImpl allocation test suite
+ */
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief Check that the events of different sizes keep their arguments
+ * when their memory is reused, also when they are released by another
+ * thread, and that the released memory is reused.
+ */
+class EventImplPoolTestCase : public TestCase
+{
+public:
+  EventImplPoolTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Event with a small argument.
+   * \param value The argument.
+   */
+  void Small (uint32_t value);
+  /**
+   * Event with a large argument, larger than the size classes.
+   * \param values The argument.
+   */
+  void Large (std::array<uint64_t, 64> values);
+  /**
+   * Create the events.
+   * \param first The value of the first event.
+   * \return The events.
+   */
+  std::vector<Ptr<EventImpl> > CreateEvents (uint32_t first);
+
+  uint64_t m_sum {0}; //!< Sum of the arguments of the invoked events
+};
+
+EventImplPoolTestCase::EventImplPoolTestCase ()
+  : TestCase ("Check the pooled allocation of the events")
+{}
+
+void
+EventImplPoolTestCase::Small (uint32_t value)
+{
+  m_sum += value;
+}
+
+void
+EventImplPoolTestCase::Large (std::array<uint64_t, 64> values)
+{
+  for (auto v : values)
+    {
+      m_sum += v;
+    }
+}
+
+std::vector<Ptr<EventImpl> >
+EventImplPoolTestCase::CreateEvents (uint32_t first)
+{
+  std::vector<Ptr<EventImpl> > events;
+  for (uint32_t i = 0; i < 100; ++i)
+    {
+      events.push_back (Ptr<EventImpl> (MakeEvent (&EventImplPoolTestCase::Small, this, first + i), false));
+    }
+  std::array<uint64_t, 64> values;
+  values.fill (1);
+  events.push_back (Ptr<EventImpl> (MakeEvent (&EventImplPoolTestCase::Large, this, values), false));
+  return events;
+}
+
+void
+EventImplPoolTestCase::DoRun (void)
+{
+  EventImpl::AllocationStats before = EventImpl::GetAllocationStats ();
+
+  // The second round reuses the memory of the first one
+  for (uint32_t round = 0; round < 2; ++round)
+    {
+      m_sum = 0;
+      auto events = CreateEvents (1000 * round);
+      for (auto &ev : events)
+        {
+          ev->Invoke ();
+        }
+      uint64_t expected = 100 * 1000 * round + 99 * 100 / 2 + 64;
+      NS_TEST_ASSERT_MSG_EQ (m_sum, expected, "Wrong arguments in round " << round);
+    }
+
+  EventImpl::AllocationStats after = EventImpl::GetAllocationStats ();
+#ifndef __SANITIZE_ADDRESS__
+  NS_TEST_ASSERT_MSG_EQ (after.allocations - before.allocations, 202, "Wrong number of allocations");
+  NS_TEST_ASSERT_MSG_EQ (after.largeAllocations - before.largeAllocations, 2, "Wrong number of large allocations");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (after.poolHits - before.poolHits, 100, "The memory was not reused");
+  NS_TEST_ASSERT_MSG_EQ (after.deallocations - before.deallocations, 202, "Wrong number of deallocations");
+#endif
+
+  // Events created by a thread and released by this one
+  std::vector<Ptr<EventImpl> > events;
+  std::thread other ([&events, this] ()
+                     {
+                       events = CreateEvents (5000);
+                     });
+  other.join ();
+  m_sum = 0;
+  for (auto &ev : events)
+    {
+      ev->Invoke ();
+    }
+  events.clear ();
+  NS_TEST_ASSERT_MSG_EQ (m_sum, 100 * 5000 + 99 * 100 / 2 + 64, "Wrong arguments of the other thread");
+
+  EventImpl::AllocationStats last = EventImpl::GetAllocationStats ();
+#ifndef __SANITIZE_ADDRESS__
+  // The counters of the exited thread are included
+  NS_TEST_ASSERT_MSG_EQ (last.allocations - after.allocations, 101, "Wrong number of allocations");
+  NS_TEST_ASSERT_MSG_EQ (last.deallocations - after.deallocations, 101, "Wrong number of deallocations");
+#endif
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief Check that a SizeClassPool keeps at most MAX_CACHED blocks per
+ * size class, and that the counters of the threads that exit are kept.
+ */
+class SizeClassPoolCapTestCase : public TestCase
+{
+public:
+  SizeClassPoolCapTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /** The pool of this test. */
+  typedef SizeClassPool<SizeClassPoolCapTestCase> Pool;
+};
+
+SizeClassPoolCapTestCase::SizeClassPoolCapTestCase ()
+  : TestCase ("Check the cap of the free lists and the threads that exit")
+{}
+
+void
+SizeClassPoolCapTestCase::DoRun (void)
+{
+  const uint32_t burst = Pool::MAX_CACHED + 100;
+  Pool::Stats before = Pool::GetStats ();
+
+  // A burst of allocations of the same size class
+  std::vector<void *> blocks;
+  for (uint32_t i = 0; i < burst; ++i)
+    {
+      blocks.push_back (Pool::Allocate (24));
+    }
+  for (void *block : blocks)
+    {
+      Pool::Deallocate (block, 24);
+    }
+
+  Pool::Stats after = Pool::GetStats ();
+#ifndef __SANITIZE_ADDRESS__
+  NS_TEST_ASSERT_MSG_EQ (after.allocations - before.allocations, burst, "Wrong number of allocations");
+  NS_TEST_ASSERT_MSG_EQ (after.deallocations - before.deallocations, burst, "Wrong number of deallocations");
+  NS_TEST_ASSERT_MSG_EQ (after.cachedBlocks, Pool::MAX_CACHED, "The free list is not capped");
+#endif
+
+  // Blocks of another thread, which releases its free lists when it exits
+  std::thread other ([] ()
+                     {
+                       std::vector<void *> otherBlocks;
+                       for (uint32_t i = 0; i < 10; ++i)
+                         {
+                           otherBlocks.push_back (Pool::Allocate (100));
+                         }
+                       for (void *block : otherBlocks)
+                         {
+                           Pool::Deallocate (block, 100);
+                         }
+                     });
+  other.join ();
+
+  Pool::Stats last = Pool::GetStats ();
+#ifndef __SANITIZE_ADDRESS__
+  NS_TEST_ASSERT_MSG_EQ (last.allocations - after.allocations, 10, "Wrong number of allocations of the exited thread");
+  NS_TEST_ASSERT_MSG_EQ (last.deallocations - after.deallocations, 10, "Wrong number of deallocations of the exited thread");
+  NS_TEST_ASSERT_MSG_EQ (last.cachedBlocks, Pool::MAX_CACHED, "The blocks of the exited thread are cached");
+#endif
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief The EventImpl allocation TestSuite.
+ */
+class EventImplPoolTestSuite : public TestSuite
+{
+public:
+  EventImplPoolTestSuite ()
+    : TestSuite ("event-impl-pool")
+  {
+    AddTestCase (new EventImplPoolTestCase (), TestCase::QUICK);
+    AddTestCase (new SizeClassPoolCapTestCase (), TestCase::QUICK);
+  }
+};
+
+/// Static variable for test initialization.
+static EventImplPoolTestSuite g_eventImplPoolTestSuite;
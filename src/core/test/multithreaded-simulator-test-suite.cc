@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
+
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup core-tests
+ * MultithreadedSimulatorImpl test suite
+ */
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief Check that the MultithreadedSimulatorImpl runs the same events, at
+ * the same times and with the same contexts, of the DefaultSimulatorImpl.
+ *
+ * Every context runs a periodic event, and sometimes sends an event to the
+ * next context with a delay equal to the lookahead. Each context has its own
+ * partition, and records the events it runs.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param threads The maximum number of threads.
+   * \param parallelStart The time at which the parallel phase starts.
+   */
+  MultithreadedSimulatorTestCase (uint32_t threads, Time parallelStart);
+
+private:
+  virtual void DoRun (void);
+
+  /** A record of an event: timestamp, context and kind of event. */
+  typedef std::pair<uint64_t, uint32_t> Record;
+
+  /**
+   * Run the scenario with a simulator implementation
+   * \param simulatorType The simulator type.
+   * \return the records of each context
+   */
+  std::vector<std::vector<Record> > RunScenario (const std::string &simulatorType);
+  /**
+   * Periodic event of a context
+   * \param iteration The number of the event.
+   */
+  void Tick (uint32_t iteration);
+  /**
+   * Event sent by another context
+   * \param from The context that sent the event.
+   */
+  void Receive (uint32_t from);
+
+  static const uint32_t N_CONTEXTS = 4;     //!< Number of contexts
+  static const uint32_t N_TICKS = 200;      //!< Periodic events of each context
+
+  uint32_t m_threads;                       //!< Maximum number of threads
+  Time m_parallelStart;                     //!< Start of the parallel phase
+  Time m_lookahead;                         //!< Lookahead
+  std::vector<std::vector<Record> > m_records; //!< Records of each context
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase (uint32_t threads, Time parallelStart)
+  : TestCase ("Check the multithreaded simulator with " + std::to_string (threads) +
+              " threads, parallel from " + std::to_string (parallelStart.GetMilliSeconds ()) + " ms"),
+    m_threads (threads),
+    m_parallelStart (parallelStart),
+    m_lookahead (MicroSeconds (500))
+{
+}
+
+void
+MultithreadedSimulatorTestCase::Tick (uint32_t iteration)
+{
+  uint32_t context = Simulator::GetContext ();
+  m_records.at (context).push_back (std::make_pair (Simulator::Now ().GetTimeStep (), iteration));
+
+  if (iteration % 3 == 0)
+    {
+      uint32_t to = (context + 1) % N_CONTEXTS;
+      // The offset avoids ties with the periodic events, whose order
+      // would depend on the uids
+      Simulator::ScheduleWithContext (to, m_lookahead + NanoSeconds (7),
+                                      &MultithreadedSimulatorTestCase::Receive, this, context);
+    }
+  if (iteration + 1 < N_TICKS)
+    {
+      // Contexts with different periods, so that the partitions drift
+      Simulator::Schedule (MicroSeconds (100 * (context + 1)),
+                           &MultithreadedSimulatorTestCase::Tick, this, iteration + 1);
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::Receive (uint32_t from)
+{
+  uint32_t context = Simulator::GetContext ();
+  m_records.at (context).push_back (std::make_pair (Simulator::Now ().GetTimeStep (), 1000 + from));
+}
+
+std::vector<std::vector<MultithreadedSimulatorTestCase::Record> >
+MultithreadedSimulatorTestCase::RunScenario (const std::string &simulatorType)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (simulatorType));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (m_lookahead));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ParallelStartTime", TimeValue (m_parallelStart));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (m_threads));
+
+  m_records.assign (N_CONTEXTS, std::vector<Record> ());
+  for (uint32_t context = 0; context < N_CONTEXTS; ++context)
+    {
+      Simulator::ScheduleWithContext (context, MicroSeconds (context),
+                                      &MultithreadedSimulatorTestCase::Tick, this, 0);
+    }
+
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl != nullptr)
+    {
+      for (uint32_t context = 0; context < N_CONTEXTS; ++context)
+        {
+          impl->SetPartition (context, context);
+        }
+    }
+
+  Simulator::Stop (MilliSeconds (50));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (50), "Wrong time after Simulator::Stop");
+  Simulator::Destroy ();
+
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  return m_records;
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun (void)
+{
+  auto expected = RunScenario ("ns3::DefaultSimulatorImpl");
+  auto records = RunScenario ("ns3::MultithreadedSimulatorImpl");
+
+  for (uint32_t context = 0; context < N_CONTEXTS; ++context)
+    {
+      NS_TEST_ASSERT_MSG_GT (expected.at (context).size (), N_TICKS / 4,
+                             "Too few events in context " << context);
+      NS_TEST_ASSERT_MSG_EQ (records.at (context).size (), expected.at (context).size (),
+                             "Wrong number of events in context " << context);
+      for (uint32_t i = 0; i < expected.at (context).size (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (records.at (context).at (i).first, expected.at (context).at (i).first,
+                                 "Wrong time of event " << i << " in context " << context);
+          NS_TEST_ASSERT_MSG_EQ (records.at (context).at (i).second, expected.at (context).at (i).second,
+                                 "Wrong event " << i << " in context " << context);
+        }
+    }
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief The MultithreadedSimulatorImpl TestSuite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ()
+    : TestSuite ("multithreaded-simulator")
+  {
+    AddTestCase (new MultithreadedSimulatorTestCase (1, Seconds (0)), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorTestCase (4, Seconds (0)), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorTestCase (4, MilliSeconds (10)), TestCase::QUICK);
+  }
+};
+
+/// Static variable for test initialization.
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite;
@@ -24,6 +24,13 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/timing-wheel-scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
+
+#include <cstdlib>
+#include <vector>
 
 using namespace ns3;
 
@@ -531,6 +538,168 @@ SimulatorTemplateTestCase::DoRun (void)
 }
 
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that the TimingWheelScheduler returns the events in the same
+ * order of the MapScheduler, with events in the wheel and in the overflow,
+ * removals, and insertions before the current bucket.
+ */
+class TimingWheelSchedulerTestCase : public TestCase
+{
+public:
+  TimingWheelSchedulerTestCase ();
+  virtual void DoRun (void);
+};
+
+TimingWheelSchedulerTestCase::TimingWheelSchedulerTestCase ()
+  : TestCase ("Check the order of the events of the TimingWheelScheduler")
+{}
+
+void
+TimingWheelSchedulerTestCase::DoRun (void)
+{
+  ObjectFactory factory ("ns3::TimingWheelScheduler");
+  factory.Set ("SlotWidth", TimeValue (TimeStep (10)));
+  factory.Set ("NumSlots", UintegerValue (60));  // rounded up to 64
+  Ptr<Scheduler> wheel = factory.Create<Scheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+
+  std::srand (1);
+  std::vector<Scheduler::Event> pending;
+  uint64_t now = 5000;
+  uint32_t uid = 0;
+  auto insert = [&] (uint64_t ts)
+    {
+      Scheduler::Event ev;
+      ev.impl = nullptr;
+      ev.key.m_ts = ts;
+      ev.key.m_uid = uid++;
+      ev.key.m_context = 0;
+      wheel->Insert (ev);
+      reference->Insert (ev);
+      pending.push_back (ev);
+    };
+
+  // Out of order insertions before the start, some before the first one
+  for (uint32_t i = 0; i < 200; ++i)
+    {
+      insert (now + std::rand () % 3000 - 1500);
+    }
+
+  for (uint32_t step = 0; step < 20000; ++step)
+    {
+      int op = std::rand () % 10;
+      if (op < 4)
+        {
+          // near events, ties included, and far ones
+          uint64_t delay = (op == 0) ? std::rand () % 5000 : std::rand () % 200;
+          insert (now + delay);
+        }
+      else if (op < 5 && !pending.empty ())
+        {
+          std::size_t i = std::rand () % pending.size ();
+          wheel->Remove (pending[i]);
+          reference->Remove (pending[i]);
+          pending[i] = pending.back ();
+          pending.pop_back ();
+        }
+      else if (!reference->IsEmpty ())
+        {
+          NS_TEST_ASSERT_MSG_EQ (wheel->IsEmpty (), false, "The wheel should not be empty");
+          Scheduler::Event expected = reference->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (wheel->PeekNext ().key.m_uid, expected.key.m_uid, "Wrong next event");
+          Scheduler::Event ev = wheel->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_ts, expected.key.m_ts, "Wrong timestamp");
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.key.m_uid, "Wrong event");
+          now = ev.key.m_ts;
+          for (std::size_t i = 0; i < pending.size (); ++i)
+            {
+              if (pending[i].key.m_uid == ev.key.m_uid)
+                {
+                  pending[i] = pending.back ();
+                  pending.pop_back ();
+                  break;
+                }
+            }
+        }
+    }
+
+  while (!reference->IsEmpty ())
+    {
+      Scheduler::Event expected = reference->RemoveNext ();
+      Scheduler::Event ev = wheel->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.key.m_uid, "Wrong event");
+    }
+  NS_TEST_ASSERT_MSG_EQ (wheel->IsEmpty (), true, "The wheel should be empty");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the order of the events of the TimingWheelScheduler with a
+ * small population, half of the events scheduled with a zero delay and
+ * the others far apart, as with the ScheduleNow calls of a simulation
+ * with few pending events.
+ */
+class TimingWheelSchedulerNowTestCase : public TestCase
+{
+public:
+  TimingWheelSchedulerNowTestCase ();
+  virtual void DoRun (void);
+};
+
+TimingWheelSchedulerNowTestCase::TimingWheelSchedulerNowTestCase ()
+  : TestCase ("Check the order of the events of the TimingWheelScheduler with zero delays")
+{}
+
+void
+TimingWheelSchedulerNowTestCase::DoRun (void)
+{
+  Ptr<Scheduler> wheel = CreateObject<TimingWheelScheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+
+  std::srand (2);
+  uint64_t now = 0;
+  uint32_t uid = 0;
+  auto insert = [&] (uint64_t ts)
+    {
+      Scheduler::Event ev;
+      ev.impl = nullptr;
+      ev.key.m_ts = ts;
+      ev.key.m_uid = uid++;
+      ev.key.m_context = 0;
+      wheel->Insert (ev);
+      reference->Insert (ev);
+    };
+
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      insert (std::rand () % 1000000);
+    }
+
+  // Each event schedules one more, now or between 10 us and 1 ms later
+  for (uint32_t step = 0; step < 20000; ++step)
+    {
+      Scheduler::Event expected = reference->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (wheel->PeekNext ().key.m_uid, expected.key.m_uid, "Wrong next event");
+      Scheduler::Event ev = wheel->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (ev.key.m_ts, expected.key.m_ts, "Wrong timestamp");
+      NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.key.m_uid, "Wrong event");
+      now = ev.key.m_ts;
+      uint64_t delay = (std::rand () % 2 == 0) ? 0 : 10000 + std::rand () % 990000;
+      insert (now + delay);
+    }
+
+  while (!reference->IsEmpty ())
+    {
+      Scheduler::Event expected = reference->RemoveNext ();
+      Scheduler::Event ev = wheel->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.key.m_uid, "Wrong event");
+    }
+  NS_TEST_ASSERT_MSG_EQ (wheel->IsEmpty (), true, "The wheel should be empty");
+}
+
 /**
  * \ingroup simulator-tests
  *  
@@ -554,6 +723,10 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (TimingWheelScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new TimingWheelSchedulerTestCase (), TestCase::QUICK);
+    AddTestCase (new TimingWheelSchedulerNowTestCase (), TestCase::QUICK);
   }
 };
 
@@ -38,6 +38,8 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 
+#include <algorithm>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
@@ -55,6 +57,8 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
 
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
+
+  Compile ();
 }
 
 void
@@ -62,6 +66,193 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+
+  Compile ();
+}
+
+const EpcTftClassifier::FilterSet &
+EpcTftClassifier::PortTable::Lookup (uint16_t port) const
+{
+  // the first interval always starts at port 0
+  std::vector<uint16_t>::const_iterator it = std::upper_bound (intervalStart.begin (),
+                                                                intervalStart.end (),
+                                                                port);
+  return filters.at (std::distance (intervalStart.begin (), it) - 1);
+}
+
+template <class ADDRESS, class HASH>
+const EpcTftClassifier::FilterSet &
+EpcTftClassifier::AddressTable<ADDRESS, HASH>::Lookup (const ADDRESS &address) const
+{
+  typename std::unordered_map<ADDRESS, FilterSet, HASH>::const_iterator it = exact.find (address);
+  return it != exact.end () ? it->second : masked;
+}
+
+void
+EpcTftClassifier::Compile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // rank the filters in the order in which they have to be evaluated.
+  // We use a reverse iterator since filter priority is not implemented properly.
+  // This way, since the default bearer is expected to be added first, it will be evaluated last.
+  m_filters.clear ();
+  for (std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
+    {
+      for (const EpcTft::PacketFilter &f : it->second->GetPacketFilters ())
+        {
+          m_filters.push_back ({f, it->first});
+        }
+    }
+  NS_LOG_LOGIC ("compiling " << m_filters.size () << " filters of " << m_tftMap.size () << " TFTs");
+
+  const FilterSet empty ((m_filters.size () + 63) / 64, 0);
+
+  m_downlinkFilters = empty;
+  m_uplinkFilters = empty;
+  m_remoteIpv4 = {};
+  m_remoteIpv4.masked = empty;
+  m_localIpv4 = {};
+  m_localIpv4.masked = empty;
+  m_remoteIpv6 = {};
+  m_remoteIpv6.masked = empty;
+  m_localIpv6 = {};
+  m_localIpv6.masked = empty;
+
+  auto set = [] (FilterSet &filters, size_t rank)
+    {
+      filters[rank / 64] |= (1ULL << (rank % 64));
+    };
+
+  // address tables: first the filters with a masked address, which are
+  // also part of every exact entry, then the exact addresses
+  for (size_t rank = 0; rank < m_filters.size (); ++rank)
+    {
+      const EpcTft::PacketFilter &f = m_filters[rank].filter;
+      if (f.direction & EpcTft::DOWNLINK)
+        {
+          set (m_downlinkFilters, rank);
+        }
+      if (f.direction & EpcTft::UPLINK)
+        {
+          set (m_uplinkFilters, rank);
+        }
+      if (f.remoteMask != Ipv4Mask::GetOnes ())
+        {
+          set (m_remoteIpv4.masked, rank);
+        }
+      if (f.localMask != Ipv4Mask::GetOnes ())
+        {
+          set (m_localIpv4.masked, rank);
+        }
+      if (f.remoteIpv6Prefix.GetPrefixLength () != 128)
+        {
+          set (m_remoteIpv6.masked, rank);
+        }
+      if (f.localIpv6Prefix.GetPrefixLength () != 128)
+        {
+          set (m_localIpv6.masked, rank);
+        }
+    }
+  for (size_t rank = 0; rank < m_filters.size (); ++rank)
+    {
+      const EpcTft::PacketFilter &f = m_filters[rank].filter;
+      if (f.remoteMask == Ipv4Mask::GetOnes ())
+        {
+          set (m_remoteIpv4.exact.emplace (f.remoteAddress, m_remoteIpv4.masked).first->second, rank);
+        }
+      if (f.localMask == Ipv4Mask::GetOnes ())
+        {
+          set (m_localIpv4.exact.emplace (f.localAddress, m_localIpv4.masked).first->second, rank);
+        }
+      if (f.remoteIpv6Prefix.GetPrefixLength () == 128)
+        {
+          set (m_remoteIpv6.exact.emplace (f.remoteIpv6Address, m_remoteIpv6.masked).first->second, rank);
+        }
+      if (f.localIpv6Prefix.GetPrefixLength () == 128)
+        {
+          set (m_localIpv6.exact.emplace (f.localIpv6Address, m_localIpv6.masked).first->second, rank);
+        }
+    }
+
+  // port tables: the port ranges of all the filters split the port space
+  // into elementary intervals, each one matched by a fixed set of filters
+  auto buildPortTable = [this, &empty, &set] (PortTable &table, bool remote)
+    {
+      std::vector<uint16_t> &starts = table.intervalStart;
+      starts.assign (1, 0);
+      for (const CompiledFilter &cf : m_filters)
+        {
+          uint16_t start = remote ? cf.filter.remotePortStart : cf.filter.localPortStart;
+          uint16_t end = remote ? cf.filter.remotePortEnd : cf.filter.localPortEnd;
+          starts.push_back (start);
+          if (end < 65535)
+            {
+              starts.push_back (end + 1);
+            }
+        }
+      std::sort (starts.begin (), starts.end ());
+      starts.erase (std::unique (starts.begin (), starts.end ()), starts.end ());
+
+      table.filters.assign (starts.size (), empty);
+      for (size_t i = 0; i < starts.size (); ++i)
+        {
+          for (size_t rank = 0; rank < m_filters.size (); ++rank)
+            {
+              const EpcTft::PacketFilter &f = m_filters[rank].filter;
+              uint16_t start = remote ? f.remotePortStart : f.localPortStart;
+              uint16_t end = remote ? f.remotePortEnd : f.localPortEnd;
+              if (start <= starts[i] && starts[i] <= end)
+                {
+                  set (table.filters[i], rank);
+                }
+            }
+        }
+    };
+  buildPortTable (m_remotePorts, true);
+  buildPortTable (m_localPorts, false);
+}
+
+template <class ADDRESS, class HASH>
+uint32_t
+EpcTftClassifier::Lookup (const AddressTable<ADDRESS, HASH> &remote,
+                          const AddressTable<ADDRESS, HASH> &local,
+                          EpcTft::Direction d, ADDRESS ra, ADDRESS la,
+                          uint16_t rp, uint16_t lp, uint8_t tos)
+{
+  if (m_filters.empty ())
+    {
+      NS_LOG_LOGIC ("no filters");
+      return 0;
+    }
+
+  const FilterSet &direction = (d == EpcTft::DOWNLINK) ? m_downlinkFilters : m_uplinkFilters;
+  const FilterSet &remoteAddress = remote.Lookup (ra);
+  const FilterSet &localAddress = local.Lookup (la);
+  const FilterSet &remotePort = m_remotePorts.Lookup (rp);
+  const FilterSet &localPort = m_localPorts.Lookup (lp);
+
+  for (size_t w = 0; w < direction.size (); ++w)
+    {
+      uint64_t candidates = direction[w] & remoteAddress[w] & localAddress[w] &
+        remotePort[w] & localPort[w];
+      while (candidates != 0)
+        {
+          size_t rank = w * 64 + __builtin_ctzll (candidates);
+          candidates &= candidates - 1;
+          CompiledFilter &cf = m_filters[rank];
+          NS_LOG_LOGIC ("candidate filter " << rank << " of TFT id: " << cf.tftId);
+          // the sets only pre-select the filters: masked addresses and
+          // the type of service are checked here
+          if (cf.filter.Matches (d, ra, la, rp, lp, tos))
+            {
+              NS_LOG_LOGIC ("matches with TFT ID = " << cf.tftId);
+              return cf.tftId; // the id of the matching TFT
+            }
+        }
+    }
+  NS_LOG_LOGIC ("no match");
+  return 0;  // no match
 }
 
 uint32_t 
@@ -268,22 +459,8 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
           << " tos=0x" << (uint16_t) tos );
 
       // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
-
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-        {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv4, localAddressIpv4, remotePort, localPort, tos))
-            {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
-            }
-        }
+      return Lookup (m_remoteIpv4, m_localIpv4, direction,
+                     remoteAddressIpv4, localAddressIpv4, remotePort, localPort, tos);
     }
   else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
     {
@@ -295,22 +472,8 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
           << " tos=0x" << (uint16_t) tos );
 
       // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
-
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-        {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv6, localAddressIpv6, remotePort, localPort, tos))
-            {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
-            }
-        }
+      return Lookup (m_remoteIpv6, m_localIpv6, direction,
+                     remoteAddressIpv6, localAddressIpv6, remotePort, localPort, tos);
     }
   NS_LOG_LOGIC ("no match");
   return 0;  // no match
@@ -26,8 +26,12 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include "ns3/epc-tft.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 
 namespace ns3 {
@@ -50,6 +54,22 @@ class Packet;
  *
  * When we cannot cache the port info, the TFT of the default bearer is used. This may happen
  * if there is reordering or losses of IP packets.
+ *
+ * The packet filters of all the TFTs are compiled into a decision structure
+ * every time a TFT is added or deleted, instead of being evaluated one after
+ * the other for every packet. Each filter gets a rank in the order in which the
+ * filters would have been evaluated (TFTs in decreasing ID order, so that the
+ * default bearer is evaluated last), and for every packet field a set of
+ * candidate filters is looked up:
+ *  - direction: one set per direction;
+ *  - local and remote addresses: a hash table for the filters with an exact
+ *    (full mask / full prefix) address, plus a set for all the other filters;
+ *  - local and remote ports: a table of the elementary port intervals
+ *    delimited by the port ranges of all the filters, searched by bisection.
+ *
+ * The intersection of the sets is scanned in rank order, and the first filter
+ * that fully matches the packet determines the TFT. Therefore, the TFTs should
+ * not be modified after having been added to the classifier.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
 {
@@ -86,9 +106,86 @@ public:
   uint32_t Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t protocolNumber);
   
 protected:
-  
+  /**
+   * Set of packet filters, as a bitmap indexed by the filter rank
+   */
+  typedef std::vector<uint64_t> FilterSet;
+
+  /**
+   * A packet filter of a TFT, together with the ID of the TFT
+   */
+  struct CompiledFilter
+  {
+    EpcTft::PacketFilter filter; ///< the packet filter
+    uint32_t tftId;              ///< the ID of the TFT the filter belongs to
+  };
+
+  /**
+   * Table of the filters matching each port, built from the port ranges
+   * of all the filters
+   */
+  struct PortTable
+  {
+    std::vector<uint16_t> intervalStart; ///< first port of each elementary interval, sorted
+    std::vector<FilterSet> filters;      ///< filters whose port range includes each interval
+
+    /**
+     * \param port the port
+     * \return the filters whose port range includes the port
+     */
+    const FilterSet & Lookup (uint16_t port) const;
+  };
+
+  /**
+   * Table of the filters matching each address
+   */
+  template <class ADDRESS, class HASH>
+  struct AddressTable
+  {
+    std::unordered_map<ADDRESS, FilterSet, HASH> exact; ///< filters matching an exact address (and all the masked ones)
+    FilterSet masked;                                   ///< filters matching a masked address
+
+    /**
+     * \param address the address
+     * \return the filters possibly matching the address
+     */
+    const FilterSet & Lookup (const ADDRESS &address) const;
+  };
+
+  /**
+   * Rebuild the decision structure from the TFTs in m_tftMap
+   */
+  void Compile ();
+
+  /**
+   * Find the first compiled filter that matches all the parameters
+   *
+   * \param d the direction
+   * \param ra the remote address
+   * \param la the local address
+   * \param rp the remote port
+   * \param lp the local port
+   * \param tos the type of service
+   * \return the ID of the TFT of the matching filter, or 0 if no filter matched
+   */
+  template <class ADDRESS, class HASH>
+  uint32_t Lookup (const AddressTable<ADDRESS, HASH> &remote,
+                   const AddressTable<ADDRESS, HASH> &local,
+                   EpcTft::Direction d, ADDRESS ra, ADDRESS la,
+                   uint16_t rp, uint16_t lp, uint8_t tos);
+
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap; ///< TFT map
 
+  std::vector<CompiledFilter> m_filters; ///< the filters of all the TFTs, in rank order
+  FilterSet m_downlinkFilters;           ///< filters matching the downlink direction
+  FilterSet m_uplinkFilters;             ///< filters matching the uplink direction
+  PortTable m_remotePorts;               ///< filters matching each remote port
+  PortTable m_localPorts;                ///< filters matching each local port
+  AddressTable<Ipv4Address, Ipv4AddressHash> m_remoteIpv4; ///< filters matching each remote IPv4 address
+  AddressTable<Ipv4Address, Ipv4AddressHash> m_localIpv4;  ///< filters matching each local IPv4 address
+  AddressTable<Ipv6Address, Ipv6AddressHash> m_remoteIpv6; ///< filters matching each remote IPv6 address
+  AddressTable<Ipv6Address, Ipv6AddressHash> m_localIpv6;  ///< filters matching each local IPv6 address
+
   std::map < std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
              std::pair<uint32_t, uint32_t> >
       m_classifiedIpv4Fragments; ///< Map with already classified IPv4 Fragments
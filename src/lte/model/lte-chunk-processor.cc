@@ -24,6 +24,7 @@
 #include <ns3/log.h>
 #include <ns3/spectrum-value.h>
 #include "lte-chunk-processor.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -50,7 +51,12 @@ void
 LteChunkProcessor::Start ()
 {
   NS_LOG_FUNCTION (this);
-  m_sumValues = 0;
+  // the values of the previous reception are cleared, but their memory is
+  // reused if the spectrum model does not change
+  if (m_sumValues != 0)
+    {
+      std::fill (m_sumValues->ValuesBegin (), m_sumValues->ValuesEnd (), 0.0);
+    }
   m_totDuration = MicroSeconds (0);
 }
 
@@ -59,11 +65,19 @@ void
 LteChunkProcessor::EvaluateChunk (const SpectrumValue& sinr, Time duration)
 {
   NS_LOG_FUNCTION (this << sinr << duration);
-  if (m_sumValues == 0)
+  if (m_sumValues == 0 || m_sumValues->GetSpectrumModelUid () != sinr.GetSpectrumModelUid ())
     {
       m_sumValues = Create<SpectrumValue> (sinr.GetSpectrumModel ());
     }
-  (*m_sumValues) += sinr * duration.GetSeconds ();
+  // sum in place, without a temporary SpectrumValue for each chunk
+  double seconds = duration.GetSeconds ();
+  Values::iterator sum = m_sumValues->ValuesBegin ();
+  Values::const_iterator value = sinr.ConstValuesBegin ();
+  const size_t numBands = m_sumValues->GetValuesN ();
+  for (size_t i = 0; i < numBands; ++i)
+    {
+      sum[i] += value[i] * seconds;
+    }
   m_totDuration += duration;
 }
 
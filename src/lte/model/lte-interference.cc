@@ -31,9 +31,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("LteInterference");
 
 LteInterference::LteInterference ()
-  : m_receiving (false),
-    m_lastSignalId (0),
-    m_lastSignalIdBeforeReset (0)
+  : m_receiving (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -50,6 +48,7 @@ LteInterference::DoDispose ()
   m_rsPowerChunkProcessorList.clear ();
   m_sinrChunkProcessorList.clear ();
   m_interfChunkProcessorList.clear ();
+  m_pendingSignals = {};
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
@@ -75,6 +74,9 @@ LteInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
   if (m_receiving == false)
     {
       NS_LOG_LOGIC ("first signal");
+      // the interference of the first chunk must not include the signals
+      // that ended before now
+      SubtractExpiredSignals ();
       m_rxSignal = rxPsd->Copy ();
       m_lastChangeTime = Now ();
       m_receiving = true;
@@ -136,17 +138,7 @@ LteInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration)
 {
   NS_LOG_FUNCTION (this << *spd << duration);
   DoAddSignal (spd);
-  uint32_t signalId = ++m_lastSignalId;
-  if (signalId == m_lastSignalIdBeforeReset)
-    {
-      // This happens when m_lastSignalId eventually wraps around. Given that so
-      // many signals have elapsed since the last reset, we hope that by now there is
-      // no stale pending signal (i.e., a signal that was scheduled
-      // for subtraction before the reset). So we just move the
-      // boundary further.
-      m_lastSignalIdBeforeReset += 0x10000000;
-    }
-  Simulator::Schedule (duration, &LteInterference::DoSubtractSignal, this, spd, signalId);
+  m_pendingSignals.push ({Now () + duration, spd});
 }
 
 
@@ -159,18 +151,31 @@ LteInterference::DoAddSignal (Ptr<const SpectrumValue> spd)
 }
 
 void
-LteInterference::DoSubtractSignal (Ptr<const SpectrumValue> spd, uint32_t signalId)
-{ 
-  NS_LOG_FUNCTION (this << *spd);
-  ConditionallyEvaluateChunk ();   
-  int32_t deltaSignalId = signalId - m_lastSignalIdBeforeReset;
-  if (deltaSignalId > 0)
-    {   
-      (*m_allSignals) -= (*spd);
-    }
-  else
+LteInterference::SubtractExpiredSignals ()
+{
+  NS_LOG_FUNCTION (this);
+  Time now = Now ();
+  while (!m_pendingSignals.empty () && m_pendingSignals.top ().m_endTime <= now)
     {
-      NS_LOG_INFO ("ignoring signal scheduled for subtraction before last reset");
+      Time endTime = m_pendingSignals.top ().m_endTime;
+      // the chunk ending at endTime still contains the expiring signals
+      DoEvaluateChunk (endTime);
+      // subtract all the signals ending at the same time before the
+      // next chunk is evaluated
+      Values::iterator first = m_allSignals->ValuesBegin ();
+      size_t numBands = m_allSignals->GetValuesN ();
+      do
+        {
+          NS_LOG_LOGIC ("subtracting signal ended at " << endTime);
+          Values::const_iterator spd = m_pendingSignals.top ().m_spd->ConstValuesBegin ();
+          NS_ASSERT (m_pendingSignals.top ().m_spd->GetValuesN () == numBands);
+          for (size_t i = 0; i < numBands; ++i)
+            {
+              first[i] -= spd[i];
+            }
+          m_pendingSignals.pop ();
+        }
+      while (!m_pendingSignals.empty () && m_pendingSignals.top ().m_endTime == endTime);
     }
 }
 
@@ -179,19 +184,27 @@ void
 LteInterference::ConditionallyEvaluateChunk ()
 {
   NS_LOG_FUNCTION (this);
+  SubtractExpiredSignals ();
+  DoEvaluateChunk (Now ());
+}
+
+void
+LteInterference::DoEvaluateChunk (Time chunkEnd)
+{
+  NS_LOG_FUNCTION (this << chunkEnd);
   if (m_receiving)
     {
       NS_LOG_DEBUG (this << " Receiving");
     }
-  NS_LOG_DEBUG (this << " now "  << Now () << " last " << m_lastChangeTime);
-  if (m_receiving && (Now () > m_lastChangeTime))
+  NS_LOG_DEBUG (this << " chunk end "  << chunkEnd << " last " << m_lastChangeTime);
+  if (m_receiving && (chunkEnd > m_lastChangeTime))
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
 
       SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
 
       SpectrumValue sinr = (*m_rxSignal) / interf;
-      Time duration = Now () - m_lastChangeTime;
+      Time duration = chunkEnd - m_lastChangeTime;
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
         {
           (*it)->EvaluateChunk (sinr, duration);
@@ -204,7 +217,7 @@ LteInterference::ConditionallyEvaluateChunk ()
         {
           (*it)->EvaluateChunk (*m_rxSignal, duration);
         }
-      m_lastChangeTime = Now ();
+      m_lastChangeTime = chunkEnd;
     }
 }
 
@@ -222,9 +235,9 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
       // abort rx
       m_receiving = false;
     }
-  // record the last SignalId so that we can ignore all signals that
-  // were scheduled for subtraction before m_allSignal 
-  m_lastSignalIdBeforeReset = m_lastSignalId;
+  // the signals pending for subtraction are not part of the new
+  // m_allSignals, so forget them
+  m_pendingSignals = {};
 }
 
 void
@@ -28,6 +28,8 @@
 #include <ns3/spectrum-value.h>
 
 #include <list>
+#include <queue>
+#include <vector>
 
 namespace ns3 {
 
@@ -38,6 +40,13 @@ class LteChunkProcessor;
  * This class implements a gaussian interference model, i.e., all
  * incoming signals are added to the total interference.
  *
+ * Signals are not removed from the total interference by a dedicated
+ * simulator event. Instead, the end time of every signal is kept in a
+ * time-ordered queue, and the signals that have expired are subtracted
+ * lazily, in time order, whenever the aggregate is needed (i.e., at every
+ * chunk boundary). The result is the same as subtracting each signal
+ * exactly at its end time, without scheduling one event per signal.
+ *
  */
 class LteInterference : public Object
 {
@@ -112,9 +121,20 @@ public:
 
 protected:
   /**
-   * Conditionally evaluate chunk
+   * Subtract the expired signals from the total interference, and then
+   * evaluate the chunk that ends now
    */
   virtual void ConditionallyEvaluateChunk ();
+  /**
+   * \brief Evaluate the chunk that goes from the last change time until
+   * the provided time, if a RX attempt is ongoing.
+   *
+   * Called once for every boundary of the interference, i.e., at the end
+   * of every expired signal and at every change of the total interference.
+   *
+   * @param chunkEnd the end of the chunk to evaluate
+   */
+  virtual void DoEvaluateChunk (Time chunkEnd);
   /**
    * Add signal function
    *
@@ -122,12 +142,11 @@ protected:
    */
   virtual void DoAddSignal (Ptr<const SpectrumValue> spd);
   /**
-   * Subtract signal
-   *
-   * @param spd the power spectral density of the new signal
-   * @param signalId the signal ID
+   * \brief Subtract from the total interference all the signals that ended
+   * before or at the current time, evaluating the chunk that ends at
+   * each of their end times.
    */
-  virtual void DoSubtractSignal (Ptr<const SpectrumValue> spd, uint32_t signalId);
+  void SubtractExpiredSignals ();
 
   bool m_receiving {false}; ///< are we receiving?
 
@@ -147,8 +166,29 @@ protected:
                                        * m_TotalPower
                                        */
 
-  uint32_t m_lastSignalId {0}; ///< the last signal ID
-  uint32_t m_lastSignalIdBeforeReset {0}; ///< the last signal ID before reset
+  /**
+   * A signal that is part of m_allSignals, and that has to be subtracted
+   * from it once its end time is reached
+   */
+  struct PendingSignal
+  {
+    Time m_endTime;                  ///< the time at which the signal ends
+    Ptr<const SpectrumValue> m_spd;  ///< the power spectral density of the signal
+
+    /**
+     * \brief Compare the end time of two pending signals
+     * \param o the other pending signal
+     * \return true if this signal ends after o
+     */
+    bool operator > (const PendingSignal &o) const
+    {
+      return m_endTime > o.m_endTime;
+    }
+  };
+
+  /// the signals included in m_allSignals, ordered by end time (earliest first)
+  std::priority_queue<PendingSignal, std::vector<PendingSignal>,
+                      std::greater<PendingSignal> > m_pendingSignals;
 
   /** all the processor instances that need to be notified whenever
   a new interference chunk is calculated */
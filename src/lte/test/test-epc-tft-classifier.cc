@@ -33,7 +33,9 @@
 
 #include "ns3/epc-tft-classifier.h"
 
+#include <chrono>
 #include <iomanip>
+#include <random>
 
 using namespace ns3;
 
@@ -212,6 +214,184 @@ EpcTftClassifierTestCase::DoRun (void)
 
 
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Microbenchmark of the Tft Classifier. A classifier with the maximum
+ * number of TFTs, each one with many packet filters (exact and ranged ports,
+ * exact and masked addresses, type of service), classifies a large number of
+ * random UDP packets. Every classification is checked against a linear
+ * evaluation of the TFTs in decreasing ID order, and the time spent by both
+ * is logged.
+ */
+class EpcTftClassifierBenchmarkTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param numPackets the number of packets to classify
+   * \param useIpv6 use IPv6 or IPv4 addresses. If set, addresses will be used as IPv4 mapped addresses
+   */
+  EpcTftClassifierBenchmarkTestCase (uint32_t numPackets, bool useIpv6);
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_numPackets; ///< the number of packets to classify
+  bool m_useIpv6; ///< use IPv4 or IPv6 header/addresses
+};
+
+EpcTftClassifierBenchmarkTestCase::EpcTftClassifierBenchmarkTestCase (uint32_t numPackets,
+                                                                      bool useIpv6)
+  : TestCase (std::string ("TFT classifier benchmark, ") + (useIpv6 ? "IPv6" : "IPv4")),
+    m_numPackets (numPackets),
+    m_useIpv6 (useIpv6)
+{
+}
+
+void
+EpcTftClassifierBenchmarkTestCase::DoRun (void)
+{
+  std::mt19937 rng (42);
+  auto uniform = [&rng] (uint32_t min, uint32_t max)
+    {
+      return std::uniform_int_distribution<uint32_t> (min, max) (rng);
+    };
+  auto ipv6 = [] (Ipv4Address a)
+    {
+      return Ipv6Address::MakeIpv4MappedAddress (a);
+    };
+
+  // the default bearer, plus 15 dedicated bearers with 15 filters each
+  std::map<uint32_t, Ptr<EpcTft> > tfts;
+  tfts[1] = EpcTft::Default ();
+  for (uint32_t id = 2; id <= 16; ++id)
+    {
+      Ptr<EpcTft> tft = Create<EpcTft> ();
+      for (uint32_t i = 0; i < 15; ++i)
+        {
+          EpcTft::PacketFilter pf;
+          pf.direction = static_cast<EpcTft::Direction> (uniform (1, 3));
+          switch (uniform (0, 3))
+            {
+            case 0:
+              pf.localPortStart = pf.localPortEnd = uniform (1000, 1999);
+              break;
+            case 1:
+              pf.remotePortStart = uniform (2000, 2999);
+              pf.remotePortEnd = pf.remotePortStart + uniform (0, 50);
+              break;
+            case 2:
+              pf.remoteAddress = Ipv4Address (0x0a000000 + uniform (0, 255));
+              pf.remoteMask = Ipv4Mask::GetOnes ();
+              pf.remoteIpv6Address = ipv6 (pf.remoteAddress);
+              pf.remoteIpv6Prefix = Ipv6Prefix (128);
+              break;
+            default:
+              pf.localAddress = Ipv4Address (0x07000000 + (uniform (0, 3) << 8));
+              pf.localMask = Ipv4Mask (0xffffff00);
+              pf.localIpv6Address = ipv6 (pf.localAddress);
+              pf.localIpv6Prefix = Ipv6Prefix (96 + 24);
+              pf.typeOfService = uniform (0, 1) << 5;
+              pf.typeOfServiceMask = 0xe0;
+              break;
+            }
+          tft->Add (pf);
+        }
+      tfts[id] = tft;
+    }
+
+  Ptr<EpcTftClassifier> c = Create<EpcTftClassifier> ();
+  for (const auto &tft : tfts)
+    {
+      c->Add (tft.second, tft.first);
+    }
+
+  std::vector<Ptr<Packet> > packets;
+  std::vector<EpcTft::Direction> directions;
+  std::vector<uint32_t> expected;
+  std::chrono::steady_clock::duration referenceTime {0};
+  for (uint32_t n = 0; n < m_numPackets; ++n)
+    {
+      EpcTft::Direction d = uniform (0, 1) ? EpcTft::UPLINK : EpcTft::DOWNLINK;
+      Ipv4Address ueAddress (0x07000000 + (uniform (0, 7) << 8) + uniform (1, 254));
+      Ipv4Address remoteAddress (0x0a000000 + uniform (0, 511));
+      uint16_t uePort = uniform (0, 1) ? uniform (1000, 1999) : uniform (0, 65535);
+      uint16_t remotePort = uniform (0, 1) ? uniform (2000, 3049) : uniform (0, 65535);
+      uint8_t tos = uniform (0, 255);
+
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (d == EpcTft::UPLINK ? uePort : remotePort);
+      udpHeader.SetDestinationPort (d == EpcTft::UPLINK ? remotePort : uePort);
+      Ptr<Packet> p = Create<Packet> ();
+      p->AddHeader (udpHeader);
+      Ipv4Address sa = d == EpcTft::UPLINK ? ueAddress : remoteAddress;
+      Ipv4Address da = d == EpcTft::UPLINK ? remoteAddress : ueAddress;
+      if (m_useIpv6)
+        {
+          Ipv6Header ipv6Header;
+          ipv6Header.SetSource (ipv6 (sa));
+          ipv6Header.SetDestination (ipv6 (da));
+          ipv6Header.SetTrafficClass (tos);
+          ipv6Header.SetPayloadLength (8);
+          ipv6Header.SetNextHeader (UdpL4Protocol::PROT_NUMBER);
+          p->AddHeader (ipv6Header);
+        }
+      else
+        {
+          Ipv4Header ipHeader;
+          ipHeader.SetSource (sa);
+          ipHeader.SetDestination (da);
+          ipHeader.SetTos (tos);
+          ipHeader.SetPayloadSize (8);
+          ipHeader.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+          p->AddHeader (ipHeader);
+        }
+      packets.push_back (p);
+      directions.push_back (d);
+
+      // reference: evaluate the TFTs one after the other, the default one last
+      auto start = std::chrono::steady_clock::now ();
+      uint32_t id = 0;
+      for (auto it = tfts.rbegin (); it != tfts.rend () && id == 0; ++it)
+        {
+          bool matches = m_useIpv6 ?
+            it->second->Matches (d, ipv6 (remoteAddress), ipv6 (ueAddress), remotePort, uePort, tos) :
+            it->second->Matches (d, remoteAddress, ueAddress, remotePort, uePort, tos);
+          if (matches)
+            {
+              id = it->first;
+            }
+        }
+      referenceTime += std::chrono::steady_clock::now () - start;
+      expected.push_back (id);
+    }
+
+  uint16_t protocolNumber = m_useIpv6 ? Ipv6L3Protocol::PROT_NUMBER : Ipv4L3Protocol::PROT_NUMBER;
+  std::vector<uint32_t> obtained (m_numPackets);
+  auto start = std::chrono::steady_clock::now ();
+  for (uint32_t n = 0; n < m_numPackets; ++n)
+    {
+      obtained[n] = c->Classify (packets[n], directions[n], protocolNumber);
+    }
+  std::chrono::steady_clock::duration classifierTime = std::chrono::steady_clock::now () - start;
+
+  uint32_t dedicated = 0;
+  for (uint32_t n = 0; n < m_numPackets; ++n)
+    {
+      NS_TEST_ASSERT_MSG_EQ (obtained[n], expected[n], "bad classification of packet " << n);
+      dedicated += expected[n] > 1 ? 1 : 0;
+    }
+
+  typedef std::chrono::duration<double, std::micro> Microseconds;
+  NS_LOG_INFO (m_numPackets << " packets, " << dedicated << " on dedicated bearers: classifier "
+               << Microseconds (classifierTime).count () << " us (including header parsing),"
+               << " linear TFT evaluation " << Microseconds (referenceTime).count () << " us");
+}
+
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -429,5 +609,7 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite ()
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   "9.1.1.1", "8.1.1.1",  7895,       10,     0,    1, useIpv6), TestCase::QUICK);
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   "9.1.1.1", "8.1.1.1",     9,     5897,     0,    2, useIpv6), TestCase::QUICK);
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::DOWNLINK, "9.1.1.1", "8.1.1.1",  5897,       10,     0,    2, useIpv6), TestCase::QUICK);
+
+      AddTestCase (new EpcTftClassifierBenchmarkTestCase (10000, useIpv6), TestCase::QUICK);
     }
 }
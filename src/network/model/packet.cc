@@ -23,12 +23,13 @@
 #include "ns3/simulator.h"
 #include <string>
 #include <cstdarg>
+#include <vector>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+std::atomic<uint32_t> Packet::m_globalUid (0);
 
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
@@ -136,12 +137,11 @@ Packet::Packet ()
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, 0),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid++, 0),
     m_nixVector (0),
     m_periodicity(),
     m_deadline()
 {
-  m_globalUid++;
 }
 
 Packet::Packet (const Packet &o)
@@ -182,12 +182,11 @@ Packet::Packet (uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid++, size),
     m_nixVector (0),
     m_periodicity(),
     m_deadline()
 {
-  m_globalUid++;
 }
 Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
   : m_buffer (0, false),
@@ -212,12 +211,11 @@ Packet::Packet (uint8_t const*buffer, uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid++, size),
     m_nixVector (0),
     m_periodicity(),
     m_deadline()
 {
-  m_globalUid++;
   m_buffer.AddAtStart (size);
   Buffer::Iterator i = m_buffer.Begin ();
   i.Write (buffer, size);
@@ -1034,6 +1032,33 @@ std::ostream& operator<< (std::ostream& os, const Packet &packet)
   return os;
 }
 
+void
+EventArgumentCopy (Ptr<Packet> &packet)
+{
+  NS_LOG_FUNCTION (packet);
+  if (packet == 0)
+    {
+      return;
+    }
+  std::vector<uint8_t> buffer (packet->GetSerializedSize ());
+  uint32_t serialized = packet->Serialize (buffer.data (), buffer.size ());
+  NS_ASSERT (serialized == 1);
+  Ptr<Packet> copy = Create<Packet> (buffer.data (), buffer.size (), true);
+  copy->m_periodicity = packet->m_periodicity;
+  copy->m_deadline = packet->m_deadline;
+  packet = copy;
+}
+
+void
+EventArgumentCopy (Ptr<const Packet> &packet)
+{
+  NS_LOG_FUNCTION (packet);
+  Ptr<Packet> copy = ConstCast<Packet> (packet);
+  packet = 0;
+  EventArgumentCopy (copy);
+  packet = copy;
+}
+
 // Configured Grant
 Packet::Packet (uint32_t size, uint8_t periodicity, uint32_t deadline)
   : m_buffer (size),
@@ -1045,12 +1070,11 @@ Packet::Packet (uint32_t size, uint8_t periodicity, uint32_t deadline)
      * zero.  The lower 32 bits are for the
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid++, size),
     m_nixVector (0),
     m_periodicity(periodicity),
     m_deadline(deadline)
 {
-  m_globalUid++;
 }
 
 uint8_t
@@ -21,6 +21,7 @@
 #define PACKET_H
 
 #include <stdint.h>
+#include <atomic>
 #include "buffer.h"
 #include "header.h"
 #include "trailer.h"
@@ -786,6 +787,8 @@ private:
    */
   uint32_t Deserialize (uint8_t const*buffer, uint32_t size);
 
+  friend void EventArgumentCopy (Ptr<Packet> &packet);
+
   Buffer m_buffer;                //!< the packet buffer (it's actual contents)
   ByteTagList m_byteTagList;      //!< the ByteTag list
   PacketTagList m_packetTagList;  //!< the packet's Tag list
@@ -794,7 +797,12 @@ private:
   /* Please see comments above about nix-vector */
   mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  /**
+   * Global counter of packets Uid. It is atomic so that the packets can be
+   * created by the threads of a parallel simulator implementation; the uids
+   * are unique, but their order depends on the threads timing.
+   */
+  static std::atomic<uint32_t> m_globalUid;
 
   // Configured Grant
   uint8_t m_periodicity;
@@ -810,6 +818,26 @@ private:
  */
 std::ostream& operator<< (std::ostream& os, const Packet &packet);
 
+/**
+ * \brief Replace a packet bound to an event by a deep copy of it.
+ *
+ * Called through EventImpl::CopyArguments() when the event is handed over
+ * to another thread. The reference counts of the packet, of its buffer and
+ * of its tag and metadata lists are not atomic, and the copies of a packet
+ * share the bytes of its buffer: the packet is serialized and deserialized,
+ * so that the copy shares nothing with the packets of the scheduling thread.
+ *
+ * \param [in,out] packet The packet; it can be null.
+ */
+void EventArgumentCopy (Ptr<Packet> &packet);
+
+/**
+ * \copybrief EventArgumentCopy(Ptr<Packet>&)
+ *
+ * \param [in,out] packet The packet; it can be null.
+ */
+void EventArgumentCopy (Ptr<const Packet> &packet);
+
 /**
  * \ingroup network
  * \defgroup packetperf Packet Performance
@@ -19,6 +19,7 @@
  */
 #include "ns3/packet.h"
 #include "ns3/packet-tag-list.h"
+#include "ns3/make-event.h"
 #include "ns3/test.h"
 #include <limits>     // std:numeric_limits
 #include <string>
@@ -453,6 +454,13 @@ private:
    * \param ... The variable arguments
    */
   void DoCheckData (Ptr<const Packet> p, uint32_t n, ...);
+  /**
+   * Keeps the packet received by an event
+   * \param p The packet
+   */
+  void ReceivePacket (Ptr<const Packet> p);
+
+  Ptr<const Packet> m_received; //!< The packet received by an event
 };
 
 
@@ -460,6 +468,12 @@ PacketTest::PacketTest ()
   : TestCase ("Packet") {
 }
 
+void
+PacketTest::ReceivePacket (Ptr<const Packet> p)
+{
+  m_received = p;
+}
+
 void
 PacketTest::DoCheck (Ptr<const Packet> p, uint32_t n, ...)
 {
@@ -759,6 +773,35 @@ PacketTest::DoRun (void)
     CHECK_DATA (p2, 3, E_DATA (10, 0, 1000, 65), E_DATA (11, 0, 1000, 66), E_DATA (12, 0, 1000, 67));
   }
 
+  /* Test the deep copy of the packets bound to an event */
+  {
+    uint8_t data[] = {1, 2, 3, 4};
+    Ptr<Packet> p1 = Create<Packet> (data, 4);
+    p1->AddPacketTag (ATestTag<10> (65));
+    p1->AddByteTag (ATestTag<11> (66));
+
+    EventImpl *event = MakeEvent (&PacketTest::ReceivePacket, this, p1);
+    event->CopyArguments ();
+    event->Invoke ();
+    event->Unref ();
+
+    NS_TEST_EXPECT_MSG_NE (m_received, p1, "the event got the packet of the sender");
+    NS_TEST_EXPECT_MSG_EQ (m_received->GetUid (), p1->GetUid (), "the copy has another uid");
+    uint8_t copied[4];
+    NS_TEST_EXPECT_MSG_EQ (m_received->CopyData (copied, 4), 4, "the copy has another size");
+    NS_TEST_EXPECT_MSG_EQ ((uint32_t) copied[3], 4, "the copy has other data");
+    ATestTag<10> a;
+    NS_TEST_EXPECT_MSG_EQ (m_received->PeekPacketTag (a), true, "the copy has no packet tag");
+    NS_TEST_EXPECT_MSG_EQ (a.GetData (), 65, "the copy has another packet tag");
+    CHECK_DATA (m_received, 1, E_DATA (11, 0, 4, 66));
+
+    Ptr<const Packet> p2 = p1;
+    EventArgumentCopy (p2);
+    NS_TEST_EXPECT_MSG_NE (p2, p1, "the const packet was not copied");
+    NS_TEST_EXPECT_MSG_EQ (p2->GetSize (), 4, "the const packet copy has another size");
+    m_received = 0;
+  }
+
   {
     /// \internal
     /// See \bugid{572}
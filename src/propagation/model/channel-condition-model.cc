@@ -19,9 +19,12 @@
 
 #include "channel-condition-model.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/mobility-model.h"
 #include <cmath>
+#include <cstring>
+#include <limits>
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
@@ -282,6 +285,19 @@ ThreeGppChannelConditionModel::GetTypeId (void)
                    TimeValue (MilliSeconds (0)),
                    MakeTimeAccessor (&ThreeGppChannelConditionModel::m_updatePeriod),
                    MakeTimeChecker ())
+    .AddAttribute ("ConditionMapEnabled",
+                   "If true, the channel condition is drawn from a map of spatially correlated values "
+                   "of each base station, at the position of the user terminal, instead of being drawn "
+                   "and stored for each pair of nodes: close user terminals see similar conditions.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ThreeGppChannelConditionModel::m_conditionMapEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ConditionMapCorrelationDistance",
+                   "The correlation distance of the condition maps in meters "
+                   "(see 3GPP TR 38.901, Table 7.6.3.1-2).",
+                   DoubleValue (50.0),
+                   MakeDoubleAccessor (&ThreeGppChannelConditionModel::m_conditionMapCorrelationDistance),
+                   MakeDoubleChecker<double> (std::numeric_limits<double>::min ()))
   ;
   return tid;
 }
@@ -300,6 +316,7 @@ ThreeGppChannelConditionModel::~ThreeGppChannelConditionModel ()
 void ThreeGppChannelConditionModel::DoDispose ()
 {
   m_channelConditionMap.clear ();
+  m_conditionMaps.clear ();
   m_updatePeriod = Seconds (0.0);
 }
 
@@ -307,6 +324,12 @@ Ptr<ChannelCondition>
 ThreeGppChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
                                                     Ptr<const MobilityModel> b) const
 {
+  if (m_conditionMapEnabled)
+    {
+      // the condition follows the position of the user terminal
+      return ComputeChannelCondition (a, b);
+    }
+
   Ptr<ChannelCondition> cond;
 
   // get the key for this channel
@@ -363,7 +386,7 @@ ThreeGppChannelConditionModel::ComputeChannelCondition (Ptr<const MobilityModel>
   double pNlos = ComputePnlos (a, b);
 
   // draw a random value
-  double pRef = m_uniformVar->GetValue ();
+  double pRef = m_conditionMapEnabled ? GetConditionMapValue (a, b) : m_uniformVar->GetValue ();
 
   NS_LOG_DEBUG ("pRef " << pRef << " pLos " << pLos << " pNlos " << pNlos);
 
@@ -396,6 +419,47 @@ ThreeGppChannelConditionModel::ComputePnlos (Ptr<const MobilityModel> a,
   return (1 - ComputePlos (a, b));
 }
 
+double
+ThreeGppChannelConditionModel::GetConditionMapValue (Ptr<const MobilityModel> a,
+                                                     Ptr<const MobilityModel> b) const
+{
+  NS_LOG_FUNCTION (this << a << b);
+
+  if (!m_updatePeriod.IsZero () && Simulator::Now () - m_conditionMapsTime > m_updatePeriod)
+    {
+      NS_LOG_DEBUG ("the condition maps have to be updated");
+      m_conditionMaps.clear ();
+    }
+  if (m_conditionMaps.empty ())
+    {
+      m_conditionMapsTime = Simulator::Now ();
+    }
+
+  uint32_t idA = a->GetObject<Node> ()->GetId ();
+  uint32_t idB = b->GetObject<Node> ()->GetId ();
+  Vector posA = a->GetPosition ();
+  Vector posB = b->GetPosition ();
+  bool aIsBs = (posA.z > posB.z) || (posA.z == posB.z && idA < idB);
+  uint32_t bsId = aIsBs ? idA : idB;
+  Vector utPos = aIsBs ? posB : posA;
+
+  auto it = m_conditionMaps.find (bsId);
+  if (it == m_conditionMaps.end ())
+    {
+      // the seed of the map is drawn from the uniform random variable, so
+      // that the maps change with the run number and the assigned streams
+      double draw = m_uniformVar->GetValue ();
+      uint64_t seed;
+      std::memcpy (&seed, &draw, sizeof (seed));
+      NS_LOG_DEBUG ("new condition map for node " << bsId);
+      it = m_conditionMaps.emplace (bsId, Create<SpatiallyCorrelatedMap> (m_conditionMapCorrelationDistance, seed)).first;
+    }
+
+  // transform the Gaussian value of the map in a uniform value
+  double value = it->second->GetValue (utPos.x, utPos.y);
+  return 0.5 * std::erfc (-value / std::sqrt (2.0));
+}
+
 int64_t
 ThreeGppChannelConditionModel::AssignStreams (int64_t stream)
 {
@@ -24,6 +24,7 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/vector.h"
 #include "ns3/nstime.h"
+#include "ns3/spatially-correlated-map.h"
 #include <unordered_map>
 
 namespace ns3 {
@@ -471,6 +472,11 @@ public:
    * ComputeChannelCondition and stores it in a local cache, that will be updated 
    * following the "UpdatePeriod" parameter.
    *
+   * If the attribute "ConditionMapEnabled" is true, the condition is instead
+   * computed at each call, from the value of the condition map of the base
+   * station at the position of the user terminal (see GetConditionMapValue),
+   * and it is not stored: it changes when the user terminal moves.
+   *
    * \param a mobility model
    * \param b mobility model
    * \return the condition of the channel between a and b
@@ -549,6 +555,21 @@ private:
    */
   static uint32_t GetKey (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
 
+  /**
+   * \brief Get the value, uniform in [0, 1], of the condition map of the
+   *        channel between a and b at the position of the user terminal.
+   *
+   * The base station is the node with the highest antenna, or with the
+   * lowest node ID if the heights are equal, and each base station has its
+   * own map, with correlation distance "ConditionMapCorrelationDistance".
+   * The maps are generated again when "UpdatePeriod" expires, if not 0.
+   *
+   * \param a tx mobility model
+   * \param b rx mobility model
+   * \return the value used to draw the channel condition
+   */
+  double GetConditionMapValue (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const;
+
   /**
    * Struct to store the channel condition in the m_channelConditionMap
    */
@@ -560,6 +581,10 @@ private:
 
   std::unordered_map<uint32_t, Item> m_channelConditionMap; //!< map to store the channel conditions
   Time m_updatePeriod; //!< the update period for the channel condition
+  bool m_conditionMapEnabled {false}; //!< true if the channel conditions are read from the condition maps
+  double m_conditionMapCorrelationDistance {50.0}; //!< the correlation distance of the condition maps in meters
+  mutable std::unordered_map<uint32_t, Ptr<SpatiallyCorrelatedMap> > m_conditionMaps; //!< the condition maps, by node ID of the base station
+  mutable Time m_conditionMapsTime; //!< the time when the condition maps were generated
 };
 
 /**
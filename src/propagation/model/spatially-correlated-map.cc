@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "spatially-correlated-map.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SpatiallyCorrelatedMap");
+
+const int64_t SpatiallyCorrelatedMap::TILE_SIZE;
+
+/**
+ * \brief The SplitMix64 finalizer, used to hash the seed and the grid indices
+ * \param z the value to hash
+ * \return the hash
+ */
+static uint64_t
+Mix (uint64_t z)
+{
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * \brief Floor division of an index by the tile size
+ * \param i the index
+ * \return the index of the tile
+ */
+static int64_t
+TileIndex (int64_t i)
+{
+  int64_t t = i / SpatiallyCorrelatedMap::TILE_SIZE;
+  return (i % SpatiallyCorrelatedMap::TILE_SIZE < 0) ? t - 1 : t;
+}
+
+SpatiallyCorrelatedMap::SpatiallyCorrelatedMap (double correlationDistance, uint64_t seed)
+  : m_correlationDistance (correlationDistance),
+    m_resolution (correlationDistance / 4),
+    m_rho (std::exp (-0.25)),
+    m_seed (Mix (seed))
+{
+  NS_LOG_FUNCTION (this << correlationDistance << seed);
+  NS_ABORT_MSG_IF (!(correlationDistance > 0), "The correlation distance must be positive");
+
+  // The impulse response of a first order autoregressive filter, truncated
+  // when the coefficients fall below 1e-3 of the first one, gives the
+  // correlation m_rho^|d| between grid points at distance d. The
+  // coefficients are normalized to give unit variance.
+  const std::size_t length = static_cast<std::size_t> (std::ceil (std::log (1e-3) / std::log (m_rho)));
+  double energy = 0;
+  for (std::size_t k = 0; k < length; k++)
+    {
+      m_kernel.push_back (std::pow (m_rho, k));
+      energy += m_kernel.back () * m_kernel.back ();
+    }
+  for (double &h : m_kernel)
+    {
+      h /= std::sqrt (energy);
+    }
+}
+
+double
+SpatiallyCorrelatedMap::GetCorrelationDistance () const
+{
+  return m_correlationDistance;
+}
+
+std::size_t
+SpatiallyCorrelatedMap::GetNumTiles () const
+{
+  return m_tiles.size ();
+}
+
+double
+SpatiallyCorrelatedMap::GetNoise (int64_t ix, int64_t iy) const
+{
+  uint64_t h1 = Mix (Mix (m_seed ^ static_cast<uint64_t> (ix)) ^ static_cast<uint64_t> (iy));
+  uint64_t h2 = Mix (h1);
+
+  // Box-Muller transform of two uniform values, the first in (0, 1]
+  double u1 = ((h1 >> 11) + 1) * 0x1.0p-53;
+  double u2 = (h2 >> 11) * 0x1.0p-53;
+  return std::sqrt (-2 * std::log (u1)) * std::cos (2 * M_PI * u2);
+}
+
+void
+SpatiallyCorrelatedMap::GenerateTile (int64_t tx, int64_t ty, std::vector<double> &tile) const
+{
+  NS_LOG_FUNCTION (this << tx << ty);
+
+  // The tile needs the noise of the grid points up to the length of the
+  // filter before its first point, along each axis
+  const int64_t length = static_cast<int64_t> (m_kernel.size ());
+  const int64_t side = TILE_SIZE + length - 1;
+  const int64_t x0 = tx * TILE_SIZE - (length - 1);
+  const int64_t y0 = ty * TILE_SIZE - (length - 1);
+
+  std::vector<double> noise (side * side);
+  for (int64_t j = 0; j < side; j++)
+    {
+      for (int64_t i = 0; i < side; i++)
+        {
+          noise[j * side + i] = GetNoise (x0 + i, y0 + j);
+        }
+    }
+
+  // filter along the x axis, and then along the y axis
+  std::vector<double> rows (side * TILE_SIZE, 0.0);
+  for (int64_t j = 0; j < side; j++)
+    {
+      for (int64_t i = 0; i < TILE_SIZE; i++)
+        {
+          double sum = 0;
+          for (int64_t k = 0; k < length; k++)
+            {
+              sum += m_kernel[k] * noise[j * side + i + length - 1 - k];
+            }
+          rows[j * TILE_SIZE + i] = sum;
+        }
+    }
+  tile.assign (TILE_SIZE * TILE_SIZE, 0.0);
+  for (int64_t j = 0; j < TILE_SIZE; j++)
+    {
+      for (int64_t k = 0; k < length; k++)
+        {
+          for (int64_t i = 0; i < TILE_SIZE; i++)
+            {
+              tile[j * TILE_SIZE + i] += m_kernel[k] * rows[(j + length - 1 - k) * TILE_SIZE + i];
+            }
+        }
+    }
+}
+
+double
+SpatiallyCorrelatedMap::GetGridValue (int64_t ix, int64_t iy) const
+{
+  int64_t tx = TileIndex (ix);
+  int64_t ty = TileIndex (iy);
+  uint64_t key = (static_cast<uint64_t> (static_cast<uint32_t> (tx)) << 32) | static_cast<uint32_t> (ty);
+
+  auto it = m_tiles.find (key);
+  if (it == m_tiles.end ())
+    {
+      it = m_tiles.emplace (key, std::vector<double> ()).first;
+      GenerateTile (tx, ty, it->second);
+    }
+  return it->second[(iy - ty * TILE_SIZE) * TILE_SIZE + (ix - tx * TILE_SIZE)];
+}
+
+double
+SpatiallyCorrelatedMap::GetValue (double x, double y) const
+{
+  double gx = x / m_resolution;
+  double gy = y / m_resolution;
+  int64_t ix = static_cast<int64_t> (std::floor (gx));
+  int64_t iy = static_cast<int64_t> (std::floor (gy));
+  double fx = gx - ix;
+  double fy = gy - iy;
+
+  double value = (1 - fx) * (1 - fy) * GetGridValue (ix, iy)
+    + fx * (1 - fy) * GetGridValue (ix + 1, iy)
+    + (1 - fx) * fy * GetGridValue (ix, iy + 1)
+    + fx * fy * GetGridValue (ix + 1, iy + 1);
+
+  // the variance of the interpolation of the correlated grid values, which
+  // is the product of the variances along the two axes
+  double varianceX = (1 - fx) * (1 - fx) + fx * fx + 2 * fx * (1 - fx) * m_rho;
+  double varianceY = (1 - fy) * (1 - fy) + fy * fy + 2 * fy * (1 - fy) * m_rho;
+  return value / std::sqrt (varianceX * varianceY);
+}
+
+} // namespace ns3
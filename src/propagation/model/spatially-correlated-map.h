@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SPATIALLY_CORRELATED_MAP_H
+#define SPATIALLY_CORRELATED_MAP_H
+
+#include "ns3/simple-ref-count.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup propagation
+ *
+ * \brief A map of spatially correlated Gaussian values, with zero mean and
+ *        unit variance, over the horizontal plane
+ *
+ * The values are defined on a square grid, with a spacing of a quarter of the
+ * correlation distance, and interpolated bilinearly between the grid points.
+ * The correlation between two grid points at a distance dx along the x axis
+ * and dy along the y axis is exp (-(|dx| + |dy|) / d), where d is the
+ * correlation distance, which gives the exponential autocorrelation of
+ * 3GPP TR 38.901, Sec. 7.4.4 along the axes. The interpolated values are
+ * rescaled so that their variance is still 1.
+ *
+ * The grid is generated by tiles of TILE_SIZE x TILE_SIZE points, only when
+ * a value in the tile is requested, and the tiles are kept: the memory grows
+ * with the area where the values are requested, and not with the number of
+ * requests. The grid values are obtained filtering white Gaussian noise,
+ * drawn from a hash of the seed and of the grid point, so that the values do
+ * not depend on the order in which the tiles are generated.
+ */
+class SpatiallyCorrelatedMap : public SimpleRefCount<SpatiallyCorrelatedMap>
+{
+public:
+  /**
+   * \brief Create a map
+   * \param correlationDistance the correlation distance in meters
+   * \param seed the seed of the map: maps with the same correlation distance
+   *        and seed have the same values
+   */
+  SpatiallyCorrelatedMap (double correlationDistance, uint64_t seed);
+
+  /**
+   * \brief Get the value of the map at a position
+   * \param x the x coordinate in meters
+   * \param y the y coordinate in meters
+   * \return the Gaussian value, with zero mean and unit variance
+   */
+  double GetValue (double x, double y) const;
+
+  /**
+   * \return the correlation distance in meters
+   */
+  double GetCorrelationDistance (void) const;
+
+  /**
+   * \return the number of tiles generated
+   */
+  std::size_t GetNumTiles (void) const;
+
+  static const int64_t TILE_SIZE = 32; //!< the number of grid points along each side of a tile
+
+private:
+  /**
+   * \brief Get the white noise at a grid point
+   * \param ix the index of the grid point along the x axis
+   * \param iy the index of the grid point along the y axis
+   * \return the Gaussian noise, with zero mean and unit variance
+   */
+  double GetNoise (int64_t ix, int64_t iy) const;
+
+  /**
+   * \brief Get the value of a grid point, generating its tile if needed
+   * \param ix the index of the grid point along the x axis
+   * \param iy the index of the grid point along the y axis
+   * \return the value of the grid point
+   */
+  double GetGridValue (int64_t ix, int64_t iy) const;
+
+  /**
+   * \brief Generate the values of a tile
+   * \param tx the index of the tile along the x axis
+   * \param ty the index of the tile along the y axis
+   * \param tile the values, in the order of the y index and then of the x index
+   */
+  void GenerateTile (int64_t tx, int64_t ty, std::vector<double> &tile) const;
+
+  double m_correlationDistance; //!< the correlation distance in meters
+  double m_resolution; //!< the spacing of the grid in meters
+  double m_rho; //!< the correlation of adjacent grid points
+  uint64_t m_seed; //!< the seed of the noise
+  std::vector<double> m_kernel; //!< the coefficients of the filter along each axis
+  mutable std::unordered_map<uint64_t, std::vector<double> > m_tiles; //!< the tiles generated, by index
+};
+
+} // namespace ns3
+
+#endif /* SPATIALLY_CORRELATED_MAP_H */
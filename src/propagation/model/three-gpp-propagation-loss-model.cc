@@ -25,6 +25,7 @@
 #include "ns3/boolean.h"
 #include "ns3/pointer.h"
 #include <cmath>
+#include <cstring>
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 
@@ -53,6 +54,13 @@ ThreeGppPropagationLossModel::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&ThreeGppPropagationLossModel::m_shadowingEnabled),
                    MakeBooleanChecker ())
+    .AddAttribute ("ShadowingMapEnabled",
+                   "If true, the shadowing of the channels of each base station is read from "
+                   "a map of spatially correlated values, at the position of the user terminal, "
+                   "instead of being generated and stored for each pair of nodes.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ThreeGppPropagationLossModel::m_shadowingMapEnabled),
+                   MakeBooleanChecker ())
     .AddAttribute ("ChannelConditionModel", "Pointer to the channel condition model.",
                    PointerValue (),
                    MakePointerAccessor (&ThreeGppPropagationLossModel::SetChannelConditionModel,
@@ -84,6 +92,7 @@ ThreeGppPropagationLossModel::DoDispose ()
   m_channelConditionModel->Dispose ();
   m_channelConditionModel = nullptr;
   m_shadowingMap.clear ();
+  m_shadowingMaps.clear ();
 }
 
 void
@@ -187,6 +196,11 @@ ThreeGppPropagationLossModel::GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityMo
 {
   NS_LOG_FUNCTION (this);
 
+  if (m_shadowingMapEnabled)
+    {
+      return GetShadowingFromMap (a, b, cond);
+    }
+
   double shadowingValue;
 
   // compute the channel key
@@ -233,6 +247,35 @@ ThreeGppPropagationLossModel::GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityMo
   return shadowingValue;
 }
 
+double
+ThreeGppPropagationLossModel::GetShadowingFromMap (Ptr<MobilityModel> a, Ptr<MobilityModel> b, ChannelCondition::LosConditionValue cond) const
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t idA = a->GetObject<Node> ()->GetId ();
+  uint32_t idB = b->GetObject<Node> ()->GetId ();
+  Vector posA = a->GetPosition ();
+  Vector posB = b->GetPosition ();
+  bool aIsBs = (posA.z > posB.z) || (posA.z == posB.z && idA < idB);
+  uint32_t bsId = aIsBs ? idA : idB;
+  Vector utPos = aIsBs ? posB : posA;
+
+  uint64_t key = (static_cast<uint64_t> (bsId) << 2) | static_cast<uint64_t> (cond);
+  auto it = m_shadowingMaps.find (key);
+  if (it == m_shadowingMaps.end ())
+    {
+      // the seed of the map is drawn from the normal random variable, so
+      // that the maps change with the run number and the assigned streams
+      double draw = m_normRandomVariable->GetValue ();
+      uint64_t seed;
+      std::memcpy (&seed, &draw, sizeof (seed));
+      NS_LOG_DEBUG ("new shadowing map for node " << bsId << " and condition " << cond);
+      it = m_shadowingMaps.emplace (key, Create<SpatiallyCorrelatedMap> (GetShadowingCorrelationDistance (cond), seed)).first;
+    }
+
+  return it->second->GetValue (utPos.x, utPos.y) * GetShadowingStd (a, b, cond);
+}
+
 std::pair<double, double>
 ThreeGppPropagationLossModel::GetUtAndBsHeights (double za, double zb) const
 {
@@ -22,6 +22,7 @@
 
 #include "ns3/propagation-loss-model.h"
 #include "ns3/channel-condition-model.h"
+#include "ns3/spatially-correlated-map.h"
 
 namespace ns3 {
 
@@ -173,6 +174,20 @@ private:
    */
   double GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityModel> b, ChannelCondition::LosConditionValue cond) const;
 
+  /**
+   * \brief Retrieves the shadowing value from the map of the base station,
+   *        at the position of the user terminal. The base station is the
+   *        tallest node, or the one with the lowest ID if the nodes have the
+   *        same height. The map of each base station and channel condition is
+   *        created the first time it is needed, with the shadowing correlation
+   *        distance of the condition.
+   * \param a tx mobility model
+   * \param b rx mobility model
+   * \param cond the LOS/NLOS channel condition
+   * \return shadowing loss in dB
+   */
+  double GetShadowingFromMap (Ptr<MobilityModel> a, Ptr<MobilityModel> b, ChannelCondition::LosConditionValue cond) const;
+
   /**
    * \brief Returns the shadow fading standard deviation
    * \param a tx mobility model
@@ -239,6 +254,9 @@ protected:
   };
 
   mutable std::unordered_map<uint32_t, ShadowingMapItem> m_shadowingMap; //!< map to store the shadowing values
+
+  bool m_shadowingMapEnabled {false}; //!< read the shadowing from the maps of the base stations
+  mutable std::unordered_map<uint64_t, Ptr<SpatiallyCorrelatedMap> > m_shadowingMaps; //!< the shadowing maps, by base station and channel condition
 };
 
 /**
@@ -0,0 +1,339 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/spatially-correlated-map.h"
+#include "ns3/channel-condition-model.h"
+#include "ns3/three-gpp-propagation-loss-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("SpatiallyCorrelatedMapTest");
+
+/**
+ * \ingroup propagation-tests
+ *
+ * Test case for the statistics of the SpatiallyCorrelatedMap. The values
+ * at positions far apart must have zero mean and unit variance, and the
+ * values at a distance equal to the correlation distance must have a
+ * correlation close to exp (-1).
+ */
+class SpatiallyCorrelatedMapStatisticsTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  SpatiallyCorrelatedMapStatisticsTestCase ();
+
+private:
+  /**
+   * Builds the simulation scenario and perform the tests
+   */
+  virtual void DoRun (void) override;
+};
+
+SpatiallyCorrelatedMapStatisticsTestCase::SpatiallyCorrelatedMapStatisticsTestCase ()
+  : TestCase ("Check the mean, the variance and the correlation of the spatially correlated map")
+{
+}
+
+void
+SpatiallyCorrelatedMapStatisticsTestCase::DoRun (void)
+{
+  const double distance = 20.0;
+  const uint32_t side = 40;
+  double sum = 0;
+  double sumSquares = 0;
+  double sumProducts = 0;
+  uint32_t n = 0;
+
+  SpatiallyCorrelatedMap map (distance, 1);
+  for (uint32_t i = 0; i < side; i++)
+    {
+      for (uint32_t j = 0; j < side; j++)
+        {
+          // positions 10 correlation distances apart, not on the grid points
+          double x = (i * 10.0 - 200.0 + 0.3) * distance;
+          double y = (j * 10.0 - 200.0 + 0.7) * distance;
+          double value = map.GetValue (x, y);
+          sum += value;
+          sumSquares += value * value;
+          sumProducts += value * map.GetValue (x + distance, y);
+          n++;
+        }
+    }
+
+  double mean = sum / n;
+  double variance = sumSquares / n - mean * mean;
+  NS_TEST_ASSERT_MSG_EQ_TOL (mean, 0.0, 0.1, "Wrong mean of the map values");
+  NS_TEST_ASSERT_MSG_EQ_TOL (variance, 1.0, 0.12, "Wrong variance of the map values");
+  NS_TEST_ASSERT_MSG_EQ_TOL (sumProducts / n, std::exp (-1.0), 0.1, "Wrong correlation at the correlation distance");
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * Test case for the generation of the tiles of the SpatiallyCorrelatedMap:
+ * the values must not depend on the order of the requests, and the tiles
+ * must be generated only where the values are requested.
+ */
+class SpatiallyCorrelatedMapTilesTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  SpatiallyCorrelatedMapTilesTestCase ();
+
+private:
+  /**
+   * Builds the simulation scenario and perform the tests
+   */
+  virtual void DoRun (void) override;
+};
+
+SpatiallyCorrelatedMapTilesTestCase::SpatiallyCorrelatedMapTilesTestCase ()
+  : TestCase ("Check the generation of the tiles of the spatially correlated map")
+{
+}
+
+void
+SpatiallyCorrelatedMapTilesTestCase::DoRun (void)
+{
+  const double distance = 10.0;
+  const double tileSide = SpatiallyCorrelatedMap::TILE_SIZE * distance / 4;
+  std::vector<std::pair<double, double> > positions {{0.0, 0.0}, {-1.5, 3.2}, {5 * tileSide, -7 * tileSide},
+                                                     {-3.3 * tileSide, 0.1}, {tileSide, tileSide}};
+
+  SpatiallyCorrelatedMap map (distance, 42);
+  SpatiallyCorrelatedMap sameMap (distance, 42);
+  SpatiallyCorrelatedMap otherMap (distance, 43);
+  std::vector<double> values;
+  for (const auto &p : positions)
+    {
+      values.push_back (map.GetValue (p.first, p.second));
+    }
+  for (std::size_t i = positions.size (); i-- > 0; )
+    {
+      NS_TEST_ASSERT_MSG_EQ (sameMap.GetValue (positions[i].first, positions[i].second), values[i],
+                             "The values depend on the order of the requests");
+      NS_TEST_ASSERT_MSG_NE (otherMap.GetValue (positions[i].first, positions[i].second), values[i],
+                             "Maps with different seeds have the same values");
+    }
+
+  // the values inside a tile, and on the border with the next tiles, need at
+  // most four tiles
+  SpatiallyCorrelatedMap smallMap (distance, 7);
+  for (uint32_t i = 0; i <= 20; i++)
+    {
+      for (uint32_t j = 0; j <= 20; j++)
+        {
+          smallMap.GetValue (i * tileSide / 20, j * tileSide / 20);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (smallMap.GetNumTiles (), 4, "Wrong number of tiles");
+  double value = smallMap.GetValue (0.5 * tileSide, 0.5 * tileSide);
+  NS_TEST_ASSERT_MSG_EQ (smallMap.GetValue (0.5 * tileSide, 0.5 * tileSide), value, "The value of a position changed");
+  NS_TEST_ASSERT_MSG_EQ (smallMap.GetNumTiles (), 4, "A tile was generated again");
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * Test case for the shadowing of the ThreeGppPropagationLossModel read from
+ * the spatially correlated maps. The shadowing must be reciprocal, the same
+ * for user terminals at the same position, with the standard deviation of
+ * the scenario, and close for user terminals close to each other.
+ */
+class ThreeGppShadowingMapTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppShadowingMapTestCase ();
+
+private:
+  /**
+   * Builds the simulation scenario and perform the tests
+   */
+  virtual void DoRun (void) override;
+};
+
+ThreeGppShadowingMapTestCase::ThreeGppShadowingMapTestCase ()
+  : TestCase ("Check the shadowing of the 3GPP propagation loss model read from the maps")
+{
+}
+
+void
+ThreeGppShadowingMapTestCase::DoRun (void)
+{
+  const uint32_t numUts = 400;
+  NodeContainer nodes;
+  nodes.Create (2 * numUts + 1);
+
+  Ptr<MobilityModel> bs = CreateObject<ConstantPositionMobilityModel> ();
+  bs->SetPosition (Vector (0.0, 0.0, 25.0));
+  nodes.Get (0)->AggregateObject (bs);
+
+  Ptr<ThreeGppPropagationLossModel> lossModel = CreateObject<ThreeGppUmaPropagationLossModel> ();
+  lossModel->SetAttribute ("Frequency", DoubleValue (3.5e9));
+  lossModel->SetAttribute ("ShadowingMapEnabled", BooleanValue (true));
+  lossModel->SetChannelConditionModel (CreateObject<AlwaysLosChannelConditionModel> ());
+
+  Ptr<ThreeGppPropagationLossModel> refLossModel = CreateObject<ThreeGppUmaPropagationLossModel> ();
+  refLossModel->SetAttribute ("Frequency", DoubleValue (3.5e9));
+  refLossModel->SetAttribute ("ShadowingEnabled", BooleanValue (false));
+  refLossModel->SetChannelConditionModel (CreateObject<AlwaysLosChannelConditionModel> ());
+
+  // pairs of user terminals 1 m apart, at 100 m from the base station, on
+  // a circle with the pairs 500 m apart (the correlation distance is 37 m)
+  double sumSquares = 0;
+  double sumDiffSquares = 0;
+  for (uint32_t i = 0; i < numUts; i++)
+    {
+      double angle = 2 * M_PI * i / numUts;
+      double radius = 500.0 * numUts / (2 * M_PI);
+      Vector center (radius * std::cos (angle), radius * std::sin (angle), 1.5);
+
+      Ptr<MobilityModel> ut = CreateObject<ConstantPositionMobilityModel> ();
+      ut->SetPosition (center);
+      nodes.Get (2 * i + 1)->AggregateObject (ut);
+      Ptr<MobilityModel> nearUt = CreateObject<ConstantPositionMobilityModel> ();
+      nearUt->SetPosition (Vector (center.x + 1.0, center.y, center.z));
+      nodes.Get (2 * i + 2)->AggregateObject (nearUt);
+
+      double shadowing = refLossModel->CalcRxPower (0, bs, ut) - lossModel->CalcRxPower (0, bs, ut);
+      NS_TEST_ASSERT_MSG_EQ (lossModel->CalcRxPower (0, ut, bs), lossModel->CalcRxPower (0, bs, ut),
+                             "The shadowing is not reciprocal");
+      double nearShadowing = refLossModel->CalcRxPower (0, bs, nearUt) - lossModel->CalcRxPower (0, bs, nearUt);
+      sumSquares += shadowing * shadowing;
+      sumDiffSquares += (shadowing - nearShadowing) * (shadowing - nearShadowing);
+
+      nearUt->SetPosition (center);
+      NS_TEST_ASSERT_MSG_EQ_TOL (refLossModel->CalcRxPower (0, bs, nearUt) - lossModel->CalcRxPower (0, bs, nearUt),
+                                 shadowing, 1e-9, "Different shadowing at the same position");
+    }
+
+  // UMa LOS, shadowing standard deviation of 4 dB
+  NS_TEST_ASSERT_MSG_EQ_TOL (std::sqrt (sumSquares / numUts), 4.0, 0.5, "Wrong standard deviation of the shadowing");
+  NS_TEST_ASSERT_MSG_LT (std::sqrt (sumDiffSquares / numUts), 1.5, "The shadowing of close user terminals is not correlated");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * Test case for the channel conditions of the ThreeGppChannelConditionModel
+ * drawn from the spatially correlated maps. The fraction of LOS channels
+ * must match the LOS probability, and the condition must be the same for
+ * user terminals at the same position.
+ */
+class ThreeGppConditionMapTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppConditionMapTestCase ();
+
+private:
+  /**
+   * Builds the simulation scenario and perform the tests
+   */
+  virtual void DoRun (void) override;
+};
+
+ThreeGppConditionMapTestCase::ThreeGppConditionMapTestCase ()
+  : TestCase ("Check the channel conditions of the 3GPP channel condition model drawn from the maps")
+{
+}
+
+void
+ThreeGppConditionMapTestCase::DoRun (void)
+{
+  // each base station has its own map: a user terminal for each of many
+  // base stations gives independent conditions
+  const uint32_t numBss = 1000;
+  const double distance = 100.0;
+  NodeContainer nodes;
+  nodes.Create (3 * numBss);
+
+  Ptr<ChannelConditionModel> condModel = CreateObject<ThreeGppUmaChannelConditionModel> ();
+  condModel->SetAttribute ("ConditionMapEnabled", BooleanValue (true));
+
+  uint32_t numLos = 0;
+  for (uint32_t i = 0; i < numBss; i++)
+    {
+      Ptr<MobilityModel> bs = CreateObject<ConstantPositionMobilityModel> ();
+      bs->SetPosition (Vector (10.0 * i, 0.0, 25.0));
+      nodes.Get (3 * i)->AggregateObject (bs);
+      Ptr<MobilityModel> ut = CreateObject<ConstantPositionMobilityModel> ();
+      ut->SetPosition (Vector (10.0 * i, distance, 1.5));
+      nodes.Get (3 * i + 1)->AggregateObject (ut);
+      Ptr<MobilityModel> sameUt = CreateObject<ConstantPositionMobilityModel> ();
+      sameUt->SetPosition (Vector (10.0 * i, distance, 1.5));
+      nodes.Get (3 * i + 2)->AggregateObject (sameUt);
+
+      ChannelCondition::LosConditionValue cond = condModel->GetChannelCondition (bs, ut)->GetLosCondition ();
+      NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (ut, bs)->GetLosCondition (), cond,
+                             "The channel condition is not reciprocal");
+      NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (bs, sameUt)->GetLosCondition (), cond,
+                             "Different channel conditions at the same position");
+      numLos += (cond == ChannelCondition::LosConditionValue::LOS) ? 1 : 0;
+    }
+
+  // UMa LOS probability, 3GPP TR 38.901, Table 7.4.2-1, for a user
+  // terminal below 13 m
+  double pLos = 18 / distance + std::exp (-distance / 63) * (1 - 18 / distance);
+  NS_TEST_ASSERT_MSG_EQ_TOL (static_cast<double> (numLos) / numBss, pLos, 0.05, "Wrong fraction of LOS channels");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * Test suite for the spatially correlated maps of the shadowing and of the
+ * channel conditions
+ */
+class SpatiallyCorrelatedMapTestSuite : public TestSuite
+{
+public:
+  SpatiallyCorrelatedMapTestSuite ();
+};
+
+SpatiallyCorrelatedMapTestSuite::SpatiallyCorrelatedMapTestSuite ()
+  : TestSuite ("spatially-correlated-map", UNIT)
+{
+  AddTestCase (new SpatiallyCorrelatedMapStatisticsTestCase, TestCase::QUICK);
+  AddTestCase (new SpatiallyCorrelatedMapTilesTestCase, TestCase::QUICK);
+  AddTestCase (new ThreeGppShadowingMapTestCase, TestCase::QUICK);
+  AddTestCase (new ThreeGppConditionMapTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static SpatiallyCorrelatedMapTestSuite g_spatiallyCorrelatedMapTestSuite;
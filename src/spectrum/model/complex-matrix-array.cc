@@ -0,0 +1,65 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "complex-matrix-array.h"
+
+namespace ns3 {
+
+ComplexMatrixArray::ComplexMatrixArray (std::size_t numRows, std::size_t numCols, std::size_t numPages)
+{
+  Resize (numRows, numCols, numPages);
+}
+
+void
+ComplexMatrixArray::Resize (std::size_t numRows, std::size_t numCols, std::size_t numPages)
+{
+  m_numRows = numRows;
+  m_numCols = numCols;
+  m_numPages = numPages;
+  m_values.assign (numRows * numCols * numPages, value_type (0, 0));
+}
+
+ComplexMatrixArray::value_type
+ComplexMatrixArray::MultiplyLeftAndRight (const std::vector<value_type> &left,
+                                          const std::vector<value_type> &right,
+                                          std::size_t page) const
+{
+  NS_ASSERT (left.size () == m_numRows);
+  NS_ASSERT (right.size () == m_numCols);
+
+  // The products are written with the real and imaginary parts, so that the
+  // inner loop runs on contiguous doubles without the checks for infinite
+  // values of the complex product
+  const double *r = reinterpret_cast<const double *> (right.data ());
+  double sumRe = 0;
+  double sumIm = 0;
+  for (std::size_t row = 0; row < m_numRows; row++)
+    {
+      const double *h = reinterpret_cast<const double *> (GetRow (row, page));
+      double rowRe = 0;
+      double rowIm = 0;
+      for (std::size_t col = 0; col < m_numCols; col++)
+        {
+          rowRe += h[2 * col] * r[2 * col] - h[2 * col + 1] * r[2 * col + 1];
+          rowIm += h[2 * col] * r[2 * col + 1] + h[2 * col + 1] * r[2 * col];
+        }
+      sumRe += left[row].real () * rowRe - left[row].imag () * rowIm;
+      sumIm += left[row].real () * rowIm + left[row].imag () * rowRe;
+    }
+  return value_type (sumRe, sumIm);
+}
+
+} // namespace ns3
@@ -0,0 +1,259 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COMPLEX_MATRIX_ARRAY_H
+#define COMPLEX_MATRIX_ARRAY_H
+
+#include <ns3/assert.h>
+#include <complex>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup spectrum
+ *
+ * Allocator of memory aligned to a given number of bytes, used to
+ * store vectors that are processed with SIMD instructions.
+ *
+ * \tparam T the type of the elements
+ * \tparam Alignment the alignment, in bytes
+ */
+template <class T, std::size_t Alignment>
+class AlignedAllocator
+{
+public:
+  typedef T value_type; //!< type of the elements
+
+  /**
+   * Rebind the allocator to another type
+   */
+  template <class U>
+  struct rebind
+  {
+    typedef AlignedAllocator<U, Alignment> other; //!< the rebound allocator
+  };
+
+  AlignedAllocator () = default;
+
+  /**
+   * Copy constructor from an allocator of another type
+   */
+  template <class U>
+  AlignedAllocator (const AlignedAllocator<U, Alignment> &)
+  {}
+
+  /**
+   * Allocate the memory of n elements
+   * \param n the number of elements
+   * \return the memory, aligned to Alignment bytes
+   */
+  T * allocate (std::size_t n)
+  {
+    return static_cast<T *> (::operator new (n * sizeof (T), std::align_val_t (Alignment)));
+  }
+
+  /**
+   * Release the memory allocated by allocate
+   * \param p the memory
+   */
+  void deallocate (T *p, std::size_t)
+  {
+    ::operator delete (p, std::align_val_t (Alignment));
+  }
+
+  /**
+   * \return true, all the allocators are the same
+   */
+  template <class U>
+  bool operator== (const AlignedAllocator<U, Alignment> &) const
+  {
+    return true;
+  }
+
+  /**
+   * \return false, all the allocators are the same
+   */
+  template <class U>
+  bool operator!= (const AlignedAllocator<U, Alignment> &) const
+  {
+    return false;
+  }
+};
+
+/**
+ * \ingroup spectrum
+ *
+ * Array of complex matrices of the same size, e.g., the channel matrix
+ * H[u][s][n] of the 3GPP channel model, where each cluster n (a page) is
+ * a matrix of numRows receive elements u and numCols transmit elements s.
+ *
+ * The values are stored in a single contiguous block of memory, aligned to
+ * 64 bytes. The pages follow one another, and each page is stored by rows:
+ * the element (row, col, page) is at ((page * numRows) + row) * numCols + col.
+ * A page, or a row of a page, can then be accessed as a plain array with
+ * GetPage and GetRow, without following a pointer for each dimension.
+ */
+class ComplexMatrixArray
+{
+public:
+  typedef std::complex<double> value_type; //!< type of the elements
+  typedef std::vector<value_type, AlignedAllocator<value_type, 64> > Storage; //!< type of the storage
+
+  ComplexMatrixArray () = default;
+
+  /**
+   * Create an array of matrices with all the elements set to 0
+   * \param numRows the number of rows of each matrix
+   * \param numCols the number of columns of each matrix
+   * \param numPages the number of matrices
+   */
+  ComplexMatrixArray (std::size_t numRows, std::size_t numCols, std::size_t numPages);
+
+  /**
+   * Change the size of the array, setting all the elements to 0
+   * \param numRows the number of rows of each matrix
+   * \param numCols the number of columns of each matrix
+   * \param numPages the number of matrices
+   */
+  void Resize (std::size_t numRows, std::size_t numCols, std::size_t numPages);
+
+  /**
+   * \return the number of rows of each matrix
+   */
+  std::size_t GetNumRows () const
+  {
+    return m_numRows;
+  }
+  /**
+   * \return the number of columns of each matrix
+   */
+  std::size_t GetNumCols () const
+  {
+    return m_numCols;
+  }
+  /**
+   * \return the number of matrices
+   */
+  std::size_t GetNumPages () const
+  {
+    return m_numPages;
+  }
+  /**
+   * \return the total number of elements
+   */
+  std::size_t GetSize () const
+  {
+    return m_values.size ();
+  }
+
+  /**
+   * Access an element
+   * \param row the row
+   * \param col the column
+   * \param page the matrix
+   * \return a reference to the element
+   */
+  value_type & operator() (std::size_t row, std::size_t col, std::size_t page)
+  {
+    NS_ASSERT (row < m_numRows && col < m_numCols && page < m_numPages);
+    return m_values[(page * m_numRows + row) * m_numCols + col];
+  }
+  /**
+   * Access an element
+   * \param row the row
+   * \param col the column
+   * \param page the matrix
+   * \return a const reference to the element
+   */
+  const value_type & operator() (std::size_t row, std::size_t col, std::size_t page) const
+  {
+    NS_ASSERT (row < m_numRows && col < m_numCols && page < m_numPages);
+    return m_values[(page * m_numRows + row) * m_numCols + col];
+  }
+
+  /**
+   * \param page the matrix
+   * \return the first element of the matrix, whose row r starts at r * GetNumCols ()
+   */
+  value_type * GetPage (std::size_t page)
+  {
+    NS_ASSERT (page < m_numPages);
+    return m_values.data () + page * m_numRows * m_numCols;
+  }
+  /**
+   * \param page the matrix
+   * \return the first element of the matrix, whose row r starts at r * GetNumCols ()
+   */
+  const value_type * GetPage (std::size_t page) const
+  {
+    NS_ASSERT (page < m_numPages);
+    return m_values.data () + page * m_numRows * m_numCols;
+  }
+  /**
+   * \param row the row
+   * \param page the matrix
+   * \return the first of the GetNumCols () contiguous elements of the row
+   */
+  const value_type * GetRow (std::size_t row, std::size_t page) const
+  {
+    NS_ASSERT (row < m_numRows);
+    return GetPage (page) + row * m_numCols;
+  }
+
+  /**
+   * Compute left^T * H * right for a matrix H of the array, i.e., the sum
+   * over the rows r and the columns c of left[r] * H(r, c) * right[c]
+   *
+   * \param left the vector of the rows (e.g., the receive beamforming vector)
+   * \param right the vector of the columns (e.g., the transmit beamforming vector)
+   * \param page the matrix
+   * \return the product
+   */
+  value_type MultiplyLeftAndRight (const std::vector<value_type> &left,
+                                   const std::vector<value_type> &right,
+                                   std::size_t page) const;
+
+  /**
+   * \param other the other array
+   * \return true if the arrays have the same size and the same elements
+   */
+  bool operator== (const ComplexMatrixArray &other) const
+  {
+    return m_numRows == other.m_numRows && m_numCols == other.m_numCols
+           && m_numPages == other.m_numPages && m_values == other.m_values;
+  }
+  /**
+   * \param other the other array
+   * \return true if the arrays are different
+   */
+  bool operator!= (const ComplexMatrixArray &other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  std::size_t m_numRows {0};  //!< number of rows of each matrix
+  std::size_t m_numCols {0};  //!< number of columns of each matrix
+  std::size_t m_numPages {0}; //!< number of matrices
+  Storage m_values;           //!< the elements, page after page, each by rows
+};
+
+} // namespace ns3
+
+#endif /* COMPLEX_MATRIX_ARRAY_H */
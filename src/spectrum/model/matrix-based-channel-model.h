@@ -27,6 +27,7 @@
 #include <ns3/nstime.h>
 #include <ns3/vector.h>
 #include <ns3/phased-array-model.h>
+#include <ns3/complex-matrix-array.h>
 #include <tuple>
 
 namespace ns3 {
@@ -52,14 +53,14 @@ public:
   typedef std::vector<DoubleVector> Double2DVector; //!< type definition for matrices of doubles
   typedef std::vector<Double2DVector> Double3DVector; //!< type definition for 3D matrices of doubles
   typedef std::vector<PhasedArrayModel::ComplexVector> Complex2DVector; //!< type definition for complex matrices
-  typedef std::vector<Complex2DVector> Complex3DVector; //!< type definition for complex 3D matrices
+  typedef ComplexMatrixArray Complex3DVector; //!< type definition for complex 3D matrices, stored in contiguous memory
 
   /**
    * Data structure that stores a channel realization
    */
   struct ChannelMatrix : public SimpleRefCount<ChannelMatrix>
   {
-    Complex3DVector    m_channel; //!< channel matrix H[u][s][n].
+    Complex3DVector    m_channel; //!< channel matrix H[u][s][n], i.e., m_channel (u, s, n)
     Time               m_generatedTime; //!< generation time
     std::pair<uint32_t, uint32_t> m_antennaPair; //!< the first element is the ID of the antenna of the s-node (the antenna of the transmitter when the channel was generated), the second element is ID of the antenna of the u-node antenna (the antenna of the receiver when the channel was generated)
     std::pair<uint32_t, uint32_t> m_nodeIds; //!< the first element is the s-node ID (the transmitter when the channel was generated), the second element is the u-node ID (the receiver when the channel was generated)
@@ -251,6 +251,8 @@ ThreeGppChannelModel::ThreeGppChannelModel ()
   m_normalRv = CreateObject<NormalRandomVariable> ();
   m_normalRv->SetAttribute ("Mean", DoubleValue (0.0));
   m_normalRv->SetAttribute ("Variance", DoubleValue (1.0));
+
+  m_channelParams = Create<ChannelParamsMap> ();
 }
 
 ThreeGppChannelModel::~ThreeGppChannelModel ()
@@ -267,7 +269,7 @@ ThreeGppChannelModel::DoDispose ()
       m_channelConditionModel->Dispose ();
     }
   m_channelMatrixMap.clear ();
-  m_channelParamsMap.clear ();
+  m_channelParams = nullptr;
   m_channelConditionModel = nullptr;
 }
 
@@ -382,6 +384,19 @@ ThreeGppChannelModel::GetScenario () const
   return m_scenario;
 }
 
+void
+ThreeGppChannelModel::ShareChannelParams (Ptr<const ThreeGppChannelModel> other)
+{
+  NS_LOG_FUNCTION (this << other);
+  NS_ASSERT_MSG (m_scenario == other->m_scenario,
+                 "The channel parameters can be shared only by models of the same scenario");
+  NS_ASSERT_MSG (m_channelConditionModel == other->m_channelConditionModel,
+                 "The channel parameters can be shared only by models with the same channel condition model");
+  NS_ASSERT_MSG (m_updatePeriod == other->m_updatePeriod,
+                 "The channel parameters can be shared only by models with the same update period");
+  m_channelParams = other->m_channelParams;
+}
+
 Ptr<const ThreeGppChannelModel::ParamsTable>
 ThreeGppChannelModel::GetThreeGppTable (Ptr<const ChannelCondition> channelCondition, double hBS,
                                         double hUT, double distance2D) const
@@ -1104,9 +1119,10 @@ ThreeGppChannelModel::GetChannel (Ptr<const MobilityModel> aMob,
   Ptr<ThreeGppChannelParams> channelParams;
 
 
-  if (m_channelParamsMap.find (channelParamsKey) != m_channelParamsMap.end ())
+  auto paramsIt = m_channelParams->m_map.find (channelParamsKey);
+  if (paramsIt != m_channelParams->m_map.end ())
     {
-      channelParams = m_channelParamsMap[channelParamsKey];
+      channelParams = paramsIt->second;
       // check if it has to be updated
       updateParams = ChannelParamsNeedsUpdate (channelParams, condition);
     }
@@ -1140,7 +1156,7 @@ ThreeGppChannelModel::GetChannel (Ptr<const MobilityModel> aMob,
       //Step 10: Draw initial phases
       channelParams = GenerateChannelParameters (condition, table3gpp, aMob, bMob);
       // store or replace the channel parameters
-      m_channelParamsMap[channelParamsKey] = channelParams;
+      m_channelParams->m_map[channelParamsKey] = channelParams;
     }
 
   if (m_channelMatrixMap.find (channelMatrixKey) != m_channelMatrixMap.end ())
@@ -1180,9 +1196,10 @@ ThreeGppChannelModel::GetParams (Ptr<const MobilityModel> aMob,
   // Compute the channel key. The key is reciprocal, i.e., key (a, b) = key (b, a)
   uint64_t channelParamsKey = GetKey (aMob->GetObject<Node> ()->GetId (), bMob->GetObject<Node> ()->GetId ());
 
-  if (m_channelParamsMap.find (channelParamsKey) != m_channelParamsMap.end ())
+  auto paramsIt = m_channelParams->m_map.find (channelParamsKey);
+  if (paramsIt != m_channelParams->m_map.end ())
     {
-      return m_channelParamsMap.find (channelParamsKey)->second;
+      return paramsIt->second;
     }
   else
     {
@@ -1818,16 +1835,6 @@ ThreeGppChannelModel::GetNewChannel (Ptr<const ThreeGppChannelParams> channelPar
   uint64_t uSize = uAntenna->GetNumberOfElements ();
   uint64_t sSize = sAntenna->GetNumberOfElements ();
 
-  hUsn.resize (uSize);
-  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
-    {
-      hUsn[uIndex].resize (sSize);
-      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
-        {
-          hUsn[uIndex][sIndex].resize (channelParams->m_reducedClusterNumber);
-        }
-    }
-
   NS_ASSERT (channelParams->m_reducedClusterNumber <= channelParams->m_clusterPhase.size ());
   NS_ASSERT (channelParams->m_reducedClusterNumber <= channelParams->m_clusterPower.size ());
   NS_ASSERT (channelParams->m_reducedClusterNumber <= channelParams->m_crossPolarizationPowerRatios.size ());
@@ -1857,158 +1864,251 @@ ThreeGppChannelModel::GetNewChannel (Ptr<const ThreeGppChannelParams> channelPar
   Angles uAngle (sMob->GetPosition (), uMob->GetPosition ());
 
 
-  // The following for loops computes the channel coefficients
+  // The channel coefficients are separable: the field patterns and the
+  // polarization term of a ray do not depend on the antenna elements, and the
+  // phase of an element depends only on the ray and on that element. These
+  // terms are computed once, and then combined for every (u, s) pair.
+  const uint8_t numClusters = channelParams->m_reducedClusterNumber;
+  const uint8_t numRays = table3gpp->m_raysPerCluster;
+  const uint32_t numRaysTotal = static_cast<uint32_t> (numClusters) * numRays;
+
+  // The sub-clusters 2 and 3 of the strongest clusters follow the
+  // numClusters clusters, in the order of the cluster index
+  std::vector<uint8_t> subClusterPage (numClusters, 0);
+  uint8_t numPages = numClusters;
+  for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+    {
+      if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
+        {
+          subClusterPage[nIndex] = numPages;
+          numPages += 2;
+        }
+    }
+  hUsn.Resize (uSize, sSize, numPages);
+
+  // Unit vectors of arrival and departure of each ray (index n * numRays + m),
+  // and the angles at which the field patterns are computed
+  std::vector<Vector> rxDirection (numRaysTotal);
+  std::vector<Vector> txDirection (numRaysTotal);
+  std::vector<Angles> rxAngles;
+  std::vector<Angles> txAngles;
+  rxAngles.reserve (numRaysTotal);
+  txAngles.reserve (numRaysTotal);
+  for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+    {
+      bool strongCluster = (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd);
+      for (uint8_t mIndex = 0; mIndex < numRays; mIndex++)
+        {
+          uint32_t r = nIndex * numRays + mIndex;
+          rxDirection[r] = Vector (sin (rayZoaRadian[nIndex][mIndex]) * cos (rayAoaRadian[nIndex][mIndex]),
+                                   sin (rayZoaRadian[nIndex][mIndex]) * sin (rayAoaRadian[nIndex][mIndex]),
+                                   cos (rayZoaRadian[nIndex][mIndex]));
+          txDirection[r] = Vector (sin (rayZodRadian[nIndex][mIndex]) * cos (rayAodRadian[nIndex][mIndex]),
+                                   sin (rayZodRadian[nIndex][mIndex]) * sin (rayAodRadian[nIndex][mIndex]),
+                                   cos (rayZodRadian[nIndex][mIndex]));
+          // NOTE Doppler is computed in the CalcBeamformingGain function and is simplified to only account for the center angle of each cluster.
+
+          if (strongCluster)
+            {
+              rxAngles.emplace_back (rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]);
+              txAngles.emplace_back (rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]);
+            }
+          else
+            {
+              rxAngles.emplace_back (channelParams->m_rayAoaRadian[nIndex][mIndex], channelParams->m_rayZoaRadian[nIndex][mIndex]);
+              txAngles.emplace_back (channelParams->m_rayAodRadian[nIndex][mIndex], channelParams->m_rayZodRadian[nIndex][mIndex]);
+            }
+        }
+    }
+
+  // The field patterns of all the rays are computed at once
+  std::vector<std::pair<double, double> > rxFieldPatterns;
+  std::vector<std::pair<double, double> > txFieldPatterns;
+  uAntenna->GetElementFieldPatterns (rxAngles, rxFieldPatterns);
+  sAntenna->GetElementFieldPatterns (txAngles, txFieldPatterns);
+
+  // Polarization and field pattern term of each ray
+  std::vector<std::complex<double> > rayTerm (numRaysTotal);
+  for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+    {
+      for (uint8_t mIndex = 0; mIndex < numRays; mIndex++)
+        {
+          uint32_t r = nIndex * numRays + mIndex;
+          const DoubleVector &initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
+          NS_ASSERT (4 <= initialPhase.size ());
+          double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
+
+          double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
+          std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = rxFieldPatterns[r];
+          std::tie (txFieldPatternPhi, txFieldPatternTheta) = txFieldPatterns[r];
+
+          rayTerm[r] = std::complex<double> (cos (initialPhase[0]), sin (initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
+            std::complex<double> (cos (initialPhase[1]), sin (initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
+            std::complex<double> (cos (initialPhase[2]), sin (initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
+            std::complex<double> (cos (initialPhase[3]), sin (initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi;
+        }
+    }
+
+  // Phase of each ray at each element: rxPhase[u * numRaysTotal + r] and
+  // txPhase[s * numRaysTotal + r]. lambda_0 is accounted in the antenna
+  // spacing uLoc and sLoc.
+  const std::vector<Vector> &uLocations = uAntenna->GetElementLocations ();
+  const std::vector<Vector> &sLocations = sAntenna->GetElementLocations ();
+  std::vector<std::complex<double> > rxPhase (uSize * numRaysTotal);
+  std::vector<std::complex<double> > txPhase (sSize * numRaysTotal);
   for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
     {
-      Vector uLoc = uAntenna->GetElementLocation (uIndex);
+      const Vector &uLoc = uLocations[uIndex];
+      for (uint32_t r = 0; r < numRaysTotal; r++)
+        {
+          double rxPhaseDiff = 2 * M_PI * (rxDirection[r].x * uLoc.x + rxDirection[r].y * uLoc.y + rxDirection[r].z * uLoc.z);
+          rxPhase[uIndex * numRaysTotal + r] = std::complex<double> (cos (rxPhaseDiff), sin (rxPhaseDiff));
+        }
+    }
+  for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+    {
+      const Vector &sLoc = sLocations[sIndex];
+      for (uint32_t r = 0; r < numRaysTotal; r++)
+        {
+          double txPhaseDiff = 2 * M_PI * (txDirection[r].x * sLoc.x + txDirection[r].y * sLoc.y + txDirection[r].z * sLoc.z);
+          txPhase[sIndex * numRaysTotal + r] = std::complex<double> (cos (txPhaseDiff), sin (txPhaseDiff));
+        }
+    }
+
+  // Sub-cluster of each ray of the 2 strongest clusters (7.5-28)
+  std::vector<uint8_t> raySubCluster (numRays);
+  for (uint8_t mIndex = 0; mIndex < numRays; mIndex++)
+    {
+      switch (mIndex)
+        {
+          case 9:
+          case 10:
+          case 11:
+          case 12:
+          case 17:
+          case 18:
+            raySubCluster[mIndex] = 1;
+            break;
+          case 13:
+          case 14:
+          case 15:
+          case 16:
+            raySubCluster[mIndex] = 2;
+            break;
+          default:                      //case 1,2,3,4,5,6,7,8,19,20
+            raySubCluster[mIndex] = 0;
+            break;
+        }
+    }
+
+  // The terms of the LOS ray (7.5-29), computed only if needed
+  std::complex<double> losTerm (0, 0);
+  std::vector<std::complex<double> > rxLosPhase;
+  std::vector<std::complex<double> > txLosPhase;
+  double kLinear = 0.0;
+  if (channelParams->m_losCondition == ChannelCondition::LOS)
+    {
+      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
+      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (uAngle.GetAzimuth (), uAngle.GetInclination ()));
+      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (sAngle.GetAzimuth (), sAngle.GetInclination ()));
+
+      double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
 
+      losTerm = (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi)
+        * std::complex<double> (cos (-2 * M_PI * distance3D / lambda), sin (-2 * M_PI * distance3D / lambda));
+
+      Vector rxLosDirection (sin (uAngle.GetInclination ()) * cos (uAngle.GetAzimuth ()),
+                             sin (uAngle.GetInclination ()) * sin (uAngle.GetAzimuth ()),
+                             cos (uAngle.GetInclination ()));
+      rxLosPhase.resize (uSize);
+      for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
+          const Vector &uLoc = uLocations[uIndex];
+          double rxPhaseDiff = 2 * M_PI * (rxLosDirection.x * uLoc.x + rxLosDirection.y * uLoc.y + rxLosDirection.z * uLoc.z);
+          rxLosPhase[uIndex] = std::complex<double> (cos (rxPhaseDiff), sin (rxPhaseDiff));
+        }
+      Vector txLosDirection (sin (sAngle.GetInclination ()) * cos (sAngle.GetAzimuth ()),
+                             sin (sAngle.GetInclination ()) * sin (sAngle.GetAzimuth ()),
+                             cos (sAngle.GetInclination ()));
+      txLosPhase.resize (sSize);
       for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
         {
-          Vector sLoc = sAntenna->GetElementLocation (sIndex);
+          const Vector &sLoc = sLocations[sIndex];
+          double txPhaseDiff = 2 * M_PI * (txLosDirection.x * sLoc.x + txLosDirection.y * sLoc.y + txLosDirection.z * sLoc.z);
+          txLosPhase[sIndex] = std::complex<double> (cos (txPhaseDiff), sin (txPhaseDiff));
+        }
+
+      kLinear = pow (10, channelParams->m_K_factor / 10);
+    }
+
+  // The following for loops combine the terms in the channel coefficients
+  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+      const std::complex<double> *uRayPhase = &rxPhase[uIndex * numRaysTotal];
 
-          for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
+      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+          const std::complex<double> *sRayPhase = &txPhase[sIndex * numRaysTotal];
+
+          for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
             {
+              double clusterAmplitude = sqrt (channelParams->m_clusterPower[nIndex] / numRays);
+              uint32_t first = nIndex * numRays;
+
               //Compute the N-2 weakest cluster, assuming 0 slant angle and a
               //polarization slant angle configured in the array (7.5-22)
               if (nIndex != channelParams->m_cluster1st && nIndex != channelParams->m_cluster2nd)
                 {
                   std::complex<double> rays (0,0);
-                  for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                  for (uint32_t r = first; r < first + numRays; r++)
                     {
-                      DoubleVector initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
-                      double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
-                      //lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoaRadian[nIndex][mIndex]) * cos (rayAoaRadian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoaRadian[nIndex][mIndex]) * sin (rayAoaRadian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoaRadian[nIndex][mIndex]) * uLoc.z);
-
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZodRadian[nIndex][mIndex]) * cos (rayAodRadian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZodRadian[nIndex][mIndex]) * sin (rayAodRadian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZodRadian[nIndex][mIndex]) * sLoc.z);
-                      // NOTE Doppler is computed in the CalcBeamformingGain function and is simplified to only account for the center angle of each cluster.
-
-                      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (channelParams->m_rayAoaRadian[nIndex][mIndex], channelParams->m_rayZoaRadian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (channelParams->m_rayAodRadian[nIndex][mIndex], channelParams->m_rayZodRadian[nIndex][mIndex]));
-                      NS_ASSERT (4 <= initialPhase.size ());
-                      rays += (std::complex<double> (cos (initialPhase[0]), sin (initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                               std::complex<double> (cos (initialPhase[1]), sin (initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                               std::complex<double> (cos (initialPhase[2]), sin (initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                               std::complex<double> (cos (initialPhase[3]), sin (initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                        * std::complex<double> (cos (rxPhaseDiff), sin (rxPhaseDiff))
-                        * std::complex<double> (cos (txPhaseDiff), sin (txPhaseDiff));
+                      rays += rayTerm[r] * uRayPhase[r] * sRayPhase[r];
                     }
-                  rays *= sqrt (channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                  hUsn[uIndex][sIndex][nIndex] = rays;
+                  rays *= clusterAmplitude;
+                  hUsn (uIndex, sIndex, nIndex) = rays;
                 }
               else  //(7.5-28)
                 {
-                  std::complex<double> raysSub1 (0, 0);
-                  std::complex<double> raysSub2 (0, 0);
-                  std::complex<double> raysSub3 (0, 0);
-
-                  for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                  //ZML:Just remind me that the angle offsets for the 3 subclusters were not generated correctly.
+                  std::complex<double> raysSub[3] = {{0, 0}, {0, 0}, {0, 0}};
+                  for (uint8_t mIndex = 0; mIndex < numRays; mIndex++)
                     {
-                      double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
-
-                      //ZML:Just remind me that the angle offsets for the 3 subclusters were not generated correctly.
-                      DoubleVector initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
-                      NS_ASSERT (4 <= initialPhase.size ());
-
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoaRadian[nIndex][mIndex]) * cos (rayAoaRadian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoaRadian[nIndex][mIndex]) * sin (rayAoaRadian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoaRadian[nIndex][mIndex]) * uLoc.z);
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZodRadian[nIndex][mIndex]) * cos (rayAodRadian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZodRadian[nIndex][mIndex]) * sin (rayAodRadian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZodRadian[nIndex][mIndex]) * sLoc.z);
-
-                      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]));
-
-                      std::complex<double> raySub = (std::complex<double> (cos (initialPhase[0]), sin (initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                                     std::complex<double> (cos (initialPhase[1]), sin (initialPhase[1])) * sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                                     std::complex<double> (cos (initialPhase[2]), sin (initialPhase[2])) * sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                                     std::complex<double> (cos (initialPhase[3]), sin (initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                        * std::complex<double> (cos (rxPhaseDiff), sin (rxPhaseDiff))
-                        * std::complex<double> (cos (txPhaseDiff), sin (txPhaseDiff));
-
-                      switch (mIndex)
-                        {
-                          case 9:
-                          case 10:
-                          case 11:
-                          case 12:
-                          case 17:
-                          case 18:
-                            raysSub2 += raySub;
-                            break;
-                          case 13:
-                          case 14:
-                          case 15:
-                          case 16:
-                            raysSub3 += raySub;
-                            break;
-                          default:                      //case 1,2,3,4,5,6,7,8,19,20
-                            raysSub1 += raySub;
-                            break;
-                        }
+                      uint32_t r = first + mIndex;
+                      raysSub[raySubCluster[mIndex]] += rayTerm[r] * uRayPhase[r] * sRayPhase[r];
                     }
-                  raysSub1 *= sqrt (channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                  raysSub2 *= sqrt (channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                  raysSub3 *= sqrt (channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                  hUsn[uIndex][sIndex][nIndex] = raysSub1;
-                  hUsn[uIndex][sIndex].push_back (raysSub2);
-                  hUsn[uIndex][sIndex].push_back (raysSub3);
+                  hUsn (uIndex, sIndex, nIndex) = raysSub[0] * clusterAmplitude;
+                  hUsn (uIndex, sIndex, subClusterPage[nIndex]) = raysSub[1] * clusterAmplitude;
+                  hUsn (uIndex, sIndex, subClusterPage[nIndex] + 1) = raysSub[2] * clusterAmplitude;
                 }
             }
 
           if (channelParams->m_losCondition == ChannelCondition::LOS) //(7.5-29) && (7.5-30)
             {
-              std::complex<double> ray (0, 0);
-              double rxPhaseDiff = 2 * M_PI * (sin (uAngle.GetInclination ()) * cos (uAngle.GetAzimuth ()) * uLoc.x
-                                               + sin (uAngle.GetInclination ()) * sin (uAngle.GetAzimuth ()) * uLoc.y
-                                               + cos (uAngle.GetInclination ()) * uLoc.z);
-              double txPhaseDiff = 2 * M_PI * (sin (sAngle.GetInclination ()) * cos (sAngle.GetAzimuth ()) * sLoc.x
-                                               + sin (sAngle.GetInclination ()) * sin (sAngle.GetAzimuth ()) * sLoc.y
-                                               + cos (sAngle.GetInclination ()) * sLoc.z);
-
-              double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-              std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (uAngle.GetAzimuth (), uAngle.GetInclination ()));
-              std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (sAngle.GetAzimuth (), sAngle.GetInclination ()));
-
-              double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
-
-              ray = (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi)
-                * std::complex<double> (cos (-2 * M_PI * distance3D / lambda), sin (-2 * M_PI * distance3D / lambda))
-                * std::complex<double> (cos (rxPhaseDiff), sin (rxPhaseDiff))
-                * std::complex<double> (cos (txPhaseDiff), sin (txPhaseDiff));
-
-              double kLinear = pow (10, channelParams->m_K_factor / 10);
+              std::complex<double> ray = losTerm * rxLosPhase[uIndex] * txLosPhase[sIndex];
+
               // the LOS path should be attenuated if blockage is enabled.
-              hUsn[uIndex][sIndex][0] = sqrt (1 / (kLinear + 1)) * hUsn[uIndex][sIndex][0] + sqrt (kLinear / (1 + kLinear)) * ray / pow (10, channelParams->m_attenuation_dB[0] / 10);           //(7.5-30) for tau = tau1
-              double tempSize = hUsn[uIndex][sIndex].size ();
-              for (uint8_t nIndex = 1; nIndex < tempSize; nIndex++)
+              hUsn (uIndex, sIndex, 0) = sqrt (1 / (kLinear + 1)) * hUsn (uIndex, sIndex, 0) + sqrt (kLinear / (1 + kLinear)) * ray / pow (10, channelParams->m_attenuation_dB[0] / 10);           //(7.5-30) for tau = tau1
+              for (uint8_t nIndex = 1; nIndex < numPages; nIndex++)
                 {
-                  hUsn[uIndex][sIndex][nIndex] *= sqrt (1 / (kLinear + 1)); //(7.5-30) for tau = tau2...taunN
+                  hUsn (uIndex, sIndex, nIndex) *= sqrt (1 / (kLinear + 1)); //(7.5-30) for tau = tau2...taunN
                 }
             }
         }
     }
 
   NS_LOG_DEBUG ("Husn (sAntenna, uAntenna):" << sAntenna->GetId () << ", " << uAntenna->GetId ());
-  for (auto& i:hUsn)
+  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
     {
-      for (auto& j:i)
+      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
         {
-          for (auto& k:j)
+          for (uint8_t nIndex = 0; nIndex < numPages; nIndex++)
             {
-              NS_LOG_DEBUG (" " << k << ",");
+              NS_LOG_DEBUG (" " << hUsn (uIndex, sIndex, nIndex) << ",");
             }
         }
     }
-  NS_LOG_INFO ("size of coefficient matrix =[" << hUsn.size () << "][" << hUsn[0].size () << "][" << hUsn[0][0].size () << "]");
-  channelMatrix->m_channel = hUsn;
+  NS_LOG_INFO ("size of coefficient matrix =[" << hUsn.GetNumRows () << "][" << hUsn.GetNumCols () << "][" << hUsn.GetNumPages () << "]");
+  channelMatrix->m_channel = std::move (hUsn);
   return channelMatrix;
 }
 
@@ -43,6 +43,11 @@ class MobilityModel;
  * The class implements the channel matrix generation procedure
  * described in 3GPP TR 38.901.
  *
+ * The channel parameters of a pair of nodes (large scale parameters, cluster
+ * delays, powers and angles) can be shared by the channel models of
+ * co-located carriers, see ShareChannelParams. In this case, each model only
+ * generates the channel matrices of its own antennas and frequency.
+ *
  * \see GetChannel
  */
 class ThreeGppChannelModel : public MatrixBasedChannelModel
@@ -102,6 +107,23 @@ public:
    */
   std::string GetScenario (void) const;
 
+  /**
+   * Share the channel parameters of the pairs of nodes with another channel
+   * model, e.g., the one of another carrier of the same band, so that they
+   * are generated once for both models. The channel matrices are still
+   * generated by each model, with its own frequency and antennas.
+   *
+   * This is an approximation: the parameters are drawn with the 3GPP tables,
+   * and the blockage attenuation, of the frequency of the model that
+   * generates them, so it holds for carriers that are close in frequency.
+   * The two models must use the same scenario, channel condition model and
+   * update period, otherwise each model would regenerate the parameters of
+   * the other one.
+   *
+   * \param other the channel model whose parameters are shared
+   */
+  void ShareChannelParams (Ptr<const ThreeGppChannelModel> other);
+
   /**
    * Looks for the channel matrix associated to the aMob and bMob pair in m_channelMatrixMap.
    * If found, it checks if it has to be updated. If not found or if it has to
@@ -122,7 +144,7 @@ public:
 
   /**
    * Looks for the channel params associated to the aMob and bMob pair in
-   * m_channelParamsMap. If not found it will return a nullptr.
+   * m_channelParams. If not found it will return a nullptr.
    *
    * \param aMob mobility model of the a device
    * \param bMob mobility model of the b device
@@ -312,8 +334,17 @@ protected:
    */
   bool ChannelMatrixNeedsUpdate (Ptr<const ThreeGppChannelParams> channelParams, Ptr<const ChannelMatrix> channelMatrix);
 
+  /**
+   * The common channel parameters per pair of nodes, that can be shared by
+   * several channel models
+   */
+  struct ChannelParamsMap : public SimpleRefCount<ChannelParamsMap>
+  {
+    std::unordered_map<uint64_t, Ptr<ThreeGppChannelParams> > m_map; //!< the channel parameters, the key of this map is reciprocal and uniquely identifies a pair of nodes
+  };
+
   std::unordered_map<uint64_t, Ptr<ChannelMatrix> > m_channelMatrixMap; //!< map containing the channel realizations per pair of PhasedAntennaArray instances, the key of this map is reciprocal uniquely identifies a pair of PhasedAntennaArrays
-  std::unordered_map<uint64_t, Ptr<ThreeGppChannelParams> > m_channelParamsMap; //!< map containing the common channel parameters per pair of nodes, the key of this map is reciprocal and uniquely identifies a pair of nodes
+  Ptr<ChannelParamsMap> m_channelParams; //!< the common channel parameters per pair of nodes, possibly shared with other channel models
   Time m_updatePeriod; //!< the channel update period
   double m_frequency; //!< the operating frequency
   std::string m_scenario; //!< the 3GPP scenario
@@ -27,8 +27,10 @@
 #include "ns3/node.h"
 #include "ns3/double.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 #include "ns3/simulator.h"
 #include "ns3/pointer.h"
+#include <algorithm>
 #include <map>
 
 namespace ns3 {
@@ -68,6 +70,26 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId (void)
                   MakePointerAccessor (&ThreeGppSpectrumPropagationLossModel::SetChannelModel,
                                        &ThreeGppSpectrumPropagationLossModel::GetChannelModel),
                                        MakePointerChecker<MatrixBasedChannelModel> ())
+    .AddAttribute ("LongTermCacheSize",
+                   "The maximum number of beam pairs whose long term component is "
+                   "cached for each pair of antenna arrays. The least recently used "
+                   "beam pair is dropped when the cache is full.",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("LongTermCacheHits",
+                   "The number of long term components found in the cache",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ThreeGppSpectrumPropagationLossModel::GetLongTermCacheHits),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("LongTermCacheMisses",
+                   "The number of long term components computed because they "
+                   "were not in the cache",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMisses),
+                   MakeUintegerChecker<uint64_t> ())
     ;
   return tid;
 }
@@ -114,31 +136,18 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm (Ptr<const MatrixBasedChannel
   uint16_t sAntenna = static_cast<uint16_t> (sW.size ());
   uint16_t uAntenna = static_cast<uint16_t> (uW.size ());
 
-  NS_ASSERT (uAntenna == params->m_channel.size ());
-  NS_ASSERT (sAntenna == params->m_channel.at (0).size());
+  NS_ASSERT (uAntenna == params->m_channel.GetNumRows ());
+  NS_ASSERT (sAntenna == params->m_channel.GetNumCols ());
 
   NS_LOG_DEBUG ("CalcLongTerm with sAntenna " << sAntenna << " uAntenna " << uAntenna);
   //store the long term part to reduce computation load
   //only the small scale fading needs to be updated if the large scale parameters and antenna weights remain unchanged.
-  PhasedArrayModel::ComplexVector longTerm;
-  uint8_t numCluster = static_cast<uint8_t> (params->m_channel[0][0].size ());
-
-  NS_ASSERT (uAntenna == params->m_channel.size ());
-  NS_ASSERT (sAntenna == params->m_channel.at (0).size());
+  uint8_t numCluster = static_cast<uint8_t> (params->m_channel.GetNumPages ());
+  PhasedArrayModel::ComplexVector longTerm (numCluster);
 
   for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
     {
-      std::complex<double> txSum (0, 0);
-      for (uint16_t sIndex = 0; sIndex < sAntenna; sIndex++)
-        {
-          std::complex<double> rxSum (0, 0);
-          for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
-            {
-              rxSum = rxSum + uW[uIndex] * params->m_channel[uIndex][sIndex][cIndex];
-            }
-          txSum = txSum + sW[sIndex] * rxSum;
-        }
-      longTerm.push_back (txSum);
+      longTerm[cIndex] = params->m_channel.MultiplyLeftAndRight (uW, sW, cIndex);
     }
   return longTerm;
 }
@@ -155,7 +164,7 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<SpectrumValue> tx
   Ptr<SpectrumValue> tempPsd = Copy<SpectrumValue> (txPsd);
 
   //channel[rx][tx][cluster]
-  uint8_t numCluster = static_cast<uint8_t> (channelMatrix->m_channel[0][0].size ());
+  uint8_t numCluster = static_cast<uint8_t> (channelMatrix->m_channel.GetNumPages ());
 
   // compute the doppler term
   // NOTE the update of Doppler is simplified by only taking the center angle of
@@ -260,65 +269,71 @@ ThreeGppSpectrumPropagationLossModel::GetLongTerm (Ptr<const MatrixBasedChannelM
                                                    Ptr<const PhasedArrayModel> aPhasedArrayModel,
                                                    Ptr<const PhasedArrayModel> bPhasedArrayModel) const
 {
-  PhasedArrayModel::ComplexVector longTerm; // vector containing the long term component for each cluster
-
   // check if the channel matrix was generated considering a as the s-node and
   // b as the u-node or viceversa
-  PhasedArrayModel::ComplexVector sW, uW;
-  if (!channelMatrix->IsReverse (aPhasedArrayModel->GetId (), bPhasedArrayModel->GetId ()))
+  Ptr<const PhasedArrayModel> sPhasedArrayModel = aPhasedArrayModel;
+  Ptr<const PhasedArrayModel> uPhasedArrayModel = bPhasedArrayModel;
+  if (channelMatrix->IsReverse (aPhasedArrayModel->GetId (), bPhasedArrayModel->GetId ()))
   {
-    sW = aPhasedArrayModel->GetBeamformingVector ();
-    uW = bPhasedArrayModel->GetBeamformingVector ();
-  }
-  else
-  {
-    sW = bPhasedArrayModel->GetBeamformingVector ();
-    uW = aPhasedArrayModel->GetBeamformingVector ();
+    std::swap (sPhasedArrayModel, uPhasedArrayModel);
   }
-
-  bool update = false; // indicates whether the long term has to be updated
-  bool notFound = false; // indicates if the long term has not been computed yet
+  const PhasedArrayModel::ComplexVector &sW = sPhasedArrayModel->GetBeamformingVectorRef ();
+  const PhasedArrayModel::ComplexVector &uW = uPhasedArrayModel->GetBeamformingVectorRef ();
+  uint64_t sHash = sPhasedArrayModel->GetBeamformingVectorHash ();
+  uint64_t uHash = uPhasedArrayModel->GetBeamformingVectorHash ();
 
   // compute the long term key, the key is unique for each tx-rx pair
   uint64_t longTermId = MatrixBasedChannelModel::GetKey (aPhasedArrayModel->GetId (), bPhasedArrayModel->GetId ());
+  LongTermCache &cache = m_longTermMap[longTermId];
 
-  // look for the long term in the map and check if it is valid
-  if (m_longTermMap.find (longTermId) != m_longTermMap.end ())
+  // the long terms computed with a previous channel matrix are not valid anymore
+  if (cache.m_channel == nullptr || cache.m_channel->m_generatedTime != channelMatrix->m_generatedTime)
     {
-      NS_LOG_DEBUG ("found the long term component in the map");
-      longTerm = m_longTermMap[longTermId]->m_longTerm;
-
-      // check if the channel matrix has been updated
-      // or the s beam has been changed
-      // or the u beam has been changed
-      update = (m_longTermMap[longTermId]->m_channel->m_generatedTime != channelMatrix->m_generatedTime
-                || m_longTermMap[longTermId]->m_sW != sW
-                || m_longTermMap[longTermId]->m_uW != uW);
-
+      NS_LOG_DEBUG ("new channel matrix, discard the cached long term components");
+      cache.m_channel = channelMatrix;
+      cache.m_entries.clear ();
     }
-  else
+
+  // look for the beam pair among the cached ones, the most recently used first
+  for (auto it = cache.m_entries.begin (); it != cache.m_entries.end (); ++it)
     {
-      NS_LOG_DEBUG ("long term component NOT found");
-      notFound = true;
+      if (it->m_sHash == sHash && it->m_uHash == uHash && it->m_sW == sW && it->m_uW == uW)
+        {
+          NS_LOG_DEBUG ("found the long term component in the cache");
+          ++m_longTermCacheHits;
+          std::rotate (cache.m_entries.begin (), it, it + 1);
+          return cache.m_entries.front ().m_longTerm;
+        }
     }
 
-  if (update || notFound)
+  NS_LOG_DEBUG ("compute the long term");
+  ++m_longTermCacheMisses;
+  if (cache.m_entries.size () >= m_longTermCacheSize)
     {
-      NS_LOG_DEBUG ("compute the long term");
-      // compute the long term component
-      longTerm = CalcLongTerm (channelMatrix, sW, uW);
-
-      // store the long term
-      Ptr<LongTerm> longTermItem = Create<LongTerm> ();
-      longTermItem->m_longTerm = longTerm;
-      longTermItem->m_channel = channelMatrix;
-      longTermItem->m_sW = sW;
-      longTermItem->m_uW = uW;
-
-      m_longTermMap[longTermId] = longTermItem;
+      // drop the least recently used beam pair
+      cache.m_entries.pop_back ();
     }
+  LongTerm entry;
+  entry.m_longTerm = CalcLongTerm (channelMatrix, sW, uW);
+  entry.m_sW = sW;
+  entry.m_uW = uW;
+  entry.m_sHash = sHash;
+  entry.m_uHash = uHash;
+  cache.m_entries.insert (cache.m_entries.begin (), std::move (entry));
+
+  return cache.m_entries.front ().m_longTerm;
+}
 
-  return longTerm;
+uint64_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheHits () const
+{
+  return m_longTermCacheHits;
+}
+
+uint64_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMisses () const
+{
+  return m_longTermCacheMisses;
 }
 
 Ptr<SpectrumValue>
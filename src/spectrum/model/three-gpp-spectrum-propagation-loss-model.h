@@ -106,9 +106,10 @@ public:
    * the product between the cluster matrices and the TX and RX beamforming
    * vectors (w_rx^T H^n_ab w_tx), and accounts for the Doppler component and
    * the propagation delay.
-   * To reduce the computational load, the long term component associated with
-   * a certain channel is cached and recomputed only when the channel realization
-   * is updated, or when the beamforming vectors change.
+   * To reduce the computational load, the long term components associated with
+   * a certain channel are cached for the last LongTermCacheSize beam pairs,
+   * and recomputed only when the channel realization is updated, or when a
+   * beam pair that is not in the cache is used.
    *
    * \param txPsd tx PSD
    * \param a first node mobility model
@@ -123,16 +124,38 @@ public:
                                                    Ptr<const PhasedArrayModel> aPhasedArrayModel,
                                                    Ptr<const PhasedArrayModel> bPhasedArrayModel) const override;
 
+  /**
+   * \return the number of long term components found in the cache
+   */
+  uint64_t GetLongTermCacheHits () const;
+
+  /**
+   * \return the number of long term components computed because they were
+   * not in the cache
+   */
+  uint64_t GetLongTermCacheMisses () const;
+
 private:
   /**
-   * Data structure that stores the long term component for a tx-rx pair
+   * Data structure that stores the long term component for a beam pair
    */
-  struct LongTerm : public SimpleRefCount<LongTerm>
+  struct LongTerm
   {
     PhasedArrayModel::ComplexVector m_longTerm; //!< vector containing the long term component for each cluster
-    Ptr<const MatrixBasedChannelModel::ChannelMatrix> m_channel; //!< pointer to the channel matrix used to compute the long term
     PhasedArrayModel::ComplexVector m_sW; //!< the beamforming vector for the node s used to compute the long term
     PhasedArrayModel::ComplexVector m_uW; //!< the beamforming vector for the node u used to compute the long term
+    uint64_t m_sHash {0}; //!< the hash of m_sW
+    uint64_t m_uHash {0}; //!< the hash of m_uW
+  };
+
+  /**
+   * Data structure that stores the long term components of a tx-rx pair
+   * for the most recently used beam pairs
+   */
+  struct LongTermCache
+  {
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> m_channel; //!< pointer to the channel matrix used to compute the long terms
+    std::vector<LongTerm> m_entries; //!< the long terms, from the most recently used
   };
 
   /**
@@ -142,9 +165,10 @@ private:
   double GetFrequency () const;
 
   /**
-   * Looks for the long term component in m_longTermMap. If found, checks
-   * whether it has to be updated. If not found or if it has to be updated,
-   * calls the method CalcLongTerm to compute it.
+   * Looks for the long term component of the current beam pair in
+   * m_longTermMap. The cache of the tx-rx pair is emptied if the channel
+   * matrix has been updated. If not found, calls the method CalcLongTerm to
+   * compute it, and stores it in place of the least recently used one.
    * \param channelMatrix the channel matrix
    * \param aPhasedArrayModel the antenna array of the tx device
    * \param bPhasedArrayModel the antenna array of the rx device
@@ -180,7 +204,10 @@ private:
                                           Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
                                           const Vector &sSpeed, const Vector &uSpeed) const;
 
-  mutable std::unordered_map < uint64_t, Ptr<const LongTerm> > m_longTermMap; //!< map containing the long term components
+  mutable std::unordered_map < uint64_t, LongTermCache > m_longTermMap; //!< map containing the long term components of each tx-rx pair
+  uint32_t m_longTermCacheSize {8}; //!< maximum number of beam pairs cached for each tx-rx pair
+  mutable uint64_t m_longTermCacheHits {0}; //!< number of long term components found in the cache
+  mutable uint64_t m_longTermCacheMisses {0}; //!< number of long term components not found in the cache
   Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
 };
 } // namespace ns3
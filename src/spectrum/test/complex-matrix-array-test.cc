@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/complex-matrix-array.h>
+#include <ns3/test.h>
+#include <cstdint>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case that checks the layout and the alignment of the elements of
+ * a ComplexMatrixArray, and that MultiplyLeftAndRight gives the same
+ * result as the sum over the elements.
+ */
+class ComplexMatrixArrayTestCase : public TestCase
+{
+public:
+  ComplexMatrixArrayTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+ComplexMatrixArrayTestCase::ComplexMatrixArrayTestCase ()
+  : TestCase ("Check the layout and the products of a ComplexMatrixArray")
+{}
+
+void
+ComplexMatrixArrayTestCase::DoRun (void)
+{
+  const std::size_t numRows = 4;
+  const std::size_t numCols = 7;
+  const std::size_t numPages = 3;
+  ComplexMatrixArray array (numRows, numCols, numPages);
+
+  NS_TEST_ASSERT_MSG_EQ (array.GetSize (), numRows * numCols * numPages, "Wrong number of elements");
+  NS_TEST_ASSERT_MSG_EQ (reinterpret_cast<std::uintptr_t> (array.GetPage (0)) % 64, 0, "The elements are not aligned");
+
+  for (std::size_t page = 0; page < numPages; page++)
+    {
+      for (std::size_t row = 0; row < numRows; row++)
+        {
+          for (std::size_t col = 0; col < numCols; col++)
+            {
+              array (row, col, page) = std::complex<double> (row + 0.5 * col, page - 0.25 * col);
+            }
+        }
+    }
+
+  // The rows of a page are contiguous, and the pages follow one another
+  const std::complex<double> *data = array.GetPage (0);
+  for (std::size_t page = 0; page < numPages; page++)
+    {
+      for (std::size_t row = 0; row < numRows; row++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (array.GetRow (row, page), data + (page * numRows + row) * numCols, "Wrong position of the row");
+          for (std::size_t col = 0; col < numCols; col++)
+            {
+              NS_TEST_ASSERT_MSG_EQ ((data[(page * numRows + row) * numCols + col] == array (row, col, page)), true, "Wrong element");
+            }
+        }
+    }
+
+  std::vector<std::complex<double> > left (numRows);
+  std::vector<std::complex<double> > right (numCols);
+  for (std::size_t row = 0; row < numRows; row++)
+    {
+      left[row] = std::complex<double> (1.0 / (row + 1), -0.5 * row);
+    }
+  for (std::size_t col = 0; col < numCols; col++)
+    {
+      right[col] = std::complex<double> (0.1 * col, 1.0 - 0.2 * col);
+    }
+  for (std::size_t page = 0; page < numPages; page++)
+    {
+      std::complex<double> expected (0, 0);
+      for (std::size_t row = 0; row < numRows; row++)
+        {
+          for (std::size_t col = 0; col < numCols; col++)
+            {
+              expected += left[row] * array (row, col, page) * right[col];
+            }
+        }
+      std::complex<double> product = array.MultiplyLeftAndRight (left, right, page);
+      NS_TEST_ASSERT_MSG_EQ_TOL (product.real (), expected.real (), 1e-9, "Wrong real part of page " << page);
+      NS_TEST_ASSERT_MSG_EQ_TOL (product.imag (), expected.imag (), 1e-9, "Wrong imaginary part of page " << page);
+    }
+
+  ComplexMatrixArray copy = array;
+  NS_TEST_ASSERT_MSG_EQ ((copy == array), true, "The copy is different");
+  copy (1, 2, 2) += 1.0;
+  NS_TEST_ASSERT_MSG_EQ ((copy != array), true, "The modified copy is equal");
+  NS_TEST_ASSERT_MSG_EQ ((ComplexMatrixArray (numCols, numRows, numPages) != ComplexMatrixArray (numRows, numCols, numPages)), true,
+                         "Arrays with different sizes are equal");
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test suite for the ComplexMatrixArray
+ */
+class ComplexMatrixArrayTestSuite : public TestSuite
+{
+public:
+  ComplexMatrixArrayTestSuite ();
+};
+
+ComplexMatrixArrayTestSuite::ComplexMatrixArrayTestSuite ()
+  : TestSuite ("complex-matrix-array", UNIT)
+{
+  AddTestCase (new ComplexMatrixArrayTestCase (), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static ComplexMatrixArrayTestSuite g_complexMatrixArrayTestSuite;
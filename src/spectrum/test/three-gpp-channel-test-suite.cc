@@ -97,7 +97,7 @@ ThreeGppChannelMatrixComputationTest::DoComputeNorm (Ptr<ThreeGppChannelModel> c
   Ptr<const ThreeGppChannelModel::ChannelMatrix> channelMatrix = channelModel->GetChannel (txMob, rxMob, txAntenna, rxAntenna);
 
   double channelNorm = 0;
-  uint8_t numTotClusters = channelMatrix->m_channel.at (0).at (0).size ();
+  uint8_t numTotClusters = channelMatrix->m_channel.GetNumPages ();
   for (uint8_t cIndex = 0; cIndex < numTotClusters; cIndex++)
   {
     double clusterNorm = 0;
@@ -105,7 +105,7 @@ ThreeGppChannelMatrixComputationTest::DoComputeNorm (Ptr<ThreeGppChannelModel> c
     {
       for (uint32_t uIndex = 0; uIndex < rxAntennaElements; uIndex++)
       {
-        clusterNorm += std::pow (std::abs (channelMatrix->m_channel.at (uIndex).at (sIndex).at (cIndex)), 2);
+        clusterNorm += std::pow (std::abs (channelMatrix->m_channel (uIndex, sIndex, cIndex)), 2);
       }
     }
     channelNorm += clusterNorm;
@@ -167,8 +167,8 @@ ThreeGppChannelMatrixComputationTest::DoRun (void)
   Ptr<const ThreeGppChannelModel::ChannelMatrix> channelMatrix = channelModel->GetChannel (txMob, rxMob, txAntenna, rxAntenna);
 
   // check the channel matrix dimensions
-  NS_TEST_ASSERT_MSG_EQ (channelMatrix->m_channel.at (0).size (), txAntennaElements [0] * txAntennaElements [1], "The second dimension of H should be equal to the number of tx antenna elements");
-  NS_TEST_ASSERT_MSG_EQ (channelMatrix->m_channel.size (), rxAntennaElements [0] * rxAntennaElements [1], "The first dimension of H should be equal to the number of rx antenna elements");
+  NS_TEST_ASSERT_MSG_EQ (channelMatrix->m_channel.GetNumCols (), txAntennaElements [0] * txAntennaElements [1], "The second dimension of H should be equal to the number of tx antenna elements");
+  NS_TEST_ASSERT_MSG_EQ (channelMatrix->m_channel.GetNumRows (), rxAntennaElements [0] * rxAntennaElements [1], "The first dimension of H should be equal to the number of rx antenna elements");
 
   // test if the channel matrix is correctly generated
   uint16_t numIt = 1000;
@@ -349,6 +349,146 @@ ThreeGppChannelMatrixUpdateTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case for the ThreeGppChannelModel class.
+ * It checks that two channel models that share the channel parameters,
+ * e.g., of two carriers of the same band, use the same parameters for a
+ * pair of nodes, and that each model generates its own channel matrix,
+ * which is updated when the shared parameters are updated by the other
+ * model.
+ */
+class ThreeGppSharedChannelParamsTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppSharedChannelParamsTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~ThreeGppSharedChannelParamsTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Compute the channel matrices of the two models, the second model first,
+   * and check the channel parameters
+   * \param update whether the channel should be updated or not
+   */
+  void DoGetChannels (bool update);
+
+  Ptr<ThreeGppChannelModel> m_channelModels[2]; //!< the channel models that share the parameters
+  Ptr<PhasedArrayModel> m_txAntennas[2]; //!< the tx antennas of the two models
+  Ptr<PhasedArrayModel> m_rxAntennas[2]; //!< the rx antennas of the two models
+  Ptr<MobilityModel> m_txMob; //!< the mobility model of the tx node
+  Ptr<MobilityModel> m_rxMob; //!< the mobility model of the rx node
+  Ptr<const ThreeGppChannelModel::ChannelParams> m_currentParams; //!< the current channel parameters
+  Ptr<const ThreeGppChannelModel::ChannelMatrix> m_currentChannels[2]; //!< the current channel matrices of the two models
+};
+
+ThreeGppSharedChannelParamsTest::ThreeGppSharedChannelParamsTest ()
+  : TestCase ("Check the channel parameters shared by two channel models")
+{
+}
+
+ThreeGppSharedChannelParamsTest::~ThreeGppSharedChannelParamsTest ()
+{
+}
+
+void
+ThreeGppSharedChannelParamsTest::DoGetChannels (bool update)
+{
+  Ptr<const ThreeGppChannelModel::ChannelMatrix> channels[2];
+  for (int8_t i = 1; i >= 0; i--)
+    {
+      channels[i] = m_channelModels[i]->GetChannel (m_txMob, m_rxMob, m_txAntennas[i], m_rxAntennas[i]);
+      NS_TEST_ASSERT_MSG_EQ (channels[i]->m_channel.GetNumRows (), m_rxAntennas[i]->GetNumberOfElements (),
+                             "The channel matrix does not match the rx antenna of the model");
+      NS_TEST_ASSERT_MSG_EQ (channels[i]->m_channel.GetNumCols (), m_txAntennas[i]->GetNumberOfElements (),
+                             "The channel matrix does not match the tx antenna of the model");
+      if (m_currentChannels[i] != nullptr)
+        {
+          NS_TEST_ASSERT_MSG_EQ ((m_currentChannels[i] != channels[i]), update, "The channel matrix is not correctly updated");
+        }
+      m_currentChannels[i] = channels[i];
+    }
+
+  Ptr<const ThreeGppChannelModel::ChannelParams> params = m_channelModels[0]->GetParams (m_txMob, m_rxMob);
+  NS_TEST_ASSERT_MSG_NE (params, nullptr, "The channel parameters are not found");
+  NS_TEST_ASSERT_MSG_EQ (m_channelModels[1]->GetParams (m_txMob, m_rxMob), params, "The channel parameters are not shared");
+  if (m_currentParams != nullptr)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((m_currentParams != params), update, "The channel parameters are not correctly updated");
+    }
+  m_currentParams = params;
+}
+
+void
+ThreeGppSharedChannelParamsTest::DoRun (void)
+{
+  uint32_t updatePeriodMs = 100; // update period in ms
+  double frequencies[] {28.0e9, 28.4e9}; // the frequencies of the two carriers
+  uint8_t txAntennaElements[][2] {{2, 2}, {4, 2}}; // tx antenna dimensions
+  uint8_t rxAntennaElements[][2] {{4, 4}, {2, 1}}; // rx antenna dimensions
+
+  Ptr<ChannelConditionModel> channelConditionModel = CreateObject<AlwaysLosChannelConditionModel> ();
+
+  for (uint8_t i = 0; i < 2; i++)
+    {
+      m_channelModels[i] = CreateObject<ThreeGppChannelModel> ();
+      m_channelModels[i]->SetAttribute ("Frequency", DoubleValue (frequencies[i]));
+      m_channelModels[i]->SetAttribute ("Scenario", StringValue ("UMa"));
+      m_channelModels[i]->SetAttribute ("ChannelConditionModel", PointerValue (channelConditionModel));
+      m_channelModels[i]->SetAttribute ("UpdatePeriod", TimeValue (MilliSeconds (updatePeriodMs)));
+
+      m_txAntennas[i] = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (txAntennaElements[i][0]),
+                                                                        "NumRows", UintegerValue (txAntennaElements[i][1]),
+                                                                        "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+      m_rxAntennas[i] = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (rxAntennaElements[i][0]),
+                                                                        "NumRows", UintegerValue (rxAntennaElements[i][1]),
+                                                                        "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+    }
+  m_channelModels[1]->ShareChannelParams (m_channelModels[0]);
+
+  // create the tx and rx nodes, with their mobility models
+  NodeContainer nodes;
+  nodes.Create (2);
+  m_txMob = CreateObject<ConstantPositionMobilityModel> ();
+  m_txMob->SetPosition (Vector (0.0, 0.0, 10.0));
+  m_rxMob = CreateObject<ConstantPositionMobilityModel> ();
+  m_rxMob->SetPosition (Vector (100.0, 0.0, 1.6));
+  nodes.Get (0)->AggregateObject (m_txMob);
+  nodes.Get (1)->AggregateObject (m_rxMob);
+
+  // the first model does not find the parameters generated by the second
+  // one, and the matrices are updated when the second model updates the
+  // parameters
+  uint32_t firstTimeMs = 1;
+  Simulator::Schedule (MilliSeconds (firstTimeMs), &ThreeGppSharedChannelParamsTest::DoGetChannels, this, true);
+  Simulator::Schedule (MilliSeconds (firstTimeMs + updatePeriodMs / 2), &ThreeGppSharedChannelParamsTest::DoGetChannels, this, false);
+  Simulator::Schedule (MilliSeconds (firstTimeMs + updatePeriodMs + 1), &ThreeGppSharedChannelParamsTest::DoGetChannels, this, true);
+
+  Simulator::Run ();
+
+  // a model that does not share the parameters generates its own ones
+  Ptr<ThreeGppChannelModel> otherModel = CreateObject<ThreeGppChannelModel> ();
+  otherModel->SetAttribute ("Frequency", DoubleValue (frequencies[0]));
+  otherModel->SetAttribute ("Scenario", StringValue ("UMa"));
+  otherModel->SetAttribute ("ChannelConditionModel", PointerValue (channelConditionModel));
+  otherModel->GetChannel (m_txMob, m_rxMob, m_txAntennas[0], m_rxAntennas[0]);
+  NS_TEST_ASSERT_MSG_NE (otherModel->GetParams (m_txMob, m_rxMob), m_currentParams, "The channel parameters are shared");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup spectrum-tests
  * \brief A structure that holds the parameters for the function
@@ -560,16 +700,30 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun ()
   // change the position of the rx device and recompute the beamforming vectors
   rxMob->SetPosition (Vector (10.0, 5.0, 10.0));
   PhasedArrayModel::ComplexVector txBfVector = txAntenna->GetBeamformingVector ();
+  PhasedArrayModel::ComplexVector txBfVectorOld = txBfVector;
   txBfVector [0] = std::complex<double> (0.0, 0.0);
   txAntenna->SetBeamformingVector (txBfVector);
 
   rxPsdNew = lossModel->DoCalcRxPowerSpectralDensity (txPsd, rxMob, txMob, rxAntenna, txAntenna);
   NS_TEST_ASSERT_MSG_EQ (ArePsdEqual (rxPsdOld, rxPsdNew),  false, "Changing the BF vectors the rx PSD does not change");
 
+  // 3) check that the long terms of the previous beam pairs are taken from
+  // the cache, and that they give the same rx PSD
+  NS_TEST_ASSERT_MSG_EQ (lossModel->GetLongTermCacheMisses (), 2, "Wrong number of long terms computed");
+  NS_TEST_ASSERT_MSG_EQ (lossModel->GetLongTermCacheHits (), 1, "The long term of the reverse channel was not cached");
+  txAntenna->SetBeamformingVector (txBfVectorOld);
+  Ptr<SpectrumValue> rxPsdCached = lossModel->DoCalcRxPowerSpectralDensity (txPsd, rxMob, txMob, rxAntenna, txAntenna);
+  NS_TEST_ASSERT_MSG_EQ (ArePsdEqual (rxPsdOld, rxPsdCached),  true, "The cached long term gives a different rx PSD");
+  txAntenna->SetBeamformingVector (txBfVector);
+  rxPsdCached = lossModel->DoCalcRxPowerSpectralDensity (txPsd, rxMob, txMob, rxAntenna, txAntenna);
+  NS_TEST_ASSERT_MSG_EQ (ArePsdEqual (rxPsdNew, rxPsdCached),  true, "The cached long term gives a different rx PSD");
+  NS_TEST_ASSERT_MSG_EQ (lossModel->GetLongTermCacheMisses (), 2, "The long term of a previous beam pair was computed again");
+  NS_TEST_ASSERT_MSG_EQ (lossModel->GetLongTermCacheHits (), 3, "The long term of a previous beam pair was not cached");
+
   // update rxPsdOld
   rxPsdOld = rxPsdNew;
 
-  // 3) check if the long term is updated when the channel matrix is recomputed
+  // 4) check if the long term is updated when the channel matrix is recomputed
   Simulator::Schedule (MilliSeconds (101), &ThreeGppSpectrumPropagationLossModelTest::CheckLongTermUpdate,
                        this, CheckLongTermUpdateParams (lossModel, txPsd, txMob, rxMob, rxPsdOld, txAntenna, rxAntenna));
 
@@ -596,6 +750,7 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite ()
 {
   AddTestCase (new ThreeGppChannelMatrixComputationTest, TestCase::QUICK);
   AddTestCase (new ThreeGppChannelMatrixUpdateTest, TestCase::QUICK);
+  AddTestCase (new ThreeGppSharedChannelParamsTest, TestCase::QUICK);
   AddTestCase (new ThreeGppSpectrumPropagationLossModelTest, TestCase::QUICK);
 }
 
@@ -22,6 +22,7 @@
 #include "ns3/abort.h"
 #include "ns3/log.h"
 #include "ns3/nstime.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -36,6 +37,22 @@ SQLiteOutput::SQLiteOutput (const std::string &name, const std::string &semName)
 
 SQLiteOutput::~SQLiteOutput ()
 {
+  if (m_writer.joinable ())
+    {
+      {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_stop = true;
+      }
+      m_queued.notify_one ();
+      m_writer.join ();
+    }
+
+  for (auto &statement : m_insertStatements)
+    {
+      SpinFinalize (statement.second);
+    }
+  m_insertStatements.clear ();
+
   int rc = SQLITE_FAIL;
 
   rc = sqlite3_close_v2 (m_db);
@@ -49,15 +66,191 @@ SQLiteOutput::SetJournalInMemory ()
   SpinExec ("PRAGMA journal_mode = MEMORY");
 }
 
+void
+SQLiteOutput::SetWalMode ()
+{
+  NS_LOG_FUNCTION (this);
+  // the pragma returns the new journal mode as a row, so it is not run
+  // with SpinExec, which expects no rows
+  sqlite3_stmt *stmt;
+  int rc = SpinPrepare (m_db, &stmt, "PRAGMA journal_mode = WAL;");
+  CheckError (m_db, rc, "PRAGMA journal_mode = WAL;", nullptr, true);
+  rc = SpinStep (stmt);
+  NS_ABORT_MSG_IF (rc != SQLITE_ROW, "PRAGMA journal_mode = WAL; error " << sqlite3_errmsg (m_db));
+  NS_ABORT_MSG_IF (std::string (reinterpret_cast<const char *> (sqlite3_column_text (stmt, 0))) != "wal",
+                   "The database " << m_dBname << " does not support the WAL journal");
+  SpinFinalize (stmt);
+  SpinExec ("PRAGMA synchronous = NORMAL;");
+}
+
+void
+SQLiteOutput::EnableAsyncWrite (std::size_t maxPendingBatches)
+{
+  NS_LOG_FUNCTION (this << maxPendingBatches);
+  NS_ABORT_MSG_IF (maxPendingBatches == 0, "At least one batch must be queued");
+  NS_ABORT_MSG_IF (m_writer.joinable (), "The asynchronous write is already enabled");
+  m_maxPending = maxPendingBatches;
+  m_writer = std::thread (&SQLiteOutput::WriterLoop, this);
+}
+
+void
+SQLiteOutput::Write (RowBatch &&batch)
+{
+  NS_LOG_FUNCTION (this << batch.GetTable () << batch.GetNumRows ());
+  if (batch.GetNumRows () == 0)
+    {
+      return;
+    }
+  if (!m_writer.joinable ())
+    {
+      WriteBatch (batch);
+      return;
+    }
+
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    m_written.wait (lock, [this] { return m_pending.size () < m_maxPending; });
+    m_pending.push_back (std::move (batch));
+  }
+  m_queued.notify_one ();
+}
+
+void
+SQLiteOutput::Flush () const
+{
+  if (!m_writer.joinable ())
+    {
+      return;
+    }
+  std::unique_lock<std::mutex> lock (m_mutex);
+  m_written.wait (lock, [this] { return m_pending.empty () && !m_writing; });
+}
+
+void
+SQLiteOutput::WriterLoop ()
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (true)
+    {
+      m_queued.wait (lock, [this] { return m_stop || !m_pending.empty (); });
+      if (m_pending.empty ())
+        {
+          // m_stop is set, and all the batches are written
+          return;
+        }
+      RowBatch batch = std::move (m_pending.front ());
+      m_pending.pop_front ();
+      m_writing = true;
+      lock.unlock ();
+      // there is space for another batch in the queue
+      m_written.notify_all ();
+
+      WriteBatch (batch);
+
+      lock.lock ();
+      m_writing = false;
+      m_written.notify_all ();
+    }
+}
+
+SQLiteOutput::RowBatch::RowBatch (const std::string &table, uint32_t numColumns)
+  : m_table (table),
+    m_numColumns (numColumns)
+{
+  NS_ASSERT (numColumns > 0);
+}
+
+sqlite3_stmt *
+SQLiteOutput::GetInsertStatement (const std::string &table, uint32_t numColumns, uint32_t numRows)
+{
+  auto it = m_insertStatements.find (std::make_pair (table, numRows));
+  if (it != m_insertStatements.end ())
+    {
+      return it->second;
+    }
+
+  std::string row = "(?";
+  for (uint32_t i = 1; i < numColumns; i++)
+    {
+      row += ",?";
+    }
+  row += ")";
+  std::string cmd = "INSERT INTO " + table + " VALUES " + row;
+  for (uint32_t i = 1; i < numRows; i++)
+    {
+      cmd += "," + row;
+    }
+  cmd += ";";
+
+  sqlite3_stmt *stmt;
+  int rc = SpinPrepare (m_db, &stmt, cmd);
+  CheckError (m_db, rc, cmd, nullptr, true);
+  m_insertStatements.emplace (std::make_pair (table, numRows), stmt);
+  return stmt;
+}
+
+void
+SQLiteOutput::WriteBatch (const RowBatch &batch)
+{
+  // Rows inserted by a statement: the number of parameters of a statement is
+  // limited to 999 by the older versions of sqlite
+  const uint32_t numColumns = batch.GetNumColumns ();
+  const uint32_t rowsPerStatement = std::max<uint32_t> (1, std::min<uint32_t> (100, 999 / numColumns));
+  const std::vector<RowBatch::Value> &values = batch.GetValues ();
+
+  int rc = SpinExec (m_db, "BEGIN TRANSACTION;");
+  CheckError (m_db, rc, "BEGIN TRANSACTION;", nullptr, true);
+
+  std::size_t row = 0;
+  const std::size_t numRows = batch.GetNumRows ();
+  while (row < numRows)
+    {
+      // the last rows are inserted one by one, to prepare only two statements per table
+      uint32_t rows = (numRows - row >= rowsPerStatement) ? rowsPerStatement : 1;
+      sqlite3_stmt *stmt = GetInsertStatement (batch.GetTable (), numColumns, rows);
+
+      const std::size_t first = row * numColumns;
+      for (std::size_t i = 0; i < static_cast<std::size_t> (rows) * numColumns; i++)
+        {
+          const RowBatch::Value &value = values[first + i];
+          int pos = static_cast<int> (i + 1);
+          if (std::holds_alternative<int64_t> (value))
+            {
+              rc = sqlite3_bind_int64 (stmt, pos, std::get<int64_t> (value));
+            }
+          else if (std::holds_alternative<double> (value))
+            {
+              rc = sqlite3_bind_double (stmt, pos, std::get<double> (value));
+            }
+          else
+            {
+              const std::string &text = std::get<std::string> (value);
+              rc = sqlite3_bind_text (stmt, pos, text.c_str (), static_cast<int> (text.size ()), SQLITE_STATIC);
+            }
+          CheckError (m_db, rc, "bind of " + batch.GetTable (), nullptr, true);
+        }
+
+      rc = SpinStep (stmt);
+      CheckError (m_db, rc, "INSERT INTO " + batch.GetTable (), nullptr, true);
+      SpinReset (stmt);
+      row += rows;
+    }
+
+  rc = SpinExec (m_db, "END TRANSACTION;");
+  CheckError (m_db, rc, "END TRANSACTION;", nullptr, true);
+}
+
 bool
 SQLiteOutput::SpinExec (const std::string &cmd) const
 {
+  Flush ();
   return (SpinExec (m_db, cmd) == SQLITE_OK);
 }
 
 bool
 SQLiteOutput::SpinExec (sqlite3_stmt *stmt) const
 {
+  Flush ();
   int rc = SpinExec (m_db, stmt);
   return !CheckError (m_db, rc, "", nullptr, false);
 }
@@ -65,6 +258,7 @@ SQLiteOutput::SpinExec (sqlite3_stmt *stmt) const
 bool
 SQLiteOutput::WaitExec (const std::string &cmd) const
 {
+  Flush ();
   int rc = WaitExec (m_db, cmd);
   return !CheckError (m_db, rc, cmd, nullptr, false);
 }
@@ -72,18 +266,21 @@ SQLiteOutput::WaitExec (const std::string &cmd) const
 bool
 SQLiteOutput::WaitExec (sqlite3_stmt *stmt) const
 {
+  Flush ();
   return (WaitExec (m_db, stmt) == SQLITE_OK);
 }
 
 bool
 SQLiteOutput::WaitPrepare (sqlite3_stmt **stmt, const std::string &cmd) const
 {
+  Flush ();
   return (WaitPrepare (m_db, stmt, cmd) == SQLITE_OK);
 }
 
 bool
 SQLiteOutput::SpinPrepare (sqlite3_stmt **stmt, const std::string &cmd) const
 {
+  Flush ();
   return (SpinPrepare (m_db, stmt, cmd) == SQLITE_OK);
 }
 
@@ -19,10 +19,21 @@
 #ifndef SQLITE_OUTPUT_H
 #define SQLITE_OUTPUT_H
 
+#include "ns3/assert.h"
 #include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
 #include <sqlite3.h>
 #include <string>
 #include <semaphore.h>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace ns3 {
 
@@ -41,6 +52,14 @@ namespace ns3 {
  * the database is unique, using "Spin" methods will speed up database access.
  *
  * The database is opened in the constructor, and closed in the deconstructor.
+ *
+ * Large amounts of results can be stored with Write, which inserts a
+ * RowBatch in a table with a single transaction, reusing a prepared
+ * statement that inserts several rows at once. After EnableAsyncWrite, the
+ * batches are written by a background thread, and Write returns as soon as
+ * the batch is queued, so that the simulation does not wait for the disk.
+ * The other methods that access the database wait until all the queued
+ * batches are written, so the order of the operations is kept.
  */
 class SQLiteOutput : public SimpleRefCount <SQLiteOutput>
 {
@@ -56,12 +75,147 @@ public:
    */
   ~SQLiteOutput ();
 
+  /**
+   * \brief Rows to be inserted in a table with SQLiteOutput::Write
+   *
+   * The values are copied in the batch, so the batch can be written later
+   * by another thread.
+   */
+  class RowBatch
+  {
+  public:
+    /**
+     * \brief Type of a value: integers are stored as int64_t, Time as seconds
+     */
+    typedef std::variant<int64_t, double, std::string> Value;
+
+    /**
+     * \brief RowBatch constructor
+     * \param table name of the table
+     * \param numColumns number of values of each row
+     */
+    RowBatch (const std::string &table, uint32_t numColumns);
+
+    /**
+     * \brief Add a row
+     * \param values the values of the columns, in the order of the table
+     */
+    template <typename... Ts>
+    void AddRow (const Ts &... values)
+    {
+      NS_ASSERT_MSG (sizeof... (Ts) == m_numColumns, "Wrong number of values for table " << m_table);
+      (Add (values), ...);
+    }
+
+    /**
+     * \return the name of the table
+     */
+    const std::string & GetTable () const
+    {
+      return m_table;
+    }
+    /**
+     * \return the number of values of each row
+     */
+    uint32_t GetNumColumns () const
+    {
+      return m_numColumns;
+    }
+    /**
+     * \return the number of rows
+     */
+    std::size_t GetNumRows () const
+    {
+      return m_values.size () / m_numColumns;
+    }
+    /**
+     * \return the values, row after row
+     */
+    const std::vector<Value> & GetValues () const
+    {
+      return m_values;
+    }
+
+  private:
+    /**
+     * \brief Add an integer value
+     * \param value the value
+     */
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    void Add (const T &value)
+    {
+      m_values.emplace_back (static_cast<int64_t> (value));
+    }
+    /**
+     * \brief Add a floating point value
+     * \param value the value
+     */
+    void Add (double value)
+    {
+      m_values.emplace_back (value);
+    }
+    /**
+     * \brief Add a time, in seconds
+     * \param value the value
+     */
+    void Add (const Time &value)
+    {
+      m_values.emplace_back (value.GetSeconds ());
+    }
+    /**
+     * \brief Add a text value
+     * \param value the value
+     */
+    void Add (const std::string &value)
+    {
+      m_values.emplace_back (value);
+    }
+
+    std::string m_table;         //!< Table name
+    uint32_t m_numColumns;       //!< Number of values of each row
+    std::vector<Value> m_values; //!< The values, row after row
+  };
+
   /**
    * \brief Instruct SQLite to store the journal in memory. May lead to data losses
    * in case of unexpected program exits.
    */
   void SetJournalInMemory ();
 
+  /**
+   * \brief Instruct SQLite to use a write-ahead log, so that the writes of
+   * a simulation do not block the readers (e.g., other simulations of a
+   * campaign that use the same database) and are appended sequentially.
+   */
+  void SetWalMode ();
+
+  /**
+   * \brief Write the batches in a background thread
+   *
+   * Write queues the batches, and a thread of this object inserts them in
+   * the database. If maxPendingBatches batches are already queued, Write
+   * waits for the thread, to limit the memory. The thread is stopped, after
+   * writing all the queued batches, by the destructor.
+   *
+   * \param maxPendingBatches maximum number of batches in the queue
+   */
+  void EnableAsyncWrite (std::size_t maxPendingBatches = 8);
+
+  /**
+   * \brief Insert the rows of a batch in its table, with a single transaction
+   *
+   * If EnableAsyncWrite was called, the batch is queued and written later;
+   * otherwise, it is written immediately. Errors are fatal.
+   *
+   * \param batch the rows
+   */
+  void Write (RowBatch &&batch);
+
+  /**
+   * \brief Wait until all the queued batches are written
+   */
+  void Flush () const;
+
   /**
    * \brief Execute a command until the return value is OK or an ERROR
    *
@@ -210,6 +364,25 @@ protected:
    * \param cmd Command
    */
   [[ noreturn ]] static void Error (sqlite3 *db, const std::string &cmd);
+
+  /**
+   * \brief Insert the rows of a batch, with a single transaction
+   * \param batch the rows
+   */
+  void WriteBatch (const RowBatch &batch);
+  /**
+   * \brief Get the statement that inserts some rows in a table, preparing
+   * it the first time
+   * \param table the table
+   * \param numColumns the number of values of each row
+   * \param numRows the number of rows inserted by the statement
+   * \return the statement
+   */
+  sqlite3_stmt * GetInsertStatement (const std::string &table, uint32_t numColumns, uint32_t numRows);
+  /**
+   * \brief Body of the thread that writes the queued batches
+   */
+  void WriterLoop ();
   /**
    * \brief Check any error in the db
    * \param db Database
@@ -228,6 +401,17 @@ private:
   sqlite3 *m_db {
     nullptr
   };                         //!< Database pointer
+
+  std::map<std::pair<std::string, uint32_t>, sqlite3_stmt *> m_insertStatements; //!< Prepared inserts, by table and number of rows
+
+  std::thread m_writer;                         //!< Thread that writes the queued batches
+  mutable std::mutex m_mutex;                   //!< Protects the queue
+  mutable std::condition_variable m_queued;     //!< Signals a batch in the queue, or the stop
+  mutable std::condition_variable m_written;    //!< Signals a batch written
+  std::deque<RowBatch> m_pending;               //!< Batches to be written
+  std::size_t m_maxPending {0};                 //!< Maximum number of queued batches, 0 without thread
+  bool m_writing {false};                       //!< True while the thread writes a batch
+  bool m_stop {false};                          //!< True when the thread has to exit
 };
 
 } // namespace ns3
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/sqlite-output.h"
+
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SQLiteOutput - Test case for the batches of rows, written by the
+ * simulation thread or by the background thread.
+ */
+class SQLiteOutputWriteTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param async true to write the batches in the background thread
+   */
+  SQLiteOutputWriteTestCase (bool async);
+
+private:
+  virtual void DoRun (void);
+
+  bool m_async; //!< Write the batches in the background thread
+};
+
+SQLiteOutputWriteTestCase::SQLiteOutputWriteTestCase (bool async)
+  : TestCase (async ? "Write batches of rows in the background" : "Write batches of rows"),
+    m_async (async)
+{
+}
+
+void
+SQLiteOutputWriteTestCase::DoRun (void)
+{
+  std::string name = CreateTempDirFilename (m_async ? "sqlite-output-async.db" : "sqlite-output.db");
+  std::remove (name.c_str ());
+  {
+    SQLiteOutput db (name, "sqlite-output-test");
+    db.SetWalMode ();
+    bool ret = db.SpinExec ("CREATE TABLE results (Id INTEGER NOT NULL, Value DOUBLE NOT NULL, "
+                            "Delay DOUBLE NOT NULL, Tag TEXT NOT NULL);");
+    NS_TEST_ASSERT_MSG_EQ (ret, true, "Table not created");
+    if (m_async)
+      {
+        db.EnableAsyncWrite (2);
+      }
+
+    // more batches than the queue, with a number of rows that is not a
+    // multiple of the rows inserted by a statement
+    const uint32_t numBatches = 5;
+    const uint32_t rowsPerBatch = 333;
+    for (uint32_t b = 0; b < numBatches; b++)
+      {
+        SQLiteOutput::RowBatch batch ("results", 4);
+        for (uint32_t i = 0; i < rowsPerBatch; i++)
+          {
+            uint32_t id = b * rowsPerBatch + i;
+            batch.AddRow (id, 0.5 * id, MilliSeconds (id), std::string (id % 2 ? "odd" : "even"));
+          }
+        db.Write (std::move (batch));
+      }
+    db.Write (SQLiteOutput::RowBatch ("results", 4));
+
+    // the query waits for the queued batches
+    sqlite3_stmt *stmt;
+    ret = db.SpinPrepare (&stmt, "SELECT COUNT(*), SUM(Id), SUM(Value), SUM(Delay) FROM results WHERE Tag = 'odd';");
+    NS_TEST_ASSERT_MSG_EQ (ret, true, "Query not prepared");
+    NS_TEST_ASSERT_MSG_EQ (SQLiteOutput::SpinStep (stmt), SQLITE_ROW, "Query failed");
+
+    uint32_t count = 0;
+    double sumId = 0;
+    for (uint32_t id = 1; id < numBatches * rowsPerBatch; id += 2)
+      {
+        count++;
+        sumId += id;
+      }
+    NS_TEST_ASSERT_MSG_EQ (db.RetrieveColumn<uint32_t> (stmt, 0), count, "Wrong number of rows");
+    NS_TEST_ASSERT_MSG_EQ_TOL (db.RetrieveColumn<double> (stmt, 1), sumId, 1e-6, "Wrong integer values");
+    NS_TEST_ASSERT_MSG_EQ_TOL (db.RetrieveColumn<double> (stmt, 2), 0.5 * sumId, 1e-6, "Wrong double values");
+    NS_TEST_ASSERT_MSG_EQ_TOL (db.RetrieveColumn<double> (stmt, 3), sumId / 1000, 1e-6, "Wrong time values");
+    SQLiteOutput::SpinFinalize (stmt);
+  }
+  std::remove (name.c_str ());
+  std::remove ((name + "-wal").c_str ());
+  std::remove ((name + "-shm").c_str ());
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SQLiteOutput TestSuite
+ */
+class SQLiteOutputTestSuite : public TestSuite
+{
+public:
+  SQLiteOutputTestSuite ();
+};
+
+SQLiteOutputTestSuite::SQLiteOutputTestSuite ()
+  : TestSuite ("sqlite-output", UNIT)
+{
+  AddTestCase (new SQLiteOutputWriteTestCase (false), TestCase::QUICK);
+  AddTestCase (new SQLiteOutputWriteTestCase (true), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static SQLiteOutputTestSuite sqliteOutputTestSuite;
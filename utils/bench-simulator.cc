@@ -51,8 +51,10 @@ public:
   Bench (const uint32_t population, const uint32_t total)
     : m_population (population),
       m_total (total),
-      m_count (0)
+      m_count (0),
+      m_now (0)
   {
+    m_nowRand = CreateObject<UniformRandomVariable> ();
   }
 
   /**
@@ -64,6 +66,15 @@ public:
     m_rand = stream;
   }
 
+  /**
+   * Set the fraction of the events scheduled with Simulator::ScheduleNow
+   * \param now the fraction
+   */
+  void SetNowFraction (const double now)
+  {
+    m_now = now;
+  }
+
   /**
    * Set population function
    * \param population the population
@@ -92,6 +103,8 @@ private:
   uint32_t m_population; ///< population
   uint32_t m_total; ///< total
   uint32_t m_count; ///< count
+  double m_now; ///< fraction of the events scheduled now
+  Ptr<UniformRandomVariable> m_nowRand; ///< random variable of the events scheduled now
 };
 
 void
@@ -139,8 +152,15 @@ Bench::Cb (void)
     }
   DEB ("event at " << Simulator::Now ().GetSeconds () << "s");
 
-  Time after = NanoSeconds (m_rand->GetValue ());
-  Simulator::Schedule (after, &Bench::Cb, this);
+  if (m_now > 0 && m_nowRand->GetValue () < m_now)
+    {
+      Simulator::ScheduleNow (&Bench::Cb, this);
+    }
+  else
+    {
+      Time after = NanoSeconds (m_rand->GetValue ());
+      Simulator::Schedule (after, &Bench::Cb, this);
+    }
   ++m_count;
 }
 
@@ -200,6 +220,76 @@ GetRandomStream (std::string filename)
 
 
 
+/**
+ * Print the table header
+ */
+void
+PrintHeader (void)
+{
+  LOG ("");
+  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
+       std::left << std::setw (3 * g_fwidth) << "Initialization:" <<
+       std::left << std::setw (3 * g_fwidth) << "Simulation:");
+  LOG (std::left << std::setw (g_fwidth) << "" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Per (s/ev)" );
+  LOG (std::setfill ('-') <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::setfill (' ')
+       );
+}
+
+/**
+ * Run the benchmark with a scheduler
+ * \param factory the scheduler factory
+ * \param filename the file of relative event times
+ * \param pop the event population size
+ * \param total the total number of events
+ * \param runs the number of runs
+ * \param now the fraction of the events scheduled now
+ */
+void
+RunScheduler (ObjectFactory factory, std::string filename,
+              uint32_t pop, uint32_t total, uint32_t runs, double now)
+{
+  Simulator::SetScheduler (factory);
+
+  Bench *bench = new Bench (pop, total);
+  bench->SetRandomStream (GetRandomStream (filename));
+  bench->SetNowFraction (now);
+
+  PrintHeader ();
+
+  // prime
+  DEB ("priming");
+  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
+  bench->RunBench ();
+
+  bench->SetPopulation (pop);
+  bench->SetTotal (total);
+  for (uint32_t i = 0; i < runs; i++)
+    {
+      std::cout << std::setw (g_fwidth) << i;
+
+      bench->RunBench ();
+    }
+
+  LOG ("");
+  Simulator::Destroy ();
+  delete bench;
+}
+
+
 int main (int argc, char *argv[])
 {
 
@@ -208,10 +298,13 @@ int main (int argc, char *argv[])
   bool schedList          = false;
   bool schedMap           = true;
   bool schedPriorityQueue = false;
+  bool schedWheel         = false;
+  bool compare            = false;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
   uint32_t runs  =       1;
+  double now     =       0;
   std::string filename = "";
   bool calRev = false;
 
@@ -223,23 +316,43 @@ int main (int argc, char *argv[])
              "  an ascii file, given by the --file=\"<filename>\" argument,\n"
              "  or standard input, by the argument --file=\"-\"\n"
              "In the case of either --file form, the input is expected\n"
-             "to be ascii, giving the relative event times in ns.");
+             "to be ascii, giving the relative event times in s.\n"
+             "\n"
+             "The relative event times of a simulation (e.g., an NR one)\n"
+             "can be captured from the log of the DefaultSimulatorImpl,\n"
+             "in a build with the logs enabled:\n"
+             "  NS_LOG=\"DefaultSimulatorImpl=level_function\" ./ns3 run <program> 2>&1 |\n"
+             "    sed -n -e 's/.*:Schedule(0x[0-9a-f]*, \\([0-9]*\\),.*/\\1e-9/p' \\\n"
+             "           -e 's/.*:ScheduleWithContext(0x[0-9a-f]*, [0-9]*, \\([0-9]*\\),.*/\\1e-9/p' \\\n"
+             "    > trace.txt\n"
+             "(with the default nanosecond resolution). With --compare, all the\n"
+             "schedulers replay the same event times.\n"
+             "\n"
+             "With --now, a fraction of the events is scheduled with\n"
+             "Simulator::ScheduleNow instead, like the zero delays of a model.");
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("calrev", "reverse ordering in the CalendarScheduler", calRev);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
   cmd.AddValue ("pri",   "use PriorityQueue",             schedPriorityQueue);
+  cmd.AddValue ("wheel", "use TimingWheelScheduler",      schedWheel);
+  cmd.AddValue ("compare", "run all the schedulers, one after the other", compare);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
   cmd.AddValue ("runs",  "number of runs (default 1)",    runs);
+  cmd.AddValue ("now",   "fraction of the events scheduled now (default 0)", now);
   cmd.AddValue ("file",  "file of relative event times",  filename);
   cmd.AddValue ("prec",  "printed output precision",      g_fwidth);
   cmd.Parse (argc, argv);
   g_me = cmd.GetName () + ": ";
   g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
 
+  NS_ABORT_MSG_IF (compare && filename == "-",
+                   "--compare needs to read the event times once per scheduler, not from stdin");
+
+  std::vector<ObjectFactory> factories;
   ObjectFactory factory ("ns3::MapScheduler");
   if (schedCal)
     {
@@ -258,64 +371,42 @@ int main (int argc, char *argv[])
     {
       factory.SetTypeId ("ns3::PriorityQueueScheduler");
     }
-      
-  Simulator::SetScheduler (factory);
-
-  LOGME (std::setprecision (g_fwidth - 6));
-  DEB ("debugging is ON");
-
-  std::string order;
-  if (schedCal)
+  if (schedWheel)
     {
-      order = ": insertion order: " + std::string (calRev ? "reverse" : "normal");
+      factory.SetTypeId ("ns3::TimingWheelScheduler");
     }
-  LOGME ("scheduler: " << factory.GetTypeId ().GetName () << order);
-  LOGME ("population: " << pop);
-  LOGME ("total events: " << total);
-  LOGME ("runs: " << runs);
+  factories.push_back (factory);
 
-  Bench *bench = new Bench (pop, total);
-  bench->SetRandomStream (GetRandomStream (filename));
-
-  // table header
-  LOG ("");
-  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
-       std::left << std::setw (3 * g_fwidth) << "Initialization:" <<
-       std::left << std::setw (3 * g_fwidth) << "Simulation:");
-  LOG (std::left << std::setw (g_fwidth) << "" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" );
-  LOG (std::setfill ('-') <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::setfill (' ')
-       );
+  if (compare)
+    {
+      factories.clear ();
+      for (std::string type : {"ns3::MapScheduler", "ns3::HeapScheduler",
+                               "ns3::CalendarScheduler", "ns3::PriorityQueueScheduler",
+                               "ns3::TimingWheelScheduler"})
+        {
+          factories.push_back (ObjectFactory (type));
+        }
+      factories.at (2).Set ("Reverse", BooleanValue (calRev));
+    }
 
-  // prime
-  DEB ("priming");
-  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
-  bench->RunBench ();
+  LOGME (std::setprecision (g_fwidth - 6));
+  DEB ("debugging is ON");
 
-  bench->SetPopulation (pop);
-  bench->SetTotal (total);
-  for (uint32_t i = 0; i < runs; i++)
+  for (const auto & f : factories)
     {
-      std::cout << std::setw (g_fwidth) << i;
+      std::string order;
+      if (f.GetTypeId () == CalendarScheduler::GetTypeId ())
+        {
+          order = ": insertion order: " + std::string (calRev ? "reverse" : "normal");
+        }
+      LOGME ("scheduler: " << f.GetTypeId ().GetName () << order);
+      LOGME ("population: " << pop);
+      LOGME ("total events: " << total);
+      LOGME ("runs: " << runs);
+      LOGME ("events scheduled now: " << now);
 
-      bench->RunBench ();
+      RunScheduler (f, filename, pop, total, runs, now);
     }
 
-  LOG ("");
-  Simulator::Destroy ();
-  delete bench;
   return 0;
 }